@@ -0,0 +1,360 @@
+//
+//  cppmath_bench.cpp
+//  CppMath benchmarks
+//
+//  Created by Dmytro Krasnianskyi on 17.10.26.
+//  Copyright © 2026 Dmytro Krasnianskyi. All rights reserved.
+//
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <numeric>
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include "src/cppmath.hpp"
+#include "cppmath_bench.hpp"
+
+using namespace cppmath::matrix;
+using cppmath::functions::factorial;
+
+namespace {
+
+/** Square sizes from a few cache lines to well past the last level cache:
+    the largest double matrix is 128 MiB.
+ */
+std::vector<std::size_t> matrixSizes(bool quick) {
+    if(quick) return {4, 64, 512};
+    return {4, 64, 512, 2048, 4096};
+}
+
+Matrix<double> filledMatrix(std::size_t n) {
+    Matrix<double> m(n, n);
+    for(std::size_t i = 0; i < m.size(); ++i) m[i] = static_cast<double>(i % 1024) * 0.5;
+    return m;
+}
+
+void benchConstruction(bench::Harness& h, std::size_t n) {
+    const double bytes = double(n) * n * sizeof(double);
+    h.run("matrix_construct", n, 0, bytes, [n]{
+        Matrix<double> m(n, n);
+        bench::doNotOptimize(m.data());
+    });
+    h.run("matrix_copy", n, 0, 2 * bytes, [&]{
+        static Matrix<double> source;
+        if(source.rows() != n) source = filledMatrix(n);
+        Matrix<double> copy(source);
+        bench::doNotOptimize(copy.data());
+    });
+    Matrix<double> m;
+    h.run("matrix_resize", n, 0, bytes, [&]{
+        m.reset();
+        m.resize(n, n, 1.0);
+        bench::doNotOptimize(m.data());
+    });
+}
+
+void benchIndexing(bench::Harness& h, std::size_t n) {
+    const Matrix<double> m = filledMatrix(n);
+    const double flops = double(n) * n;
+    const double bytes = flops * sizeof(double);
+    h.run("index_point", n, flops, bytes, [&]{
+        double sum = 0;
+        for(std::size_t r = 0; r < n; ++r)
+            for(std::size_t c = 0; c < n; ++c)
+                sum += m[MatrixPoint{r, c}];
+        bench::doNotOptimize(sum);
+    });
+    h.run("index_linear", n, flops, bytes, [&]{
+        double sum = 0;
+        for(std::size_t i = 0; i < m.size(); ++i) sum += m[i];
+        bench::doNotOptimize(sum);
+    });
+    h.run("index_data_pointer", n, flops, bytes, [&]{
+        const double* p = m.data();
+        double sum = 0;
+        for(std::size_t i = 0; i < m.size(); ++i) sum += p[i];
+        bench::doNotOptimize(sum);
+    });
+}
+
+void benchIterators(bench::Harness& h, std::size_t n) {
+    Matrix<double> m = filledMatrix(n);
+    const double elements = double(n) * n;
+    h.run("iterator_accumulate", n, elements, elements * sizeof(double), [&]{
+        bench::doNotOptimize(std::accumulate(m.begin(), m.end(), 0.0));
+    });
+    h.run("iterator_max_element", n, elements, elements * sizeof(double), [&]{
+        bench::doNotOptimize(*std::max_element(m.begin(), m.end()));
+    });
+    h.run("iterator_fill", n, 0, elements * sizeof(double), [&]{
+        std::fill(m.begin(), m.end(), 2.0);
+        bench::doNotOptimize(m.data());
+    });
+    Matrix<double> out(n, n);
+    h.run("iterator_transform", n, elements, 2 * elements * sizeof(double), [&]{
+        std::transform(m.begin(), m.end(), out.begin(), [](double x){ return x * 1.5; });
+        bench::doNotOptimize(out.data());
+    });
+}
+
+void benchKernels(bench::Harness& h, std::size_t n) {
+    const Matrix<double> a = filledMatrix(n);
+    const Matrix<double> b = filledMatrix(n);
+    Matrix<double> c(n, n);
+    const double elements = double(n) * n;
+    h.run("elementwise_add", n, elements, 3 * elements * sizeof(double), [&]{
+        add(a, b, c);
+        bench::doNotOptimize(c.data());
+    });
+    h.run("reduce_sum", n, elements, elements * sizeof(double), [&]{
+        bench::doNotOptimize(sum(a));
+    });
+    h.run("reduce_sum_kahan", n, elements, elements * sizeof(double), [&]{
+        bench::doNotOptimize(sum(a, Summation::Kahan));
+    });
+    h.run("reduce_extrema", n, elements, elements * sizeof(double), [&]{
+        bench::doNotOptimize(extrema(a).maximum.value);
+    });
+    Matrix<double> columnSums(1, n);
+    h.run("reduce_column_sums", n, elements, elements * sizeof(double), [&]{
+        sum(a, Axis::Columns, columnSums);
+        bench::doNotOptimize(columnSums.data());
+    });
+    ColumnMajorMatrix<double> columnMajor;
+    h.run("layout_to_column_major", n, 0, 2 * elements * sizeof(double), [&]{
+        convertLayout(a, columnMajor);
+        bench::doNotOptimize(columnMajor.data());
+    });
+    MortonMatrix<double> morton;
+    h.run("layout_to_morton", n, 0, 2 * elements * sizeof(double), [&]{
+        convertLayout(a, morton);
+        bench::doNotOptimize(morton.data());
+    });
+    if(n <= 2048) {
+        h.run("gemm", n, 2.0 * elements * n, 3 * elements * sizeof(double), [&]{
+            gemm(1.0, a, b, 0.0, c);
+            bench::doNotOptimize(c.data());
+        });
+    }
+    if(n <= 2048) {
+        // uint8 x int8 with int32 sums, 8-bit operands and a 32-bit result
+        const Matrix<std::uint8_t> qa(n, n, 3);
+        const Matrix<std::int8_t> qb(n, n, -2);
+        const Quantization za(0.1f, 5), zb(0.2f, 1);
+        Matrix<std::int32_t> qc(n, n);
+        h.run("quantized_gemm", n, 2.0 * elements * n, elements * (2 + sizeof(std::int32_t)), [&]{
+            quantizedMultiply(qa, za, qb, zb, qc);
+            bench::doNotOptimize(qc.data());
+        });
+    }
+    if(n >= 2048) {
+        // Nominal classical flops, so the rate compares directly with gemm
+        h.run("strassen", n, 2.0 * elements * n, 3 * elements * sizeof(double), [&]{
+            strassen(1.0, a, b, 0.0, c);
+            bench::doNotOptimize(c.data());
+        });
+    }
+    h.run("min_path_cost", n, 0, elements * sizeof(double), [&]{
+        bench::doNotOptimize(cppmath::paths::minPathCost(a));
+    });
+}
+
+/** Many small matrices at once; the size column is the matrix order. */
+void benchBatch(bench::Harness& h) {
+    const std::size_t count = 1 << 14;
+    const std::size_t orders[] = {2, 4, 8};
+    for(const std::size_t n : orders) {
+        MatrixBatch<double> a(count, n, n);
+        for(std::size_t i = 0; i < n; ++i)
+            for(std::size_t j = 0; j < n; ++j)
+                std::fill(a.plane(i, j), a.plane(i, j) + count, i == j ? double(n) : 1.0 / double(i + j + 1));
+        MatrixBatch<double> c(count, n, n);
+        const double elements = double(count) * n * n;
+        h.run("batch_multiply", n, 2.0 * elements * n, 3 * elements * sizeof(double), [&]{
+            batchMultiply(a, a, c);
+            bench::doNotOptimize(c.data());
+        });
+        h.run("batch_inverse", n, 2.0 * elements * n, 2 * elements * sizeof(double), [&]{
+            bench::doNotOptimize(batchInverse(a, c));
+        });
+    }
+}
+
+void benchBits(bench::Harness& h, bool quick) {
+    const std::vector<std::size_t> sizes = quick ? std::vector<std::size_t>{1024} : std::vector<std::size_t>{1024, 4096};
+    for(const std::size_t n : sizes) {
+        // Four pseudo-random out edges per vertex
+        BitMatrix graph(n, n);
+        std::uint64_t state = 88172645463325252ull;
+        for(std::size_t i = 0; i < n; ++i) {
+            for(std::size_t e = 0; e < 4; ++e) {
+                state ^= state << 13;
+                state ^= state >> 7;
+                state ^= state << 17;
+                graph.set(i, state % n);
+            }
+        }
+        const double bits = double(n) * n;
+        BitMatrix product;
+        h.run("bit_multiply", n, 2.0 * bits * n, 3 * bits / 8, [&]{
+            booleanMultiply(graph, graph, product);
+            bench::doNotOptimize(product.data());
+        });
+        BitMatrix closure;
+        h.run("bit_closure", n, 0, bits / 8, [&]{
+            closure = graph;
+            transitiveClosure(closure);
+            bench::doNotOptimize(closure.data());
+        });
+        h.run("bit_column_counts", n, bits, bits / 8, [&]{
+            std::vector<std::size_t> counts;
+            closure.columnCounts(counts);
+            bench::doNotOptimize(counts.data());
+        });
+    }
+}
+
+void benchFilters(bench::Harness& h, bool quick) {
+    const std::vector<std::size_t> sizes = quick ? std::vector<std::size_t>{1024} : std::vector<std::size_t>{1024, 4096};
+    for(const std::size_t n : sizes) {
+        Matrix<float> image(n, n);
+        for(std::size_t i = 0; i < image.size(); ++i) image[i] = float(i % 251) / 251.0f;
+        Matrix<float> out(n, n);
+        const double pixels = double(n) * n;
+        const double bytes = 2 * pixels * sizeof(float);
+        const Matrix<float> column(5, 1, {1, 4, 6, 4, 1});
+        const Matrix<float> row(1, 5, {1, 4, 6, 4, 1});
+        const Matrix<float> gaussian = column * row * (1.0f / 256);
+        h.run("conv_gaussian5", n, 2.0 * pixels * 25, bytes, [&]{
+            correlate(image, gaussian, out, Border::Reflect);
+            bench::doNotOptimize(out.data());
+        });
+        const Matrix<float> laplacian(3, 3, {0, 1, 0, 1, -4, 1, 0, 1, 0});
+        h.run("conv_laplacian3x3", n, 2.0 * pixels * 9, bytes, [&]{
+            correlate(image, laplacian, out, Border::Clamp);
+            bench::doNotOptimize(out.data());
+        });
+        Matrix<float> large(15, 15);
+        for(std::size_t i = 0; i < large.size(); ++i) large[i] = float((i * 7) % 11) - 5.0f;
+        h.run("conv_15x15_direct", n, 2.0 * pixels * 225, bytes, [&]{
+            correlate(image, large, out, Border::Zero, ConvolutionMethod::Direct);
+            bench::doNotOptimize(out.data());
+        });
+        h.run("conv_15x15_gemm", n, 2.0 * pixels * 225, bytes, [&]{
+            correlate(image, large, out, Border::Zero, ConvolutionMethod::Gemm);
+            bench::doNotOptimize(out.data());
+        });
+        // Sixteen Jacobi steps, passes over the grid cut by the temporal blocking
+        const Matrix<float> jacobi(3, 3, {0, 0.25f, 0, 0.25f, 0, 0.25f, 0, 0.25f, 0});
+        h.run("stencil5_x16", n, 2.0 * pixels * 4 * 16, bytes * 2, [&]{
+            stencil(image, jacobi, 16, out, Border::Wrap);
+            bench::doNotOptimize(out.data());
+        });
+    }
+}
+
+void benchFunctions(bench::Harness& h) {
+    const std::size_t calls = 1000;
+    // Read through volatile so the calls are not folded at compile time
+    volatile int arguments[] = {0, 5, 12, 20};
+    for(std::size_t k = 0; k < 4; ++k) {
+        const int n = arguments[k];
+        h.run("factorial", static_cast<std::size_t>(n), 0, 0, [&]{
+            std::size_t sum = 0;
+            for(std::size_t i = 0; i < calls; ++i) sum += factorial<int>(arguments[k]);
+            bench::doNotOptimize(sum);
+        });
+    }
+
+    // Table lookups for n <= 67, the multiplicative loop above
+    volatile std::uint64_t n[] = {10, 60, 1000, 100000};
+    volatile std::uint64_t r[] = {5, 30, 5, 3};
+    for(std::size_t k = 0; k < 4; ++k) {
+        h.run("binomial", static_cast<std::size_t>(n[k]), 0, 0, [&]{
+            std::uint64_t sum = 0;
+            for(std::size_t i = 0; i < calls; ++i) sum += cppmath::combinatorics::binomial(n[k], r[k]);
+            bench::doNotOptimize(sum);
+        });
+    }
+}
+
+void usage(const char* program) {
+    std::fprintf(stderr,
+                 "usage: %s [--quick] [--filter NAME] [--min-time SECONDS] [--json FILE]\n"
+                 "       [--baseline FILE] [--tolerance FRACTION]\n"
+                 "Writes JSON results to stdout unless --json is given. With --baseline the exit\n"
+                 "code is 1 when any case got slower than the tolerance (default 0.10).\n",
+                 program);
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    bench::Settings settings;
+    bool quick = false;
+    std::string jsonPath;
+    std::string baselinePath;
+    double tolerance = 0.10;
+
+    for(int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        const bool hasValue = i + 1 < argc;
+        if(arg == "--quick") {
+            quick = true;
+            settings.minSeconds = 0.02;
+        } else if(arg == "--filter" && hasValue) {
+            settings.filter = argv[++i];
+        } else if(arg == "--min-time" && hasValue) {
+            settings.minSeconds = std::atof(argv[++i]);
+        } else if(arg == "--json" && hasValue) {
+            jsonPath = argv[++i];
+        } else if(arg == "--baseline" && hasValue) {
+            baselinePath = argv[++i];
+        } else if(arg == "--tolerance" && hasValue) {
+            tolerance = std::atof(argv[++i]);
+        } else {
+            usage(argv[0]);
+            return arg == "--help" ? 0 : 2;
+        }
+    }
+
+    bench::Harness harness(settings);
+    for(const std::size_t n : matrixSizes(quick)) {
+        benchConstruction(harness, n);
+        benchIndexing(harness, n);
+        benchIterators(harness, n);
+        benchKernels(harness, n);
+    }
+    benchBatch(harness);
+    benchBits(harness, quick);
+    benchFilters(harness, quick);
+    benchFunctions(harness);
+
+    if(jsonPath.empty()) {
+        bench::writeJson(stdout, harness.results());
+    } else {
+        std::FILE* out = std::fopen(jsonPath.c_str(), "w");
+        if(!out) {
+            std::fprintf(stderr, "cannot write %s\n", jsonPath.c_str());
+            return 2;
+        }
+        bench::writeJson(out, harness.results());
+        std::fclose(out);
+    }
+
+    if(!baselinePath.empty()) {
+        std::FILE* in = std::fopen(baselinePath.c_str(), "r");
+        if(!in) {
+            std::fprintf(stderr, "cannot read %s\n", baselinePath.c_str());
+            return 2;
+        }
+        const std::vector<bench::Result> baseline = bench::readJson(in);
+        std::fclose(in);
+        if(bench::compare(baseline, harness.results(), tolerance) != 0) return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,169 @@
+//
+//  cppmath_bench.hpp
+//  CppMath benchmarks
+//
+//  Created by Dmytro Krasnianskyi on 17.10.26.
+//  Copyright © 2026 Dmytro Krasnianskyi. All rights reserved.
+//
+
+#ifndef cppmath_bench_hpp
+#define cppmath_bench_hpp
+
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <chrono>
+#include <string>
+#include <vector>
+#include <algorithm>
+
+/** A small self-contained benchmark harness.
+
+    Every case runs a few warmup calls, then timed repetitions until both a
+    minimum count and a minimum time are reached. A case reports the median
+    and the 99th percentile of the repetition times, and the GFLOP/s and
+    GB/s of the median when it declares its flops and bytes. Results are
+    written as JSON with one case per line, which is also the format read
+    back as a baseline.
+ */
+
+namespace bench {
+
+/** Keeps the compiler from dropping a computed value. */
+template <typename T>
+inline void doNotOptimize(const T& value) {
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : "r,m"(value) : "memory");
+#else
+    static volatile const void* sink;
+    sink = &value;
+#endif
+}
+
+struct Result {
+    std::string name;
+    std::size_t size = 0;
+    std::size_t repetitions = 0;
+    double medianNs = 0;
+    double p99Ns = 0;
+    double gflops = 0;
+    double gbps = 0;
+};
+
+struct Settings {
+    std::size_t warmup = 3;
+    std::size_t minRepetitions = 10;
+    std::size_t maxRepetitions = 100000;
+    double minSeconds = 0.2;
+    /** Only cases whose name contains the filter run. */
+    std::string filter;
+};
+
+class Harness {
+public:
+    explicit Harness(const Settings& settings): m_settings(settings) {}
+
+    /** Times fn(), which does flops floating point operations and moves
+        bytes bytes of memory per call. Zero leaves the rate out.
+     */
+    template <class Fn>
+    void run(const std::string& name, std::size_t size, double flops, double bytes, Fn fn) {
+        if(!m_settings.filter.empty() && name.find(m_settings.filter) == std::string::npos) return;
+        typedef std::chrono::steady_clock Clock;
+
+        for(std::size_t i = 0; i < m_settings.warmup; ++i) fn();
+
+        std::vector<double> samples;
+        const Clock::time_point start = Clock::now();
+        while(samples.size() < m_settings.maxRepetitions) {
+            const Clock::time_point before = Clock::now();
+            fn();
+            const Clock::time_point after = Clock::now();
+            samples.push_back(std::chrono::duration<double, std::nano>(after - before).count());
+            if(samples.size() >= m_settings.minRepetitions &&
+               std::chrono::duration<double>(after - start).count() >= m_settings.minSeconds) break;
+        }
+        std::sort(samples.begin(), samples.end());
+
+        Result r;
+        r.name = name;
+        r.size = size;
+        r.repetitions = samples.size();
+        r.medianNs = samples[samples.size() / 2];
+        r.p99Ns = samples[std::min(samples.size() - 1, samples.size() * 99 / 100)];
+        r.gflops = flops > 0 && r.medianNs > 0 ? flops / r.medianNs : 0;
+        r.gbps = bytes > 0 && r.medianNs > 0 ? bytes / r.medianNs : 0;
+        m_results.push_back(r);
+
+        std::fprintf(stderr, "%-34s %10zu %14.1f ns %14.1f ns p99 %9.3f GFLOP/s %9.3f GB/s\n",
+                     r.name.c_str(), r.size, r.medianNs, r.p99Ns, r.gflops, r.gbps);
+    }
+
+    inline const std::vector<Result>& results() const { return m_results; }
+
+private:
+    Settings m_settings;
+    std::vector<Result> m_results;
+};
+
+inline std::string resultKey(const std::string& name, std::size_t size) {
+    return name + "/" + std::to_string(size);
+}
+
+inline void writeJson(std::FILE* out, const std::vector<Result>& results) {
+    std::fprintf(out, "[\n");
+    for(std::size_t i = 0; i < results.size(); ++i) {
+        const Result& r = results[i];
+        std::fprintf(out, "  {\"name\": \"%s\", \"size\": %zu, \"repetitions\": %zu, \"median_ns\": %.3f, "
+                          "\"p99_ns\": %.3f, \"gflops\": %.4f, \"gbps\": %.4f}%s\n",
+                     r.name.c_str(), r.size, r.repetitions, r.medianNs, r.p99Ns, r.gflops, r.gbps,
+                     i + 1 < results.size() ? "," : "");
+    }
+    std::fprintf(out, "]\n");
+}
+
+/** Reads the name, size and median of every line written by writeJson. */
+inline std::vector<Result> readJson(std::FILE* in) {
+    std::vector<Result> results;
+    char line[1024];
+    while(std::fgets(line, sizeof(line), in)) {
+        const char* name = std::strstr(line, "\"name\": \"");
+        const char* size = std::strstr(line, "\"size\": ");
+        const char* median = std::strstr(line, "\"median_ns\": ");
+        if(!name || !size || !median) continue;
+        name += 9;
+        const char* nameEnd = std::strchr(name, '"');
+        if(!nameEnd) continue;
+        Result r;
+        r.name.assign(name, nameEnd);
+        r.size = static_cast<std::size_t>(std::strtoull(size + 8, nullptr, 10));
+        r.medianNs = std::strtod(median + 13, nullptr);
+        results.push_back(r);
+    }
+    return results;
+}
+
+/** Prints the cases whose median grew by more than tolerance (0.1 is 10%)
+    over the baseline. Returns the number of regressions.
+ */
+inline std::size_t compare(const std::vector<Result>& baseline, const std::vector<Result>& current, double tolerance) {
+    std::size_t regressions = 0;
+    for(const Result& now : current) {
+        const auto before = std::find_if(baseline.begin(), baseline.end(), [&](const Result& b){
+            return resultKey(b.name, b.size) == resultKey(now.name, now.size);
+        });
+        if(before == baseline.end() || before->medianNs <= 0) continue;
+        const double change = now.medianNs / before->medianNs - 1.0;
+        if(change > tolerance) {
+            ++regressions;
+            std::fprintf(stderr, "REGRESSION %s: %.1f ns -> %.1f ns (%+.1f%%)\n",
+                         resultKey(now.name, now.size).c_str(), before->medianNs, now.medianNs, change * 100);
+        }
+    }
+    return regressions;
+}
+
+} // namespace bench
+
+#endif /* cppmath_bench_hpp */
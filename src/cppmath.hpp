@@ -11,7 +11,27 @@
 
 #include <stdio.h>
 #include "cppmath_matrix.hpp"
+#include "cppmath_layout.hpp"
+#include "cppmath_gemm.hpp"
+#include "cppmath_strassen.hpp"
+#include "cppmath_batch.hpp"
+#include "cppmath_quantized.hpp"
+#include "cppmath_power.hpp"
+#include "cppmath_reduction.hpp"
+#include "cppmath_bit_matrix.hpp"
+#include "cppmath_convolution.hpp"
+#include "cppmath_elementwise.hpp"
+#include "cppmath_fixed_matrix.hpp"
+#include "cppmath_factorization.hpp"
+#include "cppmath_transpose.hpp"
+#include "cppmath_matrix_file.hpp"
+#include "cppmath_csv.hpp"
+#include "cppmath_sparse.hpp"
+#include "cppmath_parallel.hpp"
 #include "cppmath_functions.hpp"
+#include "cppmath_combinatorics.hpp"
+#include "cppmath_grid_paths.hpp"
+#include "cppmath_instrumentation.hpp"
 
 namespace cppmath{
 
@@ -0,0 +1,98 @@
+//
+//  cppmath_allocator.cpp
+//  CppMath
+//
+//  Created by Dmytro Krasnianskyi on 17.10.26.
+//  Copyright © 2026 Dmytro Krasnianskyi. All rights reserved.
+//
+
+#include "cppmath_allocator.hpp"
+
+#include <cassert>
+#include <algorithm>
+
+namespace cppmath {
+namespace memory {
+
+namespace detail {
+
+void* alignedAllocate(std::size_t bytes, std::size_t alignment) {
+    assert(alignment >= alignof(void*) && (alignment & (alignment - 1)) == 0);
+    const std::size_t extra = alignment - 1 + sizeof(void*);
+    if(bytes > std::numeric_limits<std::size_t>::max() - extra) throw std::bad_alloc();
+
+    void* raw = ::operator new(bytes + extra);
+    const std::uintptr_t first = reinterpret_cast<std::uintptr_t>(raw) + sizeof(void*);
+    void* aligned = reinterpret_cast<void*>((first + alignment - 1) & ~(static_cast<std::uintptr_t>(alignment) - 1));
+    static_cast<void**>(aligned)[-1] = raw;
+    return aligned;
+}
+
+void alignedDeallocate(void* p) noexcept {
+    if(p) ::operator delete(static_cast<void**>(p)[-1]);
+}
+
+} // namespace detail
+
+Arena::Arena(std::size_t initialCapacity) {
+    if(initialCapacity != 0) addChunk(initialCapacity);
+}
+
+Arena::~Arena() {
+    releaseChunks();
+}
+
+void Arena::releaseChunks() noexcept {
+    for(const Chunk& chunk : m_chunks) {
+        instrumentation::recordDeallocation(chunk.size);
+        detail::alignedDeallocate(chunk.data);
+    }
+    m_chunks.clear();
+}
+
+void Arena::addChunk(std::size_t size) {
+    Chunk chunk;
+    chunk.data = static_cast<unsigned char*>(detail::alignedAllocate(size, kSimdAlignment));
+    chunk.size = size;
+    instrumentation::recordAllocation(size);
+    m_chunks.push_back(chunk);
+    m_offset = 0;
+    m_capacity += size;
+    ++m_upstreamAllocations;
+}
+
+void* Arena::allocate(std::size_t bytes, std::size_t alignment) {
+    assert(alignment != 0 && (alignment & (alignment - 1)) == 0);
+    if(!m_chunks.empty()) {
+        const Chunk& chunk = m_chunks.back();
+        const std::uintptr_t base = reinterpret_cast<std::uintptr_t>(chunk.data);
+        const std::uintptr_t aligned = (base + m_offset + alignment - 1) & ~(static_cast<std::uintptr_t>(alignment) - 1);
+        const std::size_t offset = aligned - base;
+        if(offset <= chunk.size && bytes <= chunk.size - offset) {
+            m_used += offset + bytes - m_offset;
+            m_offset = offset + bytes;
+            return chunk.data + offset;
+        }
+    }
+
+    // Chunks start at kSimdAlignment, larger alignments may need padding
+    const std::size_t padding = alignment > kSimdAlignment ? alignment : 0;
+    const std::size_t previous = m_chunks.empty() ? 0 : m_chunks.back().size;
+    addChunk(std::max(bytes + padding, 2 * previous));
+    return allocate(bytes, alignment);
+}
+
+void Arena::reset() {
+    m_offset = 0;
+    m_used = 0;
+    if(m_chunks.size() <= 1) return;
+
+    // Replace the chunks with a single one able to hold the whole round
+    const std::size_t total = m_capacity;
+    releaseChunks();
+    m_capacity = 0;
+    addChunk(total);
+}
+
+} //namespace memory
+} //namespace cppmath
@@ -0,0 +1,198 @@
+//
+//  cppmath_allocator.hpp
+//  CppMath
+//
+//  Created by Dmytro Krasnianskyi on 17.10.26.
+//  Copyright © 2026 Dmytro Krasnianskyi. All rights reserved.
+//
+
+#ifndef cppmath_allocator_hpp
+#define cppmath_allocator_hpp
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <limits>
+#include <vector>
+#include <memory>
+
+#include "cppmath_instrumentation.hpp"
+
+/** Allocators for Matrix storage.
+
+    AlignedAllocator returns blocks aligned for the widest SIMD loads.
+    Arena is a monotonic buffer for short-lived matrices: allocation bumps a
+    pointer, deallocation is a no-op and reset() releases everything at once.
+    After a reset the arena merges its chunks into one, so a workload that
+    repeats per request stops touching the global heap after the first round.
+ */
+
+namespace cppmath {
+namespace memory {
+
+/** Alignment of a 512-bit vector register and of a cache line. */
+constexpr std::size_t kSimdAlignment = 64;
+
+namespace detail {
+
+/** Over-aligned block from operator new. The pointer returned by new is
+    kept right in front of the aligned block.
+ */
+void* alignedAllocate(std::size_t bytes, std::size_t alignment);
+void alignedDeallocate(void* p) noexcept;
+
+} // namespace detail
+
+template <typename T, std::size_t Alignment = kSimdAlignment>
+class AlignedAllocator {
+    static_assert(Alignment >= alignof(T) && (Alignment & (Alignment - 1)) == 0,
+                  "Alignment must be a power of two not below alignof(T)");
+public:
+    typedef T value_type;
+
+    template <typename U> struct rebind { typedef AlignedAllocator<U, Alignment> other; };
+
+    AlignedAllocator() noexcept = default;
+    template <typename U>
+    AlignedAllocator(const AlignedAllocator<U, Alignment>&) noexcept {}
+
+    T* allocate(std::size_t n) {
+        if(n > std::numeric_limits<std::size_t>::max() / sizeof(T)) throw std::bad_alloc();
+        T* p = static_cast<T*>(detail::alignedAllocate(n * sizeof(T), Alignment));
+        instrumentation::recordAllocation(n * sizeof(T));
+        return p;
+    }
+
+    void deallocate(T* p, std::size_t n) noexcept {
+        instrumentation::recordDeallocation(n * sizeof(T));
+        detail::alignedDeallocate(p);
+    }
+
+    template <typename U>
+    bool operator == (const AlignedAllocator<U, Alignment>&) const noexcept { return true; }
+    template <typename U>
+    bool operator != (const AlignedAllocator<U, Alignment>&) const noexcept { return false; }
+};
+
+class Arena {
+public:
+    explicit Arena(std::size_t initialCapacity = 64 * 1024);
+    ~Arena();
+
+    Arena(const Arena&) = delete;
+    Arena& operator = (const Arena&) = delete;
+
+    /** Bumps the current chunk, or takes a new chunk of at least twice the
+        previous size from the global heap.
+     */
+    void* allocate(std::size_t bytes, std::size_t alignment);
+
+    /** Releases every allocation at once. Memory made by this arena must not
+        be used afterwards.
+     */
+    void reset();
+
+    /** Bytes handed out since the last reset, including alignment padding. */
+    std::size_t used() const noexcept { return m_used; }
+
+    /** Total bytes held in chunks. */
+    std::size_t capacity() const noexcept { return m_capacity; }
+
+    /** Chunks taken from the global heap over the arena lifetime. */
+    std::size_t upstreamAllocations() const noexcept { return m_upstreamAllocations; }
+
+private:
+    struct Chunk {
+        unsigned char* data;
+        std::size_t size;
+    };
+
+    void addChunk(std::size_t size);
+    void releaseChunks() noexcept;
+
+    std::vector<Chunk> m_chunks;
+    std::size_t m_offset = 0;
+    std::size_t m_used = 0;
+    std::size_t m_capacity = 0;
+    std::size_t m_upstreamAllocations = 0;
+};
+
+/** Allocator drawing from an Arena. Deallocation is a no-op, memory comes
+    back on Arena::reset(). The arena must outlive every container using it.
+ */
+template <typename T, std::size_t Alignment = kSimdAlignment>
+class ArenaAllocator {
+    static_assert(Alignment >= alignof(T) && (Alignment & (Alignment - 1)) == 0,
+                  "Alignment must be a power of two not below alignof(T)");
+
+    template <typename U, std::size_t A> friend class ArenaAllocator;
+
+public:
+    typedef T value_type;
+
+    template <typename U> struct rebind { typedef ArenaAllocator<U, Alignment> other; };
+
+    ArenaAllocator(Arena& arena) noexcept: m_arena(&arena) {}
+    template <typename U>
+    ArenaAllocator(const ArenaAllocator<U, Alignment>& other) noexcept: m_arena(other.m_arena) {}
+
+    T* allocate(std::size_t n) {
+        if(n > std::numeric_limits<std::size_t>::max() / sizeof(T)) throw std::bad_alloc();
+        return static_cast<T*>(m_arena->allocate(n * sizeof(T), Alignment));
+    }
+
+    void deallocate(T*, std::size_t) noexcept {}
+
+    inline Arena& arena() const noexcept { return *m_arena; }
+
+    template <typename U>
+    bool operator == (const ArenaAllocator<U, Alignment>& other) const noexcept { return m_arena == other.m_arena; }
+    template <typename U>
+    bool operator != (const ArenaAllocator<U, Alignment>& other) const noexcept { return m_arena != other.m_arena; }
+
+private:
+    Arena* m_arena;
+};
+
+/** std::allocator that reports to the instrumentation counters. */
+template <typename T>
+class CountingAllocator: public std::allocator<T> {
+public:
+    typedef T value_type;
+
+    template <typename U> struct rebind { typedef CountingAllocator<U> other; };
+
+    CountingAllocator() noexcept = default;
+    template <typename U>
+    CountingAllocator(const CountingAllocator<U>&) noexcept {}
+
+    T* allocate(std::size_t n) {
+        T* p = std::allocator<T>::allocate(n);
+        instrumentation::recordAllocation(n * sizeof(T));
+        return p;
+    }
+
+    void deallocate(T* p, std::size_t n) noexcept {
+        instrumentation::recordDeallocation(n * sizeof(T));
+        std::allocator<T>::deallocate(p, n);
+    }
+
+    template <typename U>
+    bool operator == (const CountingAllocator<U>&) const noexcept { return true; }
+    template <typename U>
+    bool operator != (const CountingAllocator<U>&) const noexcept { return false; }
+};
+
+/** Allocator of Matrix<T> when none is given: counted in instrumented
+    builds, plain std::allocator otherwise.
+ */
+#if CPPMATH_INSTRUMENTATION
+template <typename T> using DefaultAllocator = CountingAllocator<T>;
+#else
+template <typename T> using DefaultAllocator = std::allocator<T>;
+#endif
+
+} //namespace memory
+} //namespace cppmath
+
+#endif /* cppmath_allocator_hpp */
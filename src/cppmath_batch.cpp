@@ -0,0 +1,186 @@
+//
+//  cppmath_batch.cpp
+//  CppMath
+//
+//  Created by Dmytro Krasnianskyi on 17.10.26.
+//  Copyright © 2026 Dmytro Krasnianskyi. All rights reserved.
+//
+
+#include "cppmath_batch.hpp"
+#include "cppmath_simd.hpp"
+
+namespace cppmath{
+namespace matrix{
+namespace detail {
+
+namespace {
+
+#if CPPMATH_X86_DISPATCH
+
+using namespace simd;
+
+/** The same kernel set is stamped out for every level, only the target
+    attribute differs. One vector holds the same element of V::width
+    matrices. The factorization copies the matrices of one vector into
+    scratch, a row-major n x n array of vectors, and works on the
+    right-hand sides in place. A row swap is a pair of blends under the
+    mask of the lanes that found a larger pivot, so the lanes pivot
+    independently. The diagonal keeps the reciprocals of the pivots.
+ */
+#define CPPMATH_BATCH_KERNELS(PREFIX, TARGET)                                           \
+template <class V, typename T>                                                          \
+TARGET void PREFIX##Multiply(const T* a, const T* b, T* c, std::size_t m, std::size_t k, \
+                             std::size_t n, std::size_t stride, std::size_t lanes) {    \
+    typedef typename V::Vec Vec;                                                        \
+    for(std::size_t l = 0; l < lanes; l += V::width) {                                  \
+        for(std::size_t i = 0; i < m; ++i) {                                            \
+            const T* ai = a + i * k * stride + l;                                       \
+            T* ci = c + i * n * stride + l;                                             \
+            std::size_t j = 0;                                                          \
+            for(; j + 4 <= n; j += 4) {                                                 \
+                Vec acc0 = V::zero(), acc1 = V::zero(), acc2 = V::zero(), acc3 = V::zero(); \
+                for(std::size_t p = 0; p < k; ++p) {                                    \
+                    const Vec x = V::load(ai + p * stride);                             \
+                    const T* bp = b + (p * n + j) * stride + l;                         \
+                    acc0 = V::fma(x, V::load(bp), acc0);                                \
+                    acc1 = V::fma(x, V::load(bp + stride), acc1);                       \
+                    acc2 = V::fma(x, V::load(bp + 2 * stride), acc2);                   \
+                    acc3 = V::fma(x, V::load(bp + 3 * stride), acc3);                   \
+                }                                                                       \
+                V::store(ci + j * stride, acc0);                                        \
+                V::store(ci + (j + 1) * stride, acc1);                                  \
+                V::store(ci + (j + 2) * stride, acc2);                                  \
+                V::store(ci + (j + 3) * stride, acc3);                                  \
+            }                                                                           \
+            for(; j < n; ++j) {                                                         \
+                Vec acc = V::zero();                                                    \
+                for(std::size_t p = 0; p < k; ++p)                                      \
+                    acc = V::fma(V::load(ai + p * stride), V::load(b + (p * n + j) * stride + l), acc); \
+                V::store(ci + j * stride, acc);                                         \
+            }                                                                           \
+        }                                                                               \
+    }                                                                                   \
+}                                                                                       \
+template <class V, typename T>                                                          \
+TARGET inline void PREFIX##SwapRows(typename V::Mask swap, T* u, T* v) {                \
+    const typename V::Vec x = V::load(u);                                               \
+    const typename V::Vec y = V::load(v);                                               \
+    V::store(u, V::select(swap, y, x));                                                 \
+    V::store(v, V::select(swap, x, y));                                                 \
+}                                                                                       \
+template <class V, typename T>                                                          \
+TARGET unsigned PREFIX##Eliminate(T* a, std::size_t n, T* x, std::size_t r, std::size_t stride, \
+                                  typename V::Vec& det) {                              \
+    typedef typename V::Vec Vec;                                                        \
+    const std::size_t w = V::width;                                                     \
+    unsigned singular = 0;                                                              \
+    det = V::set1(T(1));                                                                \
+    for(std::size_t j = 0; j < n; ++j) {                                                \
+        Vec best = V::abs(V::load(a + (j * n + j) * w));                                \
+        for(std::size_t i = j + 1; i < n; ++i) {                                        \
+            const Vec candidate = V::abs(V::load(a + (i * n + j) * w));                 \
+            const typename V::Mask swap = V::greater(candidate, best);                  \
+            best = V::select(swap, candidate, best);                                    \
+            det = V::select(swap, V::sub(V::zero(), det), det);                         \
+            for(std::size_t c = j; c < n; ++c) PREFIX##SwapRows<V>(swap, a + (j * n + c) * w, a + (i * n + c) * w); \
+            for(std::size_t c = 0; c < r; ++c) PREFIX##SwapRows<V>(swap, x + (j * r + c) * stride, x + (i * r + c) * stride); \
+        }                                                                               \
+        const Vec pivot = V::load(a + (j * n + j) * w);                                 \
+        det = V::mul(det, pivot);                                                       \
+        singular |= V::template compare<CompareOp::Equal>(pivot, V::zero());            \
+        const Vec inverse = V::div(V::set1(T(1)), pivot);                               \
+        V::store(a + (j * n + j) * w, inverse);                                         \
+        for(std::size_t i = j + 1; i < n; ++i) {                                        \
+            const Vec l = V::sub(V::zero(), V::mul(V::load(a + (i * n + j) * w), inverse)); \
+            for(std::size_t c = j + 1; c < n; ++c)                                      \
+                V::store(a + (i * n + c) * w, V::fma(l, V::load(a + (j * n + c) * w), V::load(a + (i * n + c) * w))); \
+            for(std::size_t c = 0; c < r; ++c)                                          \
+                V::store(x + (i * r + c) * stride, V::fma(l, V::load(x + (j * r + c) * stride), V::load(x + (i * r + c) * stride))); \
+        }                                                                               \
+    }                                                                                   \
+    return singular;                                                                    \
+}                                                                                       \
+template <class V, typename T>                                                          \
+TARGET void PREFIX##Gather(const T* a, std::size_t n, std::size_t stride, T* scratch) { \
+    for(std::size_t e = 0; e < n * n; ++e) V::store(scratch + e * V::width, V::load(a + e * stride)); \
+}                                                                                       \
+template <class V, typename T>                                                          \
+TARGET void PREFIX##Determinant(const T* a, T* det, std::size_t n, std::size_t stride,  \
+                                std::size_t lanes, T* scratch) {                        \
+    for(std::size_t l = 0; l < lanes; l += V::width) {                                  \
+        PREFIX##Gather<V>(a + l, n, stride, scratch);                                   \
+        typename V::Vec d;                                                              \
+        PREFIX##Eliminate<V>(scratch, n, static_cast<T*>(nullptr), 0, stride, d);       \
+        V::store(det + l, d);                                                           \
+    }                                                                                   \
+}                                                                                       \
+template <class V, typename T>                                                          \
+TARGET void PREFIX##Solve(const T* a, T* x, std::size_t n, std::size_t r, std::size_t stride, \
+                          std::size_t lanes, unsigned char* singular, T* scratch) {     \
+    typedef typename V::Vec Vec;                                                        \
+    const std::size_t w = V::width;                                                     \
+    for(std::size_t l = 0; l < lanes; l += w) {                                         \
+        PREFIX##Gather<V>(a + l, n, stride, scratch);                                   \
+        T* xl = x + l;                                                                  \
+        Vec d;                                                                          \
+        const unsigned bits = PREFIX##Eliminate<V>(scratch, n, xl, r, stride, d);       \
+        for(std::size_t q = 0; q < w; ++q) singular[l + q] = (bits >> q) & 1u;          \
+        for(std::size_t i = n; i-- > 0;) {                                              \
+            for(std::size_t c = 0; c < r; ++c) {                                        \
+                Vec s = V::load(xl + (i * r + c) * stride);                             \
+                for(std::size_t k = i + 1; k < n; ++k)                                  \
+                    s = V::fma(V::sub(V::zero(), V::load(scratch + (i * n + k) * w)), V::load(xl + (k * r + c) * stride), s); \
+                V::store(xl + (i * r + c) * stride, V::mul(s, V::load(scratch + (i * n + i) * w))); \
+            }                                                                           \
+        }                                                                               \
+    }                                                                                   \
+}                                                                                       \
+template <class V>                                                                      \
+BatchKernels<typename V::value_type> PREFIX##Kernels() {                                \
+    typedef typename V::value_type T;                                                   \
+    BatchKernels<T> k;                                                                  \
+    k.multiply = &PREFIX##Multiply<V, T>;                                               \
+    k.determinant = &PREFIX##Determinant<V, T>;                                         \
+    k.solve = &PREFIX##Solve<V, T>;                                                     \
+    return k;                                                                           \
+}
+
+CPPMATH_BATCH_KERNELS(sse2, CPPMATH_SSE2)
+CPPMATH_BATCH_KERNELS(avx2, CPPMATH_AVX2)
+CPPMATH_BATCH_KERNELS(avx512, CPPMATH_AVX512)
+
+#undef CPPMATH_BATCH_KERNELS
+
+#endif // CPPMATH_X86_DISPATCH
+
+} // namespace
+
+template <> BatchKernels<float> batchKernels<float>(cpu::InstructionSet isa) {
+#if CPPMATH_X86_DISPATCH
+    switch(isa) {
+        case cpu::InstructionSet::AVX512: return avx512Kernels<Avx512Float>();
+        case cpu::InstructionSet::AVX2: return avx2Kernels<Avx2Float>();
+        case cpu::InstructionSet::SSE2: return sse2Kernels<Sse2Float>();
+        default: break;
+    }
+#endif
+    (void)isa;
+    return genericBatchKernels<float>();
+}
+
+template <> BatchKernels<double> batchKernels<double>(cpu::InstructionSet isa) {
+#if CPPMATH_X86_DISPATCH
+    switch(isa) {
+        case cpu::InstructionSet::AVX512: return avx512Kernels<Avx512Double>();
+        case cpu::InstructionSet::AVX2: return avx2Kernels<Avx2Double>();
+        case cpu::InstructionSet::SSE2: return sse2Kernels<Sse2Double>();
+        default: break;
+    }
+#endif
+    (void)isa;
+    return genericBatchKernels<double>();
+}
+
+} // namespace detail
+} //namespace matrix
+} //namespace cppmath
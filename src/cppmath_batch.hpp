@@ -0,0 +1,360 @@
+//
+//  cppmath_batch.hpp
+//  CppMath
+//
+//  Created by Dmytro Krasnianskyi on 17.10.26.
+//  Copyright © 2026 Dmytro Krasnianskyi. All rights reserved.
+//
+
+#ifndef cppmath_batch_hpp
+#define cppmath_batch_hpp
+
+#include <cstddef>
+#include <cassert>
+#include <cmath>
+#include <vector>
+#include <utility>
+#include <algorithm>
+
+#include "cppmath_allocator.hpp"
+#include "cppmath_cpu.hpp"
+#include "cppmath_matrix_view.hpp"
+#include "cppmath_parallel.hpp"
+#include "cppmath_instrumentation.hpp"
+
+/** Batches of many small matrices of one shape in structure-of-arrays
+    layout.
+
+    MatrixBatch stores element (r, c) of all matrices next to each other, so
+    a vector register holds the same element of several matrices and every
+    SIMD lane works through its own matrix. The count is padded to a
+    multiple of kBatchLanes, so the kernels never handle a tail. Products,
+    determinants, inverses and solves run across the whole batch, float and
+    double on SSE2/AVX2/AVX-512 kernels selected once at runtime. Every
+    matrix of a batch is also reachable as a strided MatrixView.
+
+    Inverse and solve use Gaussian elimination with partial pivoting. Rows
+    are swapped with blends, so every lane pivots on its own matrix. Results
+    for singular matrices are not finite.
+ */
+
+namespace cppmath {
+namespace matrix{
+
+/** Matrices per padding step: the lanes of the widest vector, float on AVX-512. */
+constexpr std::size_t kBatchLanes = 16;
+
+template <typename T, class Allocator = memory::AlignedAllocator<T>>
+class MatrixBatch {
+public:
+    typedef T               value_type;
+    typedef Allocator       allocator_type;
+
+    MatrixBatch() = default;
+
+    /** count matrices of rows x columns, all elements set to value. */
+    MatrixBatch(std::size_t count, std::size_t rows, std::size_t columns, const T& value = T(),
+                const Allocator& allocator = Allocator()):
+        m_count(count),
+        m_rows(rows),
+        m_columns(columns),
+        m_stride(paddedStride(count)),
+        m_data(rows * columns * m_stride, value, allocator)
+    {}
+
+    std::size_t count() const noexcept {return m_count;}
+    std::size_t rows() const noexcept {return m_rows;}
+    std::size_t columns() const noexcept {return m_columns;}
+    constexpr inline bool isEmpty() const {return m_count == 0 || m_rows == 0 || m_columns == 0;}
+
+    /** Distance between the same element of consecutive rows of planes,
+        the padded count.
+     */
+    std::size_t stride() const noexcept {return m_stride;}
+
+    /** Element (row, column) of every matrix, stride() values. */
+    inline T* plane(std::size_t row, std::size_t column) noexcept {
+        assert(row < m_rows && column < m_columns);
+        return m_data.data() + (row * m_columns + column) * m_stride;
+    }
+    inline const T* plane(std::size_t row, std::size_t column) const noexcept {
+        assert(row < m_rows && column < m_columns);
+        return m_data.data() + (row * m_columns + column) * m_stride;
+    }
+
+    inline T* data() noexcept { return m_data.data(); }
+    inline const T* data() const noexcept { return m_data.data(); }
+
+    /** Matrix index of the batch as a view into the planes. */
+    inline MatrixView<T> operator [] (std::size_t index) {
+        assert(index < m_count);
+        return MatrixView<T>(m_data.data() + index, m_rows, m_columns,
+                             static_cast<std::ptrdiff_t>(m_columns * m_stride), static_cast<std::ptrdiff_t>(m_stride));
+    }
+    inline ConstMatrixView<T> operator [] (std::size_t index) const {
+        assert(index < m_count);
+        return ConstMatrixView<T>(m_data.data() + index, m_rows, m_columns,
+                                  static_cast<std::ptrdiff_t>(m_columns * m_stride), static_cast<std::ptrdiff_t>(m_stride));
+    }
+
+    allocator_type get_allocator() const { return m_data.get_allocator(); }
+
+private:
+    /** The count rounded up to kBatchLanes, plus one more group when planes
+        would start a multiple of 1 KiB apart and fall into the same cache
+        sets.
+     */
+    static std::size_t paddedStride(std::size_t count) {
+        const std::size_t stride = (count + kBatchLanes - 1) / kBatchLanes * kBatchLanes;
+        return stride * sizeof(T) % 1024 == 0 && stride != 0 ? stride + kBatchLanes : stride;
+    }
+
+    std::size_t m_count = 0;
+    std::size_t m_rows = 0;
+    std::size_t m_columns = 0;
+    std::size_t m_stride = 0;
+    std::vector<T, Allocator> m_data;
+};
+
+namespace detail {
+
+/** Element (i, j) of an operand lives at x[(i * columns + j) * stride], each
+    kernel call covers lanes matrices, a multiple of kBatchLanes.
+ */
+template <typename T>
+struct BatchKernels {
+    typedef void (*Multiply)(const T* a, const T* b, T* c, std::size_t m, std::size_t k, std::size_t n,
+                             std::size_t stride, std::size_t lanes);
+    /** scratch holds n * n * kBatchLanes values. */
+    typedef void (*Determinant)(const T* a, T* det, std::size_t n, std::size_t stride, std::size_t lanes, T* scratch);
+    /** Overwrites the n x r right-hand sides in x with A^-1 X and flags the
+        singular lanes.
+     */
+    typedef void (*Solve)(const T* a, T* x, std::size_t n, std::size_t r, std::size_t stride, std::size_t lanes,
+                          unsigned char* singular, T* scratch);
+
+    Multiply multiply = nullptr;
+    Determinant determinant = nullptr;
+    Solve solve = nullptr;
+};
+
+template <typename T>
+void genericBatchMultiply(const T* a, const T* b, T* c, std::size_t m, std::size_t k, std::size_t n,
+                          std::size_t stride, std::size_t lanes) {
+    for(std::size_t i = 0; i < m; ++i) {
+        for(std::size_t j = 0; j < n; ++j) {
+            T* out = c + (i * n + j) * stride;
+            for(std::size_t l = 0; l < lanes; ++l) out[l] = T();
+            for(std::size_t p = 0; p < k; ++p) {
+                const T* x = a + (i * k + p) * stride;
+                const T* y = b + (p * n + j) * stride;
+                for(std::size_t l = 0; l < lanes; ++l) out[l] += x[l] * y[l];
+            }
+        }
+    }
+}
+
+/** Eliminates one n x n matrix a in place with partial pivoting, applying
+    the same steps to the r right-hand sides in x. The diagonal of a keeps
+    the pivots. Returns false for a zero pivot.
+ */
+template <typename T>
+bool genericBatchEliminate(T* a, std::size_t n, T* x, std::size_t r, std::size_t stride, T& det) {
+    bool regular = true;
+    det = T(1);
+    for(std::size_t j = 0; j < n; ++j) {
+        std::size_t p = j;
+        for(std::size_t i = j + 1; i < n; ++i) {
+            if(std::abs(a[i * n + j]) > std::abs(a[p * n + j])) p = i;
+        }
+        if(p != j) {
+            std::swap_ranges(a + j * n + j, a + j * n + n, a + p * n + j);
+            for(std::size_t c = 0; c < r; ++c) std::swap(x[(j * r + c) * stride], x[(p * r + c) * stride]);
+            det = -det;
+        }
+        const T pivot = a[j * n + j];
+        det *= pivot;
+        if(pivot == T(0)) {
+            regular = false;
+            continue;
+        }
+        for(std::size_t i = j + 1; i < n; ++i) {
+            const T l = a[i * n + j] / pivot;
+            for(std::size_t c = j + 1; c < n; ++c) a[i * n + c] -= l * a[j * n + c];
+            for(std::size_t c = 0; c < r; ++c) x[(i * r + c) * stride] -= l * x[(j * r + c) * stride];
+        }
+    }
+    return regular;
+}
+
+template <typename T>
+void genericBatchDeterminant(const T* a, T* det, std::size_t n, std::size_t stride, std::size_t lanes, T* scratch) {
+    for(std::size_t l = 0; l < lanes; ++l) {
+        for(std::size_t e = 0; e < n * n; ++e) scratch[e] = a[e * stride + l];
+        genericBatchEliminate<T>(scratch, n, nullptr, 0, 0, det[l]);
+    }
+}
+
+template <typename T>
+void genericBatchSolve(const T* a, T* x, std::size_t n, std::size_t r, std::size_t stride, std::size_t lanes,
+                       unsigned char* singular, T* scratch) {
+    for(std::size_t l = 0; l < lanes; ++l) {
+        for(std::size_t e = 0; e < n * n; ++e) scratch[e] = a[e * stride + l];
+        T det;
+        T* xl = x + l;
+        singular[l] = genericBatchEliminate<T>(scratch, n, xl, r, stride, det) ? 0 : 1;
+        for(std::size_t i = n; i-- > 0;) {
+            for(std::size_t c = 0; c < r; ++c) {
+                T s = xl[(i * r + c) * stride];
+                for(std::size_t k = i + 1; k < n; ++k) s -= scratch[i * n + k] * xl[(k * r + c) * stride];
+                xl[(i * r + c) * stride] = s / scratch[i * n + i];
+            }
+        }
+    }
+}
+
+template <typename T>
+BatchKernels<T> genericBatchKernels() {
+    BatchKernels<T> k;
+    k.multiply = &genericBatchMultiply<T>;
+    k.determinant = &genericBatchDeterminant<T>;
+    k.solve = &genericBatchSolve<T>;
+    return k;
+}
+
+/** Kernels for the given instruction set level. The generic template
+    ignores the level, float and double have SIMD specializations.
+ */
+template <typename T>
+inline BatchKernels<T> batchKernels(cpu::InstructionSet) {
+    return genericBatchKernels<T>();
+}
+
+template <> BatchKernels<float> batchKernels<float>(cpu::InstructionSet isa);
+template <> BatchKernels<double> batchKernels<double>(cpu::InstructionSet isa);
+
+/** Kernels for the running CPU, selected on the first use. */
+template <typename T>
+inline const BatchKernels<T>& activeBatchKernels() {
+    static const BatchKernels<T> kernels = batchKernels<T>(cpu::instructionSet());
+    return kernels;
+}
+
+/** Below this many padded matrices a batch stays on the calling thread. */
+constexpr std::size_t kBatchParallelLanes = 64 * kBatchLanes;
+
+/** Runs fn(first, lanes) over ranges of whole kBatchLanes groups. */
+template <class Fn>
+void forBatchLanes(const execution::ExecutionPolicy& policy, std::size_t stride, Fn fn) {
+    const std::size_t groups = stride / kBatchLanes;
+    execution::parallelFor(policy, 0, groups, kBatchParallelLanes / kBatchLanes, [&](std::size_t first, std::size_t last){
+        fn(first * kBatchLanes, (last - first) * kBatchLanes);
+    });
+}
+
+} // namespace detail
+
+/** c[i] = a[i] * b[i] for every matrix of the batches. c must already have
+    the a.rows() x b.columns() shape and must not be a or b.
+ */
+template <typename T, class AllocatorA, class AllocatorB, class AllocatorC>
+void batchMultiply(const execution::ExecutionPolicy& policy, const MatrixBatch<T, AllocatorA>& a,
+                   const MatrixBatch<T, AllocatorB>& b, MatrixBatch<T, AllocatorC>& c) {
+    assert(a.count() == b.count() && a.count() == c.count());
+    assert(a.columns() == b.rows() && c.rows() == a.rows() && c.columns() == b.columns());
+    assert(static_cast<const void*>(c.data()) != a.data() && static_cast<const void*>(c.data()) != b.data());
+    if(c.isEmpty()) return;
+
+    const instrumentation::ScopedOperation counted(instrumentation::Operation::Gemm,
+                                                   2.0 * a.rows() * b.columns() * a.columns() * a.count());
+    const detail::BatchKernels<T>& kernels = detail::activeBatchKernels<T>();
+    detail::forBatchLanes(policy, a.stride(), [&](std::size_t first, std::size_t lanes){
+        kernels.multiply(a.data() + first, b.data() + first, c.data() + first,
+                         a.rows(), a.columns(), b.columns(), a.stride(), lanes);
+    });
+}
+
+/** The determinant of every square matrix of the batch. */
+template <typename T, class Allocator>
+std::vector<T> batchDeterminant(const execution::ExecutionPolicy& policy, const MatrixBatch<T, Allocator>& a) {
+    assert(a.rows() == a.columns());
+    std::vector<T> det(a.stride(), T(1));
+    if(a.count() != 0 && a.rows() != 0) {
+        const std::size_t n = a.rows();
+        const instrumentation::ScopedOperation counted(instrumentation::Operation::Factorization,
+                                                       2.0 / 3.0 * n * n * n * a.count());
+        const detail::BatchKernels<T>& kernels = detail::activeBatchKernels<T>();
+        detail::forBatchLanes(policy, a.stride(), [&](std::size_t first, std::size_t lanes){
+            std::vector<T> scratch(n * n * kBatchLanes);
+            kernels.determinant(a.data() + first, det.data() + first, n, a.stride(), lanes, scratch.data());
+        });
+    }
+    det.resize(a.count());
+    return det;
+}
+
+/** x[i] = a[i]^-1 b[i] for square a[i] and any number of right-hand
+    sides. x must already have the shape of b and may be b. Returns the
+    number of singular matrices, their solutions are not finite.
+ */
+template <typename T, class AllocatorA, class AllocatorB, class AllocatorX>
+std::size_t batchSolve(const execution::ExecutionPolicy& policy, const MatrixBatch<T, AllocatorA>& a,
+                       const MatrixBatch<T, AllocatorB>& b, MatrixBatch<T, AllocatorX>& x) {
+    assert(a.rows() == a.columns() && a.rows() == b.rows());
+    assert(a.count() == b.count() && x.count() == b.count());
+    assert(x.rows() == b.rows() && x.columns() == b.columns());
+    if(x.isEmpty()) return 0;
+    if(static_cast<const void*>(x.data()) != b.data()) std::copy(b.data(), b.data() + b.rows() * b.columns() * b.stride(), x.data());
+
+    const std::size_t n = a.rows();
+    const instrumentation::ScopedOperation counted(instrumentation::Operation::Factorization,
+                                                   (2.0 / 3.0 * n + 2.0 * b.columns()) * n * n * a.count());
+    const detail::BatchKernels<T>& kernels = detail::activeBatchKernels<T>();
+    std::vector<unsigned char> singular(a.stride(), 0);
+    detail::forBatchLanes(policy, a.stride(), [&](std::size_t first, std::size_t lanes){
+        std::vector<T> scratch(n * n * kBatchLanes);
+        kernels.solve(a.data() + first, x.data() + first, n, x.columns(), a.stride(), lanes, singular.data() + first, scratch.data());
+    });
+    return static_cast<std::size_t>(std::count(singular.begin(), singular.begin() + a.count(), 1));
+}
+
+/** out[i] = a[i]^-1. out must already have the shape of a and must not be
+    a. Returns the number of singular matrices, their inverses are not
+    finite.
+ */
+template <typename T, class AllocatorA, class AllocatorOut>
+std::size_t batchInverse(const execution::ExecutionPolicy& policy, const MatrixBatch<T, AllocatorA>& a,
+                         MatrixBatch<T, AllocatorOut>& out) {
+    assert(a.rows() == a.columns());
+    assert(out.count() == a.count() && out.rows() == a.rows() && out.columns() == a.columns());
+    assert(static_cast<const void*>(out.data()) != a.data());
+    for(std::size_t i = 0; i < out.rows(); ++i) {
+        for(std::size_t j = 0; j < out.columns(); ++j) std::fill(out.plane(i, j), out.plane(i, j) + out.stride(), i == j ? T(1) : T(0));
+    }
+    return batchSolve(policy, a, out, out);
+}
+
+template <typename T, class AllocatorA, class AllocatorB, class AllocatorC>
+void batchMultiply(const MatrixBatch<T, AllocatorA>& a, const MatrixBatch<T, AllocatorB>& b, MatrixBatch<T, AllocatorC>& c) {
+    batchMultiply(execution::par, a, b, c);
+}
+
+template <typename T, class Allocator>
+std::vector<T> batchDeterminant(const MatrixBatch<T, Allocator>& a) {
+    return batchDeterminant(execution::par, a);
+}
+
+template <typename T, class AllocatorA, class AllocatorB, class AllocatorX>
+std::size_t batchSolve(const MatrixBatch<T, AllocatorA>& a, const MatrixBatch<T, AllocatorB>& b, MatrixBatch<T, AllocatorX>& x) {
+    return batchSolve(execution::par, a, b, x);
+}
+
+template <typename T, class AllocatorA, class AllocatorOut>
+std::size_t batchInverse(const MatrixBatch<T, AllocatorA>& a, MatrixBatch<T, AllocatorOut>& out) {
+    return batchInverse(execution::par, a, out);
+}
+
+} //namespace matrix
+} //namespace cppmath
+
+#endif /* cppmath_batch_hpp */
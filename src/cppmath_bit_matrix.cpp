@@ -0,0 +1,438 @@
+//
+//  cppmath_bit_matrix.cpp
+//  CppMath
+//
+//  Created by Dmytro Krasnianskyi on 17.10.26.
+//  Copyright © 2026 Dmytro Krasnianskyi. All rights reserved.
+//
+
+#include "cppmath_bit_matrix.hpp"
+#include "cppmath_simd.hpp"
+#include "cppmath_instrumentation.hpp"
+
+#include <algorithm>
+
+namespace cppmath{
+namespace matrix{
+namespace detail {
+
+namespace {
+
+typedef BitKernels::Word Word;
+
+inline std::size_t popcount(Word w) {
+    w = w - ((w >> 1) & 0x5555555555555555ull);
+    w = (w & 0x3333333333333333ull) + ((w >> 2) & 0x3333333333333333ull);
+    w = (w + (w >> 4)) & 0x0F0F0F0F0F0F0F0Full;
+    return static_cast<std::size_t>((w * 0x0101010101010101ull) >> 56);
+}
+
+/** The portable kernels are plain word loops; the compiler vectorizes them
+    for the baseline target, the stamped copies below for the wider ones.
+ */
+#define CPPMATH_BIT_KERNELS(PREFIX, TARGET)                                             \
+TARGET void PREFIX##And(const Word* a, const Word* b, Word* out, std::size_t n) {       \
+    for(std::size_t i = 0; i < n; ++i) out[i] = a[i] & b[i];                            \
+}                                                                                       \
+TARGET void PREFIX##Or(const Word* a, const Word* b, Word* out, std::size_t n) {        \
+    for(std::size_t i = 0; i < n; ++i) out[i] = a[i] | b[i];                            \
+}                                                                                       \
+TARGET void PREFIX##Xor(const Word* a, const Word* b, Word* out, std::size_t n) {       \
+    for(std::size_t i = 0; i < n; ++i) out[i] = a[i] ^ b[i];                            \
+}                                                                                       \
+TARGET void PREFIX##Complement(const Word* a, Word* out, std::size_t n) {               \
+    for(std::size_t i = 0; i < n; ++i) out[i] = ~a[i];                                  \
+}                                                                                       \
+TARGET void PREFIX##OrTable(Word* row, const Word* tables, Word selector, std::size_t words) { \
+    for(std::size_t g = 0; g < 8; ++g, selector >>= 8) {                                \
+        const std::size_t b = static_cast<std::size_t>(selector & 0xFF);                \
+        if(b == 0) continue;                                                            \
+        const Word* t = tables + (g * 256 + b) * words;                                 \
+        for(std::size_t w = 0; w < words; ++w) row[w] |= t[w];                          \
+    }                                                                                   \
+}
+
+CPPMATH_BIT_KERNELS(generic, )
+
+std::size_t genericCount(const Word* words, std::size_t n) {
+    std::size_t total = 0;
+    for(std::size_t i = 0; i < n; ++i) total += popcount(words[i]);
+    return total;
+}
+
+#if CPPMATH_X86_DISPATCH
+
+CPPMATH_BIT_KERNELS(sse2, CPPMATH_SSE2)
+CPPMATH_BIT_KERNELS(avx2, CPPMATH_AVX2)
+CPPMATH_BIT_KERNELS(avx512, CPPMATH_AVX512)
+
+CPPMATH_POPCNT
+std::size_t popcntCount(const Word* words, std::size_t n) {
+    std::size_t c0 = 0, c1 = 0, c2 = 0, c3 = 0;
+    std::size_t i = 0;
+    for(; i + 4 <= n; i += 4) {
+        c0 += static_cast<std::size_t>(__builtin_popcountll(words[i]));
+        c1 += static_cast<std::size_t>(__builtin_popcountll(words[i + 1]));
+        c2 += static_cast<std::size_t>(__builtin_popcountll(words[i + 2]));
+        c3 += static_cast<std::size_t>(__builtin_popcountll(words[i + 3]));
+    }
+    for(; i < n; ++i) c0 += static_cast<std::size_t>(__builtin_popcountll(words[i]));
+    return c0 + c1 + c2 + c3;
+}
+
+CPPMATH_AVX512_POPCNT
+std::size_t avx512Count(const Word* words, std::size_t n) {
+    __m512i acc0 = _mm512_setzero_si512();
+    __m512i acc1 = _mm512_setzero_si512();
+    std::size_t i = 0;
+    for(; i + 16 <= n; i += 16) {
+        acc0 = _mm512_add_epi64(acc0, _mm512_popcnt_epi64(_mm512_loadu_si512(words + i)));
+        acc1 = _mm512_add_epi64(acc1, _mm512_popcnt_epi64(_mm512_loadu_si512(words + i + 8)));
+    }
+    std::size_t total = static_cast<std::size_t>(_mm512_reduce_add_epi64(_mm512_add_epi64(acc0, acc1)));
+    for(; i < n; ++i) total += static_cast<std::size_t>(__builtin_popcountll(words[i]));
+    return total;
+}
+
+#endif // CPPMATH_X86_DISPATCH
+
+#undef CPPMATH_BIT_KERNELS
+
+BitKernels makeKernels(BitKernels::Binary bitAnd, BitKernels::Binary bitOr, BitKernels::Binary bitXor,
+                       BitKernels::Unary complement, BitKernels::OrTable orTable) {
+    BitKernels k;
+    k.bitAnd = bitAnd;
+    k.bitOr = bitOr;
+    k.bitXor = bitXor;
+    k.complement = complement;
+    k.orTable = orTable;
+    k.count = &genericCount;
+    return k;
+}
+
+} // namespace
+
+BitKernels bitKernels(cpu::InstructionSet isa, bool popcnt, bool vpopcntdq) {
+#if CPPMATH_X86_DISPATCH
+    BitKernels k;
+    switch(isa) {
+        case cpu::InstructionSet::AVX512:
+            k = makeKernels(&avx512And, &avx512Or, &avx512Xor, &avx512Complement, &avx512OrTable);
+            break;
+        case cpu::InstructionSet::AVX2:
+            k = makeKernels(&avx2And, &avx2Or, &avx2Xor, &avx2Complement, &avx2OrTable);
+            break;
+        case cpu::InstructionSet::SSE2:
+            k = makeKernels(&sse2And, &sse2Or, &sse2Xor, &sse2Complement, &sse2OrTable);
+            break;
+        default:
+            k = makeKernels(&genericAnd, &genericOr, &genericXor, &genericComplement, &genericOrTable);
+            break;
+    }
+    if(isa == cpu::InstructionSet::AVX512 && vpopcntdq) k.count = &avx512Count;
+    else if(popcnt) k.count = &popcntCount;
+    return k;
+#else
+    (void)isa;
+    (void)popcnt;
+    (void)vpopcntdq;
+    return makeKernels(&genericAnd, &genericOr, &genericXor, &genericComplement, &genericOrTable);
+#endif
+}
+
+const BitKernels& activeBitKernels() {
+    static const BitKernels kernels = [](){
+        const cpu::Features& f = cpu::features();
+        return bitKernels(cpu::instructionSet(), f.popcnt, f.avx512vpopcntdq);
+    }();
+    return kernels;
+}
+
+/** Words of the right operand per Four Russians table, 256 KiB of tables. */
+constexpr std::size_t kBitTableWords = 16;
+/** Rows per task, enough to pay for building the tables. */
+constexpr std::size_t kBitRowBlock = 1024;
+
+/** Eight tables of the ORs of every subset of eight of the rows
+    block[0, count), restricted to words [w0, w0 + words).
+ */
+void buildTables(const Word* block, std::size_t stride, std::size_t count, std::size_t w0, std::size_t words, Word* tables) {
+    for(std::size_t g = 0; g < 8 && 8 * g < count; ++g) {
+        Word* table = tables + g * 256 * words;
+        std::fill(table, table + words, Word(0));
+        for(std::size_t b = 1; b < 256; ++b) {
+            std::size_t low = 0;
+            while(((b >> low) & 1) == 0) ++low;
+            const std::size_t row = 8 * g + low;
+            const Word* previous = table + (b & (b - 1)) * words;
+            Word* entry = table + b * words;
+            if(row < count) {
+                const Word* source = block + row * stride + w0;
+                for(std::size_t w = 0; w < words; ++w) entry[w] = previous[w] | source[w];
+            } else {
+                std::copy(previous, previous + words, entry);
+            }
+        }
+    }
+}
+
+/** target[i] |= OR of the rows of block selected by selectors[i], for the
+    rows [first, last) and words [w0, w0 + words). Rows with no selected bit
+    and the rows [skipFirst, skipLast) are left alone.
+ */
+void orSelectedRows(const BitKernels& kernels, const Word* block, std::size_t blockStride, std::size_t blockRows,
+                    const Word* selectors, std::size_t selectorStride, Word* target, std::size_t targetStride,
+                    std::size_t first, std::size_t last, std::size_t skipFirst, std::size_t skipLast,
+                    std::size_t w0, std::size_t words, Word* tables) {
+    buildTables(block, blockStride, blockRows, w0, words, tables);
+    for(std::size_t i = first; i < last; ++i) {
+        if(i >= skipFirst && i < skipLast) continue;
+        const Word selector = selectors[i * selectorStride];
+        if(selector != 0) kernels.orTable(target + i * targetStride + w0, tables, selector, words);
+    }
+}
+
+} // namespace detail
+
+namespace {
+
+std::size_t paddedWords(std::size_t words) {
+    if(words > 8) return (words + 7) / 8 * 8;
+    std::size_t padded = words == 0 ? 0 : 1;
+    while(padded < words) padded *= 2;
+    return padded;
+}
+
+} // namespace
+
+constexpr std::size_t BitMatrix::kWordBits;
+
+BitMatrix::BitMatrix(std::size_t rows, std::size_t columns, bool value):
+    m_rows(rows),
+    m_columns(columns),
+    m_stride(paddedWords((columns + kWordBits - 1) / kWordBits)),
+    m_words(rows * m_stride, value ? ~word_type(0) : word_type(0))
+{
+    if(value) clearPadding();
+}
+
+void BitMatrix::clearPadding() {
+    const std::size_t words = rowWords();
+    const word_type mask = m_columns % kWordBits == 0 ? ~word_type(0) : (word_type(1) << (m_columns % kWordBits)) - 1;
+    for(std::size_t r = 0; r < m_rows; ++r) {
+        word_type* row = rowData(r);
+        if(words > 0) row[words - 1] &= mask;
+        std::fill(row + words, row + m_stride, word_type(0));
+    }
+}
+
+void BitMatrix::fill(bool value) {
+    std::fill(m_words.begin(), m_words.end(), value ? ~word_type(0) : word_type(0));
+    if(value) clearPadding();
+}
+
+BitMatrix& BitMatrix::operator &= (const BitMatrix& other) {
+    assert(m_rows == other.m_rows && m_columns == other.m_columns);
+    detail::activeBitKernels().bitAnd(data(), other.data(), data(), m_words.size());
+    return *this;
+}
+
+BitMatrix& BitMatrix::operator |= (const BitMatrix& other) {
+    assert(m_rows == other.m_rows && m_columns == other.m_columns);
+    detail::activeBitKernels().bitOr(data(), other.data(), data(), m_words.size());
+    return *this;
+}
+
+BitMatrix& BitMatrix::operator ^= (const BitMatrix& other) {
+    assert(m_rows == other.m_rows && m_columns == other.m_columns);
+    detail::activeBitKernels().bitXor(data(), other.data(), data(), m_words.size());
+    return *this;
+}
+
+BitMatrix& BitMatrix::flip() {
+    detail::activeBitKernels().complement(data(), data(), m_words.size());
+    clearPadding();
+    return *this;
+}
+
+BitMatrix BitMatrix::operator ~ () const {
+    BitMatrix result(*this);
+    return result.flip();
+}
+
+std::size_t BitMatrix::count() const {
+    return detail::activeBitKernels().count(data(), m_words.size());
+}
+
+std::size_t BitMatrix::rowCount(std::size_t row) const {
+    assert(row < m_rows);
+    return detail::activeBitKernels().count(rowData(row), rowWords());
+}
+
+void BitMatrix::rowCounts(std::vector<std::size_t>& out) const {
+    const detail::BitKernels::Count count = detail::activeBitKernels().count;
+    out.resize(m_rows);
+    for(std::size_t r = 0; r < m_rows; ++r) out[r] = count(rowData(r), rowWords());
+}
+
+void BitMatrix::columnCounts(std::vector<std::size_t>& out) const {
+    // Plane p of a word column holds bit p of 64 counters. Adding a row word
+    // ripples its carries through the planes; eight planes hold 255 rows
+    // before they are added into out.
+    const std::size_t planes = 8;
+    const std::size_t flushRows = (std::size_t(1) << planes) - 1;
+    const std::size_t words = rowWords();
+    out.assign(m_columns, 0);
+    std::vector<word_type> counters(words * planes, 0);
+
+    const auto flush = [&](){
+        for(std::size_t w = 0; w < words; ++w) {
+            word_type* plane = &counters[w * planes];
+            const std::size_t columns = std::min(kWordBits, m_columns - w * kWordBits);
+            for(std::size_t b = 0; b < columns; ++b) {
+                std::size_t value = 0;
+                for(std::size_t p = 0; p < planes; ++p) value |= static_cast<std::size_t>((plane[p] >> b) & 1u) << p;
+                out[w * kWordBits + b] += value;
+            }
+            std::fill(plane, plane + planes, word_type(0));
+        }
+    };
+
+    for(std::size_t r = 0; r < m_rows; ++r) {
+        const word_type* row = rowData(r);
+        for(std::size_t w = 0; w < words; ++w) {
+            word_type carry = row[w];
+            word_type* plane = &counters[w * planes];
+            for(std::size_t p = 0; carry != 0 && p < planes; ++p) {
+                const word_type next = plane[p] & carry;
+                plane[p] ^= carry;
+                carry = next;
+            }
+        }
+        if((r + 1) % flushRows == 0) flush();
+    }
+    flush();
+}
+
+namespace {
+
+/** Bit c of word r moves to bit r of word c. */
+void transpose64(std::uint64_t block[64]) {
+    std::uint64_t mask = 0x00000000FFFFFFFFull;
+    for(std::size_t j = 32; j != 0; j >>= 1, mask ^= mask << j) {
+        for(std::size_t k = 0; k < 64; k = ((k | j) + 1) & ~j) {
+            const std::uint64_t t = ((block[k] >> j) ^ block[k | j]) & mask;
+            block[k] ^= t << j;
+            block[k | j] ^= t;
+        }
+    }
+}
+
+} // namespace
+
+BitMatrix BitMatrix::transposed() const {
+    BitMatrix result(m_columns, m_rows);
+    std::uint64_t block[64];
+    for(std::size_t r0 = 0; r0 < m_rows; r0 += kWordBits) {
+        const std::size_t rows = std::min(kWordBits, m_rows - r0);
+        for(std::size_t w = 0; w < rowWords(); ++w) {
+            for(std::size_t i = 0; i < 64; ++i) block[i] = i < rows ? rowData(r0 + i)[w] : 0;
+            transpose64(block);
+            const std::size_t columns = std::min(kWordBits, m_columns - w * kWordBits);
+            for(std::size_t i = 0; i < columns; ++i) result.rowData(w * kWordBits + i)[r0 / kWordBits] = block[i];
+        }
+    }
+    return result;
+}
+
+bool BitMatrix::operator == (const BitMatrix& other) const {
+    return m_rows == other.m_rows && m_columns == other.m_columns && m_words == other.m_words;
+}
+
+void booleanMultiply(const execution::ExecutionPolicy& policy, const BitMatrix& a, const BitMatrix& b, BitMatrix& out) {
+    assert(a.columns() == b.rows());
+    assert(&out != &a && &out != &b);
+    const instrumentation::ScopedOperation counted(instrumentation::Operation::Gemm,
+                                                   2.0 * a.rows() * a.columns() * b.columns() / BitMatrix::kWordBits);
+    out = BitMatrix(a.rows(), b.columns());
+
+    const detail::BitKernels& kernels = detail::activeBitKernels();
+    const std::size_t words = b.rowWords();
+    const std::size_t chunks = (words + detail::kBitTableWords - 1) / detail::kBitTableWords;
+    const std::size_t rowBlocks = (a.rows() + detail::kBitRowBlock - 1) / detail::kBitRowBlock;
+    execution::parallelFor(policy, 0, chunks * rowBlocks, 1, [&](std::size_t first, std::size_t last){
+        std::vector<BitMatrix::word_type> tables(8 * 256 * detail::kBitTableWords);
+        for(std::size_t task = first; task < last; ++task) {
+            const std::size_t w0 = (task % chunks) * detail::kBitTableWords;
+            const std::size_t n = std::min(detail::kBitTableWords, words - w0);
+            const std::size_t r0 = (task / chunks) * detail::kBitRowBlock;
+            const std::size_t r1 = std::min(a.rows(), r0 + detail::kBitRowBlock);
+            for(std::size_t q = 0; q < a.rowWords(); ++q) {
+                const std::size_t k0 = q * BitMatrix::kWordBits;
+                detail::orSelectedRows(kernels, b.rowData(k0), b.wordsPerRow(), std::min(BitMatrix::kWordBits, b.rows() - k0),
+                                       a.data() + q, a.wordsPerRow(), out.data(), out.wordsPerRow(),
+                                       r0, r1, 0, 0, w0, n, tables.data());
+            }
+        }
+    });
+}
+
+void booleanMultiply(const BitMatrix& a, const BitMatrix& b, BitMatrix& out) {
+    booleanMultiply(execution::par, a, b, out);
+}
+
+BitMatrix booleanMultiply(const BitMatrix& a, const BitMatrix& b) {
+    BitMatrix out;
+    booleanMultiply(execution::par, a, b, out);
+    return out;
+}
+
+void transitiveClosure(const execution::ExecutionPolicy& policy, BitMatrix& m) {
+    assert(m.isSquareMatrix());
+    const detail::BitKernels& kernels = detail::activeBitKernels();
+    const std::size_t n = m.rows();
+    const std::size_t words = m.rowWords();
+    const std::size_t stride = m.wordsPerRow();
+    const std::size_t chunks = (words + detail::kBitTableWords - 1) / detail::kBitTableWords;
+    const std::size_t rowBlocks = (n + detail::kBitRowBlock - 1) / detail::kBitRowBlock;
+    std::vector<BitMatrix::word_type> selectors(n);
+
+    for(std::size_t q = 0; q < words; ++q) {
+        const std::size_t k0 = q * BitMatrix::kWordBits;
+        const std::size_t k1 = std::min(n, k0 + BitMatrix::kWordBits);
+
+        // The block's own rows: Warshall through its vertices, whole rows.
+        for(std::size_t k = k0; k < k1; ++k) {
+            const BitMatrix::word_type bit = BitMatrix::word_type(1) << (k - k0);
+            for(std::size_t r = k0; r < k1; ++r) {
+                if(r != k && (m.rowData(r)[q] & bit) != 0) kernels.bitOr(m.rowData(r), m.rowData(k), m.rowData(r), words);
+            }
+        }
+
+        // Every other row takes the closed rows its word q selects. The
+        // selectors are copied first because word q of the rows changes.
+        bool any = false;
+        for(std::size_t i = 0; i < n; ++i) {
+            selectors[i] = i >= k0 && i < k1 ? 0 : m.rowData(i)[q];
+            any = any || selectors[i] != 0;
+        }
+        if(!any) continue;
+        execution::parallelFor(policy, 0, chunks * rowBlocks, 1, [&](std::size_t first, std::size_t last){
+            std::vector<BitMatrix::word_type> tables(8 * 256 * detail::kBitTableWords);
+            for(std::size_t task = first; task < last; ++task) {
+                const std::size_t w0 = (task % chunks) * detail::kBitTableWords;
+                const std::size_t r0 = (task / chunks) * detail::kBitRowBlock;
+                detail::orSelectedRows(kernels, m.rowData(k0), stride, k1 - k0, selectors.data(), 1,
+                                       m.data(), stride, r0, std::min(n, r0 + detail::kBitRowBlock), k0, k1,
+                                       w0, std::min(detail::kBitTableWords, words - w0), tables.data());
+            }
+        });
+    }
+}
+
+void transitiveClosure(BitMatrix& m) {
+    transitiveClosure(execution::par, m);
+}
+
+} //namespace matrix
+} //namespace cppmath
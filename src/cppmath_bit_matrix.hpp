@@ -0,0 +1,190 @@
+//
+//  cppmath_bit_matrix.hpp
+//  CppMath
+//
+//  Created by Dmytro Krasnianskyi on 17.10.26.
+//  Copyright © 2026 Dmytro Krasnianskyi. All rights reserved.
+//
+
+#ifndef cppmath_bit_matrix_hpp
+#define cppmath_bit_matrix_hpp
+
+#include <cstddef>
+#include <cstdint>
+#include <cassert>
+#include <vector>
+#include <type_traits>
+
+#include "cppmath_cpu.hpp"
+#include "cppmath_allocator.hpp"
+#include "cppmath_matrix.hpp"
+#include "cppmath_parallel.hpp"
+
+/** Packed boolean matrices with word-parallel algebra.
+
+    Every row is a run of 64-bit words, bit c % 64 of word c / 64 holding
+    column c. Rows are padded to a power of two words up to a cache line and
+    to whole cache lines beyond, and the storage is cache line aligned, so
+    rows never share a line with a partial neighbour. Bits past the last
+    column are always zero, which keeps counts and comparisons exact.
+
+    AND, OR, XOR and NOT run over whole storage words; counts use popcnt, or
+    VPOPCNTDQ on AVX-512 CPUs that have it. The boolean product and the
+    transitive closure use the method of Four Russians: for every block of 64
+    rows of the right operand eight tables hold the OR of every subset of
+    eight rows, so one byte of a left row selects up to eight rows with a
+    single OR. The closure is Warshall's algorithm blocked by 64 vertices,
+    where each block updates all other rows through the same tables. Rows
+    whose selecting word is zero are skipped, so sparse graphs cost less.
+
+    Matrix<bool> keeps its std::vector<bool> storage; this is the type to use
+    for masks and reachability.
+ */
+
+namespace cppmath {
+namespace matrix{
+
+namespace detail {
+
+struct BitKernels {
+    typedef std::uint64_t Word;
+    typedef void (*Binary)(const Word* a, const Word* b, Word* out, std::size_t n);
+    typedef void (*Unary)(const Word* a, Word* out, std::size_t n);
+    typedef std::size_t (*Count)(const Word* words, std::size_t n);
+    /** row[0, words) |= tables[g][byte g of selector] for the eight bytes,
+        with table entry (g, b) at tables + (g * 256 + b) * words.
+     */
+    typedef void (*OrTable)(Word* row, const Word* tables, Word selector, std::size_t words);
+
+    Binary bitAnd = nullptr;
+    Binary bitOr = nullptr;
+    Binary bitXor = nullptr;
+    Unary complement = nullptr;
+    Count count = nullptr;
+    OrTable orTable = nullptr;
+};
+
+/** Kernels for the given instruction set level and population count
+    instructions.
+ */
+BitKernels bitKernels(cpu::InstructionSet isa, bool popcnt, bool vpopcntdq);
+
+/** Kernels for the running CPU, selected on the first use. */
+const BitKernels& activeBitKernels();
+
+} // namespace detail
+
+class BitMatrix {
+public:
+    typedef std::uint64_t word_type;
+    typedef std::vector<word_type, memory::AlignedAllocator<word_type>> Storage;
+
+    static constexpr std::size_t kWordBits = 64;
+
+    BitMatrix() = default;
+    BitMatrix(std::size_t rows, std::size_t columns, bool value = false);
+
+    /** Set bits where the elements of m are not zero. */
+    template <class M, class = typename std::enable_if<IsMatrixLike<M>::value>::type>
+    explicit BitMatrix(const M& m):
+        BitMatrix(m.rows(), m.columns())
+    {
+        typedef typename MatrixValueType<M>::type T;
+        for(std::size_t r = 0; r < m_rows; ++r)
+            for(std::size_t c = 0; c < m_columns; ++c)
+                if(m[MatrixPoint{r, c}] != T(0)) set(r, c);
+    }
+
+    std::size_t rows() const noexcept { return m_rows; }
+    std::size_t columns() const noexcept { return m_columns; }
+    /** Bits, rows * columns. */
+    std::size_t size() const noexcept { return m_rows * m_columns; }
+    bool empty() const noexcept { return size() == 0; }
+    bool isSquareMatrix() const noexcept { return m_rows == m_columns; }
+
+    /** Words holding the columns of a row. */
+    std::size_t rowWords() const noexcept { return (m_columns + kWordBits - 1) / kWordBits; }
+    /** Words from one row to the next, rowWords() rounded up for alignment. */
+    std::size_t wordsPerRow() const noexcept { return m_stride; }
+
+    word_type* data() noexcept { return m_words.data(); }
+    const word_type* data() const noexcept { return m_words.data(); }
+    word_type* rowData(std::size_t row) noexcept { return m_words.data() + row * m_stride; }
+    const word_type* rowData(std::size_t row) const noexcept { return m_words.data() + row * m_stride; }
+
+    bool test(std::size_t row, std::size_t column) const {
+        assert(row < m_rows && column < m_columns);
+        return (rowData(row)[column / kWordBits] >> (column % kWordBits)) & 1u;
+    }
+    bool operator [] (const MatrixPoint& point) const { return test(point.row, point.column); }
+
+    void set(std::size_t row, std::size_t column, bool value = true) {
+        assert(row < m_rows && column < m_columns);
+        word_type& word = rowData(row)[column / kWordBits];
+        const word_type bit = word_type(1) << (column % kWordBits);
+        word = value ? (word | bit) : (word & ~bit);
+    }
+    void reset(std::size_t row, std::size_t column) { set(row, column, false); }
+    void flip(std::size_t row, std::size_t column) {
+        assert(row < m_rows && column < m_columns);
+        rowData(row)[column / kWordBits] ^= word_type(1) << (column % kWordBits);
+    }
+
+    void fill(bool value);
+
+    /** Element-wise AND, OR and XOR with a matrix of the same shape. */
+    BitMatrix& operator &= (const BitMatrix& other);
+    BitMatrix& operator |= (const BitMatrix& other);
+    BitMatrix& operator ^= (const BitMatrix& other);
+    /** NOT of every bit, in place. */
+    BitMatrix& flip();
+    BitMatrix operator ~ () const;
+
+    /** Set bits in the whole matrix, in a row, per row and per column. The
+        per column counts add bit-sliced counters of eight planes, so every
+        row costs a few word operations whatever the number of columns.
+     */
+    std::size_t count() const;
+    std::size_t rowCount(std::size_t row) const;
+    void rowCounts(std::vector<std::size_t>& out) const;
+    void columnCounts(std::vector<std::size_t>& out) const;
+
+    /** 64 x 64 bit blocks transposed in registers. */
+    BitMatrix transposed() const;
+
+    bool operator == (const BitMatrix& other) const;
+    bool operator != (const BitMatrix& other) const { return !(*this == other); }
+
+private:
+    /** Zero the bits past the last column. */
+    void clearPadding();
+
+    std::size_t m_rows = 0;
+    std::size_t m_columns = 0;
+    std::size_t m_stride = 0;
+    Storage m_words;
+};
+
+inline BitMatrix operator & (BitMatrix a, const BitMatrix& b) { return a &= b; }
+inline BitMatrix operator | (BitMatrix a, const BitMatrix& b) { return a |= b; }
+inline BitMatrix operator ^ (BitMatrix a, const BitMatrix& b) { return a ^= b; }
+
+/** out = a * b over (OR, AND): out(i, j) is set when a(i, k) and b(k, j) are
+    for some k. out is resized and must not be a or b. Without a policy
+    large products run in parallel.
+ */
+void booleanMultiply(const execution::ExecutionPolicy& policy, const BitMatrix& a, const BitMatrix& b, BitMatrix& out);
+void booleanMultiply(const BitMatrix& a, const BitMatrix& b, BitMatrix& out);
+BitMatrix booleanMultiply(const BitMatrix& a, const BitMatrix& b);
+
+/** Replaces the adjacency matrix m with its transitive closure: (i, j) is set
+    when j can be reached from i by a path of at least one edge. Set the
+    diagonal as well for the reflexive closure.
+ */
+void transitiveClosure(const execution::ExecutionPolicy& policy, BitMatrix& m);
+void transitiveClosure(BitMatrix& m);
+
+} //namespace matrix
+} //namespace cppmath
+
+#endif /* cppmath_bit_matrix_hpp */
@@ -0,0 +1,182 @@
+//
+//  cppmath_combinatorics.cpp
+//  CppMath
+//
+//  Created by Dmytro Krasnianskyi on 17.10.26.
+//  Copyright © 2026 Dmytro Krasnianskyi. All rights reserved.
+//
+
+#include "cppmath_combinatorics.hpp"
+
+#include <algorithm>
+
+namespace cppmath {
+namespace combinatorics {
+
+namespace {
+
+std::uint32_t powMod(std::uint64_t base, std::uint64_t exponent, std::uint32_t m) noexcept {
+    std::uint64_t result = 1 % m;
+    base %= m;
+    for(; exponent != 0; exponent >>= 1) {
+        if(exponent & 1) result = result * base % m;
+        base = base * base % m;
+    }
+    return static_cast<std::uint32_t>(result);
+}
+
+/** C(n, k) mod p for n, k < p. */
+std::uint32_t digitBinomial(std::uint64_t n, std::uint64_t k, std::uint32_t p) noexcept {
+    if(k > n - k) k = n - k;
+    std::uint64_t numerator = 1;
+    std::uint64_t denominator = 1;
+    for(std::uint64_t i = 1; i <= k; ++i) {
+        numerator = numerator * ((n - k + i) % p) % p;
+        denominator = denominator * (i % p) % p;
+    }
+    return static_cast<std::uint32_t>(numerator * powMod(denominator, p - 2, p) % p);
+}
+
+} // namespace
+
+std::uint32_t binomialMod(std::uint64_t n, std::uint64_t k, std::uint32_t prime) noexcept {
+    assert(prime > 1);
+    if(k > n) return 0;
+    std::uint64_t result = 1 % prime;
+    while(k != 0 && result != 0) {
+        const std::uint64_t ni = n % prime;
+        const std::uint64_t ki = k % prime;
+        if(ki > ni) return 0;
+        result = result * digitBinomial(ni, ki, prime) % prime;
+        n /= prime;
+        k /= prime;
+    }
+    return static_cast<std::uint32_t>(result);
+}
+
+BigUnsigned::BigUnsigned(std::uint64_t value) {
+    for(; value != 0; value >>= 32) m_limbs.push_back(static_cast<std::uint32_t>(value));
+}
+
+void BigUnsigned::trim() noexcept {
+    while(!m_limbs.empty() && m_limbs.back() == 0) m_limbs.pop_back();
+}
+
+BigUnsigned& BigUnsigned::operator += (const BigUnsigned& other) {
+    if(m_limbs.size() < other.m_limbs.size()) m_limbs.resize(other.m_limbs.size(), 0);
+    std::uint64_t carry = 0;
+    for(std::size_t i = 0; i < m_limbs.size(); ++i) {
+        if(i >= other.m_limbs.size() && carry == 0) break;
+        const std::uint64_t sum = std::uint64_t(m_limbs[i]) + (i < other.m_limbs.size() ? other.m_limbs[i] : 0) + carry;
+        m_limbs[i] = static_cast<std::uint32_t>(sum);
+        carry = sum >> 32;
+    }
+    if(carry != 0) m_limbs.push_back(static_cast<std::uint32_t>(carry));
+    return *this;
+}
+
+BigUnsigned& BigUnsigned::operator *= (const BigUnsigned& other) {
+    if(isZero() || other.isZero()) {
+        m_limbs.clear();
+        return *this;
+    }
+    std::vector<std::uint32_t> product(m_limbs.size() + other.m_limbs.size(), 0);
+    for(std::size_t i = 0; i < m_limbs.size(); ++i) {
+        std::uint64_t carry = 0;
+        for(std::size_t j = 0; j < other.m_limbs.size(); ++j) {
+            const std::uint64_t t = std::uint64_t(m_limbs[i]) * other.m_limbs[j] + product[i + j] + carry;
+            product[i + j] = static_cast<std::uint32_t>(t);
+            carry = t >> 32;
+        }
+        product[i + other.m_limbs.size()] = static_cast<std::uint32_t>(carry);
+    }
+    m_limbs.swap(product);
+    trim();
+    return *this;
+}
+
+BigUnsigned& BigUnsigned::operator *= (std::uint64_t factor) {
+    if(factor >> 32) return *this *= BigUnsigned(factor);
+    std::uint64_t carry = 0;
+    for(std::uint32_t& limb : m_limbs) {
+        const std::uint64_t t = std::uint64_t(limb) * factor + carry;
+        limb = static_cast<std::uint32_t>(t);
+        carry = t >> 32;
+    }
+    if(carry != 0) m_limbs.push_back(static_cast<std::uint32_t>(carry));
+    if(factor == 0) m_limbs.clear();
+    return *this;
+}
+
+std::uint32_t BigUnsigned::divide(std::uint32_t divisor) noexcept {
+    assert(divisor != 0);
+    std::uint64_t remainder = 0;
+    for(std::size_t i = m_limbs.size(); i-- > 0;) {
+        const std::uint64_t t = (remainder << 32) | m_limbs[i];
+        m_limbs[i] = static_cast<std::uint32_t>(t / divisor);
+        remainder = t % divisor;
+    }
+    trim();
+    return static_cast<std::uint32_t>(remainder);
+}
+
+bool operator < (const BigUnsigned& a, const BigUnsigned& b) noexcept {
+    if(a.m_limbs.size() != b.m_limbs.size()) return a.m_limbs.size() < b.m_limbs.size();
+    return std::lexicographical_compare(a.m_limbs.rbegin(), a.m_limbs.rend(), b.m_limbs.rbegin(), b.m_limbs.rend());
+}
+
+std::size_t BigUnsigned::bits() const noexcept {
+    if(m_limbs.empty()) return 0;
+    std::size_t result = 32 * (m_limbs.size() - 1);
+    for(std::uint32_t top = m_limbs.back(); top != 0; top >>= 1) ++result;
+    return result;
+}
+
+bool BigUnsigned::toUint64(std::uint64_t& value) const noexcept {
+    if(m_limbs.size() > 2) return false;
+    value = 0;
+    for(std::size_t i = m_limbs.size(); i-- > 0;) value = (value << 32) | m_limbs[i];
+    return true;
+}
+
+std::uint32_t BigUnsigned::mod(std::uint32_t m) const noexcept {
+    assert(m != 0);
+    std::uint64_t remainder = 0;
+    for(std::size_t i = m_limbs.size(); i-- > 0;) remainder = ((remainder << 32) | m_limbs[i]) % m;
+    return static_cast<std::uint32_t>(remainder);
+}
+
+std::string BigUnsigned::toString() const {
+    if(isZero()) return "0";
+    // Nine decimal digits per division
+    BigUnsigned rest = *this;
+    std::vector<std::uint32_t> groups;
+    while(!rest.isZero()) groups.push_back(rest.divide(1000000000u));
+    std::string result = std::to_string(groups.back());
+    for(std::size_t i = groups.size() - 1; i-- > 0;) {
+        const std::string group = std::to_string(groups[i]);
+        result.append(9 - group.size(), '0');
+        result += group;
+    }
+    return result;
+}
+
+BigUnsigned binomialBig(std::uint64_t n, std::uint64_t k) {
+    if(k > n) return BigUnsigned();
+    if(k > n - k) k = n - k;
+    assert(k <= std::numeric_limits<std::uint32_t>::max());
+
+    std::uint64_t small = 0;
+    if(tryBinomial(n, k, small)) return BigUnsigned(small);
+
+    // Every prefix product over i! is the binomial C(n - k + i, i)
+    BigUnsigned result(1);
+    for(std::uint64_t i = 1; i <= k; ++i) {
+        result *= n - k + i;
+        result.divide(static_cast<std::uint32_t>(i));
+    }
+    return result;
+}
+
+} //namespace combinatorics
+} //namespace cppmath
@@ -0,0 +1,362 @@
+//
+//  cppmath_combinatorics.hpp
+//  CppMath
+//
+//  Created by Dmytro Krasnianskyi on 17.10.26.
+//  Copyright © 2026 Dmytro Krasnianskyi. All rights reserved.
+//
+
+#ifndef cppmath_combinatorics_hpp
+#define cppmath_combinatorics_hpp
+
+#include <cstddef>
+#include <cstdint>
+#include <cassert>
+#include <limits>
+#include <string>
+#include <vector>
+#include <stdexcept>
+#include <type_traits>
+
+/** Exact binomial coefficients and factorials.
+
+    binomial() answers every C(n, k) with n <= 67 from a compile-time
+    Pascal table, which holds exactly the rows that fit 64 bits. Larger n
+    use the multiplicative formula over min(k, n - k) terms, reduced by a
+    gcd when a product would overflow, so that no intermediate exceeds the
+    result. Overflow is detected, tryBinomial() reports it and binomial()
+    throws.
+
+    For results past 64 bits there are two exact answers: the residue
+    modulo a prime (ModularInt, FactorialTable, binomialMod, which use
+    Lucas' theorem for n beyond the prime) and the full value as a
+    BigUnsigned. SaturatingInt is a count that sticks at its maximum, for
+    matrix products of counts that may overflow.
+ */
+
+namespace cppmath {
+namespace combinatorics {
+
+/** The largest n with n! in 64 bits. */
+constexpr std::uint64_t kMaxFactorial = 20;
+
+/** The largest n whose whole Pascal row fits 64 bits. */
+constexpr std::uint64_t kMaxTableBinomial = 67;
+
+namespace detail {
+
+struct FactorialValues {
+    std::uint64_t values[kMaxFactorial + 1] = {};
+
+    constexpr FactorialValues() {
+        values[0] = 1;
+        for(std::uint64_t i = 1; i <= kMaxFactorial; ++i) values[i] = values[i - 1] * i;
+    }
+};
+
+/** Rows 0..kMaxTableBinomial of Pascal's triangle, left halves only. */
+struct PascalValues {
+    static constexpr std::size_t kRows = kMaxTableBinomial + 1;
+    static constexpr std::size_t kEntries = (kRows / 2) * (kRows / 2 + 1) + (kRows % 2) * (kRows / 2 + 1);
+
+    std::uint64_t values[kEntries] = {};
+
+    /** Row n starts at the number of half-row entries above it. */
+    static constexpr std::size_t offset(std::size_t n) noexcept {
+        return (n / 2) * (n / 2 + 1) + (n % 2) * (n / 2 + 1);
+    }
+
+    constexpr PascalValues() {
+        for(std::size_t n = 0; n < kRows; ++n) {
+            for(std::size_t k = 0; k <= n / 2; ++k) {
+                values[offset(n) + k] = k == 0 ? 1 : at(n - 1, k - 1) + at(n - 1, k);
+            }
+        }
+    }
+
+    constexpr std::uint64_t at(std::size_t n, std::size_t k) const noexcept {
+        return values[offset(n) + (k <= n - k ? k : n - k)];
+    }
+};
+
+/** Holds the tables as static members of a template so that every
+    translation unit shares one copy.
+ */
+template <class = void>
+struct Tables {
+    static constexpr FactorialValues factorials{};
+    static constexpr PascalValues pascal{};
+};
+
+template <class X> constexpr FactorialValues Tables<X>::factorials;
+template <class X> constexpr PascalValues Tables<X>::pascal;
+
+constexpr std::uint64_t gcd(std::uint64_t a, std::uint64_t b) noexcept {
+    while(b != 0) {
+        const std::uint64_t t = a % b;
+        a = b;
+        b = t;
+    }
+    return a;
+}
+
+} // namespace detail
+
+/** n! for n <= kMaxFactorial. */
+constexpr std::uint64_t factorial(std::uint64_t n) {
+    return n <= kMaxFactorial ? detail::Tables<>::factorials.values[n] :
+        throw std::overflow_error("factorial: result does not fit 64 bits");
+}
+
+/** Stores C(n, k) in result and returns true, or returns false when it does
+    not fit 64 bits. C(n, k) is 0 for k > n.
+ */
+constexpr bool tryBinomial(std::uint64_t n, std::uint64_t k, std::uint64_t& result) noexcept {
+    if(k > n) {
+        result = 0;
+        return true;
+    }
+    if(n <= kMaxTableBinomial) {
+        result = detail::Tables<>::pascal.at(static_cast<std::size_t>(n), static_cast<std::size_t>(k));
+        return true;
+    }
+    if(k > n - k) k = n - k;
+
+    // C(n - k + i, i) from C(n - k + i - 1, i - 1): every step is an exact
+    // binomial no larger than the result
+    std::uint64_t value = 1;
+    constexpr std::uint64_t kMax = std::numeric_limits<std::uint64_t>::max();
+    for(std::uint64_t i = 1; i <= k; ++i) {
+        const std::uint64_t term = n - k + i;
+        if(value <= kMax / term) {
+            value = value * term / i;
+            continue;
+        }
+        // The product overflows, divide first
+        const std::uint64_t g = detail::gcd(value, i);
+        const std::uint64_t factor = term / (i / g);
+        value /= g;
+        if(value > kMax / factor) return false;
+        value *= factor;
+    }
+    result = value;
+    return true;
+}
+
+/** C(n, k), throws std::overflow_error when it does not fit 64 bits. */
+constexpr std::uint64_t binomial(std::uint64_t n, std::uint64_t k) {
+    std::uint64_t result = 0;
+    if(!tryBinomial(n, k, result)) throw std::overflow_error("binomial: result does not fit 64 bits");
+    return result;
+}
+
+/** An integer modulo the prime Modulus, Modulus < 2^32. */
+template <std::uint32_t Modulus>
+class ModularInt {
+public:
+    static_assert(Modulus > 1, "the modulus must be a prime");
+
+    static constexpr std::uint32_t modulus = Modulus;
+
+    constexpr ModularInt() noexcept = default;
+    constexpr ModularInt(std::uint64_t value) noexcept: m_value(static_cast<std::uint32_t>(value % Modulus)) {}
+
+    constexpr std::uint32_t value() const noexcept { return m_value; }
+
+    constexpr ModularInt& operator += (ModularInt other) noexcept {
+        const std::uint64_t sum = std::uint64_t(m_value) + other.m_value;
+        m_value = static_cast<std::uint32_t>(sum >= Modulus ? sum - Modulus : sum);
+        return *this;
+    }
+
+    constexpr ModularInt& operator -= (ModularInt other) noexcept {
+        m_value = m_value >= other.m_value ? m_value - other.m_value : static_cast<std::uint32_t>(
+            std::uint64_t(m_value) + Modulus - other.m_value);
+        return *this;
+    }
+
+    constexpr ModularInt& operator *= (ModularInt other) noexcept {
+        m_value = static_cast<std::uint32_t>(std::uint64_t(m_value) * other.m_value % Modulus);
+        return *this;
+    }
+
+    /** Multiplies by the inverse, other must not be zero. */
+    constexpr ModularInt& operator /= (ModularInt other) noexcept {
+        return *this *= other.inverse();
+    }
+
+    constexpr ModularInt pow(std::uint64_t exponent) const noexcept {
+        ModularInt base = *this;
+        ModularInt result(1);
+        for(; exponent != 0; exponent >>= 1) {
+            if(exponent & 1) result *= base;
+            base *= base;
+        }
+        return result;
+    }
+
+    /** Inverse by Fermat's little theorem. */
+    constexpr ModularInt inverse() const noexcept {
+        return pow(Modulus - 2);
+    }
+
+    friend constexpr ModularInt operator + (ModularInt a, ModularInt b) noexcept { return a += b; }
+    friend constexpr ModularInt operator - (ModularInt a, ModularInt b) noexcept { return a -= b; }
+    friend constexpr ModularInt operator * (ModularInt a, ModularInt b) noexcept { return a *= b; }
+    friend constexpr ModularInt operator / (ModularInt a, ModularInt b) noexcept { return a /= b; }
+    friend constexpr bool operator == (ModularInt a, ModularInt b) noexcept { return a.m_value == b.m_value; }
+    friend constexpr bool operator != (ModularInt a, ModularInt b) noexcept { return a.m_value != b.m_value; }
+
+private:
+    std::uint32_t m_value = 0;
+};
+
+template <std::uint32_t Modulus> constexpr std::uint32_t ModularInt<Modulus>::modulus;
+
+/** An unsigned count that stops at the largest value of T instead of
+    wrapping, so that an overflowed result stays recognizable.
+ */
+template <typename T>
+class SaturatingInt {
+public:
+    static_assert(std::is_unsigned<T>::value, "SaturatingInt needs an unsigned type");
+
+    static constexpr T max = std::numeric_limits<T>::max();
+
+    constexpr SaturatingInt() noexcept = default;
+    constexpr SaturatingInt(T value) noexcept: m_value(value) {}
+
+    constexpr T value() const noexcept { return m_value; }
+    constexpr bool saturated() const noexcept { return m_value == max; }
+
+    constexpr SaturatingInt& operator += (SaturatingInt other) noexcept {
+        m_value = other.m_value > max - m_value ? max : static_cast<T>(m_value + other.m_value);
+        return *this;
+    }
+
+    constexpr SaturatingInt& operator *= (SaturatingInt other) noexcept {
+        m_value = m_value != 0 && other.m_value > max / m_value ? max : static_cast<T>(m_value * other.m_value);
+        return *this;
+    }
+
+    friend constexpr SaturatingInt operator + (SaturatingInt a, SaturatingInt b) noexcept { return a += b; }
+    friend constexpr SaturatingInt operator * (SaturatingInt a, SaturatingInt b) noexcept { return a *= b; }
+    friend constexpr bool operator == (SaturatingInt a, SaturatingInt b) noexcept { return a.m_value == b.m_value; }
+    friend constexpr bool operator != (SaturatingInt a, SaturatingInt b) noexcept { return a.m_value != b.m_value; }
+
+private:
+    T m_value = 0;
+};
+
+template <typename T> constexpr T SaturatingInt<T>::max;
+
+/** Factorials and inverse factorials modulo the prime Modulus for 0..N-1,
+    built at compile time when declared constexpr. Binomials of any n
+    split n into base Modulus digits (Lucas' theorem) and look the digits
+    up, digits of N and above are computed term by term.
+ */
+template <std::uint32_t Modulus, std::size_t N>
+class FactorialTable {
+public:
+    typedef ModularInt<Modulus> value_type;
+
+    static_assert(N > 0 && N <= Modulus, "the table must stop below the modulus");
+
+    constexpr FactorialTable() noexcept {
+        m_factorials[0] = value_type(1);
+        for(std::size_t i = 1; i < N; ++i) m_factorials[i] = m_factorials[i - 1] * value_type(i);
+        m_inverses[N - 1] = m_factorials[N - 1].inverse();
+        for(std::size_t i = N - 1; i > 0; --i) m_inverses[i - 1] = m_inverses[i] * value_type(i);
+    }
+
+    constexpr value_type factorial(std::size_t n) const noexcept {
+        assert(n < N);
+        return m_factorials[n];
+    }
+
+    constexpr value_type inverseFactorial(std::size_t n) const noexcept {
+        assert(n < N);
+        return m_inverses[n];
+    }
+
+    constexpr value_type binomial(std::uint64_t n, std::uint64_t k) const noexcept {
+        value_type result(1);
+        while(k != 0) {
+            const std::uint64_t ni = n % Modulus;
+            const std::uint64_t ki = k % Modulus;
+            if(ki > ni) return value_type(0);
+            result *= digitBinomial(ni, ki);
+            n /= Modulus;
+            k /= Modulus;
+        }
+        return result;
+    }
+
+private:
+    constexpr value_type digitBinomial(std::uint64_t n, std::uint64_t k) const noexcept {
+        if(n < N) return m_factorials[n] * m_inverses[k] * m_inverses[n - k];
+        if(k > n - k) k = n - k;
+        value_type numerator(1);
+        value_type denominator(1);
+        for(std::uint64_t i = 1; i <= k; ++i) {
+            numerator *= value_type(n - k + i);
+            denominator *= value_type(i);
+        }
+        return numerator / denominator;
+    }
+
+    value_type m_factorials[N] = {};
+    value_type m_inverses[N] = {};
+};
+
+/** C(n, k) modulo a prime given at run time, by Lucas' theorem. Each base
+    p digit costs O(min(k_i, n_i - k_i)) multiplications and one inverse.
+ */
+std::uint32_t binomialMod(std::uint64_t n, std::uint64_t k, std::uint32_t prime) noexcept;
+
+/** Arbitrary precision unsigned integer, little-endian 32-bit limbs. */
+class BigUnsigned {
+public:
+    BigUnsigned() = default;
+    BigUnsigned(std::uint64_t value);
+
+    BigUnsigned& operator += (const BigUnsigned& other);
+    BigUnsigned& operator *= (const BigUnsigned& other);
+    BigUnsigned& operator *= (std::uint64_t factor);
+
+    /** Divides by divisor and returns the remainder. */
+    std::uint32_t divide(std::uint32_t divisor) noexcept;
+
+    friend BigUnsigned operator + (BigUnsigned a, const BigUnsigned& b) { return a += b; }
+    friend BigUnsigned operator * (BigUnsigned a, const BigUnsigned& b) { return a *= b; }
+
+    friend bool operator == (const BigUnsigned& a, const BigUnsigned& b) noexcept { return a.m_limbs == b.m_limbs; }
+    friend bool operator != (const BigUnsigned& a, const BigUnsigned& b) noexcept { return a.m_limbs != b.m_limbs; }
+    friend bool operator < (const BigUnsigned& a, const BigUnsigned& b) noexcept;
+
+    inline bool isZero() const noexcept { return m_limbs.empty(); }
+
+    /** Number of significant bits, 0 for zero. */
+    std::size_t bits() const noexcept;
+
+    /** Stores the value and returns true when it fits 64 bits. */
+    bool toUint64(std::uint64_t& value) const noexcept;
+
+    /** The residue modulo m. */
+    std::uint32_t mod(std::uint32_t m) const noexcept;
+
+    std::string toString() const;
+
+private:
+    void trim() noexcept;
+
+    std::vector<std::uint32_t> m_limbs;
+};
+
+/** The exact C(n, k) of any size, for min(k, n - k) < 2^32. */
+BigUnsigned binomialBig(std::uint64_t n, std::uint64_t k);
+
+} //namespace combinatorics
+} //namespace cppmath
+
+#endif /* cppmath_combinatorics_hpp */
@@ -0,0 +1,132 @@
+//
+//  cppmath_convolution.cpp
+//  CppMath
+//
+//  Created by Dmytro Krasnianskyi on 17.10.26.
+//  Copyright © 2026 Dmytro Krasnianskyi. All rights reserved.
+//
+
+#include "cppmath_convolution.hpp"
+#include "cppmath_simd.hpp"
+
+namespace cppmath{
+namespace matrix{
+namespace detail {
+
+namespace {
+
+#if CPPMATH_X86_DISPATCH
+
+using namespace simd;
+
+/** The same kernel set is stamped out for every level, only the target
+    attribute differs. Four output vectors are accumulated in registers over
+    all taps before they are stored, every tap is broadcast once per block;
+    tails run one vector at a time and then the scalar code.
+ */
+#define CPPMATH_CONVOLUTION_KERNELS(PREFIX, TARGET)                                     \
+template <class V, typename T>                                                          \
+TARGET void PREFIX##RowFilter(const T* src, const T* taps, std::size_t ntaps, T* out, std::size_t n, bool accumulate) { \
+    typedef typename V::Vec Vec;                                                        \
+    const std::size_t w = V::width;                                                     \
+    std::size_t c = 0;                                                                  \
+    for(; c + 4 * w <= n; c += 4 * w) {                                                 \
+        Vec acc0 = accumulate ? V::load(out + c) : V::zero();                           \
+        Vec acc1 = accumulate ? V::load(out + c + w) : V::zero();                       \
+        Vec acc2 = accumulate ? V::load(out + c + 2 * w) : V::zero();                   \
+        Vec acc3 = accumulate ? V::load(out + c + 3 * w) : V::zero();                   \
+        const T* s = src + c;                                                           \
+        for(std::size_t j = 0; j < ntaps; ++j) {                                        \
+            const Vec t = V::broadcast(taps + j);                                       \
+            acc0 = V::fma(t, V::load(s + j), acc0);                                     \
+            acc1 = V::fma(t, V::load(s + j + w), acc1);                                 \
+            acc2 = V::fma(t, V::load(s + j + 2 * w), acc2);                             \
+            acc3 = V::fma(t, V::load(s + j + 3 * w), acc3);                             \
+        }                                                                               \
+        V::store(out + c, acc0);                                                        \
+        V::store(out + c + w, acc1);                                                    \
+        V::store(out + c + 2 * w, acc2);                                                \
+        V::store(out + c + 3 * w, acc3);                                                \
+    }                                                                                   \
+    for(; c + w <= n; c += w) {                                                         \
+        Vec acc = accumulate ? V::load(out + c) : V::zero();                            \
+        for(std::size_t j = 0; j < ntaps; ++j) acc = V::fma(V::broadcast(taps + j), V::load(src + c + j), acc); \
+        V::store(out + c, acc);                                                         \
+    }                                                                                   \
+    genericRowFilter(src + c, taps, ntaps, out + c, n - c, accumulate);                 \
+}                                                                                       \
+template <class V, typename T>                                                          \
+TARGET void PREFIX##ColumnFilter(const T* src, std::ptrdiff_t stride, const T* taps, std::size_t ntaps, T* out, std::size_t n) { \
+    typedef typename V::Vec Vec;                                                        \
+    const std::size_t w = V::width;                                                     \
+    std::size_t c = 0;                                                                  \
+    for(; c + 4 * w <= n; c += 4 * w) {                                                 \
+        Vec acc0 = V::zero(), acc1 = V::zero(), acc2 = V::zero(), acc3 = V::zero();     \
+        const T* s = src + c;                                                           \
+        for(std::size_t i = 0; i < ntaps; ++i, s += stride) {                           \
+            const Vec t = V::broadcast(taps + i);                                       \
+            acc0 = V::fma(t, V::load(s), acc0);                                         \
+            acc1 = V::fma(t, V::load(s + w), acc1);                                     \
+            acc2 = V::fma(t, V::load(s + 2 * w), acc2);                                 \
+            acc3 = V::fma(t, V::load(s + 3 * w), acc3);                                 \
+        }                                                                               \
+        V::store(out + c, acc0);                                                        \
+        V::store(out + c + w, acc1);                                                    \
+        V::store(out + c + 2 * w, acc2);                                                \
+        V::store(out + c + 3 * w, acc3);                                                \
+    }                                                                                   \
+    for(; c + w <= n; c += w) {                                                         \
+        Vec acc = V::zero();                                                            \
+        const T* s = src + c;                                                           \
+        for(std::size_t i = 0; i < ntaps; ++i, s += stride) acc = V::fma(V::broadcast(taps + i), V::load(s), acc); \
+        V::store(out + c, acc);                                                         \
+    }                                                                                   \
+    genericColumnFilter(src + c, stride, taps, ntaps, out + c, n - c);                  \
+}                                                                                       \
+template <class V, typename T = typename V::value_type>                                 \
+ConvolutionKernels<T> PREFIX##Kernels() {                                               \
+    ConvolutionKernels<T> k;                                                            \
+    k.rowFilter = &PREFIX##RowFilter<V, T>;                                             \
+    k.columnFilter = &PREFIX##ColumnFilter<V, T>;                                       \
+    return k;                                                                           \
+}
+
+CPPMATH_CONVOLUTION_KERNELS(sse2, CPPMATH_SSE2)
+CPPMATH_CONVOLUTION_KERNELS(avx2, CPPMATH_AVX2)
+CPPMATH_CONVOLUTION_KERNELS(avx512, CPPMATH_AVX512)
+
+#undef CPPMATH_CONVOLUTION_KERNELS
+
+#endif // CPPMATH_X86_DISPATCH
+
+} // namespace
+
+template <> ConvolutionKernels<float> convolutionKernels<float>(cpu::InstructionSet isa) {
+#if CPPMATH_X86_DISPATCH
+    switch(isa) {
+        case cpu::InstructionSet::AVX512: return avx512Kernels<Avx512Float>();
+        case cpu::InstructionSet::AVX2: return avx2Kernels<Avx2Float>();
+        case cpu::InstructionSet::SSE2: return sse2Kernels<Sse2Float>();
+        default: break;
+    }
+#endif
+    (void)isa;
+    return genericConvolutionKernels<float>();
+}
+
+template <> ConvolutionKernels<double> convolutionKernels<double>(cpu::InstructionSet isa) {
+#if CPPMATH_X86_DISPATCH
+    switch(isa) {
+        case cpu::InstructionSet::AVX512: return avx512Kernels<Avx512Double>();
+        case cpu::InstructionSet::AVX2: return avx2Kernels<Avx2Double>();
+        case cpu::InstructionSet::SSE2: return sse2Kernels<Sse2Double>();
+        default: break;
+    }
+#endif
+    (void)isa;
+    return genericConvolutionKernels<double>();
+}
+
+} // namespace detail
+} //namespace matrix
+} //namespace cppmath
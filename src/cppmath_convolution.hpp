@@ -0,0 +1,629 @@
+//
+//  cppmath_convolution.hpp
+//  CppMath
+//
+//  Created by Dmytro Krasnianskyi on 17.10.26.
+//  Copyright © 2026 Dmytro Krasnianskyi. All rights reserved.
+//
+
+#ifndef cppmath_convolution_hpp
+#define cppmath_convolution_hpp
+
+#include <cstddef>
+#include <cassert>
+#include <cmath>
+#include <limits>
+#include <utility>
+#include <algorithm>
+#include <type_traits>
+
+#include "cppmath_cpu.hpp"
+#include "cppmath_matrix.hpp"
+#include "cppmath_gemm.hpp"
+#include "cppmath_parallel.hpp"
+#include "cppmath_instrumentation.hpp"
+
+/** 2D correlation, convolution and iterated stencils.
+
+    Output element (r, c) of correlate() is the sum of kernel(i, j) *
+    a(r + i - kh / 2, c + j - kw / 2) over the kh x kw kernel: the kernel is
+    anchored at its centre, or just below and right of it for even sizes, and
+    the output has the shape of a. convolve() correlates with the kernel
+    rotated by half a turn. Reads outside a follow the Border rule.
+
+    The output is computed in tiles of bands of rows by a few hundred
+    columns. Every tile first copies the source rows it reads, padded by the
+    border rule, into a buffer of its thread; the kernels then only run over
+    contiguous rows and never test an index. Three methods share the tiles:
+
+    Direct      every kernel row adds its taps times a shifted source row to
+                the output row; zero taps at the ends of a row and rows of
+                zeros are skipped, so cross shaped stencils cost their taps
+    Separable   a rank one kernel u * v^T runs as a column pass with u and a
+                row pass with v, kh + kw taps per element instead of kh * kw
+    Gemm        im2col: every group of nr output columns (the width of the
+                GEMM micro-kernel) gets a row holding the kh source row
+                segments under it, kw + nr - 1 elements each, and the blocked
+                GEMM multiplies these rows by a banded matrix whose column b
+                is the kernel shifted by b. For one kernel im2col alone gives
+                a matrix-vector product; the band makes it a GEMM at
+                (kw + nr - 1) / kw times the multiply-adds
+
+    The row kernels keep four vector accumulators with the taps broadcast.
+    Method Auto picks Separable for kernels that factor and Direct otherwise:
+    with AVX-512 the direct rows run within a few tens of percent of the GEMM
+    rate at every kernel size, which the extra multiply-adds of the banded
+    matrix do not make up for. Gemm stays available to callers.
+
+    stencil() applies a kernel a number of times. Bands of rows advance up to
+    kStencilDepth steps between passes over the matrix (temporal blocking):
+    every band loads a halo of depth * radius rows, which shrinks by a radius
+    per step where it borders another band, and keeps the intermediate steps
+    in its own buffers, so the grid is read and written once per depth steps.
+    The border rule holds at every step.
+
+    Buffers are kept per thread and only grow, like the GEMM packing buffers,
+    so repeated runs into a caller supplied output do not allocate. The
+    output must have the shape of a and must not overlap a or the kernel.
+ */
+
+namespace cppmath {
+namespace matrix{
+
+/** Values read outside the matrix. Zero pads with zeros, Clamp repeats the
+    edge, Wrap is periodic and Reflect mirrors with the edge repeated:
+    c b a | a b c d | d c b.
+ */
+enum class Border {
+    Zero = 0,
+    Clamp,
+    Wrap,
+    Reflect
+};
+
+enum class ConvolutionMethod {
+    Auto = 0,
+    Direct,
+    /** Falls back to Direct when the kernel is not of rank one. */
+    Separable,
+    Gemm
+};
+
+namespace detail {
+
+template <typename T>
+struct ConvolutionKernels {
+    /** out[c] = (accumulate ? out[c] : 0) + sum of taps[j] * src[c + j] over
+        j < ntaps, for c < n
+     */
+    typedef void (*RowFilter)(const T* src, const T* taps, std::size_t ntaps, T* out, std::size_t n, bool accumulate);
+    /** out[c] = sum of taps[i] * src[i * stride + c] over i < ntaps, for c < n */
+    typedef void (*ColumnFilter)(const T* src, std::ptrdiff_t stride, const T* taps, std::size_t ntaps, T* out, std::size_t n);
+
+    RowFilter rowFilter = nullptr;
+    ColumnFilter columnFilter = nullptr;
+};
+
+template <typename T>
+void genericRowFilter(const T* src, const T* taps, std::size_t ntaps, T* out, std::size_t n, bool accumulate) {
+    for(std::size_t c = 0; c < n; ++c) {
+        T acc = accumulate ? out[c] : T(0);
+        for(std::size_t j = 0; j < ntaps; ++j) acc += taps[j] * src[c + j];
+        out[c] = acc;
+    }
+}
+
+template <typename T>
+void genericColumnFilter(const T* src, std::ptrdiff_t stride, const T* taps, std::size_t ntaps, T* out, std::size_t n) {
+    std::fill(out, out + n, T(0));
+    for(std::size_t i = 0; i < ntaps; ++i) {
+        const T tap = taps[i];
+        const T* row = src + static_cast<std::ptrdiff_t>(i) * stride;
+        for(std::size_t c = 0; c < n; ++c) out[c] += tap * row[c];
+    }
+}
+
+template <typename T>
+ConvolutionKernels<T> genericConvolutionKernels() {
+    ConvolutionKernels<T> k;
+    k.rowFilter = &genericRowFilter<T>;
+    k.columnFilter = &genericColumnFilter<T>;
+    return k;
+}
+
+/** Kernels for the given instruction set level. The generic template
+    serves every type, float and double are specialised with SIMD kernels.
+ */
+template <typename T>
+inline ConvolutionKernels<T> convolutionKernels(cpu::InstructionSet) {
+    return genericConvolutionKernels<T>();
+}
+
+template <> ConvolutionKernels<float> convolutionKernels<float>(cpu::InstructionSet isa);
+template <> ConvolutionKernels<double> convolutionKernels<double>(cpu::InstructionSet isa);
+
+/** Kernels for the running CPU, selected on the first use. */
+template <typename T>
+inline const ConvolutionKernels<T>& activeConvolutionKernels() {
+    static const ConvolutionKernels<T> kernels = convolutionKernels<T>(cpu::instructionSet());
+    return kernels;
+}
+
+/** Output columns of a tile and rows of a band. */
+constexpr std::size_t kConvolutionTileColumns = 512;
+constexpr std::size_t kConvolutionBandRows = 32;
+/** Rows of a GEMM band, every output row takes kh * (kw + nr - 1) im2col elements per nr columns. */
+constexpr std::size_t kConvolutionGemmBandRows = 16;
+/** Steps a stencil band advances between passes and its height. */
+constexpr std::size_t kStencilDepth = 8;
+constexpr std::size_t kStencilBandRows = 64;
+
+template <typename T>
+struct ConvolutionWorkspace {
+    GemmBuffer<T> taps;
+    GemmBuffer<T> tile;
+    GemmBuffer<T> image;
+};
+
+/** Per thread buffers, grown only, see gemmWorkspace(). */
+template <typename T>
+inline ConvolutionWorkspace<T>& convolutionWorkspace() {
+    static thread_local ConvolutionWorkspace<T> workspace;
+    return workspace;
+}
+
+/** Index read in place of i on an axis of n elements, -1 for a zero. */
+inline std::ptrdiff_t borderIndex(std::ptrdiff_t i, std::ptrdiff_t n, Border border) {
+    if(i >= 0 && i < n) return i;
+    switch(border) {
+        case Border::Zero: return -1;
+        case Border::Clamp: return i < 0 ? 0 : n - 1;
+        case Border::Wrap: {
+            i %= n;
+            return i < 0 ? i + n : i;
+        }
+        case Border::Reflect: {
+            const std::ptrdiff_t period = 2 * n;
+            i %= period;
+            if(i < 0) i += period;
+            return i < n ? i : period - 1 - i;
+        }
+    }
+    return -1;
+}
+
+/** dst[0, width) = row `row` of a from column `first` on, the border rule
+    applied outside a.
+ */
+template <typename T>
+void loadBorderRow(const ConstMatrixView<T>& a, std::ptrdiff_t row, std::ptrdiff_t first, std::size_t width,
+                   Border border, T* dst) {
+    const std::ptrdiff_t columns = static_cast<std::ptrdiff_t>(a.columns());
+    const std::ptrdiff_t r = borderIndex(row, static_cast<std::ptrdiff_t>(a.rows()), border);
+    if(r < 0) {
+        std::fill(dst, dst + width, T(0));
+        return;
+    }
+    const T* src = a.rowData(static_cast<std::size_t>(r));
+    const std::ptrdiff_t cs = a.columnStride();
+    const std::ptrdiff_t end = first + static_cast<std::ptrdiff_t>(width);
+    const std::ptrdiff_t lo = std::max<std::ptrdiff_t>(first, 0);
+    const std::ptrdiff_t hi = std::max(lo, std::min(end, columns));
+    for(std::ptrdiff_t c = first; c < std::min(lo, end); ++c) {
+        const std::ptrdiff_t k = borderIndex(c, columns, border);
+        dst[c - first] = k < 0 ? T(0) : src[k * cs];
+    }
+    if(cs == 1) {
+        std::copy(src + lo, src + hi, dst + (lo - first));
+    } else {
+        for(std::ptrdiff_t c = lo; c < hi; ++c) dst[c - first] = src[c * cs];
+    }
+    for(std::ptrdiff_t c = hi; c < end; ++c) {
+        const std::ptrdiff_t k = borderIndex(c, columns, border);
+        dst[c - first] = k < 0 ? T(0) : src[k * cs];
+    }
+}
+
+/** Fills the left and right halos of a padded row whose columns start at
+    row + left.
+ */
+template <typename T>
+void padRow(T* row, std::size_t left, std::size_t columns, std::size_t right, Border border) {
+    const std::ptrdiff_t n = static_cast<std::ptrdiff_t>(columns);
+    T* interior = row + left;
+    for(std::size_t j = 0; j < left; ++j) {
+        const std::ptrdiff_t k = borderIndex(static_cast<std::ptrdiff_t>(j) - static_cast<std::ptrdiff_t>(left), n, border);
+        row[j] = k < 0 ? T(0) : interior[k];
+    }
+    for(std::size_t j = 0; j < right; ++j) {
+        const std::ptrdiff_t k = borderIndex(n + static_cast<std::ptrdiff_t>(j), n, border);
+        interior[columns + j] = k < 0 ? T(0) : interior[k];
+    }
+}
+
+/** [first, last) spans the non-zero taps of a kernel row, empty for zeros. */
+template <typename T>
+inline void tapSpan(const T* taps, std::size_t n, std::size_t& first, std::size_t& last) {
+    first = 0;
+    while(first < n && taps[first] == T(0)) ++first;
+    last = n;
+    while(last > first && taps[last - 1] == T(0)) --last;
+}
+
+/** out[0, n) = the sum of the kernel rows with their taps times the rows of
+    src, row i of the kernel reading src + i * stride. Returns false when
+    every tap is zero and nothing was written.
+ */
+template <typename T>
+bool directRow(const ConvolutionKernels<T>& kernels, const T* taps, std::size_t kh, std::size_t kw,
+               const T* src, std::ptrdiff_t stride, T* out, std::size_t n) {
+    bool written = false;
+    for(std::size_t i = 0; i < kh; ++i) {
+        std::size_t first, last;
+        tapSpan(taps + i * kw, kw, first, last);
+        if(first == last) continue;
+        kernels.rowFilter(src + static_cast<std::ptrdiff_t>(i) * stride + first, taps + i * kw + first, last - first,
+                          out, n, written);
+        written = true;
+    }
+    return written;
+}
+
+/** Factors the row-major kh x kw kernel k as u * v^T when it is of rank one
+    within rounding, v scaled to one at the largest element of k.
+ */
+template <typename T>
+bool separateTaps(const T* k, std::size_t kh, std::size_t kw, T* u, T* v, std::true_type) {
+    std::size_t pivot = 0;
+    for(std::size_t i = 1; i < kh * kw; ++i)
+        if(std::abs(k[i]) > std::abs(k[pivot])) pivot = i;
+    const T largest = std::abs(k[pivot]);
+    const std::size_t p = pivot / kw;
+    const std::size_t q = pivot % kw;
+    if(largest == T(0)) {
+        std::fill(u, u + kh, T(0));
+        std::fill(v, v + kw, T(0));
+        return true;
+    }
+    for(std::size_t i = 0; i < kh; ++i) u[i] = k[i * kw + q];
+    for(std::size_t j = 0; j < kw; ++j) v[j] = k[p * kw + j] / k[pivot];
+    const T tolerance = T(64) * std::numeric_limits<T>::epsilon() * largest;
+    for(std::size_t i = 0; i < kh; ++i)
+        for(std::size_t j = 0; j < kw; ++j)
+            if(std::abs(k[i * kw + j] - u[i] * v[j]) > tolerance) return false;
+    return true;
+}
+
+template <typename T>
+inline bool separateTaps(const T*, std::size_t, std::size_t, T*, T*, std::false_type) { return false; }
+
+template <typename T>
+inline bool separateTaps(const T* k, std::size_t kh, std::size_t kw, T* u, T* v) {
+    return separateTaps(k, kh, kw, u, v, std::is_floating_point<T>());
+}
+
+/** out[0, n) = src[0, n) with the given column stride. */
+template <typename T>
+inline void storeRow(const T* src, T* out, std::ptrdiff_t stride, std::size_t n) {
+    if(stride == 1) {
+        std::copy(src, src + n, out);
+        return;
+    }
+    for(std::size_t c = 0; c < n; ++c) out[static_cast<std::ptrdiff_t>(c) * stride] = src[c];
+}
+
+/** Copies the kernel row-major into taps. */
+template <typename T>
+void loadTaps(const ConstMatrixView<T>& kernel, T* taps) {
+    for(std::size_t i = 0; i < kernel.rows(); ++i)
+        for(std::size_t j = 0; j < kernel.columns(); ++j) taps[i * kernel.columns() + j] = kernel[MatrixPoint{i, j}];
+}
+
+template <typename T>
+void correlateViews(const execution::ExecutionPolicy& policy, ConstMatrixView<T> a, ConstMatrixView<T> kernel,
+                    MatrixView<T> out, Border border, ConvolutionMethod method) {
+    assert(out.rows() == a.rows() && out.columns() == a.columns());
+    const std::size_t rows = a.rows();
+    const std::size_t columns = a.columns();
+    const std::size_t kh = kernel.rows();
+    const std::size_t kw = kernel.columns();
+    if(rows == 0 || columns == 0) return;
+    if(kh == 0 || kw == 0) {
+        out.fill(T(0));
+        return;
+    }
+
+    const GemmKernel<T>& gemmKernel = activeGemmKernel<T>();
+    const std::size_t block = gemmKernel.nr;
+    const std::size_t span = kw + block - 1;
+    GemmBufferLease<T> tapsLease(convolutionWorkspace<T>().taps);
+    T* taps = tapsLease.data(kh * kw + kh + kw);
+    T* u = taps + kh * kw;
+    T* v = u + kh;
+    loadTaps(kernel, taps);
+
+    const bool factors = (method == ConvolutionMethod::Auto || method == ConvolutionMethod::Separable) &&
+                         kh > 1 && kw > 1 && separateTaps(taps, kh, kw, u, v);
+    if(method == ConvolutionMethod::Auto) {
+        method = factors ? ConvolutionMethod::Separable : ConvolutionMethod::Direct;
+    } else if(method == ConvolutionMethod::Separable && !factors) {
+        method = ConvolutionMethod::Direct;
+    }
+
+    const bool gemm = method == ConvolutionMethod::Gemm;
+    T* banded = nullptr;
+    if(gemm) {
+        taps = tapsLease.data(kh * kw + kh * span * block);
+        banded = taps + kh * kw;
+        // banded(i * span + t, b) = kernel(i, t - b): column b correlates the window starting at b
+        std::fill(banded, banded + kh * span * block, T(0));
+        for(std::size_t i = 0; i < kh; ++i)
+            for(std::size_t b = 0; b < block; ++b)
+                for(std::size_t j = 0; j < kw; ++j) banded[(i * span + b + j) * block + b] = taps[i * kw + j];
+    }
+    const std::size_t tileColumns = std::min(columns, kConvolutionTileColumns);
+    const std::size_t tiles = (columns + tileColumns - 1) / tileColumns;
+    const std::size_t groups = (tileColumns + block - 1) / block;
+    const std::size_t bandRows = std::min(rows, gemm ? kConvolutionGemmBandRows : kConvolutionBandRows);
+    const std::size_t bands = (rows + bandRows - 1) / bandRows;
+    const std::ptrdiff_t top = static_cast<std::ptrdiff_t>(kh / 2);
+    const std::ptrdiff_t left = static_cast<std::ptrdiff_t>(kw / 2);
+    const std::size_t width = (gemm ? groups * block : tileColumns) + kw - 1;
+    const std::size_t height = bandRows + kh - 1;
+    const ConvolutionKernels<T>& kernels = activeConvolutionKernels<T>();
+
+    execution::parallelFor(policy, 0, bands * tiles, 1, [&](std::size_t first, std::size_t last){
+        GemmBufferLease<T> lease(convolutionWorkspace<T>().tile);
+        const std::size_t patches = gemm ? bandRows * groups : 0;
+        T* source = lease.data(height * width + width + tileColumns + patches * (kh * span + block));
+        T* line = source + height * width;
+        T* row = line + width;
+        T* columnsMatrix = row + tileColumns;
+        T* product = columnsMatrix + patches * kh * span;
+        for(std::size_t task = first; task < last; ++task) {
+            const std::size_t r0 = task / tiles * bandRows;
+            const std::size_t c0 = task % tiles * tileColumns;
+            const std::size_t bandHeight = std::min(bandRows, rows - r0);
+            const std::size_t n = std::min(tileColumns, columns - c0);
+            for(std::size_t i = 0; i < bandHeight + kh - 1; ++i) {
+                T* dst = source + i * width;
+                loadBorderRow(a, static_cast<std::ptrdiff_t>(r0 + i) - top, static_cast<std::ptrdiff_t>(c0) - left,
+                              n + kw - 1, border, dst);
+                std::fill(dst + n + kw - 1, dst + width, T(0));
+            }
+            if(gemm) {
+                // im2col: row (r, g) holds the kh source rows under output columns [g * block, g * block + block)
+                const std::size_t used = (n + block - 1) / block;
+                T* patch = columnsMatrix;
+                for(std::size_t r = 0; r < bandHeight; ++r) {
+                    for(std::size_t g = 0; g < used; ++g) {
+                        for(std::size_t i = 0; i < kh; ++i, patch += span) {
+                            const T* src = source + (r + i) * width + g * block;
+                            std::copy(src, src + span, patch);
+                        }
+                    }
+                }
+                detail::gemm(bandHeight * used, block, kh * span, T(1), columnsMatrix, static_cast<std::ptrdiff_t>(kh * span), 1,
+                             banded, static_cast<std::ptrdiff_t>(block), 1, T(0), product, static_cast<std::ptrdiff_t>(block), 1, gemmKernel);
+                for(std::size_t r = 0; r < bandHeight; ++r)
+                    storeRow(product + r * used * block, &out[MatrixPoint{r0 + r, c0}], out.columnStride(), n);
+                continue;
+            }
+            for(std::size_t r = 0; r < bandHeight; ++r) {
+                T* target = out.columnStride() == 1 ? &out[MatrixPoint{r0 + r, c0}] : row;
+                const T* src = source + r * width;
+                if(method == ConvolutionMethod::Separable) {
+                    kernels.columnFilter(src, static_cast<std::ptrdiff_t>(width), u, kh, line, n + kw - 1);
+                    kernels.rowFilter(line, v, kw, target, n, false);
+                } else if(!directRow(kernels, taps, kh, kw, src, static_cast<std::ptrdiff_t>(width), target, n)) {
+                    std::fill(target, target + n, T(0));
+                }
+                if(target == row) storeRow(row, &out[MatrixPoint{r0 + r, c0}], out.columnStride(), n);
+            }
+        }
+    });
+}
+
+/** Advances the rows of src by `steps` applications of the kernel into dst,
+    in bands of rows that each keep their own halo.
+ */
+template <typename T>
+void stencilPass(const execution::ExecutionPolicy& policy, const ConstMatrixView<T>& src, const MatrixView<T>& dst,
+                 const T* taps, std::size_t kh, std::size_t kw, std::size_t steps, Border border) {
+    const std::size_t rows = src.rows();
+    const std::size_t columns = src.columns();
+    const std::ptrdiff_t n = static_cast<std::ptrdiff_t>(rows);
+    const std::ptrdiff_t up = static_cast<std::ptrdiff_t>(kh / 2);
+    const std::ptrdiff_t down = static_cast<std::ptrdiff_t>(kh - 1 - kh / 2);
+    const std::size_t left = kw / 2;
+    const std::size_t right = kw - 1 - left;
+    const std::size_t width = columns + kw - 1;
+    // Bands at least a radius high keep the rows that a border maps to in the band
+    const std::size_t bandRows = std::max<std::size_t>(kStencilBandRows, kh);
+    const std::size_t bands = std::max<std::size_t>(1, rows / bandRows);
+    const ConvolutionKernels<T>& kernels = activeConvolutionKernels<T>();
+    const bool wrap = border == Border::Wrap;
+
+    execution::parallelFor(policy, 0, bands, 1, [&](std::size_t first, std::size_t last){
+        GemmBufferLease<T> lease(convolutionWorkspace<T>().tile);
+        const std::size_t largest = rows / bands + 1 + steps * (kh - 1);
+        T* buffers = lease.data(2 * largest * width + width);
+        T* zeros = buffers + 2 * largest * width;
+        std::fill(zeros, zeros + width, T(0));
+        for(std::size_t band = first; band < last; ++band) {
+            const std::ptrdiff_t b0 = static_cast<std::ptrdiff_t>(rows * band / bands);
+            const std::ptrdiff_t b1 = static_cast<std::ptrdiff_t>(rows * (band + 1) / bands);
+            std::ptrdiff_t lo = b0 - static_cast<std::ptrdiff_t>(steps) * up;
+            std::ptrdiff_t hi = b1 + static_cast<std::ptrdiff_t>(steps) * down;
+            if(!wrap) {
+                lo = std::max<std::ptrdiff_t>(lo, 0);
+                hi = std::min(hi, n);
+            }
+            T* current = buffers;
+            T* next = buffers + largest * width;
+            for(std::ptrdiff_t s = lo; s < hi; ++s)
+                loadBorderRow(src, s, -static_cast<std::ptrdiff_t>(left), width, border, current + (s - lo) * width);
+
+            // Rows [validLo, validHi) of current hold the present step
+            std::ptrdiff_t validLo = lo;
+            std::ptrdiff_t validHi = hi;
+            for(std::size_t step = 0; step < steps; ++step) {
+                const std::ptrdiff_t nextLo = wrap || lo > 0 ? validLo + up : validLo;
+                const std::ptrdiff_t nextHi = wrap || hi < n ? validHi - down : validHi;
+                for(std::ptrdiff_t r = nextLo; r < nextHi; ++r) {
+                    T* target = next + (r - lo) * width;
+                    bool written = false;
+                    for(std::size_t i = 0; i < kh; ++i) {
+                        std::size_t tapFirst, tapLast;
+                        tapSpan(taps + i * kw, kw, tapFirst, tapLast);
+                        if(tapFirst == tapLast) continue;
+                        std::ptrdiff_t s = r + static_cast<std::ptrdiff_t>(i) - up;
+                        const T* row = current + (s - lo) * width;
+                        if(s < validLo || s >= validHi) {
+                            s = borderIndex(s, n, border);
+                            assert(s < 0 || (s >= validLo && s < validHi));
+                            row = s < 0 ? zeros : current + (s - lo) * width;
+                        }
+                        kernels.rowFilter(row + tapFirst, taps + i * kw + tapFirst, tapLast - tapFirst,
+                                          target + left, columns, written);
+                        written = true;
+                    }
+                    if(!written) std::fill(target + left, target + left + columns, T(0));
+                    padRow(target, left, columns, right, border);
+                }
+                validLo = nextLo;
+                validHi = nextHi;
+                std::swap(current, next);
+            }
+            for(std::ptrdiff_t r = b0; r < b1; ++r)
+                storeRow(current + (r - lo) * width + left, dst.rowData(static_cast<std::size_t>(r)), dst.columnStride(), columns);
+        }
+    });
+}
+
+template <typename T>
+void stencilViews(const execution::ExecutionPolicy& policy, ConstMatrixView<T> a, ConstMatrixView<T> kernel,
+                  std::size_t iterations, MatrixView<T> out, Border border) {
+    assert(out.rows() == a.rows() && out.columns() == a.columns());
+    const std::size_t rows = a.rows();
+    const std::size_t columns = a.columns();
+    if(rows == 0 || columns == 0) return;
+    if(iterations == 0) {
+        out.assign(a);
+        return;
+    }
+    const std::size_t kh = kernel.rows();
+    const std::size_t kw = kernel.columns();
+    if(kh == 0 || kw == 0) {
+        out.fill(T(0));
+        return;
+    }
+
+    ConvolutionWorkspace<T>& workspace = convolutionWorkspace<T>();
+    GemmBufferLease<T> tapsLease(workspace.taps);
+    T* taps = tapsLease.data(kh * kw);
+    loadTaps(kernel, taps);
+
+    // Passes alternate between out and an intermediate grid so that the last one lands in out
+    const std::size_t passes = (iterations + kStencilDepth - 1) / kStencilDepth;
+    GemmBufferLease<T> imageLease(workspace.image);
+    const MatrixView<T> intermediate(passes > 1 ? imageLease.data(rows * columns) : nullptr, rows, columns,
+                                     static_cast<std::ptrdiff_t>(columns));
+    ConstMatrixView<T> src = a;
+    for(std::size_t pass = 0; pass < passes; ++pass) {
+        const MatrixView<T> dst = (passes - pass) % 2 == 1 ? out : intermediate;
+        const std::size_t steps = std::min(kStencilDepth, iterations - pass * kStencilDepth);
+        stencilPass(policy, src, dst, taps, kh, kw, steps, border);
+        src = dst;
+    }
+}
+
+template <class A, class K, class Out>
+using EnableIfConvolution = typename std::enable_if<IsMatrixLike<A>::value && IsMatrixLike<K>::value && IsMatrixLike<Out>::value>::type;
+
+} // namespace detail
+
+/** out = a correlated with kernel, see the module comment for the anchor. */
+template <class A, class K, class Out>
+detail::EnableIfConvolution<A, K, Out> correlate(const execution::ExecutionPolicy& policy, const A& a, const K& kernel, Out&& out,
+                                                 Border border = Border::Zero, ConvolutionMethod method = ConvolutionMethod::Auto) {
+    typedef typename MatrixValueType<Out>::type T;
+    const ConstMatrixView<T> vk = constView(kernel);
+    const instrumentation::ScopedOperation counted(instrumentation::Operation::Elementwise, 2.0 * constView(a).size() * vk.size());
+    detail::correlateViews(policy, constView(a), vk, mutableView(out), border, method);
+}
+
+/** out = a convolved with kernel: the correlation with kernel rotated by
+    half a turn.
+ */
+template <class A, class K, class Out>
+detail::EnableIfConvolution<A, K, Out> convolve(const execution::ExecutionPolicy& policy, const A& a, const K& kernel, Out&& out,
+                                                Border border = Border::Zero, ConvolutionMethod method = ConvolutionMethod::Auto) {
+    typedef typename MatrixValueType<Out>::type T;
+    const ConstMatrixView<T> vk = constView(kernel);
+    const ConstMatrixView<T> rotated(vk.size() == 0 ? vk.data() : &vk[MatrixPoint{vk.rows() - 1, vk.columns() - 1}],
+                                     vk.rows(), vk.columns(), -vk.rowStride(), -vk.columnStride());
+    correlate(policy, a, rotated, std::forward<Out>(out), border, method);
+}
+
+/** out = a correlated with kernel `iterations` times, the border rule
+    applied at every step. out is a copy of a for zero iterations.
+ */
+template <class A, class K, class Out>
+detail::EnableIfConvolution<A, K, Out> stencil(const execution::ExecutionPolicy& policy, const A& a, const K& kernel,
+                                               std::size_t iterations, Out&& out, Border border = Border::Zero) {
+    typedef typename MatrixValueType<Out>::type T;
+    const ConstMatrixView<T> vk = constView(kernel);
+    const instrumentation::ScopedOperation counted(instrumentation::Operation::Elementwise,
+                                                   2.0 * constView(a).size() * vk.size() * iterations);
+    detail::stencilViews(policy, constView(a), vk, iterations, mutableView(out), border);
+}
+
+/** Factors kernel as column * row when it is of rank one within rounding:
+    column is kh x 1 and row 1 x kw, either as a row or a column vector.
+    Floating point kernels only, returns false otherwise.
+ */
+template <class K, class U, class V>
+typename std::enable_if<IsMatrixLike<K>::value && IsMatrixLike<U>::value && IsMatrixLike<V>::value, bool>::type
+separateKernel(const K& kernel, U&& column, V&& row) {
+    typedef typename MatrixValueType<K>::type T;
+    const ConstMatrixView<T> vk = constView(kernel);
+    const MatrixView<T> vu = mutableView(column);
+    const MatrixView<T> vv = mutableView(row);
+    const std::size_t kh = vk.rows();
+    const std::size_t kw = vk.columns();
+    assert(vu.size() == kh && (vu.rows() == 1 || vu.columns() == 1));
+    assert(vv.size() == kw && (vv.rows() == 1 || vv.columns() == 1));
+    if(kh == 0 || kw == 0) return false;
+    detail::GemmBufferLease<T> lease(detail::convolutionWorkspace<T>().taps);
+    T* taps = lease.data(kh * kw + kh + kw);
+    detail::loadTaps(vk, taps);
+    if(!detail::separateTaps(taps, kh, kw, taps + kh * kw, taps + kh * kw + kh)) return false;
+    for(std::size_t i = 0; i < kh; ++i) vu[i] = taps[kh * kw + i];
+    for(std::size_t j = 0; j < kw; ++j) vv[j] = taps[kh * kw + kh + j];
+    return true;
+}
+
+/** The overloads without a policy split large grids between threads. */
+template <class A, class K, class Out>
+detail::EnableIfConvolution<A, K, Out> correlate(const A& a, const K& kernel, Out&& out,
+                                                 Border border = Border::Zero, ConvolutionMethod method = ConvolutionMethod::Auto) {
+    correlate(execution::par, a, kernel, std::forward<Out>(out), border, method);
+}
+
+template <class A, class K, class Out>
+detail::EnableIfConvolution<A, K, Out> convolve(const A& a, const K& kernel, Out&& out,
+                                                Border border = Border::Zero, ConvolutionMethod method = ConvolutionMethod::Auto) {
+    convolve(execution::par, a, kernel, std::forward<Out>(out), border, method);
+}
+
+template <class A, class K, class Out>
+detail::EnableIfConvolution<A, K, Out> stencil(const A& a, const K& kernel, std::size_t iterations, Out&& out,
+                                               Border border = Border::Zero) {
+    stencil(execution::par, a, kernel, iterations, std::forward<Out>(out), border);
+}
+
+} //namespace matrix
+} //namespace cppmath
+
+#endif /* cppmath_convolution_hpp */
@@ -0,0 +1,147 @@
+//
+//  cppmath_cpu.cpp
+//  CppMath
+//
+//  Created by Dmytro Krasnianskyi on 17.10.26.
+//  Copyright © 2026 Dmytro Krasnianskyi. All rights reserved.
+//
+
+#include "cppmath_cpu.hpp"
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#   include <intrin.h>
+#   include <immintrin.h>
+#elif CPPMATH_X86_DISPATCH
+#   include <cpuid.h>
+#endif
+
+#if defined(__unix__) || defined(__APPLE__)
+#   include <unistd.h>
+#endif
+
+namespace cppmath {
+namespace cpu {
+
+namespace {
+
+struct Registers {
+    unsigned eax = 0;
+    unsigned ebx = 0;
+    unsigned ecx = 0;
+    unsigned edx = 0;
+};
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+
+bool cpuid(unsigned leaf, unsigned subleaf, Registers& regs) {
+    int info[4] = {};
+    __cpuid(info, 0);
+    if(static_cast<unsigned>(info[0]) < leaf) return false;
+    __cpuidex(info, static_cast<int>(leaf), static_cast<int>(subleaf));
+    regs.eax = info[0]; regs.ebx = info[1]; regs.ecx = info[2]; regs.edx = info[3];
+    return true;
+}
+
+unsigned long long xgetbv0() {
+    return _xgetbv(0);
+}
+
+#elif CPPMATH_X86_DISPATCH
+
+bool cpuid(unsigned leaf, unsigned subleaf, Registers& regs) {
+    if(__get_cpuid_max(0, nullptr) < leaf) return false;
+    __cpuid_count(leaf, subleaf, regs.eax, regs.ebx, regs.ecx, regs.edx);
+    return true;
+}
+
+unsigned long long xgetbv0() {
+    unsigned eax = 0, edx = 0;
+    __asm__ volatile("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+    return (static_cast<unsigned long long>(edx) << 32) | eax;
+}
+
+#else
+
+bool cpuid(unsigned, unsigned, Registers&) { return false; }
+unsigned long long xgetbv0() { return 0; }
+
+#endif
+
+inline bool bit(unsigned reg, unsigned index) { return (reg >> index) & 1u; }
+
+Features detectFeatures() {
+    Features f;
+    Registers r1;
+    if(!cpuid(1, 0, r1)) return f;
+
+    f.sse2 = bit(r1.edx, 26);
+    f.popcnt = bit(r1.ecx, 23);
+
+    // The OS must save the extended register state, otherwise AVX is unusable.
+    const bool osxsave = bit(r1.ecx, 27);
+    const unsigned long long xcr0 = osxsave ? xgetbv0() : 0;
+    const bool ymmState = (xcr0 & 0x6) == 0x6;
+    const bool zmmState = ymmState && (xcr0 & 0xE0) == 0xE0;
+
+    f.avx = ymmState && bit(r1.ecx, 28);
+    f.fma = f.avx && bit(r1.ecx, 12);
+
+    Registers r7;
+    if(cpuid(7, 0, r7)) {
+        f.avx2 = f.avx && bit(r7.ebx, 5);
+        f.avx512f = zmmState && bit(r7.ebx, 16);
+        f.avx512dq = f.avx512f && bit(r7.ebx, 17);
+        f.avx512bw = f.avx512f && bit(r7.ebx, 30);
+        f.avx512vl = f.avx512f && bit(r7.ebx, 31);
+        f.avx512vnni = f.avx512f && bit(r7.ecx, 11);
+        f.avx512vpopcntdq = f.avx512f && bit(r7.ecx, 14);
+
+        Registers r71;
+        if(cpuid(7, 1, r71)) {
+            f.avxvnni = f.avx2 && bit(r71.eax, 4);
+        }
+    }
+    return f;
+}
+
+InstructionSet detectInstructionSet() {
+    const Features& f = features();
+    if(f.avx512f && f.avx512bw && f.avx512dq && f.avx512vl && f.fma) return InstructionSet::AVX512;
+    if(f.avx2 && f.fma) return InstructionSet::AVX2;
+    if(f.sse2) return InstructionSet::SSE2;
+    return InstructionSet::Generic;
+}
+
+CacheSizes detectCacheSizes() {
+    CacheSizes sizes;
+#if defined(_SC_LEVEL1_DCACHE_SIZE) && defined(_SC_LEVEL2_CACHE_SIZE) && defined(_SC_LEVEL3_CACHE_SIZE)
+    const long l1 = sysconf(_SC_LEVEL1_DCACHE_SIZE);
+    const long l2 = sysconf(_SC_LEVEL2_CACHE_SIZE);
+    const long l3 = sysconf(_SC_LEVEL3_CACHE_SIZE);
+    if(l1 > 0) sizes.l1 = static_cast<std::size_t>(l1);
+    if(l2 > 0) sizes.l2 = static_cast<std::size_t>(l2);
+    if(l3 > 0) sizes.l3 = static_cast<std::size_t>(l3);
+    if(sizes.l3 < sizes.l2) sizes.l3 = sizes.l2;
+#endif
+    return sizes;
+}
+
+} // namespace
+
+const Features& features() noexcept {
+    static const Features detected = detectFeatures();
+    return detected;
+}
+
+InstructionSet instructionSet() noexcept {
+    static const InstructionSet detected = detectInstructionSet();
+    return detected;
+}
+
+const CacheSizes& cacheSizes() noexcept {
+    static const CacheSizes detected = detectCacheSizes();
+    return detected;
+}
+
+} // namespace cpu
+} // namespace cppmath
@@ -0,0 +1,74 @@
+//
+//  cppmath_cpu.hpp
+//  CppMath
+//
+//  Created by Dmytro Krasnianskyi on 17.10.26.
+//  Copyright © 2026 Dmytro Krasnianskyi. All rights reserved.
+//
+
+#ifndef cppmath_cpu_hpp
+#define cppmath_cpu_hpp
+
+#include <cstddef>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#   define CPPMATH_X86_DISPATCH 1
+#   define CPPMATH_TARGET(isa) __attribute__((target(isa)))
+#else
+#   define CPPMATH_X86_DISPATCH 0
+#   define CPPMATH_TARGET(isa)
+#endif
+
+namespace cppmath {
+namespace cpu {
+
+/** Instruction set levels used by the runtime kernel dispatch.
+    Levels are ordered, every level implies all the previous ones.
+ */
+enum class InstructionSet: int {
+    Generic = 0,
+    SSE2,
+    AVX2,       // AVX2 + FMA
+    AVX512      // AVX-512 F/BW/DQ/VL
+};
+
+struct Features {
+    bool sse2 = false;
+    bool avx = false;
+    bool avx2 = false;
+    bool fma = false;
+    bool avx512f = false;
+    bool avx512bw = false;
+    bool avx512dq = false;
+    bool avx512vl = false;
+    bool avx512vnni = false;
+    bool avxvnni = false;
+    bool popcnt = false;
+    bool avx512vpopcntdq = false;
+};
+
+struct CacheSizes {
+    std::size_t l1 = 32 * 1024;
+    std::size_t l2 = 256 * 1024;
+    std::size_t l3 = 8 * 1024 * 1024;
+};
+
+/** CPU features detected once on the first call. */
+const Features& features() noexcept;
+
+/** The best instruction set level supported by both the CPU and the OS. */
+InstructionSet instructionSet() noexcept;
+
+/** Data cache sizes per core (L3 is the whole shared cache), with sane
+    defaults when the platform does not report them.
+ */
+const CacheSizes& cacheSizes() noexcept;
+
+inline bool supports(InstructionSet isa) noexcept {
+    return static_cast<int>(isa) <= static_cast<int>(instructionSet());
+}
+
+} // namespace cpu
+} // namespace cppmath
+
+#endif /* cppmath_cpu_hpp */
@@ -0,0 +1,197 @@
+//
+//  cppmath_csv.cpp
+//  CppMath
+//
+//  Created by Dmytro Krasnianskyi on 17.10.26.
+//  Copyright © 2026 Dmytro Krasnianskyi. All rights reserved.
+//
+
+#include "cppmath_csv.hpp"
+
+#include <cctype>
+#include <cerrno>
+#include <cmath>
+#include <cstdlib>
+
+namespace cppmath {
+namespace io {
+namespace detail {
+
+namespace {
+
+/** A decimal number split into its parts, before the conversion. */
+struct Decimal {
+    std::uint64_t mantissa = 0;
+    int exponent = 0;
+    bool negative = false;
+    /** Digits beyond the 19 kept in the mantissa were dropped. */
+    bool truncated = false;
+};
+
+inline bool isDigit(char c) { return c >= '0' && c <= '9'; }
+
+/** Scans [sign] digits [. digits] [e [sign] digits]. Returns the end, or
+    nullptr when there are no mantissa digits or the exponent is empty.
+ */
+const char* scanDecimal(const char* p, const char* end, Decimal& d) {
+    if(p != end && (*p == '+' || *p == '-')) d.negative = *p++ == '-';
+    int kept = 0;
+    bool any = false;
+    for(; p != end && isDigit(*p); ++p) {
+        any = true;
+        if(kept < 19) {
+            d.mantissa = d.mantissa * 10 + static_cast<unsigned>(*p - '0');
+            if(d.mantissa != 0) ++kept;
+        } else {
+            ++d.exponent;
+            d.truncated |= *p != '0';
+        }
+    }
+    if(p != end && *p == '.') {
+        for(++p; p != end && isDigit(*p); ++p) {
+            any = true;
+            if(kept < 19) {
+                d.mantissa = d.mantissa * 10 + static_cast<unsigned>(*p - '0');
+                --d.exponent;
+                if(d.mantissa != 0) ++kept;
+            } else {
+                d.truncated |= *p != '0';
+            }
+        }
+    }
+    if(!any) return nullptr;
+    if(p != end && (*p == 'e' || *p == 'E')) {
+        ++p;
+        bool negative = false;
+        if(p != end && (*p == '+' || *p == '-')) negative = *p++ == '-';
+        if(p == end || !isDigit(*p)) return nullptr;
+        int exponent = 0;
+        for(; p != end && isDigit(*p); ++p) {
+            if(exponent < 100000) exponent = exponent * 10 + (*p - '0');
+        }
+        d.exponent += negative ? -exponent : exponent;
+    }
+    return p;
+}
+
+/** strtod/strtof on a NUL terminated copy, for the slow cases and for
+    inf and nan. Returns nullptr unless the whole token converts, and for
+    finite literals that overflow T.
+ */
+template <typename T, class Convert>
+const char* convertSlow(const char* begin, const char* end, T& value, Convert convert) {
+    const char* tokenEnd = begin;
+    while(tokenEnd != end && (isDigit(*tokenEnd) || std::isalpha(static_cast<unsigned char>(*tokenEnd)) ||
+                              *tokenEnd == '.' || *tokenEnd == '+' || *tokenEnd == '-')) {
+        ++tokenEnd;
+    }
+    const std::size_t length = static_cast<std::size_t>(tokenEnd - begin);
+    if(length == 0) return nullptr;
+    char small[64];
+    std::string large;
+    char* text = small;
+    if(length < sizeof(small)) {
+        std::memcpy(small, begin, length);
+        small[length] = '\0';
+    } else {
+        large.assign(begin, tokenEnd);
+        text = &large[0];
+    }
+    char* stop = nullptr;
+    errno = 0;
+    const T result = convert(text, &stop);
+    if(stop == text) return nullptr;
+    if(errno == ERANGE && std::isinf(result)) return nullptr;
+    value = result;
+    return begin + (stop - text);
+}
+
+const double kPowersOf10[] = {
+    1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+
+const float kPowersOf10f[] = {1e0f, 1e1f, 1e2f, 1e3f, 1e4f, 1e5f, 1e6f, 1e7f, 1e8f, 1e9f, 1e10f};
+
+} // namespace
+
+/** Clinger's fast path: a mantissa and a power of ten that are both exact
+    in the target type give a correctly rounded result with one operation.
+ */
+const char* parseValue(const char* begin, const char* end, double& value) {
+    Decimal d;
+    const char* p = scanDecimal(begin, end, d);
+    if(p && !d.truncated && d.mantissa <= (std::uint64_t(1) << 53) && d.exponent >= -22 && d.exponent <= 22) {
+        const double m = static_cast<double>(d.mantissa);
+        const double result = d.exponent < 0 ? m / kPowersOf10[-d.exponent] : m * kPowersOf10[d.exponent];
+        value = d.negative ? -result : result;
+        return p;
+    }
+    return convertSlow(begin, end, value, [](const char* text, char** stop){ return std::strtod(text, stop); });
+}
+
+const char* parseValue(const char* begin, const char* end, float& value) {
+    Decimal d;
+    const char* p = scanDecimal(begin, end, d);
+    if(p && !d.truncated && d.mantissa <= (std::uint64_t(1) << 24) && d.exponent >= -10 && d.exponent <= 10) {
+        const float m = static_cast<float>(d.mantissa);
+        const float result = d.exponent < 0 ? m / kPowersOf10f[-d.exponent] : m * kPowersOf10f[d.exponent];
+        value = d.negative ? -result : result;
+        return p;
+    }
+    return convertSlow(begin, end, value, [](const char* text, char** stop){ return std::strtof(text, stop); });
+}
+
+InputFile::InputFile(const std::string& path):
+    m_path(path)
+{
+    errno = 0;
+    m_file = std::fopen(path.c_str(), "rb");
+    if(!m_file) throw FileError("csv: cannot open " + path + (errno != 0 ? ": " + std::string(std::strerror(errno)) : std::string()));
+}
+
+InputFile::~InputFile() {
+    if(m_file) std::fclose(m_file);
+}
+
+std::size_t InputFile::read(char* buffer, std::size_t size) {
+    const std::size_t got = std::fread(buffer, 1, size, m_file);
+    if(got < size && std::ferror(m_file)) throw FileError("csv: cannot read " + m_path);
+    return got;
+}
+
+void InputFile::seek(std::uint64_t offset) {
+    if(std::fseek(m_file, static_cast<long>(offset), SEEK_SET) != 0) throw FileError("csv: cannot seek in " + m_path);
+}
+
+std::uint64_t InputFile::size() {
+    if(std::fseek(m_file, 0, SEEK_END) != 0) throw FileError("csv: cannot seek in " + m_path);
+    const long size = std::ftell(m_file);
+    if(size < 0) throw FileError("csv: cannot tell the size of " + m_path);
+    seek(0);
+    return static_cast<std::uint64_t>(size);
+}
+
+std::uint64_t nextLineStart(InputFile& file, std::uint64_t offset, std::uint64_t size) {
+    char buffer[4096];
+    file.seek(offset);
+    while(offset < size) {
+        const std::size_t got = file.read(buffer, sizeof(buffer));
+        if(got == 0) break;
+        const void* newline = std::memchr(buffer, '\n', got);
+        if(newline) return offset + static_cast<std::uint64_t>(static_cast<const char*>(newline) - buffer) + 1;
+        offset += got;
+    }
+    return size;
+}
+
+std::uint64_t dataStart(InputFile& file, const CsvOptions& options, std::uint64_t size) {
+    std::uint64_t offset = 0;
+    const std::size_t lines = options.skipLines + (options.hasHeader ? 1 : 0);
+    for(std::size_t i = 0; i < lines; ++i) offset = nextLineStart(file, offset, size);
+    return offset;
+}
+
+} // namespace detail
+} //namespace io
+} //namespace cppmath
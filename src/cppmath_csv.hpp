@@ -0,0 +1,358 @@
+//
+//  cppmath_csv.hpp
+//  CppMath
+//
+//  Created by Dmytro Krasnianskyi on 17.10.26.
+//  Copyright © 2026 Dmytro Krasnianskyi. All rights reserved.
+//
+
+#ifndef cppmath_csv_hpp
+#define cppmath_csv_hpp
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <memory>
+#include <limits>
+#include <algorithm>
+#include <stdexcept>
+#include <type_traits>
+
+#include "cppmath_matrix.hpp"
+#include "cppmath_matrix_file.hpp"
+#include "cppmath_parallel.hpp"
+
+/** Delimited text into Matrix<T>.
+
+    CsvParser takes the text in chunks of any size and appends every
+    complete line as a matrix row, so memory stays at one chunk plus the
+    longest line. Numbers are parsed in place: decimal mantissas of up to 19
+    digits with small exponents are converted exactly with one multiply or
+    divide, everything else falls back to strtod. readCsv() streams a file
+    through the parser, the parallel overload splits the file on line
+    boundaries and parses the parts on the thread pool.
+ */
+
+namespace cppmath {
+namespace io {
+
+class ParseError: public std::runtime_error {
+public:
+    ParseError(const std::string& what, std::size_t line):
+        std::runtime_error("csv: " + what + " at line " + std::to_string(line)),
+        m_line(line)
+    {}
+
+    /** One-based line of the error, counted from the start of the parsed
+        text. The parallel reader counts from the start of its part.
+     */
+    inline std::size_t line() const noexcept { return m_line; }
+
+private:
+    std::size_t m_line;
+};
+
+struct CsvOptions {
+    char delimiter = ',';
+    /** Lines dropped before the header or the data. */
+    std::size_t skipLines = 0;
+    /** The first line after skipLines names the columns. */
+    bool hasHeader = false;
+    /** Bytes read from a file at a time. */
+    std::size_t chunkSize = std::size_t(1) << 20;
+};
+
+namespace detail {
+
+/** Parses one number from [begin, end) and returns the end of it, or
+    nullptr when no number starts at begin or it does not fit T. A finite
+    literal beyond the range of a floating T, such as 1e39 for float, does
+    not fit; inf and nan are accepted and underflow rounds toward zero.
+ */
+const char* parseValue(const char* begin, const char* end, double& value);
+const char* parseValue(const char* begin, const char* end, float& value);
+
+template <typename T>
+typename std::enable_if<std::is_integral<T>::value, const char*>::type
+parseValue(const char* begin, const char* end, T& value) {
+    const char* p = begin;
+    bool negative = false;
+    if(p != end && (*p == '+' || *p == '-')) negative = *p++ == '-';
+    if(negative && std::is_unsigned<T>::value) return nullptr;
+
+    typedef typename std::make_unsigned<T>::type U;
+    const U limit = negative ? U(U(std::numeric_limits<T>::max()) + 1u) : U(std::numeric_limits<T>::max());
+    U result = 0;
+    const char* digits = p;
+    for(; p != end && *p >= '0' && *p <= '9'; ++p) {
+        const U d = static_cast<U>(*p - '0');
+        if(result > (limit - d) / 10u) return nullptr;
+        result = static_cast<U>(result * 10u + d);
+    }
+    if(p == digits) return nullptr;
+    value = negative ? static_cast<T>(U(0) - result) : static_cast<T>(result);
+    return p;
+}
+
+inline bool isBlank(char c) { return c == ' ' || c == '\t' || c == '\r'; }
+
+} // namespace detail
+
+/** Appends the rows of delimited text to a matrix. The first data row sets
+    the column count, later rows must match it.
+ */
+template <typename T, class Allocator = memory::DefaultAllocator<T>>
+class CsvParser {
+public:
+    typedef T           value_type;
+
+    /** Parses into out, which is emptied first and keeps its storage. */
+    explicit CsvParser(matrix::Matrix<T, Allocator>& out, const CsvOptions& options = CsvOptions()):
+        m_out(out),
+        m_options(options)
+    {
+        m_out.reset();
+    }
+
+    /** Parses the complete lines of the chunk and keeps the unfinished one. */
+    void feed(const char* data, std::size_t size) {
+        const char* end = data + size;
+        const char* p = data;
+        if(!m_carry.empty()) {
+            const char* newline = static_cast<const char*>(std::memchr(p, '\n', size));
+            if(!newline) {
+                m_carry.append(p, end);
+                return;
+            }
+            m_carry.append(p, newline);
+            parseLine(m_carry.data(), m_carry.data() + m_carry.size());
+            m_carry.clear();
+            p = newline + 1;
+        }
+        while(p != end) {
+            const char* newline = static_cast<const char*>(std::memchr(p, '\n', static_cast<std::size_t>(end - p)));
+            if(!newline) {
+                m_carry.assign(p, end);
+                return;
+            }
+            parseLine(p, newline);
+            p = newline + 1;
+        }
+    }
+
+    /** Parses a last line without a line break. */
+    void finish() {
+        if(m_carry.empty()) return;
+        parseLine(m_carry.data(), m_carry.data() + m_carry.size());
+        m_carry.clear();
+    }
+
+    /** Column names when CsvOptions::hasHeader is set. */
+    inline const std::vector<std::string>& header() const noexcept { return m_header; }
+
+    /** Lines seen so far, including skipped and header lines. */
+    inline std::size_t lines() const noexcept { return m_line; }
+
+private:
+    void parseLine(const char* begin, const char* end) {
+        ++m_line;
+        if(m_line <= m_options.skipLines) return;
+        if(m_options.hasHeader && m_line == m_options.skipLines + 1) {
+            parseHeader(begin, end);
+            return;
+        }
+        while(begin != end && detail::isBlank(*begin)) ++begin;
+        while(end != begin && detail::isBlank(end[-1])) --end;
+        if(begin == end) return;
+
+        m_row.clear();
+        const char* p = begin;
+        for(;;) {
+            while(p != end && detail::isBlank(*p)) ++p;
+            T value;
+            const char* next = detail::parseValue(p, end, value);
+            if(!next) throw ParseError("invalid number", m_line);
+            m_row.push_back(value);
+            p = next;
+            while(p != end && detail::isBlank(*p)) ++p;
+            if(p == end) break;
+            if(*p != m_options.delimiter) throw ParseError("unexpected character", m_line);
+            ++p;
+        }
+
+        const std::size_t columns = m_out.rows() == 0 ? m_row.size() : m_out.columns();
+        if(m_row.size() != columns) throw ParseError("row has " + std::to_string(m_row.size()) + " fields, expected " +
+                                                     std::to_string(columns), m_line);
+        const std::size_t rows = m_out.rows();
+        m_out.resize(rows + 1, columns);
+        std::copy(m_row.begin(), m_row.end(), m_out.data() + rows * columns);
+    }
+
+    void parseHeader(const char* begin, const char* end) {
+        while(true) {
+            const char* field = std::find(begin, end, m_options.delimiter);
+            const char* first = begin;
+            const char* last = field;
+            while(first != last && detail::isBlank(*first)) ++first;
+            while(last != first && detail::isBlank(last[-1])) --last;
+            m_header.emplace_back(first, last);
+            if(field == end) break;
+            begin = field + 1;
+        }
+    }
+
+    matrix::Matrix<T, Allocator>& m_out;
+    CsvOptions m_options;
+    std::string m_carry;
+    std::vector<T> m_row;
+    std::vector<std::string> m_header;
+    std::size_t m_line = 0;
+};
+
+namespace detail {
+
+/** Owns a std::FILE opened for binary reading. */
+class InputFile {
+public:
+    explicit InputFile(const std::string& path);
+    ~InputFile();
+
+    InputFile(const InputFile&) = delete;
+    InputFile& operator = (const InputFile&) = delete;
+
+    std::size_t read(char* buffer, std::size_t size);
+    void seek(std::uint64_t offset);
+    std::uint64_t size();
+
+private:
+    std::FILE* m_file = nullptr;
+    std::string m_path;
+};
+
+/** Feeds bytes [begin, end) of a file to a parser in chunks. */
+template <class Parser>
+void feedFile(InputFile& file, Parser& parser, std::uint64_t begin, std::uint64_t end, std::size_t chunkSize) {
+    std::vector<char> buffer(std::max<std::size_t>(chunkSize, 1));
+    file.seek(begin);
+    while(begin < end) {
+        const std::size_t want = static_cast<std::size_t>(std::min<std::uint64_t>(buffer.size(), end - begin));
+        const std::size_t got = file.read(buffer.data(), want);
+        if(got == 0) break;
+        parser.feed(buffer.data(), got);
+        begin += got;
+    }
+    parser.finish();
+}
+
+/** Offset just past the first line break at or after offset, or the file
+    size when there is none.
+ */
+std::uint64_t nextLineStart(InputFile& file, std::uint64_t offset, std::uint64_t size);
+
+/** Offset of the first data line after the skipped and header lines. */
+std::uint64_t dataStart(InputFile& file, const CsvOptions& options, std::uint64_t size);
+
+} // namespace detail
+
+/** Parses a delimited string into out. */
+template <typename T, class Allocator>
+void parseCsv(const char* data, std::size_t size, matrix::Matrix<T, Allocator>& out, const CsvOptions& options = CsvOptions()) {
+    CsvParser<T, Allocator> parser(out, options);
+    parser.feed(data, size);
+    parser.finish();
+}
+
+template <typename T>
+matrix::Matrix<T> parseCsv(const std::string& text, const CsvOptions& options = CsvOptions()) {
+    matrix::Matrix<T> out;
+    parseCsv(text.data(), text.size(), out, options);
+    return out;
+}
+
+/** Streams a delimited file into out, reading options.chunkSize bytes at a
+    time. Throws FileError when the file cannot be read and ParseError on
+    malformed text.
+ */
+template <typename T, class Allocator>
+void readCsv(const std::string& path, matrix::Matrix<T, Allocator>& out, const CsvOptions& options = CsvOptions()) {
+    detail::InputFile file(path);
+    CsvParser<T, Allocator> parser(out, options);
+    detail::feedFile(file, parser, 0, file.size(), options.chunkSize);
+}
+
+/** readCsv that splits the data lines of large files into parts on line
+    boundaries, parses the parts on the pool and joins them into out.
+ */
+template <typename T, class Allocator>
+void readCsv(const execution::ExecutionPolicy& policy, const std::string& path, matrix::Matrix<T, Allocator>& out,
+             const CsvOptions& options = CsvOptions()) {
+    detail::InputFile file(path);
+    const std::uint64_t size = file.size();
+    const std::size_t chunk = std::max<std::size_t>(options.chunkSize, 1);
+    const std::size_t maxParts = 4 * execution::threadCount();
+    const std::uint64_t start = policy.isParallel() ? detail::dataStart(file, options, size) : 0;
+    const std::size_t parts = policy.isParallel() ?
+        static_cast<std::size_t>(std::min<std::uint64_t>(maxParts, (size - start) / chunk + 1)) : 1;
+    if(parts <= 1) {
+        CsvParser<T, Allocator> parser(out, options);
+        detail::feedFile(file, parser, 0, size, chunk);
+        return;
+    }
+
+    std::vector<std::uint64_t> bounds(parts + 1, size);
+    bounds[0] = start;
+    for(std::size_t i = 1; i < parts; ++i) {
+        bounds[i] = std::max(bounds[i - 1], detail::nextLineStart(file, start + (size - start) * i / parts, size));
+    }
+
+    CsvOptions partOptions = options;
+    partOptions.skipLines = 0;
+    partOptions.hasHeader = false;
+    std::vector<matrix::Matrix<T>> results(parts);
+    execution::parallelFor(policy, 0, parts, 1, [&](std::size_t first, std::size_t last){
+        detail::InputFile partFile(path);
+        for(std::size_t i = first; i < last; ++i) {
+            CsvParser<T> parser(results[i], partOptions);
+            detail::feedFile(partFile, parser, bounds[i], bounds[i + 1], chunk);
+        }
+    });
+
+    std::size_t rows = 0;
+    std::size_t columns = 0;
+    for(const matrix::Matrix<T>& part : results) {
+        if(part.rows() == 0) continue;
+        if(rows != 0 && part.columns() != columns) throw ParseError("parts disagree on the column count", 1);
+        columns = part.columns();
+        rows += part.rows();
+    }
+    out.reset();
+    out.resize(rows, columns);
+    std::size_t offset = 0;
+    for(const matrix::Matrix<T>& part : results) {
+        std::copy(part.data(), part.data() + part.size(), out.data() + offset);
+        offset += part.size();
+    }
+}
+
+template <typename T>
+matrix::Matrix<T> readCsv(const std::string& path, const CsvOptions& options = CsvOptions()) {
+    matrix::Matrix<T> out;
+    readCsv(path, out, options);
+    return out;
+}
+
+template <typename T>
+matrix::Matrix<T> readCsv(const execution::ExecutionPolicy& policy, const std::string& path,
+                          const CsvOptions& options = CsvOptions()) {
+    matrix::Matrix<T> out;
+    readCsv(policy, path, out, options);
+    return out;
+}
+
+} //namespace io
+} //namespace cppmath
+
+#endif /* cppmath_csv_hpp */
@@ -0,0 +1,156 @@
+//
+//  cppmath_elementwise.cpp
+//  CppMath
+//
+//  Created by Dmytro Krasnianskyi on 17.10.26.
+//  Copyright © 2026 Dmytro Krasnianskyi. All rights reserved.
+//
+
+#include "cppmath_elementwise.hpp"
+#include "cppmath_simd.hpp"
+
+namespace cppmath{
+namespace matrix{
+namespace detail {
+
+namespace {
+
+#if CPPMATH_X86_DISPATCH
+
+using namespace simd;
+
+/** The same kernel set is stamped out for every level, only the target
+    attribute differs. Main loops are unrolled by two vectors, tails are
+    finished with the scalar code.
+ */
+#define CPPMATH_ELEMENTWISE_KERNELS(PREFIX, TARGET)                                     \
+template <class V, typename T>                                                          \
+TARGET void PREFIX##Add(const T* a, const T* b, T* out, std::size_t n) {                \
+    const std::size_t w = V::width;                                                     \
+    std::size_t i = 0;                                                                  \
+    for(; i + 2 * w <= n; i += 2 * w) {                                                 \
+        V::store(out + i, V::add(V::load(a + i), V::load(b + i)));                      \
+        V::store(out + i + w, V::add(V::load(a + i + w), V::load(b + i + w)));          \
+    }                                                                                   \
+    for(; i + w <= n; i += w) V::store(out + i, V::add(V::load(a + i), V::load(b + i))); \
+    for(; i < n; ++i) out[i] = a[i] + b[i];                                             \
+}                                                                                       \
+template <class V, typename T>                                                          \
+TARGET void PREFIX##Subtract(const T* a, const T* b, T* out, std::size_t n) {           \
+    const std::size_t w = V::width;                                                     \
+    std::size_t i = 0;                                                                  \
+    for(; i + 2 * w <= n; i += 2 * w) {                                                 \
+        V::store(out + i, V::sub(V::load(a + i), V::load(b + i)));                      \
+        V::store(out + i + w, V::sub(V::load(a + i + w), V::load(b + i + w)));          \
+    }                                                                                   \
+    for(; i + w <= n; i += w) V::store(out + i, V::sub(V::load(a + i), V::load(b + i))); \
+    for(; i < n; ++i) out[i] = a[i] - b[i];                                             \
+}                                                                                       \
+template <class V, typename T>                                                          \
+TARGET void PREFIX##Multiply(const T* a, const T* b, T* out, std::size_t n) {           \
+    const std::size_t w = V::width;                                                     \
+    std::size_t i = 0;                                                                  \
+    for(; i + 2 * w <= n; i += 2 * w) {                                                 \
+        V::store(out + i, V::mul(V::load(a + i), V::load(b + i)));                      \
+        V::store(out + i + w, V::mul(V::load(a + i + w), V::load(b + i + w)));          \
+    }                                                                                   \
+    for(; i + w <= n; i += w) V::store(out + i, V::mul(V::load(a + i), V::load(b + i))); \
+    for(; i < n; ++i) out[i] = a[i] * b[i];                                             \
+}                                                                                       \
+template <class V, typename T>                                                          \
+TARGET void PREFIX##Scale(const T* a, T alpha, T* out, std::size_t n) {                 \
+    const std::size_t w = V::width;                                                     \
+    const typename V::Vec va = V::set1(alpha);                                          \
+    std::size_t i = 0;                                                                  \
+    for(; i + 2 * w <= n; i += 2 * w) {                                                 \
+        V::store(out + i, V::mul(va, V::load(a + i)));                                  \
+        V::store(out + i + w, V::mul(va, V::load(a + i + w)));                          \
+    }                                                                                   \
+    for(; i + w <= n; i += w) V::store(out + i, V::mul(va, V::load(a + i)));            \
+    for(; i < n; ++i) out[i] = alpha * a[i];                                            \
+}                                                                                       \
+template <class V, typename T>                                                          \
+TARGET void PREFIX##Axpy(T alpha, const T* x, T* y, std::size_t n) {                    \
+    const std::size_t w = V::width;                                                     \
+    const typename V::Vec va = V::set1(alpha);                                          \
+    std::size_t i = 0;                                                                  \
+    for(; i + 2 * w <= n; i += 2 * w) {                                                 \
+        V::store(y + i, V::fma(va, V::load(x + i), V::load(y + i)));                    \
+        V::store(y + i + w, V::fma(va, V::load(x + i + w), V::load(y + i + w)));        \
+    }                                                                                   \
+    for(; i + w <= n; i += w) V::store(y + i, V::fma(va, V::load(x + i), V::load(y + i))); \
+    for(; i < n; ++i) y[i] += alpha * x[i];                                             \
+}                                                                                       \
+template <class V, CompareOp Op, typename T>                                            \
+TARGET void PREFIX##CompareOp(const T* a, const T* b, unsigned char* mask, std::size_t n) { \
+    const std::size_t w = V::width;                                                     \
+    std::size_t i = 0;                                                                  \
+    for(; i + w <= n; i += w) {                                                         \
+        const unsigned bits = V::template compare<Op>(V::load(a + i), V::load(b + i));  \
+        for(std::size_t l = 0; l < w; ++l) mask[i + l] = (bits >> l) & 1u;              \
+    }                                                                                   \
+    genericCompare(a + i, b + i, mask + i, n - i, Op);                                  \
+}                                                                                       \
+template <class V, typename T>                                                          \
+TARGET void PREFIX##Compare(const T* a, const T* b, unsigned char* mask, std::size_t n, CompareOp op) { \
+    switch(op) {                                                                        \
+        case CompareOp::Equal: return PREFIX##CompareOp<V, CompareOp::Equal>(a, b, mask, n); \
+        case CompareOp::NotEqual: return PREFIX##CompareOp<V, CompareOp::NotEqual>(a, b, mask, n); \
+        case CompareOp::Less: return PREFIX##CompareOp<V, CompareOp::Less>(a, b, mask, n); \
+        case CompareOp::LessEqual: return PREFIX##CompareOp<V, CompareOp::LessEqual>(a, b, mask, n); \
+        case CompareOp::Greater: return PREFIX##CompareOp<V, CompareOp::Greater>(a, b, mask, n); \
+        case CompareOp::GreaterEqual: return PREFIX##CompareOp<V, CompareOp::GreaterEqual>(a, b, mask, n); \
+    }                                                                                   \
+}                                                                                       \
+template <class V>                                                                      \
+ElementwiseKernels<typename V::value_type> PREFIX##Kernels() {                          \
+    typedef typename V::value_type T;                                                   \
+    ElementwiseKernels<T> k;                                                            \
+    k.add = &PREFIX##Add<V, T>;                                                         \
+    k.subtract = &PREFIX##Subtract<V, T>;                                               \
+    k.multiply = &PREFIX##Multiply<V, T>;                                               \
+    k.scale = &PREFIX##Scale<V, T>;                                                     \
+    k.axpy = &PREFIX##Axpy<V, T>;                                                       \
+    k.compare = &PREFIX##Compare<V, T>;                                                 \
+    return k;                                                                           \
+}
+
+CPPMATH_ELEMENTWISE_KERNELS(sse2, CPPMATH_SSE2)
+CPPMATH_ELEMENTWISE_KERNELS(avx2, CPPMATH_AVX2)
+CPPMATH_ELEMENTWISE_KERNELS(avx512, CPPMATH_AVX512)
+
+#undef CPPMATH_ELEMENTWISE_KERNELS
+
+#endif // CPPMATH_X86_DISPATCH
+
+} // namespace
+
+template <> ElementwiseKernels<float> elementwiseKernels<float>(cpu::InstructionSet isa) {
+#if CPPMATH_X86_DISPATCH
+    switch(isa) {
+        case cpu::InstructionSet::AVX512: return avx512Kernels<Avx512Float>();
+        case cpu::InstructionSet::AVX2: return avx2Kernels<Avx2Float>();
+        case cpu::InstructionSet::SSE2: return sse2Kernels<Sse2Float>();
+        default: break;
+    }
+#endif
+    (void)isa;
+    return genericElementwiseKernels<float>();
+}
+
+template <> ElementwiseKernels<double> elementwiseKernels<double>(cpu::InstructionSet isa) {
+#if CPPMATH_X86_DISPATCH
+    switch(isa) {
+        case cpu::InstructionSet::AVX512: return avx512Kernels<Avx512Double>();
+        case cpu::InstructionSet::AVX2: return avx2Kernels<Avx2Double>();
+        case cpu::InstructionSet::SSE2: return sse2Kernels<Sse2Double>();
+        default: break;
+    }
+#endif
+    (void)isa;
+    return genericElementwiseKernels<double>();
+}
+
+} // namespace detail
+} //namespace matrix
+} //namespace cppmath
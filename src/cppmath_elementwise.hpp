@@ -0,0 +1,316 @@
+//
+//  cppmath_elementwise.hpp
+//  CppMath
+//
+//  Created by Dmytro Krasnianskyi on 17.10.26.
+//  Copyright © 2026 Dmytro Krasnianskyi. All rights reserved.
+//
+
+#ifndef cppmath_elementwise_hpp
+#define cppmath_elementwise_hpp
+
+#include <cstddef>
+#include <cassert>
+#include <utility>
+#include <algorithm>
+#include <type_traits>
+
+#include "cppmath_cpu.hpp"
+#include "cppmath_matrix.hpp"
+#include "cppmath_parallel.hpp"
+
+/** Element-wise kernels over the contiguous matrix storage.
+    float and double run SSE2/AVX2/AVX-512 code selected once at runtime,
+    every other type uses the portable loops below. Output may alias inputs.
+ */
+
+namespace cppmath {
+namespace matrix{
+
+enum class CompareOp: int {
+    Equal = 0,
+    NotEqual,
+    Less,
+    LessEqual,
+    Greater,
+    GreaterEqual
+};
+
+namespace detail {
+
+template <typename T>
+struct ElementwiseKernels {
+    typedef void (*Binary)(const T* a, const T* b, T* out, std::size_t n);
+    typedef void (*Scale)(const T* a, T alpha, T* out, std::size_t n);
+    typedef void (*Axpy)(T alpha, const T* x, T* y, std::size_t n);
+    typedef void (*Compare)(const T* a, const T* b, unsigned char* mask, std::size_t n, CompareOp op);
+
+    Binary add = nullptr;
+    Binary subtract = nullptr;
+    Binary multiply = nullptr;
+    Scale scale = nullptr;
+    Axpy axpy = nullptr;
+    Compare compare = nullptr;
+};
+
+template <typename T>
+void genericAdd(const T* a, const T* b, T* out, std::size_t n) {
+    for(std::size_t i = 0; i < n; ++i) out[i] = a[i] + b[i];
+}
+
+template <typename T>
+void genericSubtract(const T* a, const T* b, T* out, std::size_t n) {
+    for(std::size_t i = 0; i < n; ++i) out[i] = a[i] - b[i];
+}
+
+template <typename T>
+void genericMultiply(const T* a, const T* b, T* out, std::size_t n) {
+    for(std::size_t i = 0; i < n; ++i) out[i] = a[i] * b[i];
+}
+
+template <typename T>
+void genericScale(const T* a, T alpha, T* out, std::size_t n) {
+    for(std::size_t i = 0; i < n; ++i) out[i] = alpha * a[i];
+}
+
+template <typename T>
+void genericAxpy(T alpha, const T* x, T* y, std::size_t n) {
+    for(std::size_t i = 0; i < n; ++i) y[i] += alpha * x[i];
+}
+
+template <typename T>
+void genericCompare(const T* a, const T* b, unsigned char* mask, std::size_t n, CompareOp op) {
+    switch(op) {
+        case CompareOp::Equal:
+            for(std::size_t i = 0; i < n; ++i) mask[i] = a[i] == b[i];
+            break;
+        case CompareOp::NotEqual:
+            for(std::size_t i = 0; i < n; ++i) mask[i] = a[i] != b[i];
+            break;
+        case CompareOp::Less:
+            for(std::size_t i = 0; i < n; ++i) mask[i] = a[i] < b[i];
+            break;
+        case CompareOp::LessEqual:
+            for(std::size_t i = 0; i < n; ++i) mask[i] = a[i] <= b[i];
+            break;
+        case CompareOp::Greater:
+            for(std::size_t i = 0; i < n; ++i) mask[i] = a[i] > b[i];
+            break;
+        case CompareOp::GreaterEqual:
+            for(std::size_t i = 0; i < n; ++i) mask[i] = a[i] >= b[i];
+            break;
+    }
+}
+
+template <typename T>
+ElementwiseKernels<T> genericElementwiseKernels() {
+    ElementwiseKernels<T> k;
+    k.add = &genericAdd<T>;
+    k.subtract = &genericSubtract<T>;
+    k.multiply = &genericMultiply<T>;
+    k.scale = &genericScale<T>;
+    k.axpy = &genericAxpy<T>;
+    k.compare = &genericCompare<T>;
+    return k;
+}
+
+/** Kernels for the given instruction set level. The generic template
+    ignores the level, float and double have SIMD specializations.
+ */
+template <typename T>
+inline ElementwiseKernels<T> elementwiseKernels(cpu::InstructionSet) {
+    return genericElementwiseKernels<T>();
+}
+
+template <> ElementwiseKernels<float> elementwiseKernels<float>(cpu::InstructionSet isa);
+template <> ElementwiseKernels<double> elementwiseKernels<double>(cpu::InstructionSet isa);
+
+/** Kernels for the running CPU, selected on the first use. */
+template <typename T>
+inline const ElementwiseKernels<T>& activeElementwiseKernels() {
+    static const ElementwiseKernels<T> kernels = elementwiseKernels<T>(cpu::instructionSet());
+    return kernels;
+}
+
+template <typename T, typename U>
+inline bool sameShape(const BasicMatrixView<T>& a, const BasicMatrixView<U>& b) {
+    return a.rows() == b.rows() && a.columns() == b.columns();
+}
+
+/** Elements per task of the parallel element-wise kernels. */
+constexpr std::size_t kElementwiseGrain = std::size_t(1) << 15;
+
+/** Feeds the rows of up to two inputs and one output to a contiguous kernel
+    fn(const A* a, const B* b, Out* out, std::size_t n). Dense operands are
+    split into element ranges, rows with unit column stride take one call per
+    row, and other rows are gathered into small stack chunks first. When all
+    the operands have contiguous columns instead, the transposes are fed. With
+    readOutput set the output chunk is gathered as well, for in-place kernels
+    like axpy.
+ */
+template <typename A, typename B, typename Out, class Fn>
+void applyRows(const execution::ExecutionPolicy& policy,
+               const ConstMatrixView<A>& a, const ConstMatrixView<B>& b, const MatrixView<Out>& out,
+               bool readOutput, Fn fn) {
+    assert(sameShape(a, out) && sameShape(b, out));
+    // Column-major operands are walked as their row-major transposes
+    if(!out.hasContiguousRows() && out.transposed().hasContiguousRows() &&
+       a.transposed().hasContiguousRows() && b.transposed().hasContiguousRows()) {
+        applyRows(policy, a.transposed(), b.transposed(), out.transposed(), readOutput, fn);
+        return;
+    }
+    if(a.isContiguous() && b.isContiguous() && out.isContiguous()) {
+        execution::parallelFor(policy, 0, out.size(), kElementwiseGrain, [&](std::size_t first, std::size_t last){
+            fn(a.data() + first, b.data() + first, out.data() + first, last - first);
+        });
+        return;
+    }
+
+    const std::size_t columns = out.columns();
+    const bool rowsContiguous = a.hasContiguousRows() && b.hasContiguousRows() && out.hasContiguousRows();
+    const std::size_t grain = std::max<std::size_t>(1, kElementwiseGrain / std::max<std::size_t>(columns, 1));
+
+    execution::parallelFor(policy, 0, out.rows(), grain, [&](std::size_t firstRow, std::size_t lastRow){
+        if(rowsContiguous) {
+            for(std::size_t r = firstRow; r < lastRow; ++r) fn(a.rowData(r), b.rowData(r), out.rowData(r), columns);
+            return;
+        }
+
+        // Strided rows only: the chunks are not constructed otherwise
+        const std::size_t chunk = 256;
+        A bufferA[chunk];
+        B bufferB[chunk];
+        Out bufferOut[chunk];
+
+        for(std::size_t r = firstRow; r < lastRow; ++r) {
+            for(std::size_t c0 = 0; c0 < columns; c0 += chunk) {
+                const std::size_t n = std::min(chunk, columns - c0);
+                const A* pa = &a[MatrixPoint{r, c0}];
+                const B* pb = &b[MatrixPoint{r, c0}];
+                Out* po = &out[MatrixPoint{r, c0}];
+                if(a.columnStride() != 1) {
+                    for(std::size_t i = 0; i < n; ++i) bufferA[i] = pa[static_cast<std::ptrdiff_t>(i) * a.columnStride()];
+                    pa = bufferA;
+                }
+                if(b.columnStride() != 1) {
+                    for(std::size_t i = 0; i < n; ++i) bufferB[i] = pb[static_cast<std::ptrdiff_t>(i) * b.columnStride()];
+                    pb = bufferB;
+                }
+                if(out.columnStride() != 1) {
+                    if(readOutput) {
+                        for(std::size_t i = 0; i < n; ++i) bufferOut[i] = po[static_cast<std::ptrdiff_t>(i) * out.columnStride()];
+                    }
+                    fn(pa, pb, bufferOut, n);
+                    for(std::size_t i = 0; i < n; ++i) po[static_cast<std::ptrdiff_t>(i) * out.columnStride()] = bufferOut[i];
+                } else {
+                    fn(pa, pb, po, n);
+                }
+            }
+        }
+    });
+}
+
+template <class A, class B, class Out>
+using EnableIfElementwise = typename std::enable_if<IsMatrixLike<A>::value && IsMatrixLike<B>::value && IsMatrixLike<Out>::value>::type;
+
+template <class A, class Out>
+using EnableIfUnaryElementwise = typename std::enable_if<IsMatrixLike<A>::value && IsMatrixLike<Out>::value>::type;
+
+} // namespace detail
+
+/** out = a + b */
+template <class A, class B, class Out>
+detail::EnableIfElementwise<A, B, Out> add(const execution::ExecutionPolicy& policy, const A& a, const B& b, Out&& out) {
+    typedef typename MatrixValueType<Out>::type T;
+    const instrumentation::ScopedOperation counted(instrumentation::Operation::Elementwise, double(constView(a).size()));
+    detail::applyRows(policy, constView(a), constView(b), mutableView(out), false,
+                      detail::activeElementwiseKernels<T>().add);
+}
+
+/** out = a - b */
+template <class A, class B, class Out>
+detail::EnableIfElementwise<A, B, Out> subtract(const execution::ExecutionPolicy& policy, const A& a, const B& b, Out&& out) {
+    typedef typename MatrixValueType<Out>::type T;
+    const instrumentation::ScopedOperation counted(instrumentation::Operation::Elementwise, double(constView(a).size()));
+    detail::applyRows(policy, constView(a), constView(b), mutableView(out), false,
+                      detail::activeElementwiseKernels<T>().subtract);
+}
+
+/** out = a .* b (Hadamard product) */
+template <class A, class B, class Out>
+detail::EnableIfElementwise<A, B, Out> hadamard(const execution::ExecutionPolicy& policy, const A& a, const B& b, Out&& out) {
+    typedef typename MatrixValueType<Out>::type T;
+    const instrumentation::ScopedOperation counted(instrumentation::Operation::Elementwise, double(constView(a).size()));
+    detail::applyRows(policy, constView(a), constView(b), mutableView(out), false,
+                      detail::activeElementwiseKernels<T>().multiply);
+}
+
+/** out = alpha * a */
+template <class A, class Out>
+detail::EnableIfUnaryElementwise<A, Out> scale(const execution::ExecutionPolicy& policy,
+                                               const A& a, const typename MatrixValueType<Out>::type& alpha, Out&& out) {
+    typedef typename MatrixValueType<Out>::type T;
+    const typename detail::ElementwiseKernels<T>::Scale kernel = detail::activeElementwiseKernels<T>().scale;
+    const ConstMatrixView<T> va = constView(a);
+    const instrumentation::ScopedOperation counted(instrumentation::Operation::Elementwise, double(va.size()));
+    detail::applyRows(policy, va, va, mutableView(out), false,
+                      [kernel, alpha](const T* x, const T*, T* y, std::size_t n){ kernel(x, alpha, y, n); });
+}
+
+/** y += alpha * x */
+template <class X, class Y>
+detail::EnableIfUnaryElementwise<X, Y> axpy(const execution::ExecutionPolicy& policy,
+                                            const typename MatrixValueType<Y>::type& alpha, const X& x, Y&& y) {
+    typedef typename MatrixValueType<Y>::type T;
+    const typename detail::ElementwiseKernels<T>::Axpy kernel = detail::activeElementwiseKernels<T>().axpy;
+    const ConstMatrixView<T> vx = constView(x);
+    const instrumentation::ScopedOperation counted(instrumentation::Operation::Elementwise, 2.0 * vx.size());
+    detail::applyRows(policy, vx, vx, mutableView(y), true,
+                      [kernel, alpha](const T* a, const T*, T* out, std::size_t n){ kernel(alpha, a, out, n); });
+}
+
+/** mask = (a op b) per element, as 0/1 bytes. */
+template <class A, class B, class Mask>
+detail::EnableIfElementwise<A, B, Mask> compare(const execution::ExecutionPolicy& policy,
+                                                const A& a, const B& b, CompareOp op, Mask&& mask) {
+    typedef typename MatrixValueType<A>::type T;
+    const typename detail::ElementwiseKernels<T>::Compare kernel = detail::activeElementwiseKernels<T>().compare;
+    detail::applyRows(policy, constView(a), constView(b), mutableView(mask), false,
+                      [kernel, op](const T* x, const T* y, unsigned char* out, std::size_t n){ kernel(x, y, out, n, op); });
+}
+
+/** The overloads without a policy split large operands between threads. */
+template <class A, class B, class Out>
+detail::EnableIfElementwise<A, B, Out> add(const A& a, const B& b, Out&& out) {
+    add(execution::par, a, b, std::forward<Out>(out));
+}
+
+template <class A, class B, class Out>
+detail::EnableIfElementwise<A, B, Out> subtract(const A& a, const B& b, Out&& out) {
+    subtract(execution::par, a, b, std::forward<Out>(out));
+}
+
+template <class A, class B, class Out>
+detail::EnableIfElementwise<A, B, Out> hadamard(const A& a, const B& b, Out&& out) {
+    hadamard(execution::par, a, b, std::forward<Out>(out));
+}
+
+template <class A, class Out>
+detail::EnableIfUnaryElementwise<A, Out> scale(const A& a, const typename MatrixValueType<Out>::type& alpha, Out&& out) {
+    scale(execution::par, a, alpha, std::forward<Out>(out));
+}
+
+template <class X, class Y>
+detail::EnableIfUnaryElementwise<X, Y> axpy(const typename MatrixValueType<Y>::type& alpha, const X& x, Y&& y) {
+    axpy(execution::par, alpha, x, std::forward<Y>(y));
+}
+
+template <class A, class B, class Mask>
+detail::EnableIfElementwise<A, B, Mask> compare(const A& a, const B& b, CompareOp op, Mask&& mask) {
+    compare(execution::par, a, b, op, std::forward<Mask>(mask));
+}
+
+} //namespace matrix
+} //namespace cppmath
+
+#endif /* cppmath_elementwise_hpp */
@@ -0,0 +1,307 @@
+//
+//  cppmath_expression.hpp
+//  CppMath
+//
+//  Created by Dmytro Krasnianskyi on 17.10.26.
+//  Copyright © 2026 Dmytro Krasnianskyi. All rights reserved.
+//
+
+#ifndef cppmath_expression_hpp
+#define cppmath_expression_hpp
+
+#include <cstddef>
+#include <cassert>
+#include <iterator>
+#include <memory>
+#include <type_traits>
+
+#include "cppmath_allocator.hpp"
+#include "cppmath_layout.hpp"
+
+/** Lazy element-wise arithmetic.
+
+    A + B * 2 - C builds a tree of lightweight nodes, nothing is computed
+    until the tree is assigned to a Matrix, which is then filled in a single
+    pass without temporaries. Matrix operands are captured by pointer, so an
+    expression must not outlive the matrices it refers to (for example a
+    stored expression over a temporary Matrix dangles).
+    Note that Matrix * Matrix stays the eager matrix product.
+ */
+
+namespace cppmath {
+namespace matrix{
+
+template <typename T, class Allocator = memory::DefaultAllocator<T>, class Layout = layout::RowMajor> class Matrix;
+template <typename T> class BasicMatrixView;
+
+template <class E> class ExpressionIterator;
+
+template <class Derived>
+class MatrixExpression {
+public:
+    typedef ExpressionIterator<Derived> Iterator;
+
+    inline const Derived& derived() const noexcept { return static_cast<const Derived&>(*this); }
+
+    inline std::size_t rows() const noexcept { return derived().rows(); }
+    inline std::size_t columns() const noexcept { return derived().columns(); }
+    inline std::size_t size() const noexcept { return rows() * columns(); }
+
+    inline Iterator begin() const { return Iterator(&derived(), 0); }
+    inline Iterator end() const { return Iterator(&derived(), size()); }
+
+    /** Writes all the elements into contiguous row-major storage. */
+    template <typename U>
+    inline void evaluateTo(U* out) const {
+        const Derived& e = derived();
+        const std::size_t rows = this->rows();
+        const std::size_t columns = this->columns();
+        for(std::size_t r = 0; r < rows; ++r, out += columns) {
+            for(std::size_t c = 0; c < columns; ++c) out[c] = e.coeff(r, c);
+        }
+    }
+};
+
+/** Random access iterator over the values of an expression, usable with the
+    STL algorithms next to RowIterator.
+ */
+template <class E>
+class ExpressionIterator {
+public:
+    typedef typename E::value_type              value_type;
+    typedef value_type                          reference;
+    typedef void                                pointer;
+    typedef std::ptrdiff_t                      difference_type;
+    typedef std::random_access_iterator_tag     iterator_category;
+
+    ExpressionIterator() = default;
+    ExpressionIterator(const E* expression, std::size_t index): m_expression(expression), m_index(index) {}
+
+    inline value_type operator *() const { return m_expression->coeff(m_index); }
+    inline value_type operator [](difference_type di) const { return m_expression->coeff(m_index + di); }
+
+    inline ExpressionIterator& operator ++() noexcept { ++m_index; return *this; }
+    inline ExpressionIterator operator ++(int) noexcept { ExpressionIterator r(*this); ++m_index; return r; }
+    inline ExpressionIterator& operator --() noexcept { --m_index; return *this; }
+    inline ExpressionIterator operator --(int) noexcept { ExpressionIterator r(*this); --m_index; return r; }
+    inline ExpressionIterator& operator +=(difference_type di) noexcept { m_index += di; return *this; }
+    inline ExpressionIterator& operator -=(difference_type di) noexcept { m_index -= di; return *this; }
+    inline ExpressionIterator operator + (difference_type di) const noexcept { return ExpressionIterator(m_expression, m_index + di); }
+    inline ExpressionIterator operator - (difference_type di) const noexcept { return ExpressionIterator(m_expression, m_index - di); }
+    inline difference_type operator - (const ExpressionIterator& other) const noexcept {
+        return static_cast<difference_type>(m_index) - static_cast<difference_type>(other.m_index);
+    }
+    friend inline ExpressionIterator operator + (difference_type di, const ExpressionIterator& it) noexcept { return it + di; }
+
+    inline bool operator == (const ExpressionIterator& other) const { return m_index == other.m_index; }
+    inline bool operator != (const ExpressionIterator& other) const { return m_index != other.m_index; }
+    inline bool operator < (const ExpressionIterator& other) const { return m_index < other.m_index; }
+    inline bool operator > (const ExpressionIterator& other) const { return m_index > other.m_index; }
+    inline bool operator <= (const ExpressionIterator& other) const { return m_index <= other.m_index; }
+    inline bool operator >= (const ExpressionIterator& other) const { return m_index >= other.m_index; }
+
+    inline std::size_t index() const noexcept { return m_index; }
+    inline std::size_t column() const { return m_expression->columns() != 0 ? m_index % m_expression->columns() : 0; }
+    inline std::size_t row() const { return m_expression->columns() != 0 ? m_index / m_expression->columns() : 0; }
+
+private:
+    const E* m_expression = nullptr;
+    std::size_t m_index = 0;
+};
+
+/** Expression leaf referring to the storage of a Matrix. */
+template <typename T, class Layout = layout::RowMajor>
+class MatrixLeaf final: public MatrixExpression<MatrixLeaf<T, Layout>> {
+public:
+    typedef T value_type;
+
+    template <class Allocator>
+    explicit MatrixLeaf(const Matrix<T, Allocator, Layout>& m): m_data(m.data()), m_rows(m.rows()), m_columns(m.columns()) {}
+
+    inline std::size_t rows() const noexcept { return m_rows; }
+    inline std::size_t columns() const noexcept { return m_columns; }
+    inline const T& coeff(std::size_t index) const noexcept {
+        return Layout::kRowMajor ? m_data[index] : coeff(index / m_columns, index % m_columns);
+    }
+    inline const T& coeff(std::size_t row, std::size_t column) const noexcept {
+        return m_data[Layout::offset(row, column, m_rows, m_columns)];
+    }
+
+private:
+    const T* m_data;
+    std::size_t m_rows;
+    std::size_t m_columns;
+};
+
+template <class X> struct IsMatrix: std::false_type {};
+template <typename T, class Allocator, class Layout> struct IsMatrix<Matrix<T, Allocator, Layout>>: std::true_type {};
+
+/** Matrices whose storage a MatrixView can describe. */
+template <class X> struct IsStridedMatrix: std::false_type {};
+template <typename T, class Allocator, class Layout> struct IsStridedMatrix<Matrix<T, Allocator, Layout>>:
+    std::integral_constant<bool, Layout::kStrided> {};
+
+template <class X> struct IsMatrixExpression: std::is_base_of<MatrixExpression<X>, X> {};
+
+template <class X> struct IsExpressionOperand:
+    std::integral_constant<bool, IsMatrix<X>::value || IsMatrixExpression<X>::value> {};
+
+/** How a node keeps its operand: matrices as leaves, nodes by value. */
+template <class X> struct ExpressionOperand { typedef X type; };
+template <typename T, class Allocator, class Layout> struct ExpressionOperand<Matrix<T, Allocator, Layout>> {
+    typedef MatrixLeaf<T, Layout> type;
+};
+
+template <class X>
+inline typename ExpressionOperand<X>::type makeOperand(const X& x) {
+    return typename ExpressionOperand<X>::type(x);
+}
+
+namespace op {
+
+struct Plus { template <typename T> static inline T apply(const T& a, const T& b) { return a + b; } };
+struct Minus { template <typename T> static inline T apply(const T& a, const T& b) { return a - b; } };
+struct Multiplies { template <typename T> static inline T apply(const T& a, const T& b) { return a * b; } };
+struct Divides { template <typename T> static inline T apply(const T& a, const T& b) { return a / b; } };
+struct Negate { template <typename T> static inline T apply(const T& a) { return -a; } };
+
+} // namespace op
+
+template <class L, class R, class Op>
+class BinaryExpression final: public MatrixExpression<BinaryExpression<L, R, Op>> {
+public:
+    typedef typename L::value_type value_type;
+    static_assert(std::is_same<value_type, typename R::value_type>::value,
+                  "Operands of an element-wise expression must have the same value type");
+
+    BinaryExpression(const L& left, const R& right): m_left(left), m_right(right) {
+        assert(left.rows() == right.rows() && left.columns() == right.columns());
+    }
+
+    inline std::size_t rows() const noexcept { return m_left.rows(); }
+    inline std::size_t columns() const noexcept { return m_left.columns(); }
+    inline value_type coeff(std::size_t index) const {
+        return Op::apply(static_cast<value_type>(m_left.coeff(index)), static_cast<value_type>(m_right.coeff(index)));
+    }
+    inline value_type coeff(std::size_t row, std::size_t column) const {
+        return Op::apply(static_cast<value_type>(m_left.coeff(row, column)), static_cast<value_type>(m_right.coeff(row, column)));
+    }
+
+private:
+    L m_left;
+    R m_right;
+};
+
+/** Expression combined with a scalar, the scalar is the right operand of Op
+    unless ScalarOnLeft is set.
+ */
+template <class E, class Op, bool ScalarOnLeft = false>
+class ScalarExpression final: public MatrixExpression<ScalarExpression<E, Op, ScalarOnLeft>> {
+public:
+    typedef typename E::value_type value_type;
+
+    ScalarExpression(const E& expression, const value_type& scalar): m_expression(expression), m_scalar(scalar) {}
+
+    inline std::size_t rows() const noexcept { return m_expression.rows(); }
+    inline std::size_t columns() const noexcept { return m_expression.columns(); }
+    inline value_type coeff(std::size_t index) const {
+        return ScalarOnLeft ? Op::apply(m_scalar, static_cast<value_type>(m_expression.coeff(index)))
+                            : Op::apply(static_cast<value_type>(m_expression.coeff(index)), m_scalar);
+    }
+    inline value_type coeff(std::size_t row, std::size_t column) const {
+        return ScalarOnLeft ? Op::apply(m_scalar, static_cast<value_type>(m_expression.coeff(row, column)))
+                            : Op::apply(static_cast<value_type>(m_expression.coeff(row, column)), m_scalar);
+    }
+
+private:
+    E m_expression;
+    value_type m_scalar;
+};
+
+template <class E, class Op>
+class UnaryExpression final: public MatrixExpression<UnaryExpression<E, Op>> {
+public:
+    typedef typename E::value_type value_type;
+
+    explicit UnaryExpression(const E& expression): m_expression(expression) {}
+
+    inline std::size_t rows() const noexcept { return m_expression.rows(); }
+    inline std::size_t columns() const noexcept { return m_expression.columns(); }
+    inline value_type coeff(std::size_t index) const { return Op::apply(static_cast<value_type>(m_expression.coeff(index))); }
+    inline value_type coeff(std::size_t row, std::size_t column) const {
+        return Op::apply(static_cast<value_type>(m_expression.coeff(row, column)));
+    }
+
+private:
+    E m_expression;
+};
+
+template <class L, class R, class Op>
+using BinaryExpressionOf = BinaryExpression<typename ExpressionOperand<L>::type, typename ExpressionOperand<R>::type, Op>;
+
+template <class L, class R, class Op>
+using EnableIfBinary = typename std::enable_if<IsExpressionOperand<L>::value && IsExpressionOperand<R>::value,
+                                               BinaryExpressionOf<L, R, Op>>::type;
+
+template <class E, class S, class Op, bool ScalarOnLeft = false>
+using EnableIfScalar = typename std::enable_if<IsExpressionOperand<E>::value && std::is_arithmetic<S>::value,
+                                               ScalarExpression<typename ExpressionOperand<E>::type, Op, ScalarOnLeft>>::type;
+
+template <class E, class S, class Op, bool ScalarOnLeft = false>
+inline EnableIfScalar<E, S, Op, ScalarOnLeft> makeScalarExpression(const E& e, const S& s) {
+    typedef typename ExpressionOperand<E>::type Operand;
+    return EnableIfScalar<E, S, Op, ScalarOnLeft>(makeOperand(e), static_cast<typename Operand::value_type>(s));
+}
+
+template <class L, class R>
+inline EnableIfBinary<L, R, op::Plus> operator + (const L& left, const R& right) {
+    return EnableIfBinary<L, R, op::Plus>(makeOperand(left), makeOperand(right));
+}
+
+template <class L, class R>
+inline EnableIfBinary<L, R, op::Minus> operator - (const L& left, const R& right) {
+    return EnableIfBinary<L, R, op::Minus>(makeOperand(left), makeOperand(right));
+}
+
+/** Element-wise (Hadamard) product as an expression node. */
+template <class L, class R>
+inline EnableIfBinary<L, R, op::Multiplies> hadamard(const L& left, const R& right) {
+    return EnableIfBinary<L, R, op::Multiplies>(makeOperand(left), makeOperand(right));
+}
+
+template <class E>
+inline typename std::enable_if<IsExpressionOperand<E>::value,
+                               UnaryExpression<typename ExpressionOperand<E>::type, op::Negate>>::type
+operator - (const E& e) {
+    return UnaryExpression<typename ExpressionOperand<E>::type, op::Negate>(makeOperand(e));
+}
+
+template <class E, class S>
+inline EnableIfScalar<E, S, op::Multiplies> operator * (const E& e, const S& s) {
+    return makeScalarExpression<E, S, op::Multiplies>(e, s);
+}
+
+template <class S, class E>
+inline EnableIfScalar<E, S, op::Multiplies, true> operator * (const S& s, const E& e) {
+    return makeScalarExpression<E, S, op::Multiplies, true>(e, s);
+}
+
+template <class E, class S>
+inline EnableIfScalar<E, S, op::Divides> operator / (const E& e, const S& s) {
+    return makeScalarExpression<E, S, op::Divides>(e, s);
+}
+
+template <class E, class S>
+inline EnableIfScalar<E, S, op::Plus> operator + (const E& e, const S& s) {
+    return makeScalarExpression<E, S, op::Plus>(e, s);
+}
+
+template <class E, class S>
+inline EnableIfScalar<E, S, op::Minus> operator - (const E& e, const S& s) {
+    return makeScalarExpression<E, S, op::Minus>(e, s);
+}
+
+} //namespace matrix
+} //namespace cppmath
+
+#endif /* cppmath_expression_hpp */
@@ -0,0 +1,548 @@
+//
+//  cppmath_factorization.hpp
+//  CppMath
+//
+//  Created by Dmytro Krasnianskyi on 17.10.26.
+//  Copyright © 2026 Dmytro Krasnianskyi. All rights reserved.
+//
+
+#ifndef cppmath_factorization_hpp
+#define cppmath_factorization_hpp
+
+#include <cstddef>
+#include <cassert>
+#include <cmath>
+#include <vector>
+#include <utility>
+#include <algorithm>
+#include <stdexcept>
+#include <type_traits>
+
+#include "cppmath_matrix.hpp"
+#include "cppmath_gemm.hpp"
+#include "cppmath_elementwise.hpp"
+#include "cppmath_parallel.hpp"
+
+/** Dense factorizations: LU with partial pivoting, Cholesky and Householder
+    QR.
+
+    All three are right-looking blocked algorithms. A narrow panel of block
+    columns is factored with vector operations, then the trailing matrix is
+    updated with one gemm per panel, so almost all of the work runs in the
+    matrix multiply kernels. A factorization object keeps its factors, so
+    every solve() after the first one costs only the triangular solves.
+    Inputs of the wrong shape throw std::invalid_argument: LU, Cholesky,
+    determinant() and inverse() need a non-empty square matrix, QR one
+    with at least as many rows as columns.
+ */
+
+namespace cppmath {
+namespace matrix{
+
+namespace detail {
+
+/** Panel width of the blocked factorizations. */
+constexpr std::size_t kFactorizationBlock = 64;
+
+/** Solves T X = B in place for a triangular T. B must have contiguous rows.
+    Diagonal blocks are solved row by row with axpy, the rest of B is updated
+    with gemm.
+ */
+template <typename T>
+void solveTriangular(const ConstMatrixView<T>& t, bool lower, bool unitDiagonal, const MatrixView<T>& b,
+                     std::size_t block = kFactorizationBlock) {
+    const std::size_t n = t.rows();
+    const std::size_t k = b.columns();
+    assert(t.columns() == n && b.rows() == n);
+    assert(b.hasContiguousRows() || k <= 1 || n == 0);
+    if(n == 0 || k == 0) return;
+
+    const ElementwiseKernels<T>& kernels = activeElementwiseKernels<T>();
+    block = std::max<std::size_t>(block, 1);
+
+    const auto solveRow = [&](std::size_t i, std::size_t from, std::size_t to) {
+        T* row = &b[MatrixPoint{i, 0}];
+        for(std::size_t j = from; j < to; ++j) {
+            const T factor = t[MatrixPoint{i, j}];
+            if(factor != T(0)) kernels.axpy(-factor, &b[MatrixPoint{j, 0}], row, k);
+        }
+        if(!unitDiagonal) kernels.scale(row, T(1) / t[MatrixPoint{i, i}], row, k);
+    };
+
+    if(lower) {
+        for(std::size_t k0 = 0; k0 < n; k0 += block) {
+            const std::size_t kb = std::min(block, n - k0);
+            for(std::size_t i = k0; i < k0 + kb; ++i) solveRow(i, k0, i);
+            const std::size_t rest = n - k0 - kb;
+            if(rest != 0) {
+                gemm(T(-1), t.submatrix(MatrixPoint{k0 + kb, k0}, rest, kb), b.submatrix(MatrixPoint{k0, 0}, kb, k),
+                     T(1), b.submatrix(MatrixPoint{k0 + kb, 0}, rest, k));
+            }
+        }
+    } else {
+        for(std::size_t end = n; end > 0;) {
+            const std::size_t kb = std::min(block, end);
+            const std::size_t k0 = end - kb;
+            for(std::size_t i = end; i-- > k0;) solveRow(i, i + 1, end);
+            if(k0 != 0) {
+                gemm(T(-1), t.submatrix(MatrixPoint{0, k0}, k0, kb), b.submatrix(MatrixPoint{k0, 0}, kb, k),
+                     T(1), b.submatrix(MatrixPoint{0, 0}, k0, k));
+            }
+            end = k0;
+        }
+    }
+}
+
+template <typename T>
+Matrix<T> identityMatrix(std::size_t n) {
+    Matrix<T> result(n, n);
+    for(std::size_t i = 0; i < n; ++i) result[MatrixPoint{i, i}] = T(1);
+    return result;
+}
+
+template <class X>
+using EnableIfFactorizable = typename std::enable_if<IsMatrixLike<X>::value>::type;
+
+} // namespace detail
+
+/** PA = LU with partial pivoting of a square matrix. L has a unit diagonal
+    and is stored below the diagonal of the packed factor, U on and above it.
+ */
+template <typename T>
+class LU {
+public:
+    typedef T           value_type;
+
+    template <class MatrixT, class = detail::EnableIfFactorizable<MatrixT>>
+    explicit LU(const MatrixT& a, std::size_t blockSize = detail::kFactorizationBlock):
+        m_lu(constView(a))
+    {
+        if(!m_lu.isSquareMatrix()) throw std::invalid_argument("LU: matrix is not square");
+        const double n = static_cast<double>(m_lu.rows());
+        const instrumentation::ScopedOperation counted(instrumentation::Operation::Factorization, 2.0 / 3.0 * n * n * n);
+        factor(std::max<std::size_t>(blockSize, 1));
+    }
+
+    /** True when a zero pivot was met. solve() and inverse() need a
+        non-singular matrix.
+     */
+    inline bool isSingular() const noexcept { return m_singular; }
+
+    /** X with A X = B, for B with A.rows() rows and any number of columns. */
+    template <class B, class = detail::EnableIfFactorizable<B>>
+    Matrix<T> solve(const B& b) const {
+        assert(!m_singular);
+        Matrix<T> x(constView(b));
+        assert(x.rows() == m_lu.rows());
+        for(std::size_t j = 0; j < m_pivots.size(); ++j) {
+            if(m_pivots[j] != j) std::swap_ranges(x.view().rowData(j), x.view().rowData(j) + x.columns(), x.view().rowData(m_pivots[j]));
+        }
+        detail::solveTriangular(m_lu.view(), true, true, x.view(), m_block);
+        detail::solveTriangular(m_lu.view(), false, false, x.view(), m_block);
+        return x;
+    }
+
+    T determinant() const {
+        T det = m_swaps % 2 == 0 ? T(1) : T(-1);
+        for(std::size_t i = 0; i < m_lu.rows(); ++i) det *= m_lu[MatrixPoint{i, i}];
+        return det;
+    }
+
+    Matrix<T> inverse() const {
+        return solve(detail::identityMatrix<T>(m_lu.rows()));
+    }
+
+    Matrix<T> lower() const {
+        Matrix<T> l = detail::identityMatrix<T>(m_lu.rows());
+        for(std::size_t i = 0; i < m_lu.rows(); ++i)
+            for(std::size_t j = 0; j < i; ++j)
+                l[MatrixPoint{i, j}] = m_lu[MatrixPoint{i, j}];
+        return l;
+    }
+
+    Matrix<T> upper() const {
+        Matrix<T> u(m_lu.rows(), m_lu.columns());
+        for(std::size_t i = 0; i < m_lu.rows(); ++i)
+            for(std::size_t j = i; j < m_lu.columns(); ++j)
+                u[MatrixPoint{i, j}] = m_lu[MatrixPoint{i, j}];
+        return u;
+    }
+
+    /** Row i was swapped with row pivots()[i] at step i. */
+    inline const std::vector<std::size_t>& pivots() const noexcept { return m_pivots; }
+    inline const Matrix<T>& packed() const noexcept { return m_lu; }
+
+private:
+    void factor(std::size_t block) {
+        const std::size_t n = m_lu.rows();
+        const detail::ElementwiseKernels<T>& kernels = detail::activeElementwiseKernels<T>();
+        MatrixView<T> a = m_lu.view();
+        m_block = block;
+        m_pivots.resize(n);
+
+        for(std::size_t k0 = 0; k0 < n; k0 += block) {
+            const std::size_t kb = std::min(block, n - k0);
+            const std::size_t panelEnd = k0 + kb;
+
+            for(std::size_t j = k0; j < panelEnd; ++j) {
+                std::size_t p = j;
+                for(std::size_t i = j + 1; i < n; ++i) {
+                    if(std::abs(a[MatrixPoint{i, j}]) > std::abs(a[MatrixPoint{p, j}])) p = i;
+                }
+                m_pivots[j] = p;
+                if(p != j) {
+                    std::swap_ranges(a.rowData(j), a.rowData(j) + n, a.rowData(p));
+                    ++m_swaps;
+                }
+
+                const T pivot = a[MatrixPoint{j, j}];
+                if(pivot == T(0)) {
+                    m_singular = true;
+                    continue;
+                }
+                for(std::size_t i = j + 1; i < n; ++i) {
+                    T& l = a[MatrixPoint{i, j}];
+                    l /= pivot;
+                    if(l != T(0) && j + 1 < panelEnd) kernels.axpy(-l, a.rowData(j) + j + 1, a.rowData(i) + j + 1, panelEnd - j - 1);
+                }
+            }
+
+            const std::size_t rest = n - panelEnd;
+            if(rest == 0) continue;
+            // U12 = L11^-1 A12, A22 -= L21 U12
+            const MatrixView<T> a12 = a.submatrix(MatrixPoint{k0, panelEnd}, kb, rest);
+            detail::solveTriangular(ConstMatrixView<T>(a.submatrix(MatrixPoint{k0, k0}, kb, kb)), true, true, a12, block);
+            gemm(T(-1), a.submatrix(MatrixPoint{panelEnd, k0}, rest, kb), a12,
+                 T(1), a.submatrix(MatrixPoint{panelEnd, panelEnd}, rest, rest));
+        }
+    }
+
+    Matrix<T> m_lu;
+    std::vector<std::size_t> m_pivots;
+    std::size_t m_swaps = 0;
+    std::size_t m_block = detail::kFactorizationBlock;
+    bool m_singular = false;
+};
+
+/** A = L L^T for a symmetric positive definite matrix. Only the lower
+    triangle of A is read.
+ */
+template <typename T>
+class Cholesky {
+public:
+    typedef T           value_type;
+
+    template <class MatrixT, class = detail::EnableIfFactorizable<MatrixT>>
+    explicit Cholesky(const MatrixT& a, std::size_t blockSize = detail::kFactorizationBlock):
+        m_l(constView(a))
+    {
+        if(!m_l.isSquareMatrix()) throw std::invalid_argument("Cholesky: matrix is not square");
+        const double n = static_cast<double>(m_l.rows());
+        const instrumentation::ScopedOperation counted(instrumentation::Operation::Factorization, n * n * n / 3.0);
+        factor(std::max<std::size_t>(blockSize, 1));
+    }
+
+    /** False when a non-positive pivot showed that A is not positive
+        definite. The factor is unusable then.
+     */
+    inline bool isPositiveDefinite() const noexcept { return m_positiveDefinite; }
+
+    template <class B, class = detail::EnableIfFactorizable<B>>
+    Matrix<T> solve(const B& b) const {
+        assert(m_positiveDefinite);
+        Matrix<T> x(constView(b));
+        assert(x.rows() == m_l.rows());
+        detail::solveTriangular(m_l.view(), true, false, x.view(), m_block);
+        detail::solveTriangular(m_l.view().transposed(), false, false, x.view(), m_block);
+        return x;
+    }
+
+    T determinant() const {
+        T det = T(1);
+        for(std::size_t i = 0; i < m_l.rows(); ++i) det *= m_l[MatrixPoint{i, i}] * m_l[MatrixPoint{i, i}];
+        return det;
+    }
+
+    Matrix<T> inverse() const {
+        return solve(detail::identityMatrix<T>(m_l.rows()));
+    }
+
+    inline const Matrix<T>& lower() const noexcept { return m_l; }
+
+private:
+    /** Dot product of rows i and j of L over columns [from, to). */
+    T rowDot(std::size_t i, std::size_t j, std::size_t from, std::size_t to) const {
+        const T* ri = m_l.data() + i * m_l.columns();
+        const T* rj = m_l.data() + j * m_l.columns();
+        T sum = T();
+        for(std::size_t p = from; p < to; ++p) sum += ri[p] * rj[p];
+        return sum;
+    }
+
+    void factor(std::size_t block) {
+        const std::size_t n = m_l.rows();
+        MatrixView<T> a = m_l.view();
+        m_block = block;
+
+        for(std::size_t k0 = 0; k0 < n && m_positiveDefinite; k0 += block) {
+            const std::size_t kb = std::min(block, n - k0);
+            const std::size_t panelEnd = k0 + kb;
+
+            for(std::size_t j = k0; j < panelEnd; ++j) {
+                const T d = a[MatrixPoint{j, j}] - rowDot(j, j, k0, j);
+                if(!(d > T(0))) {
+                    m_positiveDefinite = false;
+                    return;
+                }
+                const T ljj = std::sqrt(d);
+                a[MatrixPoint{j, j}] = ljj;
+                for(std::size_t i = j + 1; i < panelEnd; ++i) {
+                    a[MatrixPoint{i, j}] = (a[MatrixPoint{i, j}] - rowDot(i, j, k0, j)) / ljj;
+                }
+            }
+
+            const std::size_t rest = n - panelEnd;
+            if(rest == 0) continue;
+            // L21 = A21 L11^-T row by row, then A22 -= L21 L21^T
+            execution::parallelFor(execution::par, panelEnd, n, std::max<std::size_t>(1, 4096 / kb),
+                                   [&](std::size_t first, std::size_t last){
+                for(std::size_t i = first; i < last; ++i) {
+                    for(std::size_t j = k0; j < panelEnd; ++j) {
+                        a[MatrixPoint{i, j}] = (a[MatrixPoint{i, j}] - rowDot(i, j, k0, j)) / a[MatrixPoint{j, j}];
+                    }
+                }
+            });
+            const ConstMatrixView<T> l21 = a.submatrix(MatrixPoint{panelEnd, k0}, rest, kb);
+            gemm(T(-1), l21, l21.transposed(), T(1), a.submatrix(MatrixPoint{panelEnd, panelEnd}, rest, rest));
+        }
+
+        for(std::size_t i = 0; i < n; ++i) std::fill(a.rowData(i) + i + 1, a.rowData(i) + n, T());
+    }
+
+    Matrix<T> m_l;
+    std::size_t m_block = detail::kFactorizationBlock;
+    bool m_positiveDefinite = true;
+};
+
+/** A = QR by Householder reflections for an m x n matrix with m >= n. The
+    reflectors H_j = I - tau_j v_j v_j^T are kept below the diagonal of the
+    packed factor with an implicit unit first entry, R on and above it.
+    Trailing updates apply a whole panel at once in the compact WY form
+    I - V T V^T.
+ */
+template <typename T>
+class QR {
+public:
+    typedef T           value_type;
+
+    template <class MatrixT, class = detail::EnableIfFactorizable<MatrixT>>
+    explicit QR(const MatrixT& a, std::size_t blockSize = detail::kFactorizationBlock):
+        m_qr(constView(a))
+    {
+        if(m_qr.rows() < m_qr.columns()) throw std::invalid_argument("QR: matrix has more columns than rows");
+        const double m = static_cast<double>(m_qr.rows());
+        const double n = static_cast<double>(m_qr.columns());
+        const instrumentation::ScopedOperation counted(instrumentation::Operation::Factorization,
+                                                       2.0 * m * n * n - 2.0 / 3.0 * n * n * n);
+        factor(std::max<std::size_t>(blockSize, 1));
+    }
+
+    /** True when R has no zero on its diagonal. */
+    bool isFullRank() const {
+        for(std::size_t i = 0; i < m_qr.columns(); ++i) {
+            if(m_qr[MatrixPoint{i, i}] == T(0)) return false;
+        }
+        return true;
+    }
+
+    /** Least squares solution X minimizing ||A X - B|| column by column,
+        the exact solution for square A.
+     */
+    template <class B, class = detail::EnableIfFactorizable<B>>
+    Matrix<T> solve(const B& b) const {
+        assert(isFullRank());
+        Matrix<T> y(constView(b));
+        assert(y.rows() == m_qr.rows());
+        for(std::size_t j = 0; j < m_tau.size(); ++j) applyReflector(j, y.view());
+
+        const std::size_t n = m_qr.columns();
+        Matrix<T> x(y.view().submatrix(MatrixPoint{0, 0}, n, y.columns()));
+        detail::solveTriangular(m_qr.view().submatrix(MatrixPoint{0, 0}, n, n), false, false, x.view(), m_block);
+        return x;
+    }
+
+    /** The first n columns of Q. */
+    Matrix<T> thinQ() const {
+        Matrix<T> q(m_qr.rows(), m_qr.columns());
+        for(std::size_t i = 0; i < m_qr.columns(); ++i) q[MatrixPoint{i, i}] = T(1);
+        for(std::size_t j = m_tau.size(); j-- > 0;) applyReflector(j, q.view());
+        return q;
+    }
+
+    Matrix<T> R() const {
+        const std::size_t n = m_qr.columns();
+        Matrix<T> r(n, n);
+        for(std::size_t i = 0; i < n; ++i)
+            for(std::size_t j = i; j < n; ++j)
+                r[MatrixPoint{i, j}] = m_qr[MatrixPoint{i, j}];
+        return r;
+    }
+
+    /** Determinant of a square A. Every non-trivial reflector flips the sign. */
+    T determinant() const {
+        if(!m_qr.isSquareMatrix()) throw std::invalid_argument("QR: determinant of a non-square matrix");
+        T det = T(1);
+        for(std::size_t i = 0; i < m_qr.columns(); ++i) {
+            det *= m_qr[MatrixPoint{i, i}];
+            if(m_tau[i] != T(0)) det = -det;
+        }
+        return det;
+    }
+
+    inline const std::vector<T>& tau() const noexcept { return m_tau; }
+    inline const Matrix<T>& packed() const noexcept { return m_qr; }
+
+private:
+    /** x = H_j x for a matrix x with contiguous rows, row-wise so that the
+        SIMD kernels run along the rows.
+     */
+    void applyReflector(std::size_t j, const MatrixView<T>& x) const {
+        const T tau = m_tau[j];
+        if(tau == T(0) || x.columns() == 0) return;
+        const detail::ElementwiseKernels<T>& kernels = detail::activeElementwiseKernels<T>();
+        const std::size_t k = x.columns();
+        std::vector<T> w(x.rowData(j), x.rowData(j) + k);
+        for(std::size_t i = j + 1; i < m_qr.rows(); ++i) {
+            const T v = m_qr[MatrixPoint{i, j}];
+            if(v != T(0)) kernels.axpy(v, x.rowData(i), w.data(), k);
+        }
+        kernels.axpy(-tau, w.data(), x.rowData(j), k);
+        for(std::size_t i = j + 1; i < m_qr.rows(); ++i) {
+            const T v = m_qr[MatrixPoint{i, j}];
+            if(v != T(0)) kernels.axpy(-tau * v, w.data(), x.rowData(i), k);
+        }
+    }
+
+    void factor(std::size_t block) {
+        const std::size_t m = m_qr.rows();
+        const std::size_t n = m_qr.columns();
+        MatrixView<T> a = m_qr.view();
+        m_block = block;
+        m_tau.assign(n, T());
+
+        for(std::size_t k0 = 0; k0 < n; k0 += block) {
+            const std::size_t kb = std::min(block, n - k0);
+            const std::size_t panelEnd = k0 + kb;
+
+            for(std::size_t j = k0; j < panelEnd; ++j) {
+                householder(j);
+                // Apply H_j to the rest of the panel
+                const T tau = m_tau[j];
+                if(tau == T(0)) continue;
+                for(std::size_t c = j + 1; c < panelEnd; ++c) {
+                    T w = a[MatrixPoint{j, c}];
+                    for(std::size_t i = j + 1; i < m; ++i) w += a[MatrixPoint{i, j}] * a[MatrixPoint{i, c}];
+                    w *= tau;
+                    a[MatrixPoint{j, c}] -= w;
+                    for(std::size_t i = j + 1; i < m; ++i) a[MatrixPoint{i, c}] -= w * a[MatrixPoint{i, j}];
+                }
+            }
+
+            const std::size_t rest = n - panelEnd;
+            if(rest == 0) continue;
+
+            // V: the panel reflectors with explicit unit diagonal and zeros above
+            const std::size_t rows = m - k0;
+            Matrix<T> v(rows, kb);
+            for(std::size_t i = 0; i < rows; ++i) {
+                for(std::size_t c = 0; c < kb; ++c) {
+                    v[MatrixPoint{i, c}] = i == c ? T(1) : i > c ? a[MatrixPoint{k0 + i, k0 + c}] : T();
+                }
+            }
+
+            // Upper triangular T with H_k0 ... H_panelEnd-1 = I - V T V^T
+            Matrix<T> t(kb, kb);
+            Matrix<T> vtv(kb, kb);
+            gemm(T(1), v.view().transposed(), v, T(0), vtv);
+            for(std::size_t c = 0; c < kb; ++c) {
+                const T tau = m_tau[k0 + c];
+                t[MatrixPoint{c, c}] = tau;
+                for(std::size_t r = 0; r < c; ++r) {
+                    T sum = T();
+                    for(std::size_t p = r; p < c; ++p) sum += t[MatrixPoint{r, p}] * vtv[MatrixPoint{p, c}];
+                    t[MatrixPoint{r, c}] = -tau * sum;
+                }
+            }
+
+            // A2 = (I - V T^T V^T) A2
+            const MatrixView<T> a2 = a.submatrix(MatrixPoint{k0, panelEnd}, rows, rest);
+            Matrix<T> w(kb, rest);
+            gemm(T(1), v.view().transposed(), a2, T(0), w);
+            Matrix<T> tw(kb, rest);
+            gemm(T(1), t.view().transposed(), w, T(0), tw);
+            gemm(T(-1), v, tw, T(1), a2);
+        }
+    }
+
+    /** Reflector zeroing column j below the diagonal. */
+    void householder(std::size_t j) {
+        MatrixView<T> a = m_qr.view();
+        const std::size_t m = m_qr.rows();
+        T scaleNorm = T();
+        for(std::size_t i = j + 1; i < m; ++i) scaleNorm = std::max(scaleNorm, std::abs(a[MatrixPoint{i, j}]));
+        if(scaleNorm == T(0)) {
+            m_tau[j] = T();
+            return;
+        }
+        // Scaled norm guards against overflow
+        const T alpha = a[MatrixPoint{j, j}];
+        const T s = std::max(scaleNorm, std::abs(alpha));
+        T sum = T();
+        for(std::size_t i = j; i < m; ++i) {
+            const T x = a[MatrixPoint{i, j}] / s;
+            sum += x * x;
+        }
+        const T norm = s * std::sqrt(sum);
+        const T beta = alpha >= T(0) ? -norm : norm;
+        m_tau[j] = (beta - alpha) / beta;
+        const T inv = T(1) / (alpha - beta);
+        for(std::size_t i = j + 1; i < m; ++i) a[MatrixPoint{i, j}] *= inv;
+        a[MatrixPoint{j, j}] = beta;
+    }
+
+    Matrix<T> m_qr;
+    std::vector<T> m_tau;
+    std::size_t m_block = detail::kFactorizationBlock;
+};
+
+/** Determinant of a square matrix through LU. */
+template <class MatrixT>
+typename std::enable_if<IsMatrixLike<MatrixT>::value, typename MatrixValueType<MatrixT>::type>::type
+determinant(const MatrixT& a) {
+    if(!a.isSquareMatrix()) throw std::invalid_argument("determinant: matrix is not square");
+    return LU<typename MatrixValueType<MatrixT>::type>(a).determinant();
+}
+
+/** Inverse of a non-singular square matrix through LU. */
+template <class MatrixT>
+typename std::enable_if<IsMatrixLike<MatrixT>::value, Matrix<typename MatrixValueType<MatrixT>::type>>::type
+inverse(const MatrixT& a) {
+    if(!a.isSquareMatrix()) throw std::invalid_argument("inverse: matrix is not square");
+    return LU<typename MatrixValueType<MatrixT>::type>(a).inverse();
+}
+
+/** A X = B through LU for square A, least squares through QR for tall A. */
+template <class MatrixA, class MatrixB>
+typename std::enable_if<IsMatrixLike<MatrixA>::value && IsMatrixLike<MatrixB>::value,
+                        Matrix<typename MatrixValueType<MatrixA>::type>>::type
+solve(const MatrixA& a, const MatrixB& b) {
+    typedef typename MatrixValueType<MatrixA>::type T;
+    assert(a.rows() == b.rows());
+    if(a.isSquareMatrix()) return LU<T>(a).solve(b);
+    return QR<T>(a).solve(b);
+}
+
+} //namespace matrix
+} //namespace cppmath
+
+#endif /* cppmath_factorization_hpp */
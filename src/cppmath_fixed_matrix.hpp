@@ -0,0 +1,440 @@
+//
+//  cppmath_fixed_matrix.hpp
+//  CppMath
+//
+//  Created by Dmytro Krasnianskyi on 17.10.26.
+//  Copyright © 2026 Dmytro Krasnianskyi. All rights reserved.
+//
+
+#ifndef cppmath_fixed_matrix_hpp
+#define cppmath_fixed_matrix_hpp
+
+#include <cstddef>
+#include <cassert>
+#include <utility>
+#include <initializer_list>
+
+#include "cppmath_matrix_base.hpp"
+#include "cppmath_matrix.hpp"
+
+/** Statically sized R x C matrix with inline storage.
+
+    Nothing is heap allocated and every operation is constexpr. Element-wise
+    operations and the product are expanded over index sequences, so they
+    compile to straight-line code without loops. Determinant and inverse use
+    closed forms up to 4x4 and Gaussian elimination above that.
+    Storage is aligned to 16 bytes whenever its size allows, which is the
+    largest alignment new guarantees before C++17.
+ */
+
+namespace cppmath {
+namespace matrix{
+
+namespace detail {
+
+template <typename T>
+constexpr T fixedSum() { return T(); }
+
+template <typename T, typename... Ts>
+constexpr T fixedSum(const T& first, const Ts&... rest) { return first + fixedSum<T>(rest...); }
+
+template <typename T>
+constexpr T fixedAbs(const T& value) { return value < T(0) ? -value : value; }
+
+constexpr std::size_t fixedAlignment(std::size_t bytes, std::size_t natural) {
+    return bytes % 16 == 0 && natural <= 16 ? 16 : natural;
+}
+
+template <typename T, std::size_t N> struct FixedSquare;
+
+} // namespace detail
+
+template <typename T, std::size_t R, std::size_t C>
+class FixedMatrix {
+    static_assert(R > 0 && C > 0, "FixedMatrix dimensions must be positive");
+
+    struct ValuesTag {};
+
+    template <typename U, std::size_t R2, std::size_t C2> friend class FixedMatrix;
+
+public:
+    typedef T           value_type;
+
+    using Iterator = RowIterator<FixedMatrix>;
+    using ConstIterator = RowIterator<const FixedMatrix>;
+
+    static constexpr std::size_t kRows = R;
+    static constexpr std::size_t kColumns = C;
+    static constexpr std::size_t kSize = R * C;
+
+    constexpr FixedMatrix() = default;
+
+    explicit constexpr FixedMatrix(const T& val): FixedMatrix(ValuesTag(), val, std::make_index_sequence<kSize>()) {}
+
+    constexpr FixedMatrix(T const (& arr) [R][C]): FixedMatrix(ValuesTag(), arr, std::make_index_sequence<kSize>()) {}
+
+    /** Row-major values, missing trailing values are zero and values past
+        R x C are ignored, as for Matrix.
+     */
+    constexpr FixedMatrix(std::initializer_list<T> l) {
+        std::size_t i = 0;
+        for(auto it = l.begin(); it != l.end() && i < kSize; ++it) m_data[i++] = *it;
+    }
+
+    /** Copies a dynamic matrix or view of the same shape. */
+    template <class MatrixT, class = typename std::enable_if<IsMatrixLike<MatrixT>::value>::type>
+    explicit FixedMatrix(const MatrixT& m) {
+        assert(m.rows() == R && m.columns() == C);
+        const ConstMatrixView<T> v = constView(m);
+        for(std::size_t r = 0; r < R; ++r)
+            for(std::size_t c = 0; c < C; ++c)
+                m_data[r * C + c] = v[MatrixPoint{r, c}];
+    }
+
+    static constexpr FixedMatrix identity() {
+        static_assert(R == C, "Identity matrix must be square");
+        FixedMatrix result;
+        for(std::size_t i = 0; i < R; ++i) result.m_data[i * C + i] = T(1);
+        return result;
+    }
+
+    inline Matrix<T> toMatrix() const {
+        return Matrix<T>(view());
+    }
+
+    inline MatrixView<T> view() { return MatrixView<T>(m_data, R, C, C); }
+    inline ConstMatrixView<T> view() const { return ConstMatrixView<T>(m_data, R, C, C); }
+
+    constexpr inline T& operator [] (const MatrixPoint& point) {
+        assert(point.row < R && point.column < C);
+        return m_data[point.row * C + point.column];
+    }
+
+    constexpr inline const T& operator [] (const MatrixPoint& point) const {
+        assert(point.row < R && point.column < C);
+        return m_data[point.row * C + point.column];
+    }
+
+    constexpr inline T& operator [] (std::size_t index) {
+        assert(index < kSize);
+        return m_data[index];
+    }
+
+    constexpr inline const T& operator [] (std::size_t index) const {
+        assert(index < kSize);
+        return m_data[index];
+    }
+
+    constexpr inline Iterator begin(){ return Iterator::begin(this); }
+    constexpr inline Iterator beginAt(const MatrixPoint& point){ return Iterator::beginAt(this, point.row, point.column); }
+    constexpr inline Iterator end(){ return Iterator::end(this); }
+    constexpr inline ConstIterator begin() const { return ConstIterator::begin(this); }
+    constexpr inline ConstIterator beginAt(const MatrixPoint& point) const { return ConstIterator::beginAt(this, point.row, point.column); }
+    constexpr inline ConstIterator end() const { return ConstIterator::end(this); }
+
+    constexpr inline T* data() noexcept { return m_data; }
+    constexpr inline const T* data() const noexcept { return m_data; }
+
+    constexpr std::size_t size() const noexcept {return kSize;}
+    constexpr std::size_t rows() const noexcept {return R;}
+    constexpr std::size_t columns() const noexcept {return C;}
+
+    constexpr inline bool isSquareMatrix() const {return R == C; }
+    constexpr inline bool isColumnVector() const {return C == 1;}
+    constexpr inline bool isRowVector() const {return R == 1;}
+    constexpr inline bool isVector() const {return isColumnVector() || isRowVector();}
+    constexpr inline bool isEmpty() const {return false;}
+
+    constexpr FixedMatrix operator + (const FixedMatrix& other) const {
+        return add(other, std::make_index_sequence<kSize>());
+    }
+
+    constexpr FixedMatrix operator - (const FixedMatrix& other) const {
+        return subtract(other, std::make_index_sequence<kSize>());
+    }
+
+    constexpr FixedMatrix operator - () const {
+        return scale(T(-1), std::make_index_sequence<kSize>());
+    }
+
+    constexpr FixedMatrix operator * (const T& s) const {
+        return scale(s, std::make_index_sequence<kSize>());
+    }
+
+    friend constexpr FixedMatrix operator * (const T& s, const FixedMatrix& m) {
+        return m * s;
+    }
+
+    constexpr FixedMatrix operator / (const T& s) const {
+        return divide(s, std::make_index_sequence<kSize>());
+    }
+
+    template <std::size_t C2>
+    constexpr FixedMatrix<T, R, C2> operator * (const FixedMatrix<T, C, C2>& other) const {
+        return multiply(other, std::make_index_sequence<R * C2>());
+    }
+
+    constexpr FixedMatrix& operator += (const FixedMatrix& other) { return *this = *this + other; }
+    constexpr FixedMatrix& operator -= (const FixedMatrix& other) { return *this = *this - other; }
+    constexpr FixedMatrix& operator *= (const T& s) { return *this = *this * s; }
+
+    constexpr bool operator == (const FixedMatrix& other) const {
+        for(std::size_t i = 0; i < kSize; ++i) {
+            if(!(m_data[i] == other.m_data[i])) return false;
+        }
+        return true;
+    }
+
+    constexpr bool operator != (const FixedMatrix& other) const { return !(*this == other); }
+
+    constexpr FixedMatrix<T, C, R> transposed() const {
+        return transpose(std::make_index_sequence<kSize>());
+    }
+
+    constexpr T trace() const {
+        static_assert(R == C, "Trace is defined for square matrices");
+        T result = T();
+        for(std::size_t i = 0; i < R; ++i) result += m_data[i * C + i];
+        return result;
+    }
+
+    constexpr T determinant() const {
+        static_assert(R == C, "Determinant is defined for square matrices");
+        return detail::FixedSquare<T, R>::determinant(*this);
+    }
+
+    /** Inverse of a non-singular matrix. */
+    constexpr FixedMatrix inverse() const {
+        static_assert(R == C, "Inverse is defined for square matrices");
+        return detail::FixedSquare<T, R>::inverse(*this);
+    }
+
+private:
+    template <std::size_t... I>
+    constexpr FixedMatrix(ValuesTag, const T& val, std::index_sequence<I...>): m_data{((void)I, val)...} {}
+
+    template <std::size_t... I>
+    constexpr FixedMatrix(ValuesTag, T const (& arr) [R][C], std::index_sequence<I...>): m_data{arr[I / C][I % C]...} {}
+
+    template <typename... Ts>
+    constexpr FixedMatrix(ValuesTag, std::true_type, const Ts&... values): m_data{values...} {}
+
+    template <std::size_t... I>
+    constexpr FixedMatrix add(const FixedMatrix& o, std::index_sequence<I...>) const {
+        return FixedMatrix(ValuesTag(), std::true_type(), T(m_data[I] + o.m_data[I])...);
+    }
+
+    template <std::size_t... I>
+    constexpr FixedMatrix subtract(const FixedMatrix& o, std::index_sequence<I...>) const {
+        return FixedMatrix(ValuesTag(), std::true_type(), T(m_data[I] - o.m_data[I])...);
+    }
+
+    template <std::size_t... I>
+    constexpr FixedMatrix scale(const T& s, std::index_sequence<I...>) const {
+        return FixedMatrix(ValuesTag(), std::true_type(), T(m_data[I] * s)...);
+    }
+
+    template <std::size_t... I>
+    constexpr FixedMatrix divide(const T& s, std::index_sequence<I...>) const {
+        return FixedMatrix(ValuesTag(), std::true_type(), T(m_data[I] / s)...);
+    }
+
+    template <std::size_t... I>
+    constexpr FixedMatrix<T, C, R> transpose(std::index_sequence<I...>) const {
+        return FixedMatrix<T, C, R>(typename FixedMatrix<T, C, R>::ValuesTag(), std::true_type(), m_data[(I % R) * C + I / R]...);
+    }
+
+    template <std::size_t C2, std::size_t... K>
+    constexpr T dot(const FixedMatrix<T, C, C2>& other, std::size_t row, std::size_t column, std::index_sequence<K...>) const {
+        return detail::fixedSum<T>(T(m_data[row * C + K] * other.m_data[K * C2 + column])...);
+    }
+
+    template <std::size_t C2, std::size_t... I>
+    constexpr FixedMatrix<T, R, C2> multiply(const FixedMatrix<T, C, C2>& other, std::index_sequence<I...>) const {
+        return FixedMatrix<T, R, C2>(typename FixedMatrix<T, R, C2>::ValuesTag(), std::true_type(),
+                                     dot(other, I / C2, I % C2, std::make_index_sequence<C>())...);
+    }
+
+    alignas(detail::fixedAlignment(sizeof(T) * R * C, alignof(T))) T m_data[R * C] {};
+};
+
+template <typename T> using FixedMatrix2 = FixedMatrix<T, 2, 2>;
+template <typename T> using FixedMatrix3 = FixedMatrix<T, 3, 3>;
+template <typename T> using FixedMatrix4 = FixedMatrix<T, 4, 4>;
+
+namespace detail {
+
+/** Gaussian elimination with partial pivoting for sizes without a closed form. */
+template <typename T, std::size_t N>
+struct FixedSquare {
+    typedef FixedMatrix<T, N, N> M;
+
+    static constexpr T determinant(const M& m) {
+        M a = m;
+        T det = T(1);
+        for(std::size_t k = 0; k < N; ++k) {
+            std::size_t pivot = k;
+            for(std::size_t i = k + 1; i < N; ++i) {
+                if(fixedAbs(a[MatrixPoint{i, k}]) > fixedAbs(a[MatrixPoint{pivot, k}])) pivot = i;
+            }
+            if(a[MatrixPoint{pivot, k}] == T(0)) return T(0);
+            if(pivot != k) {
+                for(std::size_t j = 0; j < N; ++j) {
+                    const T t = a[MatrixPoint{k, j}];
+                    a[MatrixPoint{k, j}] = a[MatrixPoint{pivot, j}];
+                    a[MatrixPoint{pivot, j}] = t;
+                }
+                det = -det;
+            }
+            det *= a[MatrixPoint{k, k}];
+            for(std::size_t i = k + 1; i < N; ++i) {
+                const T f = a[MatrixPoint{i, k}] / a[MatrixPoint{k, k}];
+                for(std::size_t j = k; j < N; ++j) a[MatrixPoint{i, j}] -= f * a[MatrixPoint{k, j}];
+            }
+        }
+        return det;
+    }
+
+    static constexpr M inverse(const M& m) {
+        M a = m;
+        M inv = M::identity();
+        for(std::size_t k = 0; k < N; ++k) {
+            std::size_t pivot = k;
+            for(std::size_t i = k + 1; i < N; ++i) {
+                if(fixedAbs(a[MatrixPoint{i, k}]) > fixedAbs(a[MatrixPoint{pivot, k}])) pivot = i;
+            }
+            assert(!(a[MatrixPoint{pivot, k}] == T(0)));
+            for(std::size_t j = 0; j < N; ++j) {
+                T t = a[MatrixPoint{k, j}]; a[MatrixPoint{k, j}] = a[MatrixPoint{pivot, j}]; a[MatrixPoint{pivot, j}] = t;
+                t = inv[MatrixPoint{k, j}]; inv[MatrixPoint{k, j}] = inv[MatrixPoint{pivot, j}]; inv[MatrixPoint{pivot, j}] = t;
+            }
+            const T d = a[MatrixPoint{k, k}];
+            for(std::size_t j = 0; j < N; ++j) {
+                a[MatrixPoint{k, j}] /= d;
+                inv[MatrixPoint{k, j}] /= d;
+            }
+            for(std::size_t i = 0; i < N; ++i) {
+                if(i == k) continue;
+                const T f = a[MatrixPoint{i, k}];
+                for(std::size_t j = 0; j < N; ++j) {
+                    a[MatrixPoint{i, j}] -= f * a[MatrixPoint{k, j}];
+                    inv[MatrixPoint{i, j}] -= f * inv[MatrixPoint{k, j}];
+                }
+            }
+        }
+        return inv;
+    }
+};
+
+template <typename T>
+struct FixedSquare<T, 1> {
+    typedef FixedMatrix<T, 1, 1> M;
+    static constexpr T determinant(const M& m) { return m[0]; }
+    static constexpr M inverse(const M& m) {
+        assert(!(m[0] == T(0)));
+        return M{T(1) / m[0]};
+    }
+};
+
+template <typename T>
+struct FixedSquare<T, 2> {
+    typedef FixedMatrix<T, 2, 2> M;
+    static constexpr T determinant(const M& m) { return m[0] * m[3] - m[1] * m[2]; }
+    static constexpr M inverse(const M& m) {
+        const T det = determinant(m);
+        assert(!(det == T(0)));
+        return M{m[3] / det, -m[1] / det, -m[2] / det, m[0] / det};
+    }
+};
+
+template <typename T>
+struct FixedSquare<T, 3> {
+    typedef FixedMatrix<T, 3, 3> M;
+    static constexpr T determinant(const M& m) {
+        return m[0] * (m[4] * m[8] - m[5] * m[7])
+             - m[1] * (m[3] * m[8] - m[5] * m[6])
+             + m[2] * (m[3] * m[7] - m[4] * m[6]);
+    }
+    static constexpr M inverse(const M& m) {
+        const T c00 = m[4] * m[8] - m[5] * m[7];
+        const T c01 = m[5] * m[6] - m[3] * m[8];
+        const T c02 = m[3] * m[7] - m[4] * m[6];
+        const T det = m[0] * c00 + m[1] * c01 + m[2] * c02;
+        assert(!(det == T(0)));
+        const T inv = T(1) / det;
+        return M{
+            c00 * inv, (m[2] * m[7] - m[1] * m[8]) * inv, (m[1] * m[5] - m[2] * m[4]) * inv,
+            c01 * inv, (m[0] * m[8] - m[2] * m[6]) * inv, (m[2] * m[3] - m[0] * m[5]) * inv,
+            c02 * inv, (m[1] * m[6] - m[0] * m[7]) * inv, (m[0] * m[4] - m[1] * m[3]) * inv
+        };
+    }
+};
+
+/** 4x4 through the 2x2 sub-determinants of the upper (s) and lower (c) row pairs. */
+template <typename T>
+struct FixedSquare<T, 4> {
+    typedef FixedMatrix<T, 4, 4> M;
+
+    struct Minors {
+        T s0, s1, s2, s3, s4, s5;
+        T c0, c1, c2, c3, c4, c5;
+    };
+
+    static constexpr Minors minors(const M& m) {
+        return Minors{
+            m[0] * m[5] - m[4] * m[1],
+            m[0] * m[6] - m[4] * m[2],
+            m[0] * m[7] - m[4] * m[3],
+            m[1] * m[6] - m[5] * m[2],
+            m[1] * m[7] - m[5] * m[3],
+            m[2] * m[7] - m[6] * m[3],
+            m[8] * m[13] - m[12] * m[9],
+            m[8] * m[14] - m[12] * m[10],
+            m[8] * m[15] - m[12] * m[11],
+            m[9] * m[14] - m[13] * m[10],
+            m[9] * m[15] - m[13] * m[11],
+            m[10] * m[15] - m[14] * m[11]
+        };
+    }
+
+    static constexpr T determinant(const Minors& k) {
+        return k.s0 * k.c5 - k.s1 * k.c4 + k.s2 * k.c3 + k.s3 * k.c2 - k.s4 * k.c1 + k.s5 * k.c0;
+    }
+
+    static constexpr T determinant(const M& m) { return determinant(minors(m)); }
+
+    static constexpr M inverse(const M& m) {
+        const Minors k = minors(m);
+        const T det = determinant(k);
+        assert(!(det == T(0)));
+        const T inv = T(1) / det;
+        return M{
+            ( m[5] * k.c5 - m[6] * k.c4 + m[7] * k.c3) * inv,
+            (-m[1] * k.c5 + m[2] * k.c4 - m[3] * k.c3) * inv,
+            ( m[13] * k.s5 - m[14] * k.s4 + m[15] * k.s3) * inv,
+            (-m[9] * k.s5 + m[10] * k.s4 - m[11] * k.s3) * inv,
+
+            (-m[4] * k.c5 + m[6] * k.c2 - m[7] * k.c1) * inv,
+            ( m[0] * k.c5 - m[2] * k.c2 + m[3] * k.c1) * inv,
+            (-m[12] * k.s5 + m[14] * k.s2 - m[15] * k.s1) * inv,
+            ( m[8] * k.s5 - m[10] * k.s2 + m[11] * k.s1) * inv,
+
+            ( m[4] * k.c4 - m[5] * k.c2 + m[7] * k.c0) * inv,
+            (-m[0] * k.c4 + m[1] * k.c2 - m[3] * k.c0) * inv,
+            ( m[12] * k.s4 - m[13] * k.s2 + m[15] * k.s0) * inv,
+            (-m[8] * k.s4 + m[9] * k.s2 - m[11] * k.s0) * inv,
+
+            (-m[4] * k.c3 + m[5] * k.c1 - m[6] * k.c0) * inv,
+            ( m[0] * k.c3 - m[1] * k.c1 + m[2] * k.c0) * inv,
+            (-m[12] * k.s3 + m[13] * k.s1 - m[14] * k.s0) * inv,
+            ( m[8] * k.s3 - m[9] * k.s1 + m[10] * k.s0) * inv
+        };
+    }
+};
+
+} // namespace detail
+
+} //namespace matrix
+} //namespace cppmath
+
+#endif /* cppmath_fixed_matrix_hpp */
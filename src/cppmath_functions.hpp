@@ -11,6 +11,8 @@
 #include <stdio.h>
 #include <cstddef>
 
+#include "cppmath_combinatorics.hpp"
+
 namespace cppmath {
 namespace functions {
     
@@ -26,10 +28,15 @@ namespace functions {
             return 1;
     }
     
+    /** Number of monotone paths through an m x n lattice, (m + n)! / (m! n!).
+        Throws std::overflow_error when the count does not fit 64 bits, see
+        cppmath_combinatorics.hpp for modular and arbitrary precision counts.
+     */
     template<typename T, typename R = size_t>
-    constexpr R matrixCountPaths(T m, T n) noexcept
+    constexpr R matrixCountPaths(T m, T n)
     {
-        return factorial<T, R>(m + n)/(factorial<T, R>(m) + factorial<T, R>(n));
+        return static_cast<R>(combinatorics::binomial(static_cast<std::uint64_t>(m) + static_cast<std::uint64_t>(n),
+                                                      static_cast<std::uint64_t>(m)));
     }
 } // namespace functions
 } // namespace cppmath
@@ -0,0 +1,113 @@
+//
+//  cppmath_gemm.cpp
+//  CppMath
+//
+//  Created by Dmytro Krasnianskyi on 17.10.26.
+//  Copyright © 2026 Dmytro Krasnianskyi. All rights reserved.
+//
+
+#include "cppmath_gemm.hpp"
+#include "cppmath_simd.hpp"
+
+namespace cppmath{
+namespace matrix{
+namespace detail {
+
+namespace {
+
+#if CPPMATH_X86_DISPATCH
+
+using namespace simd;
+
+/** MR x (NV * width) register tile: one broadcast of A times NV vectors of B
+    per row and per k step. The body is the same for every level, only the
+    target attribute differs.
+ */
+#define CPPMATH_GEMM_MICRO_KERNEL_BODY                                      \
+    typedef typename V::Vec Vec;                                            \
+    const std::size_t NR = NV * V::width;                                   \
+    Vec acc[MR][NV];                                                        \
+    _Pragma("GCC unroll 16")                                                \
+    for(std::size_t i = 0; i < MR; ++i) {                                   \
+        _Pragma("GCC unroll 4")                                             \
+        for(std::size_t v = 0; v < NV; ++v) acc[i][v] = V::zero();          \
+    }                                                                       \
+    for(std::size_t p = 0; p < kc; ++p, a += MR, b += NR) {                 \
+        Vec bv[NV];                                                         \
+        _Pragma("GCC unroll 4")                                             \
+        for(std::size_t v = 0; v < NV; ++v) bv[v] = V::load(b + v * V::width); \
+        _Pragma("GCC unroll 16")                                            \
+        for(std::size_t i = 0; i < MR; ++i) {                               \
+            const Vec ai = V::broadcast(a + i);                             \
+            _Pragma("GCC unroll 4")                                         \
+            for(std::size_t v = 0; v < NV; ++v) acc[i][v] = V::fma(ai, bv[v], acc[i][v]); \
+        }                                                                   \
+    }                                                                       \
+    _Pragma("GCC unroll 16")                                                \
+    for(std::size_t i = 0; i < MR; ++i) {                                   \
+        _Pragma("GCC unroll 4")                                             \
+        for(std::size_t v = 0; v < NV; ++v) V::store(ab + i * NR + v * V::width, acc[i][v]); \
+    }
+
+template <class V, std::size_t MR, std::size_t NV, typename T>
+CPPMATH_SSE2
+void sse2MicroKernel(std::size_t kc, const T* a, const T* b, T* ab) {
+    CPPMATH_GEMM_MICRO_KERNEL_BODY
+}
+
+template <class V, std::size_t MR, std::size_t NV, typename T>
+CPPMATH_AVX2
+void avx2MicroKernel(std::size_t kc, const T* a, const T* b, T* ab) {
+    CPPMATH_GEMM_MICRO_KERNEL_BODY
+}
+
+template <class V, std::size_t MR, std::size_t NV, typename T>
+CPPMATH_AVX512
+void avx512MicroKernel(std::size_t kc, const T* a, const T* b, T* ab) {
+    CPPMATH_GEMM_MICRO_KERNEL_BODY
+}
+
+#undef CPPMATH_GEMM_MICRO_KERNEL_BODY
+
+#endif // CPPMATH_X86_DISPATCH
+
+template <typename T>
+GemmKernel<T> makeKernel(std::size_t mr, std::size_t nr, typename GemmKernel<T>::MicroKernel kernel) {
+    GemmKernel<T> k;
+    k.mr = mr;
+    k.nr = nr;
+    k.kernel = kernel;
+    return k;
+}
+
+} // namespace
+
+template <> GemmKernel<float> gemmKernel<float>(cpu::InstructionSet isa) {
+#if CPPMATH_X86_DISPATCH
+    switch(isa) {
+        case cpu::InstructionSet::AVX512: return makeKernel<float>(12, 32, &avx512MicroKernel<Avx512Float, 12, 2, float>);
+        case cpu::InstructionSet::AVX2: return makeKernel<float>(6, 16, &avx2MicroKernel<Avx2Float, 6, 2, float>);
+        case cpu::InstructionSet::SSE2: return makeKernel<float>(4, 8, &sse2MicroKernel<Sse2Float, 4, 2, float>);
+        default: break;
+    }
+#endif
+    (void)isa;
+    return makeKernel<float>(4, 4, &gemmGenericMicroKernel<float, 4, 4>);
+}
+
+template <> GemmKernel<double> gemmKernel<double>(cpu::InstructionSet isa) {
+#if CPPMATH_X86_DISPATCH
+    switch(isa) {
+        case cpu::InstructionSet::AVX512: return makeKernel<double>(12, 16, &avx512MicroKernel<Avx512Double, 12, 2, double>);
+        case cpu::InstructionSet::AVX2: return makeKernel<double>(6, 8, &avx2MicroKernel<Avx2Double, 6, 2, double>);
+        case cpu::InstructionSet::SSE2: return makeKernel<double>(4, 4, &sse2MicroKernel<Sse2Double, 4, 2, double>);
+        default: break;
+    }
+#endif
+    (void)isa;
+    return makeKernel<double>(4, 4, &gemmGenericMicroKernel<double, 4, 4>);
+}
+
+} // namespace detail
+} //namespace matrix
+} //namespace cppmath
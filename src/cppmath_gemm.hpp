@@ -0,0 +1,436 @@
+//
+//  cppmath_gemm.hpp
+//  CppMath
+//
+//  Created by Dmytro Krasnianskyi on 17.10.26.
+//  Copyright © 2026 Dmytro Krasnianskyi. All rights reserved.
+//
+
+#ifndef cppmath_gemm_hpp
+#define cppmath_gemm_hpp
+
+#include <cstddef>
+#include <cassert>
+#include <vector>
+#include <utility>
+#include <algorithm>
+#include <type_traits>
+
+#include "cppmath_cpu.hpp"
+#include "cppmath_matrix.hpp"
+#include "cppmath_parallel.hpp"
+
+/** General matrix multiply C = alpha * A * B + beta * C.
+
+    The driver follows the usual three level blocking scheme:
+    - B is packed in KC x NC panels that stay in L3,
+    - A is packed in MC x KC blocks that stay in L2,
+    - the MR x NR micro-kernel streams one A and one B micro-panel from L1
+      and keeps the C tile in registers.
+    For float and double the micro-kernels are SIMD code selected once at
+    runtime, every other type uses the portable micro-kernel below.
+ */
+
+namespace cppmath {
+namespace matrix{
+namespace detail {
+
+template <typename T>
+struct GemmKernel {
+    /** Computes the raw MR x NR product of packed micro-panels over kc and
+        stores it row-major (leading dimension NR) into ab.
+     */
+    typedef void (*MicroKernel)(std::size_t kc, const T* a, const T* b, T* ab);
+
+    std::size_t mr = 0;
+    std::size_t nr = 0;
+    MicroKernel kernel = nullptr;
+};
+
+struct GemmBlocking {
+    std::size_t mc = 0;
+    std::size_t kc = 0;
+    std::size_t nc = 0;
+};
+
+template <typename T, std::size_t MR, std::size_t NR>
+void gemmGenericMicroKernel(std::size_t kc, const T* a, const T* b, T* ab) {
+    T acc[MR][NR];
+    for(std::size_t i = 0; i < MR; ++i)
+        for(std::size_t j = 0; j < NR; ++j)
+            acc[i][j] = T();
+
+    for(std::size_t p = 0; p < kc; ++p, a += MR, b += NR) {
+        for(std::size_t i = 0; i < MR; ++i) {
+            const T ai = a[i];
+            for(std::size_t j = 0; j < NR; ++j)
+                acc[i][j] += ai * b[j];
+        }
+    }
+
+    for(std::size_t i = 0; i < MR; ++i)
+        for(std::size_t j = 0; j < NR; ++j)
+            ab[i * NR + j] = acc[i][j];
+}
+
+/** Micro-kernel for the given instruction set level. The generic template
+    ignores the level, float and double have SIMD specializations.
+ */
+template <typename T>
+inline GemmKernel<T> gemmKernel(cpu::InstructionSet) {
+    GemmKernel<T> k;
+    k.mr = 4;
+    k.nr = 4;
+    k.kernel = &gemmGenericMicroKernel<T, 4, 4>;
+    return k;
+}
+
+template <> GemmKernel<float> gemmKernel<float>(cpu::InstructionSet isa);
+template <> GemmKernel<double> gemmKernel<double>(cpu::InstructionSet isa);
+
+/** Micro-kernel for the running CPU, selected on the first use. */
+template <typename T>
+inline const GemmKernel<T>& activeGemmKernel() {
+    static const GemmKernel<T> kernel = gemmKernel<T>(cpu::instructionSet());
+    return kernel;
+}
+
+inline std::size_t roundDown(std::size_t value, std::size_t multiple) {
+    return std::max(multiple, value / multiple * multiple);
+}
+
+/** Derives the block sizes from the cache sizes: one NR x KC micro-panel of B
+    takes half of L1, an MC x KC block of A half of L2 and the KC x NC panel
+    of B half of L3.
+ */
+template <typename T>
+GemmBlocking gemmBlocking(std::size_t mr, std::size_t nr) {
+    const cpu::CacheSizes& caches = cpu::cacheSizes();
+    GemmBlocking blocking;
+    blocking.kc = std::min<std::size_t>(512, roundDown(caches.l1 / 2 / (nr * sizeof(T)), 8));
+    blocking.kc = std::max<std::size_t>(blocking.kc, 64);
+    blocking.mc = std::min<std::size_t>(1024, roundDown(caches.l2 / 2 / (blocking.kc * sizeof(T)), mr));
+    blocking.nc = std::min<std::size_t>(8192, roundDown(caches.l3 / 2 / (blocking.kc * sizeof(T)), nr));
+    return blocking;
+}
+
+template <typename T>
+struct GemmBuffer {
+    std::vector<T> data;
+    bool busy = false;
+};
+
+template <typename T>
+struct GemmWorkspace {
+    GemmBuffer<T> packedA;
+    GemmBuffer<T> packedB;
+    GemmBuffer<T> strassen;
+};
+
+/** Packing buffers are kept per thread and only grow, so repeated calls do
+    not touch the heap.
+ */
+template <typename T>
+inline GemmWorkspace<T>& gemmWorkspace() {
+    static thread_local GemmWorkspace<T> workspace;
+    return workspace;
+}
+
+/** Borrows a packing buffer of the calling thread. A thread waiting for
+    parallel tasks may run a nested product while its buffer is in use, that
+    product gets a private one.
+ */
+template <typename T>
+class GemmBufferLease {
+public:
+    explicit GemmBufferLease(GemmBuffer<T>& shared): m_buffer(shared.busy ? &m_own : &shared) {
+        m_buffer->busy = true;
+    }
+
+    ~GemmBufferLease() { m_buffer->busy = false; }
+
+    GemmBufferLease(const GemmBufferLease&) = delete;
+    GemmBufferLease& operator = (const GemmBufferLease&) = delete;
+
+    inline T* data(std::size_t size) {
+        if(m_buffer->data.size() < size) m_buffer->data.resize(size);
+        return m_buffer->data.data();
+    }
+
+private:
+    GemmBuffer<T> m_own;
+    GemmBuffer<T>* m_buffer;
+};
+
+/** Scratch for one mr x nr micro-kernel result. Trivial element types keep
+    it on the stack, others borrow gemmTileSize() extra elements past the
+    packed A block so that no objects are constructed per macro-kernel call.
+ */
+template <typename T, bool = std::is_trivially_default_constructible<T>::value>
+struct GemmTile {
+    static constexpr std::size_t kCapacity = 32 * 32;
+    T data[kCapacity];
+    inline T* get(T* /*scratch*/, std::size_t size) noexcept {
+        assert(size <= kCapacity);
+        (void)size;
+        return data;
+    }
+};
+
+template <typename T>
+struct GemmTile<T, false> {
+    inline T* get(T* scratch, std::size_t /*size*/) noexcept { return scratch; }
+};
+
+template <typename T>
+constexpr std::size_t gemmTileSize(std::size_t mr, std::size_t nr) {
+    return std::is_trivially_default_constructible<T>::value ? 0 : mr * nr;
+}
+
+/** Below this many multiply-adds a product stays on the calling thread. */
+constexpr std::size_t kGemmParallelWork = std::size_t(1) << 21;
+
+/** Packs an mb x kb block of A into micro-panels of mr rows, p-major inside
+    each panel. Rows past mb are zero padded.
+ */
+template <typename T>
+void gemmPackA(std::size_t mb, std::size_t kb, const T* a, std::ptrdiff_t rsA, std::ptrdiff_t csA,
+               std::size_t mr, T* dst) {
+    for(std::size_t ir = 0; ir < mb; ir += mr) {
+        const std::size_t rows = std::min(mr, mb - ir);
+        const T* panel = a + static_cast<std::ptrdiff_t>(ir) * rsA;
+        for(std::size_t p = 0; p < kb; ++p) {
+            const T* src = panel + static_cast<std::ptrdiff_t>(p) * csA;
+            std::size_t i = 0;
+            for(; i < rows; ++i) *dst++ = src[static_cast<std::ptrdiff_t>(i) * rsA];
+            for(; i < mr; ++i) *dst++ = T();
+        }
+    }
+}
+
+/** Packs a kb x nb panel of B into micro-panels of nr columns, p-major inside
+    each panel. Columns past nb are zero padded.
+ */
+template <typename T>
+void gemmPackB(std::size_t kb, std::size_t nb, const T* b, std::ptrdiff_t rsB, std::ptrdiff_t csB,
+               std::size_t nr, T* dst) {
+    for(std::size_t jr = 0; jr < nb; jr += nr) {
+        const std::size_t columns = std::min(nr, nb - jr);
+        const T* panel = b + static_cast<std::ptrdiff_t>(jr) * csB;
+        for(std::size_t p = 0; p < kb; ++p) {
+            const T* src = panel + static_cast<std::ptrdiff_t>(p) * rsB;
+            std::size_t j = 0;
+            if(csB == 1) {
+                for(; j < columns; ++j) *dst++ = src[j];
+            } else {
+                for(; j < columns; ++j) *dst++ = src[static_cast<std::ptrdiff_t>(j) * csB];
+            }
+            for(; j < nr; ++j) *dst++ = T();
+        }
+    }
+}
+
+template <typename T>
+void gemmScale(std::size_t m, std::size_t n, const T& beta, T* c, std::ptrdiff_t rsC, std::ptrdiff_t csC) {
+    for(std::size_t i = 0; i < m; ++i) {
+        T* row = c + static_cast<std::ptrdiff_t>(i) * rsC;
+        for(std::size_t j = 0; j < n; ++j) {
+            T& value = row[static_cast<std::ptrdiff_t>(j) * csC];
+            value = beta == T(0) ? T() : beta * value;
+        }
+    }
+}
+
+/** Multiplies packed mb x kb block of A by packed kb x nb panel of B and
+    merges the result into C. scratch holds gemmTileSize() elements.
+ */
+template <typename T>
+void gemmMacroKernel(std::size_t mb, std::size_t nb, std::size_t kb, const T& alpha,
+                     const T* packedA, const T* packedB, const T& beta,
+                     T* c, std::ptrdiff_t rsC, std::ptrdiff_t csC, const GemmKernel<T>& kernel,
+                     T* scratch) {
+    const std::size_t mr = kernel.mr;
+    const std::size_t nr = kernel.nr;
+    GemmTile<T> edge;
+    T* tile = edge.get(scratch, mr * nr);
+
+    for(std::size_t jr = 0; jr < nb; jr += nr) {
+        const std::size_t columns = std::min(nr, nb - jr);
+        const T* b = packedB + jr * kb;
+        for(std::size_t ir = 0; ir < mb; ir += mr) {
+            const std::size_t rows = std::min(mr, mb - ir);
+            kernel.kernel(kb, packedA + ir * kb, b, tile);
+
+            T* cTile = c + static_cast<std::ptrdiff_t>(ir) * rsC + static_cast<std::ptrdiff_t>(jr) * csC;
+            for(std::size_t i = 0; i < rows; ++i) {
+                T* cRow = cTile + static_cast<std::ptrdiff_t>(i) * rsC;
+                const T* abRow = tile + i * nr;
+                if(beta == T(0)) {
+                    for(std::size_t j = 0; j < columns; ++j)
+                        cRow[static_cast<std::ptrdiff_t>(j) * csC] = alpha * abRow[j];
+                } else {
+                    for(std::size_t j = 0; j < columns; ++j) {
+                        T& value = cRow[static_cast<std::ptrdiff_t>(j) * csC];
+                        value = alpha * abRow[j] + beta * value;
+                    }
+                }
+            }
+        }
+    }
+}
+
+/** Strided GEMM on raw storage: element (i, j) of X lives at x[i * rsX + j * csX].
+    C must not alias A or B.
+ */
+template <typename T>
+void gemm(std::size_t m, std::size_t n, std::size_t k, const T& alpha,
+          const T* a, std::ptrdiff_t rsA, std::ptrdiff_t csA,
+          const T* b, std::ptrdiff_t rsB, std::ptrdiff_t csB,
+          const T& beta, T* c, std::ptrdiff_t rsC, std::ptrdiff_t csC,
+          const GemmKernel<T>& kernel = activeGemmKernel<T>(),
+          const execution::ExecutionPolicy& policy = execution::seq) {
+    if(m == 0 || n == 0) return;
+    if(k == 0 || alpha == T(0)) {
+        if(!(beta == T(1))) gemmScale(m, n, beta, c, rsC, csC);
+        return;
+    }
+
+    const GemmBlocking blocking = gemmBlocking<T>(kernel.mr, kernel.nr);
+    const std::size_t mr = kernel.mr;
+    const std::size_t nr = kernel.nr;
+
+    const std::size_t packedASize = (std::min(blocking.mc, m) + mr - 1) / mr * mr * std::min(blocking.kc, k);
+    const std::size_t packedBSize = (std::min(blocking.nc, n) + nr - 1) / nr * nr * std::min(blocking.kc, k);
+    const std::size_t tileSize = gemmTileSize<T>(mr, nr);
+    GemmBufferLease<T> leaseB(gemmWorkspace<T>().packedB);
+    T* packedB = leaseB.data(packedBSize);
+
+    const std::size_t mBlocks = (m - 1) / blocking.mc + 1;
+    const std::size_t threads = policy.isParallel() && m * n * k >= kGemmParallelWork ?
+                                execution::defaultPool().concurrency() : 1;
+
+    for(std::size_t jc = 0; jc < n; jc += blocking.nc) {
+        const std::size_t nb = std::min(blocking.nc, n - jc);
+        for(std::size_t pc = 0; pc < k; pc += blocking.kc) {
+            const std::size_t kb = std::min(blocking.kc, k - pc);
+            const T blockBeta = pc == 0 ? beta : T(1);
+            gemmPackB(kb, nb, b + static_cast<std::ptrdiff_t>(pc) * rsB + static_cast<std::ptrdiff_t>(jc) * csB,
+                      rsB, csB, nr, packedB);
+
+            if(threads <= 1) {
+                GemmBufferLease<T> leaseA(gemmWorkspace<T>().packedA);
+                T* packedA = leaseA.data(packedASize + tileSize);
+                for(std::size_t ic = 0; ic < m; ic += blocking.mc) {
+                    const std::size_t mb = std::min(blocking.mc, m - ic);
+                    gemmPackA(mb, kb, a + static_cast<std::ptrdiff_t>(ic) * rsA + static_cast<std::ptrdiff_t>(pc) * csA,
+                              rsA, csA, mr, packedA);
+                    gemmMacroKernel(mb, nb, kb, alpha, packedA, packedB, blockBeta,
+                                    c + static_cast<std::ptrdiff_t>(ic) * rsC + static_cast<std::ptrdiff_t>(jc) * csC,
+                                    rsC, csC, kernel, packedA + packedASize);
+                }
+                continue;
+            }
+
+            // Tasks are (A block, group of B micro-panels) pairs, ordered so
+            // that consecutive tasks of one range share the packed A block
+            const std::size_t panels = (nb - 1) / nr + 1;
+            const std::size_t groups = std::min(panels, std::max<std::size_t>(1, (2 * threads - 1) / mBlocks + 1));
+            execution::parallelFor(policy, 0, mBlocks * groups, 1, [&](std::size_t first, std::size_t last){
+                GemmBufferLease<T> leaseA(gemmWorkspace<T>().packedA);
+                T* packedA = leaseA.data(packedASize + tileSize);
+                std::size_t packed = mBlocks;
+                for(std::size_t task = first; task < last; ++task) {
+                    const std::size_t block = task / groups;
+                    const std::size_t group = task % groups;
+                    const std::size_t ic = block * blocking.mc;
+                    const std::size_t mb = std::min(blocking.mc, m - ic);
+                    const std::size_t j0 = panels * group / groups * nr;
+                    const std::size_t j1 = std::min(nb, panels * (group + 1) / groups * nr);
+                    if(j0 >= j1) continue;
+                    if(packed != block) {
+                        gemmPackA(mb, kb, a + static_cast<std::ptrdiff_t>(ic) * rsA + static_cast<std::ptrdiff_t>(pc) * csA,
+                                  rsA, csA, mr, packedA);
+                        packed = block;
+                    }
+                    gemmMacroKernel(mb, j1 - j0, kb, alpha, packedA, packedB + j0 * kb, blockBeta,
+                                    c + static_cast<std::ptrdiff_t>(ic) * rsC + static_cast<std::ptrdiff_t>(jc + j0) * csC,
+                                    rsC, csC, kernel, packedA + packedASize);
+                }
+            });
+        }
+    }
+}
+
+} // namespace detail
+
+template <class A, class B, class C>
+using EnableIfGemmOperands = typename std::enable_if<IsMatrixLike<A>::value && IsMatrixLike<B>::value && IsMatrixLike<C>::value>::type;
+
+/** C = alpha * A * B + beta * C for matrices and views in any combination.
+    C must already have A.rows() x B.columns() shape and must not overlap the
+    operands. Without a policy large products run in parallel.
+ */
+template <class A, class B, class C>
+EnableIfGemmOperands<A, B, C> gemm(const execution::ExecutionPolicy& policy,
+                                   const typename MatrixValueType<C>::type& alpha, const A& a, const B& b,
+                                   const typename MatrixValueType<C>::type& beta, C&& c) {
+    typedef typename MatrixValueType<C>::type T;
+    const ConstMatrixView<T> va = constView(a);
+    const ConstMatrixView<T> vb = constView(b);
+    const MatrixView<T> vc = mutableView(c);
+
+    assert(va.columns() == vb.rows());
+    assert(vc.rows() == va.rows() && vc.columns() == vb.columns());
+
+    const instrumentation::ScopedOperation counted(instrumentation::Operation::Gemm,
+                                                   2.0 * va.rows() * vb.columns() * va.columns());
+    detail::gemm(va.rows(), vb.columns(), va.columns(), alpha,
+                 va.data(), va.rowStride(), va.columnStride(),
+                 vb.data(), vb.rowStride(), vb.columnStride(),
+                 beta, vc.data(), vc.rowStride(), vc.columnStride(), detail::activeGemmKernel<T>(), policy);
+}
+
+template <class A, class B, class C>
+EnableIfGemmOperands<A, B, C> gemm(const typename MatrixValueType<C>::type& alpha, const A& a, const B& b,
+                                   const typename MatrixValueType<C>::type& beta, C&& c) {
+    gemm(execution::par, alpha, a, b, beta, std::forward<C>(c));
+}
+
+namespace detail {
+
+/** Result of a * b: a matrix with the allocator and layout of the left
+    operand, or a default row-major matrix when it is a view.
+ */
+template <class X, class = void>
+struct ProductMatrix {};
+
+template <class X>
+struct ProductMatrix<X, typename std::enable_if<IsMatrixView<X>::value>::type> {
+    typedef Matrix<typename MatrixValueType<X>::type> type;
+    static type make(const X&, std::size_t rows, std::size_t columns) { return type(rows, columns); }
+};
+
+template <typename T, class Allocator, class Layout>
+struct ProductMatrix<Matrix<T, Allocator, Layout>> {
+    typedef Matrix<T, Allocator, Layout> type;
+    static type make(const type& a, std::size_t rows, std::size_t columns) {
+        return type(rows, columns, a.get_allocator());
+    }
+};
+
+} // namespace detail
+
+template <class A, class B>
+typename std::enable_if<IsMatrixLike<A>::value && IsMatrixLike<B>::value, typename detail::ProductMatrix<A>::type>::type
+operator * (const A& a, const B& b) {
+    typedef typename MatrixValueType<A>::type T;
+    assert(a.columns() == b.rows());
+    typename detail::ProductMatrix<A>::type result = detail::ProductMatrix<A>::make(a, a.rows(), b.columns());
+    gemm(T(1), a, b, T(0), result);
+    return result;
+}
+
+} //namespace matrix
+} //namespace cppmath
+
+#endif /* cppmath_gemm_hpp */
@@ -0,0 +1,155 @@
+//
+//  cppmath_grid_paths.cpp
+//  CppMath
+//
+//  Created by Dmytro Krasnianskyi on 17.10.26.
+//  Copyright © 2026 Dmytro Krasnianskyi. All rights reserved.
+//
+
+#include "cppmath_grid_paths.hpp"
+#include "cppmath_simd.hpp"
+
+#include <cstring>
+
+namespace cppmath{
+namespace paths{
+namespace detail {
+
+namespace {
+
+template <typename T>
+void minCostTail(const T* costs, const unsigned char* open, T* row, std::size_t begin, std::size_t n, T left) {
+    const T unreachable = std::numeric_limits<T>::infinity();
+    for(std::size_t c = begin; c < n; ++c) {
+        const T best = std::min(left, row[c]);
+        left = open[c] ? best + costs[c] : unreachable;
+        row[c] = left;
+    }
+}
+
+#if CPPMATH_X86_DISPATCH
+
+/** Prefix scans of four double or eight float lanes. Lane c of a block
+    holds the step x -> min(x + D, B) of its cell, with D = cost and
+    B = above + cost, both infinite for blocked cells. Two steps compose to
+    a step of the same form, so after log2(width) rounds of composing every
+    lane with the lane shifted in from the left, lane c holds the steps of
+    cells 0..c and applying it to the carry of the previous block gives the
+    results.
+ */
+CPPMATH_AVX2 void avx2MinCostRowDouble(const double* costs, const unsigned char* open, double* row, std::size_t n) {
+    const __m256i zeroInt = _mm256_setzero_si256();
+    const __m256d zero = _mm256_setzero_pd();
+    const __m256d inf = _mm256_set1_pd(std::numeric_limits<double>::infinity());
+    __m256d carry = inf;
+    std::size_t c = 0;
+    for(; c + 4 <= n; c += 4) {
+        std::int32_t bytes;
+        std::memcpy(&bytes, open + c, sizeof(bytes));
+        const __m256d m = _mm256_castsi256_pd(_mm256_cmpgt_epi64(_mm256_cvtepu8_epi64(_mm_cvtsi32_si128(bytes)), zeroInt));
+        __m256d d = _mm256_blendv_pd(inf, _mm256_loadu_pd(costs + c), m);
+        __m256d b = _mm256_add_pd(_mm256_loadu_pd(row + c), d);
+
+        __m256d shiftedD = _mm256_blend_pd(_mm256_permute4x64_pd(d, 0x90), zero, 0x1);
+        __m256d shiftedB = _mm256_blend_pd(_mm256_permute4x64_pd(b, 0x90), inf, 0x1);
+        b = _mm256_min_pd(_mm256_add_pd(shiftedB, d), b);
+        d = _mm256_add_pd(shiftedD, d);
+
+        shiftedD = _mm256_blend_pd(_mm256_permute4x64_pd(d, 0x40), zero, 0x3);
+        shiftedB = _mm256_blend_pd(_mm256_permute4x64_pd(b, 0x40), inf, 0x3);
+        b = _mm256_min_pd(_mm256_add_pd(shiftedB, d), b);
+        d = _mm256_add_pd(shiftedD, d);
+
+        const __m256d x = _mm256_min_pd(_mm256_add_pd(carry, d), b);
+        _mm256_storeu_pd(row + c, x);
+        carry = _mm256_permute4x64_pd(x, 0xFF);
+    }
+    minCostTail(costs, open, row, c, n, _mm256_cvtsd_f64(carry));
+}
+
+CPPMATH_AVX2 void avx2MinCostRowFloat(const float* costs, const unsigned char* open, float* row, std::size_t n) {
+    const __m256i zeroInt = _mm256_setzero_si256();
+    const __m256 zero = _mm256_setzero_ps();
+    const __m256 inf = _mm256_set1_ps(std::numeric_limits<float>::infinity());
+    const __m256i shift1 = _mm256_setr_epi32(0, 0, 1, 2, 3, 4, 5, 6);
+    const __m256i shift2 = _mm256_setr_epi32(0, 0, 0, 1, 2, 3, 4, 5);
+    const __m256i shift4 = _mm256_setr_epi32(0, 0, 0, 0, 0, 1, 2, 3);
+    const __m256i last = _mm256_set1_epi32(7);
+    __m256 carry = inf;
+    std::size_t c = 0;
+    for(; c + 8 <= n; c += 8) {
+        const __m128i bytes = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(open + c));
+        const __m256 m = _mm256_castsi256_ps(_mm256_cmpgt_epi32(_mm256_cvtepu8_epi32(bytes), zeroInt));
+        __m256 d = _mm256_blendv_ps(inf, _mm256_loadu_ps(costs + c), m);
+        __m256 b = _mm256_add_ps(_mm256_loadu_ps(row + c), d);
+
+        __m256 shiftedD = _mm256_blend_ps(_mm256_permutevar8x32_ps(d, shift1), zero, 0x01);
+        __m256 shiftedB = _mm256_blend_ps(_mm256_permutevar8x32_ps(b, shift1), inf, 0x01);
+        b = _mm256_min_ps(_mm256_add_ps(shiftedB, d), b);
+        d = _mm256_add_ps(shiftedD, d);
+
+        shiftedD = _mm256_blend_ps(_mm256_permutevar8x32_ps(d, shift2), zero, 0x03);
+        shiftedB = _mm256_blend_ps(_mm256_permutevar8x32_ps(b, shift2), inf, 0x03);
+        b = _mm256_min_ps(_mm256_add_ps(shiftedB, d), b);
+        d = _mm256_add_ps(shiftedD, d);
+
+        shiftedD = _mm256_blend_ps(_mm256_permutevar8x32_ps(d, shift4), zero, 0x0F);
+        shiftedB = _mm256_blend_ps(_mm256_permutevar8x32_ps(b, shift4), inf, 0x0F);
+        b = _mm256_min_ps(_mm256_add_ps(shiftedB, d), b);
+        d = _mm256_add_ps(shiftedD, d);
+
+        const __m256 x = _mm256_min_ps(_mm256_add_ps(carry, d), b);
+        _mm256_storeu_ps(row + c, x);
+        carry = _mm256_permutevar8x32_ps(x, last);
+    }
+    minCostTail(costs, open, row, c, n, _mm256_cvtss_f32(carry));
+}
+
+#endif // CPPMATH_X86_DISPATCH
+
+} // namespace
+
+void countRow(const unsigned char* open, std::uint64_t* row, std::size_t n) {
+    std::uint64_t left = 0;
+    bool ok = true;
+    for(std::size_t c = 0; c < n; ++c) {
+        const std::uint64_t sum = left + row[c];
+        ok &= sum >= left || !open[c];
+        left = open[c] ? sum : 0;
+        row[c] = left;
+    }
+    if(!ok) throw std::overflow_error("paths: count does not fit the count type");
+}
+
+/** Two-lane scans gain nothing, SSE2 uses the scalar kernels and AVX-512
+    the AVX2 ones.
+ */
+template <> MinCostKernels<float> minCostKernels<float>(cpu::InstructionSet isa) {
+    MinCostKernels<float> k = genericMinCostKernels<float>();
+#if CPPMATH_X86_DISPATCH
+    switch(isa) {
+        case cpu::InstructionSet::AVX512:
+        case cpu::InstructionSet::AVX2: k.row = &avx2MinCostRowFloat; break;
+        default: break;
+    }
+#endif
+    (void)isa;
+    return k;
+}
+
+template <> MinCostKernels<double> minCostKernels<double>(cpu::InstructionSet isa) {
+    MinCostKernels<double> k = genericMinCostKernels<double>();
+#if CPPMATH_X86_DISPATCH
+    switch(isa) {
+        case cpu::InstructionSet::AVX512:
+        case cpu::InstructionSet::AVX2: k.row = &avx2MinCostRowDouble; break;
+        default: break;
+    }
+#endif
+    (void)isa;
+    return k;
+}
+
+} // namespace detail
+} //namespace paths
+} //namespace cppmath
@@ -0,0 +1,381 @@
+//
+//  cppmath_grid_paths.hpp
+//  CppMath
+//
+//  Created by Dmytro Krasnianskyi on 17.10.26.
+//  Copyright © 2026 Dmytro Krasnianskyi. All rights reserved.
+//
+
+#ifndef cppmath_grid_paths_hpp
+#define cppmath_grid_paths_hpp
+
+#include <cstddef>
+#include <cstdint>
+#include <cassert>
+#include <limits>
+#include <vector>
+#include <algorithm>
+#include <stdexcept>
+#include <type_traits>
+
+#include "cppmath_cpu.hpp"
+#include "cppmath_matrix.hpp"
+#include "cppmath_combinatorics.hpp"
+
+/** Monotone paths through grids of cells.
+
+    A path starts in the top left cell, steps right or down and ends in the
+    bottom right cell, never entering a blocked cell. PathCounter counts the
+    paths, MinCostPath finds the smallest sum of cell costs along one. Both
+    take the grid one row at a time and keep a single row of state, so the
+    memory is O(columns) whatever the number of rows and a grid can be
+    streamed from a file.
+
+    A row update is the scan x[c] = open[c] ? x[c - 1] + above[c] : 0 for
+    counts and x[c] = min(x[c - 1], above[c]) + cost[c] for costs. The
+    float and double cost scans run as SIMD prefix scans on AVX2: each
+    block of lanes is combined in log2(width) shift steps and joined to the
+    carry of the previous block. The count scan is one add per cell and
+    stays scalar, a vector scan of it was slower. Any count type with +=
+    works, so counts can be modular (combinatorics::ModularInt) or exact
+    (combinatorics::BigUnsigned). Integer counts throw std::overflow_error
+    instead of wrapping, and so do integer costs whose sum reaches the
+    maximum of the cost type, which marks unreachable cells.
+
+    Masks mark blocked cells with nonzero elements. The SIMD cost scan adds
+    the costs in a different order than the scalar one, floating point
+    results may differ in the last bits.
+ */
+
+namespace cppmath {
+namespace paths {
+
+namespace detail {
+
+template <typename T>
+struct MinCostKernels {
+    /** row holds the costs of the row above (infinity where unreachable)
+        and receives the costs of this row.
+     */
+    typedef void (*Row)(const T* costs, const unsigned char* open, T* row, std::size_t n);
+
+    Row row = nullptr;
+};
+
+template <typename T>
+void genericMinCostRow(const T* costs, const unsigned char* open, T* row, std::size_t n) {
+    const T unreachable = std::numeric_limits<T>::infinity();
+    T left = unreachable;
+    for(std::size_t c = 0; c < n; ++c) {
+        const T best = std::min(left, row[c]);
+        left = open[c] ? best + costs[c] : unreachable;
+        row[c] = left;
+    }
+}
+
+template <typename T>
+MinCostKernels<T> genericMinCostKernels() {
+    MinCostKernels<T> k;
+    k.row = &genericMinCostRow<T>;
+    return k;
+}
+
+template <typename T>
+inline MinCostKernels<T> minCostKernels(cpu::InstructionSet) {
+    return genericMinCostKernels<T>();
+}
+
+template <> MinCostKernels<float> minCostKernels<float>(cpu::InstructionSet isa);
+template <> MinCostKernels<double> minCostKernels<double>(cpu::InstructionSet isa);
+
+template <typename T>
+inline const MinCostKernels<T>& activeMinCostKernels() {
+    static const MinCostKernels<T> kernels = minCostKernels<T>(cpu::instructionSet());
+    return kernels;
+}
+
+/** Adds y to x, throwing for integers that would overflow. */
+template <typename Count>
+inline typename std::enable_if<std::is_integral<Count>::value>::type addCount(Count& x, const Count& y) {
+    if(y > std::numeric_limits<Count>::max() - x) throw std::overflow_error("paths: count does not fit the count type");
+    x += y;
+}
+
+template <typename Count>
+inline typename std::enable_if<!std::is_integral<Count>::value>::type addCount(Count& x, const Count& y) {
+    x += y;
+}
+
+/** One row of the count scan for any count type. */
+template <typename Count>
+void countRow(const unsigned char* open, Count* row, std::size_t n) {
+    for(std::size_t c = 0; c < n; ++c) {
+        if(!open[c]) {
+            row[c] = Count(0);
+        } else if(c != 0) {
+            addCount(row[c], row[c - 1]);
+        }
+    }
+}
+
+/** The uint64_t scan without a branch per cell, checked once per row. */
+void countRow(const unsigned char* open, std::uint64_t* row, std::size_t n);
+
+/** best + cost for integer costs, throwing when the sum leaves the range
+    below the unreachable marker.
+ */
+template <typename T>
+inline T addCost(T best, T cost) {
+    const bool overflow = cost > T(0) ? best >= static_cast<T>(std::numeric_limits<T>::max() - cost)
+                                      : best < static_cast<T>(std::numeric_limits<T>::min() - cost);
+    if(overflow) throw std::overflow_error("paths: cost does not fit the cost type");
+    return static_cast<T>(best + cost);
+}
+
+/** One row of the cost scan. Integers mark unreachable cells with their
+    maximum and use the scalar scan.
+ */
+template <typename T>
+typename std::enable_if<std::is_integral<T>::value>::type
+minCostRow(const T* costs, const unsigned char* open, T* row, std::size_t n) {
+    const T unreachable = std::numeric_limits<T>::max();
+    T left = unreachable;
+    for(std::size_t c = 0; c < n; ++c) {
+        const T best = std::min(left, row[c]);
+        left = open[c] && best != unreachable ? addCost(best, costs[c]) : unreachable;
+        row[c] = left;
+    }
+}
+
+template <typename T>
+typename std::enable_if<std::is_floating_point<T>::value>::type
+minCostRow(const T* costs, const unsigned char* open, T* row, std::size_t n) {
+    activeMinCostKernels<T>().row(costs, open, row, n);
+}
+
+/** open[c] = 1 for cells whose mask element is zero. */
+template <typename U>
+inline void openCells(const U* blocked, unsigned char* open, std::size_t n) {
+    for(std::size_t c = 0; c < n; ++c) open[c] = blocked[c] == U(0) ? 1 : 0;
+}
+
+/** Row r of a matrix or view with contiguous elements, copied to buffer
+    when the view is strided.
+ */
+template <typename T>
+inline const T* rowOf(const matrix::ConstMatrixView<T>& v, std::size_t r, std::vector<T>& buffer) {
+    if(v.hasContiguousRows()) return v.rowData(r);
+    buffer.resize(v.columns());
+    for(std::size_t c = 0; c < v.columns(); ++c) buffer[c] = v[matrix::MatrixPoint{r, c}];
+    return buffer.data();
+}
+
+} // namespace detail
+
+/** Counts the paths into every cell of the rows pushed so far. Count is any
+    type constructible from 0 and 1 with +=. Integer counts throw
+    std::overflow_error from pushRow() once a cell count does not fit.
+ */
+template <typename Count = std::uint64_t>
+class PathCounter {
+public:
+    typedef Count       value_type;
+
+    explicit PathCounter(std::size_t columns):
+        m_row(columns, Count(0)),
+        m_open(columns, 1)
+    {
+        reset();
+    }
+
+    /** Appends a row, blocked[c] != 0 marks a blocked cell. */
+    template <typename U>
+    void pushRow(const U* blocked) {
+        detail::openCells(blocked, m_open.data(), m_open.size());
+        update();
+    }
+
+    /** Appends a row without blocked cells. */
+    void pushOpenRow() {
+        std::fill(m_open.begin(), m_open.end(), 1);
+        update();
+    }
+
+    /** Starts a new grid of the same width. */
+    void reset() {
+        // A virtual row above the grid enters the first cell once
+        std::fill(m_row.begin(), m_row.end(), Count(0));
+        if(!m_row.empty()) m_row[0] = Count(1);
+        m_rows = 0;
+    }
+
+    inline std::size_t rows() const noexcept { return m_rows; }
+    inline std::size_t columns() const noexcept { return m_row.size(); }
+
+    /** Paths ending in each cell of the last row. */
+    inline const std::vector<Count>& row() const noexcept {
+        assert(m_rows != 0);
+        return m_row;
+    }
+
+    /** Paths ending in the last cell of the last row. */
+    inline Count count() const {
+        return m_rows != 0 && !m_row.empty() ? m_row.back() : Count(0);
+    }
+
+private:
+    void update() {
+        detail::countRow(m_open.data(), m_row.data(), m_row.size());
+        ++m_rows;
+    }
+
+    std::vector<Count> m_row;
+    std::vector<unsigned char> m_open;
+    std::size_t m_rows = 0;
+};
+
+/** Finds the cheapest path cost into every cell of the rows pushed so far.
+    The cost of a path is the sum of the costs of all its cells. Integer
+    costs throw std::overflow_error from pushRow() once a cheapest cost
+    reaches unreachable().
+ */
+template <typename T>
+class MinCostPath {
+public:
+    typedef T           value_type;
+
+    static_assert(std::is_arithmetic<T>::value, "costs must be arithmetic");
+
+    /** Cost of cells that no path reaches: infinity, or the maximum of
+        integer types.
+     */
+    static constexpr T unreachable() noexcept {
+        return std::numeric_limits<T>::has_infinity ? std::numeric_limits<T>::infinity() : std::numeric_limits<T>::max();
+    }
+
+    explicit MinCostPath(std::size_t columns):
+        m_row(columns),
+        m_open(columns, 1)
+    {
+        reset();
+    }
+
+    /** Appends a row of cell costs, blocked[c] != 0 marks a blocked cell. */
+    template <typename U>
+    void pushRow(const T* costs, const U* blocked) {
+        detail::openCells(blocked, m_open.data(), m_open.size());
+        update(costs);
+    }
+
+    /** Appends a row of cell costs without blocked cells. */
+    void pushRow(const T* costs) {
+        std::fill(m_open.begin(), m_open.end(), 1);
+        update(costs);
+    }
+
+    void reset() {
+        std::fill(m_row.begin(), m_row.end(), unreachable());
+        if(!m_row.empty()) m_row[0] = T(0);
+        m_rows = 0;
+    }
+
+    inline std::size_t rows() const noexcept { return m_rows; }
+    inline std::size_t columns() const noexcept { return m_row.size(); }
+
+    /** Cheapest costs into each cell of the last row. */
+    inline const std::vector<T>& row() const noexcept {
+        assert(m_rows != 0);
+        return m_row;
+    }
+
+    /** Cheapest cost into the last cell of the last row. */
+    inline T cost() const noexcept {
+        return m_rows != 0 && !m_row.empty() ? m_row.back() : unreachable();
+    }
+
+    inline bool isReachable() const noexcept { return cost() != unreachable(); }
+
+private:
+    void update(const T* costs) {
+        detail::minCostRow(costs, m_open.data(), m_row.data(), m_row.size());
+        ++m_rows;
+    }
+
+    std::vector<T> m_row;
+    std::vector<unsigned char> m_open;
+    std::size_t m_rows = 0;
+};
+
+/** Paths through the grid of the mask, nonzero elements are blocked. */
+template <typename Count = std::uint64_t, class Mask>
+typename std::enable_if<matrix::IsMatrixLike<Mask>::value, Count>::type countPaths(const Mask& blocked) {
+    typedef typename matrix::MatrixValueType<Mask>::type U;
+    const matrix::ConstMatrixView<U> mask = matrix::constView(blocked);
+    PathCounter<Count> counter(mask.columns());
+    std::vector<U> buffer;
+    for(std::size_t r = 0; r < mask.rows(); ++r) counter.pushRow(detail::rowOf(mask, r, buffer));
+    return counter.count();
+}
+
+namespace detail {
+
+template <typename Count>
+Count countOpenGrid(std::size_t rows, std::size_t columns, std::false_type) {
+    PathCounter<Count> counter(columns);
+    for(std::size_t r = 0; r < rows; ++r) counter.pushOpenRow();
+    return counter.count();
+}
+
+/** The uint64_t count of an open grid is a binomial coefficient. */
+template <typename Count>
+Count countOpenGrid(std::size_t rows, std::size_t columns, std::true_type) {
+    if(rows == 0 || columns == 0) return 0;
+    return combinatorics::binomial(rows + columns - 2, rows - 1);
+}
+
+} // namespace detail
+
+/** Paths through a rows x columns grid without blocked cells. */
+template <typename Count = std::uint64_t>
+Count countPaths(std::size_t rows, std::size_t columns) {
+    return detail::countOpenGrid<Count>(rows, columns, std::is_same<Count, std::uint64_t>());
+}
+
+/** Cheapest path cost through a grid of cell costs. */
+template <class Costs>
+typename std::enable_if<matrix::IsMatrixLike<Costs>::value, typename matrix::MatrixValueType<Costs>::type>::type
+minPathCost(const Costs& costs) {
+    typedef typename matrix::MatrixValueType<Costs>::type T;
+    const matrix::ConstMatrixView<T> c = matrix::constView(costs);
+    MinCostPath<T> path(c.columns());
+    std::vector<T> buffer;
+    for(std::size_t r = 0; r < c.rows(); ++r) path.pushRow(detail::rowOf(c, r, buffer));
+    return path.cost();
+}
+
+/** Cheapest path cost avoiding the nonzero cells of the mask, which must
+    have the shape of the costs. MinCostPath<T>::unreachable() when there
+    is no path.
+ */
+template <class Costs, class Mask>
+typename std::enable_if<matrix::IsMatrixLike<Costs>::value && matrix::IsMatrixLike<Mask>::value,
+                        typename matrix::MatrixValueType<Costs>::type>::type
+minPathCost(const Costs& costs, const Mask& blocked) {
+    typedef typename matrix::MatrixValueType<Costs>::type T;
+    typedef typename matrix::MatrixValueType<Mask>::type U;
+    const matrix::ConstMatrixView<T> c = matrix::constView(costs);
+    const matrix::ConstMatrixView<U> mask = matrix::constView(blocked);
+    assert(c.rows() == mask.rows() && c.columns() == mask.columns());
+    MinCostPath<T> path(c.columns());
+    std::vector<T> costBuffer;
+    std::vector<U> maskBuffer;
+    for(std::size_t r = 0; r < c.rows(); ++r) {
+        path.pushRow(detail::rowOf(c, r, costBuffer), detail::rowOf(mask, r, maskBuffer));
+    }
+    return path.cost();
+}
+
+} //namespace paths
+} //namespace cppmath
+
+#endif /* cppmath_grid_paths_hpp */
@@ -0,0 +1,202 @@
+//
+//  cppmath_instrumentation.cpp
+//  CppMath
+//
+//  Created by Dmytro Krasnianskyi on 17.10.26.
+//  Copyright © 2026 Dmytro Krasnianskyi. All rights reserved.
+//
+
+#include "cppmath_instrumentation.hpp"
+
+#include <map>
+#include <mutex>
+#include <atomic>
+#include <algorithm>
+
+namespace cppmath {
+namespace instrumentation {
+
+namespace {
+
+void accumulate(Snapshot& to, const Snapshot& from, bool subtract) noexcept {
+    const auto apply = [subtract](std::uint64_t& a, std::uint64_t b){ a = subtract ? a - b : a + b; };
+    apply(to.allocations, from.allocations);
+    apply(to.allocatedBytes, from.allocatedBytes);
+    apply(to.deallocations, from.deallocations);
+    apply(to.deallocatedBytes, from.deallocatedBytes);
+    apply(to.deepCopies, from.deepCopies);
+    apply(to.copiedBytes, from.copiedBytes);
+    apply(to.moves, from.moves);
+    for(std::size_t i = 0; i < kOperationCount; ++i) {
+        apply(to.operations[i].calls, from.operations[i].calls);
+        apply(to.operations[i].flops, from.operations[i].flops);
+        apply(to.operations[i].nanoseconds, from.operations[i].nanoseconds);
+    }
+}
+
+#if CPPMATH_INSTRUMENTATION
+
+constexpr std::size_t kSlots = detail::kOperationSlots + 3 * kOperationCount;
+
+/** Counters written by one thread only, padded so that no two threads
+    share a cache line.
+ */
+struct Shard {
+    unsigned char front[64];
+    std::atomic<std::uint64_t> values[kSlots];
+    unsigned char back[64];
+
+    Shard() {
+        for(std::atomic<std::uint64_t>& v : values) v.store(0, std::memory_order_relaxed);
+    }
+};
+
+struct Registry {
+    std::mutex mutex;
+    std::vector<Shard*> shards;
+    /** Counts of threads that exited. */
+    std::uint64_t retired[kSlots] = {};
+    /** Totals at the last reset(). */
+    std::uint64_t baseline[kSlots] = {};
+    std::map<std::string, RegionStats> regions;
+};
+
+/** Never destroyed: threads may exit after static destruction started. */
+Registry& registry() {
+    static Registry* instance = new Registry();
+    return *instance;
+}
+
+struct LocalShard {
+    Shard* shard = new Shard();
+
+    LocalShard() {
+        Registry& r = registry();
+        std::lock_guard<std::mutex> lock(r.mutex);
+        r.shards.push_back(shard);
+    }
+
+    ~LocalShard() {
+        Registry& r = registry();
+        std::lock_guard<std::mutex> lock(r.mutex);
+        for(std::size_t i = 0; i < kSlots; ++i) r.retired[i] += shard->values[i].load(std::memory_order_relaxed);
+        r.shards.erase(std::find(r.shards.begin(), r.shards.end(), shard));
+        delete shard;
+    }
+};
+
+Shard& localShard() {
+    thread_local LocalShard local;
+    return *local.shard;
+}
+
+Snapshot toSnapshot(const std::uint64_t* v) noexcept {
+    Snapshot s;
+    s.allocations = v[detail::kAllocations];
+    s.allocatedBytes = v[detail::kAllocatedBytes];
+    s.deallocations = v[detail::kDeallocations];
+    s.deallocatedBytes = v[detail::kDeallocatedBytes];
+    s.deepCopies = v[detail::kDeepCopies];
+    s.copiedBytes = v[detail::kCopiedBytes];
+    s.moves = v[detail::kMoves];
+    for(std::size_t i = 0; i < kOperationCount; ++i) {
+        s.operations[i].calls = v[detail::kOperationSlots + 3 * i];
+        s.operations[i].flops = v[detail::kOperationSlots + 3 * i + 1];
+        s.operations[i].nanoseconds = v[detail::kOperationSlots + 3 * i + 2];
+    }
+    return s;
+}
+
+/** Sum of all threads, the registry mutex must be held. */
+void totals(Registry& r, std::uint64_t* out) {
+    std::copy(r.retired, r.retired + kSlots, out);
+    for(const Shard* shard : r.shards) {
+        for(std::size_t i = 0; i < kSlots; ++i) out[i] += shard->values[i].load(std::memory_order_relaxed);
+    }
+}
+
+#endif // CPPMATH_INSTRUMENTATION
+
+} // namespace
+
+const char* operationName(Operation operation) noexcept {
+    switch(operation) {
+        case Operation::Gemm: return "gemm";
+        case Operation::Elementwise: return "elementwise";
+        case Operation::Sparse: return "sparse";
+        case Operation::Factorization: return "factorization";
+        case Operation::Transpose: return "transpose";
+    }
+    return "unknown";
+}
+
+Snapshot operator - (const Snapshot& a, const Snapshot& b) noexcept {
+    Snapshot result = a;
+    accumulate(result, b, true);
+    return result;
+}
+
+#if CPPMATH_INSTRUMENTATION
+
+namespace detail {
+
+void add(std::size_t slot, std::uint64_t value) noexcept {
+    // Only this thread writes the shard, readers may see a slightly old value
+    std::atomic<std::uint64_t>& counter = localShard().values[slot];
+    counter.store(counter.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+}
+
+void addRegion(const char* name, std::uint64_t nanoseconds, const Snapshot& counters) {
+    Registry& r = registry();
+    std::lock_guard<std::mutex> lock(r.mutex);
+    RegionStats& stats = r.regions[name];
+    if(stats.name.empty()) stats.name = name;
+    ++stats.calls;
+    stats.nanoseconds += nanoseconds;
+    accumulate(stats.counters, counters, false);
+}
+
+} // namespace detail
+
+Snapshot snapshot() {
+    Registry& r = registry();
+    std::uint64_t values[kSlots];
+    std::lock_guard<std::mutex> lock(r.mutex);
+    totals(r, values);
+    return toSnapshot(values) - toSnapshot(r.baseline);
+}
+
+Snapshot threadSnapshot() {
+    const Shard& shard = localShard();
+    std::uint64_t values[kSlots];
+    for(std::size_t i = 0; i < kSlots; ++i) values[i] = shard.values[i].load(std::memory_order_relaxed);
+    return toSnapshot(values);
+}
+
+void reset() {
+    Registry& r = registry();
+    std::lock_guard<std::mutex> lock(r.mutex);
+    totals(r, r.baseline);
+    r.regions.clear();
+}
+
+std::vector<RegionStats> regions() {
+    Registry& r = registry();
+    std::lock_guard<std::mutex> lock(r.mutex);
+    std::vector<RegionStats> result;
+    result.reserve(r.regions.size());
+    for(const auto& entry : r.regions) result.push_back(entry.second);
+    return result;
+}
+
+#else
+
+Snapshot snapshot() { return Snapshot(); }
+Snapshot threadSnapshot() { return Snapshot(); }
+void reset() {}
+std::vector<RegionStats> regions() { return std::vector<RegionStats>(); }
+
+#endif // CPPMATH_INSTRUMENTATION
+
+} //namespace instrumentation
+} //namespace cppmath
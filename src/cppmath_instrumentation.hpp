@@ -0,0 +1,227 @@
+//
+//  cppmath_instrumentation.hpp
+//  CppMath
+//
+//  Created by Dmytro Krasnianskyi on 17.10.26.
+//  Copyright © 2026 Dmytro Krasnianskyi. All rights reserved.
+//
+
+#ifndef cppmath_instrumentation_hpp
+#define cppmath_instrumentation_hpp
+
+#include <cstddef>
+#include <cstdint>
+#include <chrono>
+#include <string>
+#include <vector>
+
+/** Optional counters of the library's own work.
+
+    Built with CPPMATH_INSTRUMENTATION=1 (the CMake option of the same name)
+    the library counts allocations and bytes of matrix storage, deep copies
+    and moves of Matrix, and calls, FLOPs and wall time of every kernel
+    family. Without it the recording hooks are empty inline functions and
+    the scoped types are empty classes, so the instrumented code compiles to
+    what it was before. The reading side stays available either way and
+    reports zeros when disabled, so exporters need no #if of their own.
+
+    Every thread counts into its own cache line. snapshot() sums all
+    threads, reset() moves the zero point without stopping writers.
+    ScopedRegion adds named regions: calls, wall time and what the calling
+    thread counted while inside. Kernel times include nested kernels, an LU
+    factorization also shows up in the times of the gemm calls it makes.
+ */
+
+#ifndef CPPMATH_INSTRUMENTATION
+#   define CPPMATH_INSTRUMENTATION 0
+#endif
+
+namespace cppmath {
+namespace instrumentation {
+
+constexpr bool kEnabled = CPPMATH_INSTRUMENTATION != 0;
+
+enum class Operation: int {
+    Gemm = 0,
+    Elementwise,
+    Sparse,
+    Factorization,
+    Transpose
+};
+
+constexpr std::size_t kOperationCount = 5;
+
+const char* operationName(Operation operation) noexcept;
+
+struct OperationStats {
+    std::uint64_t calls = 0;
+    std::uint64_t flops = 0;
+    std::uint64_t nanoseconds = 0;
+};
+
+struct Snapshot {
+    std::uint64_t allocations = 0;
+    std::uint64_t allocatedBytes = 0;
+    std::uint64_t deallocations = 0;
+    std::uint64_t deallocatedBytes = 0;
+    std::uint64_t deepCopies = 0;
+    std::uint64_t copiedBytes = 0;
+    std::uint64_t moves = 0;
+    OperationStats operations[kOperationCount];
+
+    inline const OperationStats& operator [] (Operation operation) const noexcept {
+        return operations[static_cast<std::size_t>(operation)];
+    }
+};
+
+/** Counts of a minus counts of b, field by field. */
+Snapshot operator - (const Snapshot& a, const Snapshot& b) noexcept;
+
+/** Totals of all threads since the start or the last reset(). */
+Snapshot snapshot();
+
+/** Running totals of the calling thread, unaffected by reset(). Meant for
+    differences taken on the same thread.
+ */
+Snapshot threadSnapshot();
+
+/** Zeroes snapshot() and drops the region statistics. */
+void reset();
+
+struct RegionStats {
+    std::string name;
+    std::uint64_t calls = 0;
+    std::uint64_t nanoseconds = 0;
+    /** What the threads that entered the region counted inside it. */
+    Snapshot counters;
+};
+
+/** Statistics of every region entered since the last reset(), by name. */
+std::vector<RegionStats> regions();
+
+#if CPPMATH_INSTRUMENTATION
+
+namespace detail {
+
+enum Slot: std::size_t {
+    kAllocations = 0,
+    kAllocatedBytes,
+    kDeallocations,
+    kDeallocatedBytes,
+    kDeepCopies,
+    kCopiedBytes,
+    kMoves,
+    kOperationSlots
+};
+
+/** Adds to a counter of the calling thread. */
+void add(std::size_t slot, std::uint64_t value) noexcept;
+
+inline std::size_t operationSlot(Operation operation, std::size_t field) noexcept {
+    return kOperationSlots + 3 * static_cast<std::size_t>(operation) + field;
+}
+
+void addRegion(const char* name, std::uint64_t nanoseconds, const Snapshot& counters);
+
+inline std::uint64_t now() noexcept {
+    return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+} // namespace detail
+
+inline void recordAllocation(std::size_t bytes) noexcept {
+    detail::add(detail::kAllocations, 1);
+    detail::add(detail::kAllocatedBytes, bytes);
+}
+
+inline void recordDeallocation(std::size_t bytes) noexcept {
+    detail::add(detail::kDeallocations, 1);
+    detail::add(detail::kDeallocatedBytes, bytes);
+}
+
+inline void recordCopy(std::size_t bytes) noexcept {
+    detail::add(detail::kDeepCopies, 1);
+    detail::add(detail::kCopiedBytes, bytes);
+}
+
+inline void recordMove() noexcept {
+    detail::add(detail::kMoves, 1);
+}
+
+/** Counts one call of a kernel with its FLOPs and wall time. */
+class ScopedOperation {
+public:
+    ScopedOperation(Operation operation, double flops) noexcept:
+        m_operation(operation),
+        m_flops(static_cast<std::uint64_t>(flops)),
+        m_start(detail::now())
+    {}
+
+    ~ScopedOperation() {
+        detail::add(detail::operationSlot(m_operation, 0), 1);
+        detail::add(detail::operationSlot(m_operation, 1), m_flops);
+        detail::add(detail::operationSlot(m_operation, 2), detail::now() - m_start);
+    }
+
+    ScopedOperation(const ScopedOperation&) = delete;
+    ScopedOperation& operator = (const ScopedOperation&) = delete;
+
+private:
+    Operation m_operation;
+    std::uint64_t m_flops;
+    std::uint64_t m_start;
+};
+
+/** A named region of caller code. name must outlive the region, string
+    literals are the intended use.
+ */
+class ScopedRegion {
+public:
+    explicit ScopedRegion(const char* name):
+        m_name(name),
+        m_counters(threadSnapshot()),
+        m_start(detail::now())
+    {}
+
+    ~ScopedRegion() {
+        const std::uint64_t elapsed = detail::now() - m_start;
+        detail::addRegion(m_name, elapsed, threadSnapshot() - m_counters);
+    }
+
+    ScopedRegion(const ScopedRegion&) = delete;
+    ScopedRegion& operator = (const ScopedRegion&) = delete;
+
+private:
+    const char* m_name;
+    Snapshot m_counters;
+    std::uint64_t m_start;
+};
+
+#else
+
+inline void recordAllocation(std::size_t) noexcept {}
+inline void recordDeallocation(std::size_t) noexcept {}
+inline void recordCopy(std::size_t) noexcept {}
+inline void recordMove() noexcept {}
+
+class ScopedOperation {
+public:
+    ScopedOperation(Operation, double) noexcept {}
+    ScopedOperation(const ScopedOperation&) = delete;
+    ScopedOperation& operator = (const ScopedOperation&) = delete;
+};
+
+class ScopedRegion {
+public:
+    explicit ScopedRegion(const char*) noexcept {}
+    ScopedRegion(const ScopedRegion&) = delete;
+    ScopedRegion& operator = (const ScopedRegion&) = delete;
+};
+
+#endif // CPPMATH_INSTRUMENTATION
+
+} //namespace instrumentation
+} //namespace cppmath
+
+#endif /* cppmath_instrumentation_hpp */
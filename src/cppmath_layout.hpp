@@ -0,0 +1,194 @@
+//
+//  cppmath_layout.hpp
+//  CppMath
+//
+//  Created by Dmytro Krasnianskyi on 17.10.26.
+//  Copyright © 2026 Dmytro Krasnianskyi. All rights reserved.
+//
+
+#ifndef cppmath_layout_hpp
+#define cppmath_layout_hpp
+
+#include <cstddef>
+#include <algorithm>
+#include <type_traits>
+
+#include "cppmath_matrix_base.hpp"
+
+/** Storage layouts of Matrix.
+
+    A layout maps (row, column) of a rows x columns matrix to an offset in
+    its storage. RowMajor and ColumnMajor are strided, so a Matrix with
+    either of them has a MatrixView and goes to every kernel as is. Tiled
+    and Morton keep square Tile x Tile blocks contiguous, row-major inside a
+    block, with the blocks in row-major order or along the Z-order curve.
+    Neighbours in both directions then share a few cache lines, which suits
+    2D-local access, but no stride describes the storage: these matrices are
+    indexed, iterated and used in expressions directly and converted with
+    convertLayout (cppmath_transpose.hpp) before going to the kernels.
+
+    Every layout provides:
+
+    kStrided, kRowMajor                     compile-time properties
+    storageSize(rows, columns)              elements to allocate
+    offset(row, column, rows, columns)      position of an element
+    forEach(rows, columns, fn)              fn(row, column, offset) for every
+                                            element, in storage order within
+                                            a block
+
+    Strided layouts add rowStride() and columnStride(), tiled ones kTile,
+    tileOffset() and forEachTile().
+ */
+
+namespace cppmath {
+namespace matrix{
+namespace layout {
+
+struct RowMajor {
+    static constexpr bool kStrided = true;
+    static constexpr bool kRowMajor = true;
+
+    static constexpr std::size_t storageSize(std::size_t rows, std::size_t columns) { return rows * columns; }
+    static constexpr std::size_t offset(std::size_t row, std::size_t column, std::size_t, std::size_t columns) {
+        return row * columns + column;
+    }
+    static constexpr std::ptrdiff_t rowStride(std::size_t, std::size_t columns) { return static_cast<std::ptrdiff_t>(columns); }
+    static constexpr std::ptrdiff_t columnStride(std::size_t, std::size_t) { return 1; }
+
+    template <class Fn>
+    static void forEach(std::size_t rows, std::size_t columns, Fn&& fn) {
+        std::size_t offset = 0;
+        for(std::size_t r = 0; r < rows; ++r)
+            for(std::size_t c = 0; c < columns; ++c) fn(r, c, offset++);
+    }
+};
+
+struct ColumnMajor {
+    static constexpr bool kStrided = true;
+    static constexpr bool kRowMajor = false;
+
+    static constexpr std::size_t storageSize(std::size_t rows, std::size_t columns) { return rows * columns; }
+    static constexpr std::size_t offset(std::size_t row, std::size_t column, std::size_t rows, std::size_t) {
+        return column * rows + row;
+    }
+    static constexpr std::ptrdiff_t rowStride(std::size_t, std::size_t) { return 1; }
+    static constexpr std::ptrdiff_t columnStride(std::size_t rows, std::size_t) { return static_cast<std::ptrdiff_t>(rows); }
+
+    template <class Fn>
+    static void forEach(std::size_t rows, std::size_t columns, Fn&& fn) {
+        std::size_t offset = 0;
+        for(std::size_t c = 0; c < columns; ++c)
+            for(std::size_t r = 0; r < rows; ++r) fn(r, c, offset++);
+    }
+};
+
+namespace detail {
+
+/** Blocks in row-major order over the block grid. */
+struct RowMajorTiles {
+    static constexpr std::size_t index(std::size_t row, std::size_t column, std::size_t, std::size_t columns) {
+        return row * columns + column;
+    }
+};
+
+/** Blocks along the Z-order curve, the row bit above the column bit. Grids
+    that are not powers of two stay compact: the index is the rank of the
+    block among the blocks of the grid that precede it on the curve, found
+    by descending the quadrants and adding the blocks of the skipped ones.
+ */
+struct ZOrderTiles {
+    static constexpr std::size_t extent(std::size_t n, std::size_t origin, std::size_t half) {
+        return origin >= n ? 0 : std::min(half, n - origin);
+    }
+
+    static std::size_t index(std::size_t row, std::size_t column, std::size_t rows, std::size_t columns) {
+        std::size_t side = 1;
+        while(side < rows || side < columns) side *= 2;
+        std::size_t rank = 0;
+        std::size_t r0 = 0;
+        std::size_t c0 = 0;
+        for(std::size_t half = side / 2; half != 0; half /= 2) {
+            const std::size_t top = extent(rows, r0, half);
+            const std::size_t left = extent(columns, c0, half);
+            const bool down = row >= r0 + half;
+            if(down) {
+                rank += top * (left + extent(columns, c0 + half, half));
+                r0 += half;
+            }
+            if(column >= c0 + half) {
+                rank += (down ? extent(rows, r0, half) : top) * left;
+                c0 += half;
+            }
+        }
+        return rank;
+    }
+};
+
+} // namespace detail
+
+/** Tile x Tile blocks stored contiguously, in the block order of Order. The
+    storage is padded to whole blocks; padding elements are never read.
+ */
+template <std::size_t Tile, class Order>
+struct BasicTiled {
+    static_assert(Tile != 0 && (Tile & (Tile - 1)) == 0, "The tile size must be a power of two");
+
+    static constexpr bool kStrided = false;
+    static constexpr bool kRowMajor = false;
+    static constexpr std::size_t kTile = Tile;
+
+    static constexpr std::size_t tiles(std::size_t n) { return (n + Tile - 1) / Tile; }
+
+    static constexpr std::size_t storageSize(std::size_t rows, std::size_t columns) {
+        return tiles(rows) * tiles(columns) * Tile * Tile;
+    }
+
+    /** Offset of the first element of block (tileRow, tileColumn). */
+    static std::size_t tileOffset(std::size_t tileRow, std::size_t tileColumn, std::size_t rows, std::size_t columns) {
+        return Order::index(tileRow, tileColumn, tiles(rows), tiles(columns)) * Tile * Tile;
+    }
+
+    static std::size_t offset(std::size_t row, std::size_t column, std::size_t rows, std::size_t columns) {
+        return tileOffset(row / Tile, column / Tile, rows, columns) + (row % Tile) * Tile + column % Tile;
+    }
+
+    /** fn(origin, tileRows, tileColumns, offset) for every block in the
+        block rows [firstTileRow, lastTileRow), with the extents clipped at the
+        matrix edge. Row i of a block starts at offset + i * Tile.
+     */
+    template <class Fn>
+    static void forEachTile(std::size_t rows, std::size_t columns, std::size_t firstTileRow, std::size_t lastTileRow, Fn&& fn) {
+        for(std::size_t r = firstTileRow * Tile; r < std::min(rows, lastTileRow * Tile); r += Tile) {
+            for(std::size_t c = 0; c < columns; c += Tile) {
+                fn(MatrixPoint{r, c}, std::min(Tile, rows - r), std::min(Tile, columns - c),
+                   tileOffset(r / Tile, c / Tile, rows, columns));
+            }
+        }
+    }
+
+    template <class Fn>
+    static void forEachTile(std::size_t rows, std::size_t columns, Fn&& fn) {
+        forEachTile(rows, columns, 0, tiles(rows), fn);
+    }
+
+    template <class Fn>
+    static void forEach(std::size_t rows, std::size_t columns, Fn&& fn) {
+        forEachTile(rows, columns, [&](const MatrixPoint& origin, std::size_t tileRows, std::size_t tileColumns, std::size_t offset){
+            for(std::size_t i = 0; i < tileRows; ++i)
+                for(std::size_t j = 0; j < tileColumns; ++j) fn(origin.row + i, origin.column + j, offset + i * Tile + j);
+        });
+    }
+};
+
+template <std::size_t Tile = 32> using Tiled = BasicTiled<Tile, detail::RowMajorTiles>;
+template <std::size_t Tile = 32> using Morton = BasicTiled<Tile, detail::ZOrderTiles>;
+
+} // namespace layout
+
+using layout::RowMajor;
+using layout::ColumnMajor;
+
+} //namespace matrix
+} //namespace cppmath
+
+#endif /* cppmath_layout_hpp */
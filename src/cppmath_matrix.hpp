@@ -16,7 +16,10 @@
 #include <algorithm>
 #include <initializer_list>
 
+#include "cppmath_allocator.hpp"
 #include "cppmath_matrix_base.hpp"
+#include "cppmath_expression.hpp"
+#include "cppmath_matrix_view.hpp"
 #include "cppmath_functions.hpp"
 
 /** Naming convention:
@@ -70,48 +73,247 @@ protected:
     RowIterator(MatrixT* matrix, std::size_t index): BaseT(matrix), m_index(index){}
 };
 
-template <typename T>
+/** Dense matrix. The element storage comes from Allocator, see
+    cppmath_allocator.hpp for aligned and arena allocators, and is arranged
+    by Layout, see cppmath_layout.hpp. Whatever the layout, linear indices
+    and iterators run over the elements in row-major order; data() is the
+    raw storage.
+ */
+template <typename T, class Allocator, class Layout>
 class Matrix {
 public:
     typedef T           value_type;
+    typedef Allocator   allocator_type;
+    typedef Layout      layout_type;
     
     using Iterator = RowIterator<Matrix>;
     using ConstIterator = RowIterator<const Matrix>;
     
     Matrix() = default;
-    Matrix(const Matrix&) = default;
-    Matrix(Matrix&&) = default;
     
-    Matrix& operator = (const Matrix&) = default;
-    Matrix& operator = (Matrix&&) = default;
+    Matrix(const Matrix& other):
+        m_data(other.m_data),
+        m_rows(other.m_rows),
+        m_columns(other.m_columns)
+    {
+        instrumentation::recordCopy(m_data.size() * sizeof(T));
+    }
+    
+    Matrix(Matrix&& other) noexcept:
+        m_data(std::move(other.m_data)),
+        m_rows(other.m_rows),
+        m_columns(other.m_columns)
+    {
+        other.m_rows = 0;
+        other.m_columns = 0;
+        instrumentation::recordMove();
+    }
+    
+    Matrix& operator = (const Matrix& other) {
+        if(this != &other) {
+            m_data = other.m_data;
+            m_rows = other.m_rows;
+            m_columns = other.m_columns;
+            instrumentation::recordCopy(m_data.size() * sizeof(T));
+        }
+        return *this;
+    }
+    
+    Matrix& operator = (Matrix&& other) noexcept(std::allocator_traits<Allocator>::propagate_on_container_move_assignment::value) {
+        if(this != &other) {
+            m_data = std::move(other.m_data);
+            m_rows = other.m_rows;
+            m_columns = other.m_columns;
+            other.m_rows = 0;
+            other.m_columns = 0;
+            instrumentation::recordMove();
+        }
+        return *this;
+    }
+    
+    explicit Matrix(const Allocator& alloc):
+        m_data(alloc)
+    {}
+    
+    Matrix(const Matrix& other, const Allocator& alloc):
+        m_data(other.m_data, alloc),
+        m_rows(other.m_rows),
+        m_columns(other.m_columns)
+    {
+        instrumentation::recordCopy(m_data.size() * sizeof(T));
+    }
+    
+    constexpr Matrix(std::size_t rows, std::size_t columns, const T& val = T(), const Allocator& alloc = Allocator()):
+        m_data(Layout::storageSize(rows, columns), val, alloc),
+        m_rows(rows),
+        m_columns(columns)
+    {}
     
-    constexpr Matrix(std::size_t rows, std::size_t columns, const T& val = T()):
-        m_data(rows * columns, val),
+    Matrix(std::size_t rows, std::size_t columns, const Allocator& alloc):
+        m_data(Layout::storageSize(rows, columns), T(), alloc),
         m_rows(rows),
         m_columns(columns)
     {}
     
     template <int R, int C>
-    constexpr Matrix(T const (& arr) [R][C]):
-        m_data(std::begin(arr[0]), std::end(arr[R - 1])),
+    constexpr Matrix(T const (& arr) [R][C], const Allocator& alloc = Allocator()):
+        m_data(rowMajorStorage(std::begin(arr[0]), std::end(arr[R - 1]), R, C, T(), alloc)),
         m_rows(R),
         m_columns(C)
     {}
 
-    constexpr Matrix(std::size_t rows, std::size_t columns, const std::initializer_list<T>& l, const T& val = T()):
-        m_data(l),
+    constexpr Matrix(std::size_t rows, std::size_t columns, const std::initializer_list<T>& l, const T& val = T(),
+                     const Allocator& alloc = Allocator()):
+        m_data(rowMajorStorage(l.begin(), l.end(), rows, columns, val, alloc)),
         m_rows(rows),
         m_columns(columns)
+    {}
+    
+    /** Deep copy of the viewed elements. */
+    template <typename U>
+    explicit Matrix(const BasicMatrixView<U>& view, const Allocator& alloc = Allocator()):
+        m_data(rowMajorStorage(view.begin(), view.end(), view.rows(), view.columns(), T(), alloc)),
+        m_rows(view.rows()),
+        m_columns(view.columns())
+    {}
+    
+    /** Evaluates an element-wise expression in a single pass. */
+    template <class E>
+    Matrix(const MatrixExpression<E>& expression, const Allocator& alloc = Allocator()):
+        m_data(alloc),
+        m_rows(expression.rows()),
+        m_columns(expression.columns())
     {
-        m_data.resize(rows * columns, val);
+        if(Layout::kRowMajor) {
+            m_data.assign(expression.begin(), expression.end());
+        } else {
+            m_data.resize(Layout::storageSize(m_rows, m_columns));
+            evaluate(expression.derived());
+        }
+    }
+    
+    /** Evaluates an element-wise expression in a single pass, reusing the
+        storage when the shape is unchanged. The expression may refer to this
+        matrix.
+     */
+    template <class E>
+    Matrix& operator = (const MatrixExpression<E>& expression) {
+        if(!Layout::kRowMajor) {
+            // A different shape means the expression does not refer to this matrix
+            if(expression.rows() != m_rows || expression.columns() != m_columns) {
+                m_rows = expression.rows();
+                m_columns = expression.columns();
+                m_data.resize(Layout::storageSize(m_rows, m_columns));
+            }
+            evaluate(expression.derived());
+            return *this;
+        }
+        if(expression.size() == m_data.size()) {
+            expression.evaluateTo(m_data.data());
+        } else {
+            m_data.assign(expression.begin(), expression.end());
+        }
+        m_rows = expression.rows();
+        m_columns = expression.columns();
+        return *this;
     }
     
+    /** In-place element-wise updates, the shapes must match. They reuse the
+        storage of this matrix, the right-hand side may refer to it. Matrices
+        of the same layout are added storage to storage.
+     */
+    template <class OtherAllocator, class OtherLayout>
+    Matrix& operator += (const Matrix<T, OtherAllocator, OtherLayout>& other) {
+        assert(other.rows() == m_rows && other.columns() == m_columns);
+        if(std::is_same<OtherLayout, Layout>::value) {
+            const T* src = other.data();
+            for(std::size_t i = 0; i < m_data.size(); ++i) m_data[i] += src[i];
+        } else {
+            Layout::forEach(m_rows, m_columns, [&](std::size_t r, std::size_t c, std::size_t offset){
+                m_data[offset] += other[MatrixPoint{r, c}];
+            });
+        }
+        return *this;
+    }
+
+    template <class OtherAllocator, class OtherLayout>
+    Matrix& operator -= (const Matrix<T, OtherAllocator, OtherLayout>& other) {
+        assert(other.rows() == m_rows && other.columns() == m_columns);
+        if(std::is_same<OtherLayout, Layout>::value) {
+            const T* src = other.data();
+            for(std::size_t i = 0; i < m_data.size(); ++i) m_data[i] -= src[i];
+        } else {
+            Layout::forEach(m_rows, m_columns, [&](std::size_t r, std::size_t c, std::size_t offset){
+                m_data[offset] -= other[MatrixPoint{r, c}];
+            });
+        }
+        return *this;
+    }
+
+    template <class E>
+    Matrix& operator += (const MatrixExpression<E>& expression) {
+        assert(expression.rows() == m_rows && expression.columns() == m_columns);
+        return *this = *this + expression.derived();
+    }
+
+    template <class E>
+    Matrix& operator -= (const MatrixExpression<E>& expression) {
+        assert(expression.rows() == m_rows && expression.columns() == m_columns);
+        return *this = *this - expression.derived();
+    }
+
+    Matrix& operator *= (const T& scalar) {
+        for(T& x : m_data) x *= scalar;
+        return *this;
+    }
+
+    Matrix& operator /= (const T& scalar) {
+        for(T& x : m_data) x /= scalar;
+        return *this;
+    }
+
+    inline allocator_type get_allocator() const { return m_data.get_allocator(); }
+    
+    /** Changes the shape keeping every element at its (row, column), new
+        elements are set to val. With a strided layout the rows (or columns)
+        move inside the existing storage, which is reallocated only when the
+        new size exceeds capacity(). Tiled layouts rebuild the storage.
+     */
     void resize(std::size_t rows, std::size_t columns, const T& val = T()) {
-        m_columns = columns;
+        if(Layout::kRowMajor) {
+            resizeLines(m_rows, m_columns, rows, columns, val);
+        } else if(Layout::kStrided) {
+            resizeLines(m_columns, m_rows, columns, rows, val);
+        } else {
+            std::vector<value_type, Allocator> resized(Layout::storageSize(rows, columns), val, m_data.get_allocator());
+            const std::size_t kept = std::min(rows, m_rows);
+            const std::size_t copied = std::min(columns, m_columns);
+            Layout::forEach(kept, copied, [&](std::size_t r, std::size_t c, std::size_t){
+                resized[Layout::offset(r, c, rows, columns)] = std::move(m_data[Layout::offset(r, c, m_rows, m_columns)]);
+            });
+            m_data.swap(resized);
+        }
         m_rows = rows;
-        m_data.resize(rows * columns, val);
+        m_columns = columns;
     }
     
+    /** Reinterprets the storage as rows x columns with the elements left in
+        place. The element count must not change. Nothing is copied.
+     */
+    void reshape(std::size_t rows, std::size_t columns) {
+        static_assert(Layout::kStrided, "Only strided layouts can be reshaped");
+        assert(rows * columns == m_data.size());
+        m_rows = rows;
+        m_columns = columns;
+    }
+
+    /** Storage for at least elements values, so that resizing or assigning
+        up to that size does not allocate.
+     */
+    inline void reserve(std::size_t elements) { m_data.reserve(elements); }
+    inline std::size_t capacity() const noexcept { return m_data.capacity(); }
+    inline void shrink_to_fit() { m_data.shrink_to_fit(); }
+
     void reset() {
         m_columns = 0;
         m_rows = 0;
@@ -127,19 +329,20 @@ public:
     }
     
     inline T& operator [] (const MatrixPoint& point) {
-        return m_data.at(point.row * m_columns + point.column);
+        return m_data.at(Layout::offset(point.row, point.column, m_rows, m_columns));
     }
     
     inline const T& operator [] (const MatrixPoint& point) const{
-        return m_data.at(point.row * m_columns + point.column);
+        return m_data.at(Layout::offset(point.row, point.column, m_rows, m_columns));
     }
     
+    /** Row-major linear index, whatever the layout. */
     inline T& operator [] (std::size_t index) {
-        return m_data.at(index);
+        return m_data.at(storageIndex(index));
     }
     
     inline const T& operator [] (std::size_t index) const {
-        return m_data.at(index);
+        return m_data.at(storageIndex(index));
     }
     
     constexpr inline Iterator begin(){ return Iterator::begin(this); }
@@ -149,7 +352,27 @@ public:
     constexpr inline ConstIterator beginAt(const MatrixPoint& point) const { return ConstIterator::beginAt(this, point.row, point.column); }
     constexpr inline ConstIterator end() const { return ConstIterator::end(this); }
     
-    std::size_t size()  const noexcept {return m_data.size();}
+    inline MatrixView<T> view() {
+        static_assert(Layout::kStrided, "Tiled layouts have no strided view, see convertLayout");
+        return MatrixView<T>(*this);
+    }
+    inline ConstMatrixView<T> view() const {
+        static_assert(Layout::kStrided, "Tiled layouts have no strided view, see convertLayout");
+        return ConstMatrixView<T>(*this);
+    }
+    
+    inline MatrixView<T> submatrix(const MatrixPoint& origin, std::size_t rows, std::size_t columns) {
+        return view().submatrix(origin, rows, columns);
+    }
+    
+    inline ConstMatrixView<T> submatrix(const MatrixPoint& origin, std::size_t rows, std::size_t columns) const {
+        return view().submatrix(origin, rows, columns);
+    }
+    
+    inline T* data() noexcept { return m_data.data(); }
+    inline const T* data() const noexcept { return m_data.data(); }
+    
+    std::size_t size()  const noexcept {return m_rows * m_columns;}
     std::size_t rows() const noexcept {return m_rows;}
     std::size_t columns() const noexcept {return m_columns;}
     
@@ -160,11 +383,89 @@ public:
     constexpr inline bool isEmpty() const {return size() == 0;}
     
 private:
-    std::vector<value_type> m_data;
+    typedef std::vector<value_type, Allocator> Storage;
+
+    /** Storage for rows x columns elements taken from a row-major sequence,
+        padded with val when the sequence is shorter.
+     */
+    template <class It>
+    static Storage rowMajorStorage(It first, It last, std::size_t rows, std::size_t columns, const T& val,
+                                   const Allocator& alloc) {
+        if(Layout::kRowMajor) {
+            Storage storage(first, last, alloc);
+            storage.resize(rows * columns, val);
+            return storage;
+        }
+        Storage storage(Layout::storageSize(rows, columns), val, alloc);
+        for(std::size_t i = 0; first != last && i < rows * columns; ++first, ++i) {
+            storage[Layout::offset(i / columns, i % columns, rows, columns)] = *first;
+        }
+        return storage;
+    }
+
+    inline std::size_t storageIndex(std::size_t index) const {
+        if(Layout::kRowMajor) return index;
+        return m_columns != 0 ? Layout::offset(index / m_columns, index % m_columns, m_rows, m_columns) : m_data.size();
+    }
+
+    template <class E>
+    void evaluate(const E& e) {
+        T* out = m_data.data();
+        Layout::forEach(m_rows, m_columns, [&](std::size_t r, std::size_t c, std::size_t offset){
+            out[offset] = e.coeff(r, c);
+        });
+    }
+
+    /** resize() of a strided layout stored as lines of length elements,
+        rows of a row-major or columns of a column-major matrix.
+     */
+    void resizeLines(std::size_t oldLines, std::size_t oldLength, std::size_t lines, std::size_t length, const T& val) {
+        const std::size_t kept = std::min(lines, oldLines);
+        const std::size_t copied = std::min(length, oldLength);
+        if(length < oldLength) {
+            // Lines only move towards the front, the first one stays put
+            for(std::size_t r = 1; r < kept; ++r) {
+                std::move(m_data.begin() + r * oldLength, m_data.begin() + r * oldLength + length,
+                          m_data.begin() + r * length);
+            }
+            m_data.resize(lines * length, val);
+        } else if(length > oldLength) {
+            m_data.resize(lines * length, val);
+            // Lines only move towards the back, the first one stays put
+            for(std::size_t r = kept; r-- > 0;) {
+                if(r != 0) {
+                    std::move_backward(m_data.begin() + r * oldLength, m_data.begin() + r * oldLength + copied,
+                                       m_data.begin() + r * length + copied);
+                }
+                std::fill(m_data.begin() + r * length + copied, m_data.begin() + (r + 1) * length, val);
+            }
+        } else {
+            m_data.resize(lines * length, val);
+        }
+        // Storage past the kept lines may still hold old elements
+        const std::size_t stale = std::min(oldLines * oldLength, m_data.size());
+        if(kept * length < stale) std::fill(m_data.begin() + kept * length, m_data.begin() + stale, val);
+    }
+
+    Storage m_data;
     std::size_t m_rows = 0;
     std::size_t m_columns = 0;
 };
 
+/** Rows start on a 64-byte boundary when the column count allows it. */
+template <typename T> using AlignedMatrix = Matrix<T, memory::AlignedAllocator<T>>;
+
+/** Storage drawn from a memory::Arena, for per-request temporaries. */
+template <typename T> using ArenaMatrix = Matrix<T, memory::ArenaAllocator<T>>;
+
+template <typename T> using ColumnMajorMatrix = Matrix<T, memory::DefaultAllocator<T>, layout::ColumnMajor>;
+
+/** Blocked layouts on cache line aligned storage, so that the rows of a
+    block start on a line when Tile * sizeof(T) is a multiple of 64.
+ */
+template <typename T, std::size_t Tile = 32> using TiledMatrix = Matrix<T, memory::AlignedAllocator<T>, layout::Tiled<Tile>>;
+template <typename T, std::size_t Tile = 32> using MortonMatrix = Matrix<T, memory::AlignedAllocator<T>, layout::Morton<Tile>>;
+
     
     constexpr size_t factorial(size_t n, size_t res = 1)
     {
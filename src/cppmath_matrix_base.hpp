@@ -118,9 +118,16 @@ protected:
         assert(m_matrix != nullptr);
         assert(_index() < m_matrix->size());
         
-        return (*m_matrix)[_index()];
+        return static_cast<const Derived&>(*this).element();
     };
     
+    /** Default element access through the linear index. Derived iterators
+        that know a cheaper way to reach the element may hide it.
+     */
+    constexpr inline value_type& element() const {
+        return (*m_matrix)[_index()];
+    }
+    
     /**
      Interface that must be implemented in derived classes:
      
@@ -130,6 +137,10 @@ protected:
      std::size_t column() const noexcept;
      std::size_t row() const noexcept;
      sdifference_type diff(const Derived& other) const noexcept;
+     
+     Optional:
+     
+     value_type& element() const;
      */
     inline constexpr void _inc(difference_type index = 1) noexcept {
         return static_cast<Derived&>(*this).inc(index);
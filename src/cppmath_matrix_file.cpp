@@ -0,0 +1,190 @@
+//
+//  cppmath_matrix_file.cpp
+//  CppMath
+//
+//  Created by Dmytro Krasnianskyi on 17.10.26.
+//  Copyright © 2026 Dmytro Krasnianskyi. All rights reserved.
+//
+
+#include "cppmath_matrix_file.hpp"
+
+#include <cerrno>
+#include <cstring>
+#include <limits>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace cppmath {
+namespace io {
+
+namespace {
+
+const char kMagic[8] = {'C', 'P', 'P', 'M', 'A', 'T', 'R', 'X'};
+
+/** Mappings start on a page, so data offsets aligned to at most a page
+    keep their alignment in memory.
+ */
+constexpr std::size_t kMaxAlignment = 4096;
+
+[[noreturn]] void fail(const std::string& what, const std::string& path) {
+    throw FileError("matrix file: " + what + " " + path + (errno != 0 ? ": " + std::string(std::strerror(errno)) : std::string()));
+}
+
+[[noreturn]] void invalid(const std::string& what, const std::string& path) {
+    throw FileError("matrix file: " + what + " in " + path);
+}
+
+} // namespace
+
+std::uint64_t checksum(const void* data, std::size_t bytes, std::uint64_t state) noexcept {
+    const unsigned char* p = static_cast<const unsigned char*>(data);
+    for(std::size_t i = 0; i < bytes; ++i) {
+        state ^= p[i];
+        state *= 0x100000001b3ull;
+    }
+    return state;
+}
+
+FileMapping::FileMapping(const std::string& path, MapMode mode):
+    m_mode(mode)
+{
+    errno = 0;
+    const int fd = ::open(path.c_str(), O_RDONLY);
+    if(fd < 0) fail("cannot open", path);
+
+    struct stat info;
+    if(::fstat(fd, &info) != 0) {
+        const int error = errno;
+        ::close(fd);
+        errno = error;
+        fail("cannot stat", path);
+    }
+    m_size = static_cast<std::size_t>(info.st_size);
+    if(m_size == 0) {
+        ::close(fd);
+        errno = 0;
+        invalid("no header", path);
+    }
+
+    const int protection = mode == MapMode::ReadOnly ? PROT_READ : PROT_READ | PROT_WRITE;
+    void* data = ::mmap(nullptr, m_size, protection, MAP_PRIVATE, fd, 0);
+    const int error = errno;
+    // The mapping keeps its own reference to the file
+    ::close(fd);
+    if(data == MAP_FAILED) {
+        errno = error;
+        fail("cannot map", path);
+    }
+    m_data = static_cast<unsigned char*>(data);
+}
+
+FileMapping::~FileMapping() {
+    if(m_data) ::munmap(m_data, m_size);
+}
+
+FileMapping::FileMapping(FileMapping&& other) noexcept:
+    m_data(other.m_data),
+    m_size(other.m_size),
+    m_mode(other.m_mode)
+{
+    other.m_data = nullptr;
+    other.m_size = 0;
+}
+
+FileMapping& FileMapping::operator = (FileMapping&& other) noexcept {
+    if(this != &other) {
+        if(m_data) ::munmap(m_data, m_size);
+        m_data = other.m_data;
+        m_size = other.m_size;
+        m_mode = other.m_mode;
+        other.m_data = nullptr;
+        other.m_size = 0;
+    }
+    return *this;
+}
+
+namespace detail {
+
+MatrixFileHeader makeHeader(ElementType type, std::size_t elementSize, std::size_t rows, std::size_t columns,
+                            std::size_t alignment) {
+    assert(alignment != 0 && (alignment & (alignment - 1)) == 0 && alignment <= kMaxAlignment);
+    MatrixFileHeader header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, kMagic, sizeof(kMagic));
+    header.version = kMatrixFileVersion;
+    header.endianness = kEndianMarker;
+    header.elementType = static_cast<std::uint32_t>(type);
+    header.elementSize = static_cast<std::uint32_t>(elementSize);
+    header.rows = rows;
+    header.columns = columns;
+    header.alignment = alignment;
+    header.dataOffset = (sizeof(MatrixFileHeader) + alignment - 1) / alignment * alignment;
+    header.checksum = kChecksumSeed;
+    return header;
+}
+
+MatrixFileHeader validateHeader(const FileMapping& mapping, ElementType type, std::size_t elementSize,
+                                const std::string& path) {
+    errno = 0;
+    if(mapping.size() < sizeof(MatrixFileHeader)) invalid("truncated header", path);
+    MatrixFileHeader header;
+    std::memcpy(&header, mapping.data(), sizeof(header));
+
+    if(std::memcmp(header.magic, kMagic, sizeof(kMagic)) != 0) invalid("bad magic", path);
+    if(header.endianness != kEndianMarker) invalid("foreign byte order", path);
+    if(header.version != kMatrixFileVersion) invalid("unsupported version " + std::to_string(header.version), path);
+    if(header.elementType != static_cast<std::uint32_t>(type) || header.elementSize != elementSize) {
+        invalid("element type mismatch", path);
+    }
+    if(header.alignment == 0 || (header.alignment & (header.alignment - 1)) != 0 || header.alignment > kMaxAlignment ||
+       header.dataOffset % header.alignment != 0 || header.dataOffset < sizeof(MatrixFileHeader)) {
+        invalid("bad data alignment", path);
+    }
+
+    const std::uint64_t limit = std::numeric_limits<std::uint64_t>::max() / elementSize;
+    if(header.columns != 0 && header.rows > limit / header.columns) invalid("bad shape", path);
+    const std::uint64_t bytes = header.rows * header.columns * elementSize;
+    if(header.dataOffset > mapping.size() || bytes > mapping.size() - header.dataOffset) invalid("truncated data", path);
+    return header;
+}
+
+FileWriter::FileWriter(const std::string& path):
+    m_path(path)
+{
+    errno = 0;
+    m_file = std::fopen(path.c_str(), "wb");
+    if(!m_file) fail("cannot create", path);
+}
+
+FileWriter::~FileWriter() {
+    if(m_file) std::fclose(m_file);
+}
+
+void FileWriter::write(const void* data, std::size_t bytes) {
+    assert(m_file);
+    errno = 0;
+    if(bytes != 0 && std::fwrite(data, 1, bytes, m_file) != bytes) fail("cannot write", m_path);
+}
+
+void FileWriter::writeAt(std::uint64_t offset, const void* data, std::size_t bytes) {
+    assert(m_file);
+    errno = 0;
+    if(std::fseek(m_file, static_cast<long>(offset), SEEK_SET) != 0) fail("cannot seek", m_path);
+    write(data, bytes);
+}
+
+void FileWriter::close() {
+    if(!m_file) return;
+    errno = 0;
+    const int result = std::fclose(m_file);
+    m_file = nullptr;
+    if(result != 0) fail("cannot close", m_path);
+}
+
+} // namespace detail
+
+} //namespace io
+} //namespace cppmath
@@ -0,0 +1,307 @@
+//
+//  cppmath_matrix_file.hpp
+//  CppMath
+//
+//  Created by Dmytro Krasnianskyi on 17.10.26.
+//  Copyright © 2026 Dmytro Krasnianskyi. All rights reserved.
+//
+
+#ifndef cppmath_matrix_file_hpp
+#define cppmath_matrix_file_hpp
+
+#include <cstddef>
+#include <cstdint>
+#include <cassert>
+#include <cstdio>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <utility>
+#include <stdexcept>
+#include <type_traits>
+
+#include "cppmath_allocator.hpp"
+#include "cppmath_matrix.hpp"
+
+/** Binary matrix files.
+
+    A file is a 64-byte header followed by the row-major elements in native
+    byte order, starting at an offset aligned to the alignment recorded in
+    the header:
+
+        magic "CPPMATRX", version, endianness marker, element type and size,
+        rows, columns, alignment, data offset, checksum of the data.
+
+    MappedMatrix maps a file and exposes its elements as a matrix view, so
+    opening costs the same for any size and pages are read on first touch.
+    MatrixFileWriter streams rows to a file and writes the final header on
+    close(), so a file that was not finished never opens as valid. Failed
+    I/O and invalid files throw FileError.
+ */
+
+namespace cppmath {
+namespace io {
+
+class FileError: public std::runtime_error {
+public:
+    using std::runtime_error::runtime_error;
+};
+
+enum class ElementType: std::uint32_t {
+    Int8 = 1,
+    UInt8,
+    Int16,
+    UInt16,
+    Int32,
+    UInt32,
+    Int64,
+    UInt64,
+    Float32,
+    Float64
+};
+
+template <typename T> struct ElementTypeOf;
+template <> struct ElementTypeOf<std::int8_t> { static constexpr ElementType value = ElementType::Int8; };
+template <> struct ElementTypeOf<std::uint8_t> { static constexpr ElementType value = ElementType::UInt8; };
+template <> struct ElementTypeOf<std::int16_t> { static constexpr ElementType value = ElementType::Int16; };
+template <> struct ElementTypeOf<std::uint16_t> { static constexpr ElementType value = ElementType::UInt16; };
+template <> struct ElementTypeOf<std::int32_t> { static constexpr ElementType value = ElementType::Int32; };
+template <> struct ElementTypeOf<std::uint32_t> { static constexpr ElementType value = ElementType::UInt32; };
+template <> struct ElementTypeOf<std::int64_t> { static constexpr ElementType value = ElementType::Int64; };
+template <> struct ElementTypeOf<std::uint64_t> { static constexpr ElementType value = ElementType::UInt64; };
+template <> struct ElementTypeOf<float> { static constexpr ElementType value = ElementType::Float32; };
+template <> struct ElementTypeOf<double> { static constexpr ElementType value = ElementType::Float64; };
+
+constexpr std::uint32_t kMatrixFileVersion = 1;
+
+/** Written as a native integer, reads back byte swapped on the other
+    endianness.
+ */
+constexpr std::uint32_t kEndianMarker = 0x01020304;
+
+struct MatrixFileHeader {
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t endianness;
+    std::uint32_t elementType;
+    std::uint32_t elementSize;
+    std::uint64_t rows;
+    std::uint64_t columns;
+    std::uint64_t alignment;
+    std::uint64_t dataOffset;
+    std::uint64_t checksum;
+};
+
+static_assert(sizeof(MatrixFileHeader) == 64, "matrix file header must stay 64 bytes");
+
+constexpr std::uint64_t kChecksumSeed = 0xcbf29ce484222325ull;
+
+/** 64-bit FNV-1a of the bytes, continuing from state so that the checksum
+    of a stream can be built chunk by chunk.
+ */
+std::uint64_t checksum(const void* data, std::size_t bytes, std::uint64_t state = kChecksumSeed) noexcept;
+
+enum class MapMode: int {
+    ReadOnly = 0,
+    /** Writable private pages: changes stay in memory and never reach the file. */
+    CopyOnWrite
+};
+
+/** A whole file mapped into memory. Move-only, unmapped on destruction. */
+class FileMapping {
+public:
+    FileMapping() = default;
+    FileMapping(const std::string& path, MapMode mode);
+    ~FileMapping();
+
+    FileMapping(FileMapping&& other) noexcept;
+    FileMapping& operator = (FileMapping&& other) noexcept;
+    FileMapping(const FileMapping&) = delete;
+    FileMapping& operator = (const FileMapping&) = delete;
+
+    inline unsigned char* data() const noexcept { return m_data; }
+    inline std::size_t size() const noexcept { return m_size; }
+    inline MapMode mode() const noexcept { return m_mode; }
+
+private:
+    unsigned char* m_data = nullptr;
+    std::size_t m_size = 0;
+    MapMode m_mode = MapMode::ReadOnly;
+};
+
+namespace detail {
+
+/** Header with the given shape, the data offset rounded up to alignment. */
+MatrixFileHeader makeHeader(ElementType type, std::size_t elementSize, std::size_t rows, std::size_t columns,
+                            std::size_t alignment);
+
+/** Checks magic, version, byte order, element type and that the file holds
+    all elements. Throws FileError.
+ */
+MatrixFileHeader validateHeader(const FileMapping& mapping, ElementType type, std::size_t elementSize,
+                                const std::string& path);
+
+/** Sequential binary output with one positioned write for the header. */
+class FileWriter {
+public:
+    explicit FileWriter(const std::string& path);
+    ~FileWriter();
+
+    FileWriter(const FileWriter&) = delete;
+    FileWriter& operator = (const FileWriter&) = delete;
+
+    void write(const void* data, std::size_t bytes);
+    void writeAt(std::uint64_t offset, const void* data, std::size_t bytes);
+    void close();
+    inline bool isOpen() const noexcept { return m_file != nullptr; }
+
+private:
+    std::FILE* m_file = nullptr;
+    std::string m_path;
+};
+
+} // namespace detail
+
+/** A matrix file mapped into memory. The elements are used in place, the
+    file must stay unchanged while it is mapped.
+ */
+template <typename T>
+class MappedMatrix {
+public:
+    typedef T           value_type;
+
+    explicit MappedMatrix(const std::string& path, MapMode mode = MapMode::ReadOnly):
+        m_mapping(path, mode),
+        m_header(detail::validateHeader(m_mapping, ElementTypeOf<T>::value, sizeof(T), path))
+    {}
+
+    inline std::size_t rows() const noexcept { return static_cast<std::size_t>(m_header.rows); }
+    inline std::size_t columns() const noexcept { return static_cast<std::size_t>(m_header.columns); }
+    inline std::size_t size() const noexcept { return rows() * columns(); }
+    inline const MatrixFileHeader& header() const noexcept { return m_header; }
+    inline MapMode mode() const noexcept { return m_mapping.mode(); }
+
+    inline const T* data() const noexcept {
+        return reinterpret_cast<const T*>(m_mapping.data() + m_header.dataOffset);
+    }
+
+    /** Writable elements of a copy-on-write mapping. */
+    inline T* mutableData() noexcept {
+        assert(mode() == MapMode::CopyOnWrite);
+        return reinterpret_cast<T*>(m_mapping.data() + m_header.dataOffset);
+    }
+
+    inline matrix::ConstMatrixView<T> view() const noexcept {
+        return matrix::ConstMatrixView<T>(data(), rows(), columns(), static_cast<std::ptrdiff_t>(columns()));
+    }
+
+    /** Writable view of a copy-on-write mapping. */
+    inline matrix::MatrixView<T> mutableView() noexcept {
+        return matrix::MatrixView<T>(mutableData(), rows(), columns(), static_cast<std::ptrdiff_t>(columns()));
+    }
+
+    /** Compares the stored checksum with the mapped data. This reads every
+        page, so it is left to callers that want it.
+     */
+    bool verifyChecksum() const noexcept {
+        return checksum(data(), size() * sizeof(T)) == m_header.checksum;
+    }
+
+    matrix::Matrix<T> toMatrix() const {
+        return matrix::Matrix<T>(view());
+    }
+
+private:
+    FileMapping m_mapping;
+    MatrixFileHeader m_header;
+};
+
+/** Streams a rows x columns matrix to a file in row-major order. The header
+    with the checksum is written by close() once every element arrived.
+ */
+template <typename T>
+class MatrixFileWriter {
+public:
+    typedef T           value_type;
+
+    MatrixFileWriter(const std::string& path, std::size_t rows, std::size_t columns,
+                     std::size_t alignment = memory::kSimdAlignment):
+        m_header(detail::makeHeader(ElementTypeOf<T>::value, sizeof(T), rows, columns, alignment)),
+        m_file(path)
+    {
+        // Zeroed header until close(), then padding up to the data
+        const unsigned char zeros[64] = {};
+        for(std::uint64_t written = 0; written < m_header.dataOffset; written += sizeof(zeros)) {
+            m_file.write(zeros, static_cast<std::size_t>(std::min<std::uint64_t>(sizeof(zeros), m_header.dataOffset - written)));
+        }
+    }
+
+    inline std::size_t written() const noexcept { return m_written; }
+    inline std::size_t size() const noexcept { return static_cast<std::size_t>(m_header.rows * m_header.columns); }
+
+    void write(const T* values, std::size_t count) {
+        if(count > size() - m_written) throw FileError("matrix file: more elements written than the matrix holds");
+        m_file.write(values, count * sizeof(T));
+        m_state = checksum(values, count * sizeof(T), m_state);
+        m_written += count;
+    }
+
+    /** Appends whole rows taken from a matrix or view. */
+    template <class RowsT>
+    typename std::enable_if<matrix::IsMatrixLike<RowsT>::value>::type writeRows(const RowsT& rows) {
+        const matrix::ConstMatrixView<T> v = matrix::constView(rows);
+        assert(v.columns() == m_header.columns || v.size() == 0);
+        if(v.isContiguous()) {
+            write(v.data(), v.size());
+            return;
+        }
+        std::vector<T> row(v.columns());
+        for(std::size_t r = 0; r < v.rows(); ++r) {
+            for(std::size_t c = 0; c < v.columns(); ++c) row[c] = v[matrix::MatrixPoint{r, c}];
+            write(row.data(), row.size());
+        }
+    }
+
+    /** Writes the header and closes the file. Throws when elements are
+        missing, the file then stays invalid.
+     */
+    void close() {
+        if(!m_file.isOpen()) return;
+        if(m_written != size()) {
+            m_file.close();
+            throw FileError("matrix file: closed before all elements were written");
+        }
+        m_header.checksum = m_state;
+        m_file.writeAt(0, &m_header, sizeof(m_header));
+        m_file.close();
+    }
+
+private:
+    MatrixFileHeader m_header;
+    detail::FileWriter m_file;
+    std::uint64_t m_state = kChecksumSeed;
+    std::size_t m_written = 0;
+};
+
+/** Writes a whole matrix or view to path. */
+template <class MatrixT>
+typename std::enable_if<matrix::IsMatrixLike<MatrixT>::value>::type
+save(const std::string& path, const MatrixT& m) {
+    typedef typename matrix::MatrixValueType<MatrixT>::type T;
+    MatrixFileWriter<T> writer(path, m.rows(), m.columns());
+    writer.writeRows(m);
+    writer.close();
+}
+
+/** Reads a matrix file into memory, verifying its checksum. */
+template <typename T>
+matrix::Matrix<T> load(const std::string& path) {
+    const MappedMatrix<T> mapped(path);
+    if(!mapped.verifyChecksum()) throw FileError("matrix file: checksum mismatch in " + path);
+    return mapped.toMatrix();
+}
+
+} //namespace io
+} //namespace cppmath
+
+#endif /* cppmath_matrix_file_hpp */
@@ -0,0 +1,320 @@
+//
+//  cppmath_matrix_view.hpp
+//  CppMath
+//
+//  Created by Dmytro Krasnianskyi on 17.10.26.
+//  Copyright © 2026 Dmytro Krasnianskyi. All rights reserved.
+//
+
+#ifndef cppmath_matrix_view_hpp
+#define cppmath_matrix_view_hpp
+
+#include <cstddef>
+#include <cassert>
+#include <type_traits>
+#include <algorithm>
+
+#include "cppmath_matrix_base.hpp"
+#include "cppmath_expression.hpp"
+
+/** Non-owning strided windows into matrix storage.
+
+    Element (row, column) of a view lives at data()[row * rowStride() + column * columnStride()],
+    so blocks, rows, columns, diagonals and transposes of a Matrix are all
+    views over the same buffer. MatrixView<T> gives mutable access,
+    ConstMatrixView<T> read-only access. A view never outlives the storage it
+    was taken from and is invalidated when that storage reallocates.
+ */
+
+namespace cppmath {
+namespace matrix{
+
+template <typename T> class BasicMatrixView;
+
+template <typename T> using MatrixView = BasicMatrixView<T>;
+template <typename T> using ConstMatrixView = BasicMatrixView<const T>;
+
+template <typename T> struct MatrixTrait<BasicMatrixView<T>> {
+    typedef T value_type;
+};
+
+template <typename T> struct MatrixTrait<const BasicMatrixView<T>> {
+    typedef const typename std::remove_const<T>::type value_type;
+};
+
+/** Random access iterator walking a view in row-major order. Keeps the
+    current row and column, so dereferencing never divides.
+ */
+template <class ViewT>
+class ViewIterator final: public MatrixBaseIterator<ViewT, ViewIterator<ViewT>>
+{
+    std::size_t m_row = 0;
+    std::size_t m_column = 0;
+
+public:
+    using BaseT = MatrixBaseIterator<ViewT, ViewIterator<ViewT>>;
+    using MatrixBaseIterator<ViewT, ViewIterator<ViewT>>::MatrixBaseIterator;
+
+    constexpr static inline ViewIterator begin(ViewT* view){
+        assert(view);
+        return ViewIterator(view, 0, 0);
+    };
+
+    constexpr static inline ViewIterator end(ViewT* view){
+        assert(view);
+        return view->columns() != 0 ? ViewIterator(view, view->rows(), 0) : ViewIterator(view, 0, 0);
+    };
+
+    constexpr static inline ViewIterator beginAt(ViewT* view, std::size_t row, std::size_t column){
+        assert(view);
+        return ViewIterator(view, row, column);
+    };
+
+    inline std::size_t index() const noexcept {
+        return m_row * this->m_matrix->columns() + m_column;
+    };
+    inline std::size_t column() const { return m_column; }
+    inline std::size_t row() const { return m_row; }
+
+protected:
+    friend BaseT;
+
+    inline typename BaseT::value_type& element() const {
+        return (*this->m_matrix)[MatrixPoint{m_row, m_column}];
+    }
+
+    inline void moveTo(std::size_t index) {
+        const std::size_t columns = this->m_matrix->columns();
+        m_row = columns != 0 ? index / columns : 0;
+        m_column = columns != 0 ? index % columns : 0;
+    }
+
+    inline void inc(typename BaseT::difference_type di) {
+        if(di == 1) {
+            if(++m_column == this->m_matrix->columns()) {
+                m_column = 0;
+                ++m_row;
+            }
+        } else {
+            moveTo(index() + di);
+        }
+    };
+    inline void dec(typename BaseT::difference_type di) {
+        if(di == 1 && m_column > 0) {
+            --m_column;
+        } else {
+            moveTo(index() - di);
+        }
+    };
+    inline typename BaseT::difference_type diff(const ViewIterator& other) const {
+        return static_cast<typename BaseT::difference_type>(index()) -
+               static_cast<typename BaseT::difference_type>(other.index());
+    }
+
+    ViewIterator(ViewT* view, std::size_t row, std::size_t column): BaseT(view), m_row(row), m_column(column){}
+};
+
+template <typename T>
+class BasicMatrixView {
+public:
+    typedef typename std::remove_const<T>::type value_type;
+    typedef T                                   element_type;
+
+    using Iterator = ViewIterator<BasicMatrixView>;
+    using ConstIterator = ViewIterator<const BasicMatrixView>;
+
+    BasicMatrixView() = default;
+    BasicMatrixView(const BasicMatrixView&) = default;
+    BasicMatrixView& operator = (const BasicMatrixView&) = default;
+
+    constexpr BasicMatrixView(T* data, std::size_t rows, std::size_t columns,
+                              std::ptrdiff_t rowStride, std::ptrdiff_t columnStride = 1):
+        m_data(data),
+        m_rows(rows),
+        m_columns(columns),
+        m_rowStride(rowStride),
+        m_columnStride(columnStride)
+    {}
+
+    /** View over a whole matrix. */
+    template <class MatrixT,
+              class = typename std::enable_if<IsStridedMatrix<typename std::remove_const<MatrixT>::type>::value>::type>
+    BasicMatrixView(MatrixT& m):
+        BasicMatrixView(m.data(), m.rows(), m.columns(),
+                        std::remove_const<MatrixT>::type::layout_type::rowStride(m.rows(), m.columns()),
+                        std::remove_const<MatrixT>::type::layout_type::columnStride(m.rows(), m.columns()))
+    {}
+
+    /** MatrixView<T> converts to ConstMatrixView<T>. */
+    template <typename U,
+              class = typename std::enable_if<std::is_same<const U, T>::value && !std::is_same<U, T>::value>::type>
+    constexpr BasicMatrixView(const BasicMatrixView<U>& other):
+        BasicMatrixView(other.data(), other.rows(), other.columns(), other.rowStride(), other.columnStride())
+    {}
+
+    inline T& operator [] (const MatrixPoint& point) const {
+        assert(point.row < m_rows && point.column < m_columns);
+        return m_data[static_cast<std::ptrdiff_t>(point.row) * m_rowStride +
+                      static_cast<std::ptrdiff_t>(point.column) * m_columnStride];
+    }
+
+    /** Row-major linear index, as for Matrix. */
+    inline T& operator [] (std::size_t index) const {
+        assert(index < size());
+        if(m_rows == 1) return m_data[static_cast<std::ptrdiff_t>(index) * m_columnStride];
+        if(m_columns == 1) return m_data[static_cast<std::ptrdiff_t>(index) * m_rowStride];
+        return operator[](MatrixPoint{index / m_columns, index % m_columns});
+    }
+
+    inline T* data() const noexcept { return m_data; }
+    inline T* rowData(std::size_t row) const noexcept { return m_data + static_cast<std::ptrdiff_t>(row) * m_rowStride; }
+
+    std::size_t size() const noexcept {return m_rows * m_columns;}
+    std::size_t rows() const noexcept {return m_rows;}
+    std::size_t columns() const noexcept {return m_columns;}
+    std::ptrdiff_t rowStride() const noexcept {return m_rowStride;}
+    std::ptrdiff_t columnStride() const noexcept {return m_columnStride;}
+
+    constexpr inline bool isSquareMatrix() const {return columns() == rows() && columns() != 0; }
+    constexpr inline bool isColumnVector() const {return columns() == 1 && rows() > 0;}
+    constexpr inline bool isRowVector() const {return rows() == 1 && columns() > 0;}
+    constexpr inline bool isVector() const {return isColumnVector() || isRowVector();}
+    constexpr inline bool isEmpty() const {return size() == 0;}
+
+    /** Consecutive elements of a row are adjacent in memory. */
+    constexpr inline bool hasContiguousRows() const { return m_columns <= 1 || m_columnStride == 1; }
+
+    /** The whole view is one dense row-major block. */
+    constexpr inline bool isContiguous() const {
+        return hasContiguousRows() && (m_rows <= 1 || m_rowStride == static_cast<std::ptrdiff_t>(m_columns));
+    }
+
+    BasicMatrixView submatrix(const MatrixPoint& origin, std::size_t rows, std::size_t columns) const {
+        assert(origin.row + rows <= m_rows && origin.column + columns <= m_columns);
+        T* originData = rows != 0 && columns != 0 ? &operator[](origin) : m_data;
+        return BasicMatrixView(originData, rows, columns, m_rowStride, m_columnStride);
+    }
+
+    /** 1 x columns() view of a row. */
+    inline BasicMatrixView row(std::size_t row) const {
+        return submatrix({row, 0}, 1, m_columns);
+    }
+
+    /** rows() x 1 view of a column. */
+    inline BasicMatrixView column(std::size_t column) const {
+        return submatrix({0, column}, m_rows, 1);
+    }
+
+    /** min(rows(), columns()) x 1 view of the main diagonal. */
+    inline BasicMatrixView diagonal() const {
+        return BasicMatrixView(m_data, std::min(m_rows, m_columns), 1, m_rowStride + m_columnStride, 1);
+    }
+
+    inline BasicMatrixView transposed() const {
+        return BasicMatrixView(m_data, m_columns, m_rows, m_columnStride, m_rowStride);
+    }
+
+    inline Iterator begin() { return Iterator::begin(this); }
+    inline Iterator beginAt(const MatrixPoint& point) { return Iterator::beginAt(this, point.row, point.column); }
+    inline Iterator end() { return Iterator::end(this); }
+    inline ConstIterator begin() const { return ConstIterator::begin(this); }
+    inline ConstIterator beginAt(const MatrixPoint& point) const { return ConstIterator::beginAt(this, point.row, point.column); }
+    inline ConstIterator end() const { return ConstIterator::end(this); }
+
+    /** Element-wise copy of a same-shaped view, expression or matrix into the
+        viewed elements.
+     */
+    template <class E>
+    void assign(const MatrixExpression<E>& expression) const {
+        static_assert(!std::is_const<T>::value, "Cannot assign through a ConstMatrixView");
+        assert(expression.rows() == m_rows && expression.columns() == m_columns);
+        const E& e = expression.derived();
+        for(std::size_t r = 0; r < m_rows; ++r) {
+            T* dst = rowData(r);
+            if(m_columnStride == 1) {
+                for(std::size_t c = 0; c < m_columns; ++c) dst[c] = e.coeff(r, c);
+            } else {
+                for(std::size_t c = 0; c < m_columns; ++c) dst[static_cast<std::ptrdiff_t>(c) * m_columnStride] = e.coeff(r, c);
+            }
+        }
+    }
+
+    template <typename U>
+    void assign(const BasicMatrixView<U>& other) const {
+        static_assert(!std::is_const<T>::value, "Cannot assign through a ConstMatrixView");
+        assert(other.rows() == m_rows && other.columns() == m_columns);
+        for(std::size_t r = 0; r < m_rows; ++r) {
+            for(std::size_t c = 0; c < m_columns; ++c) operator[](MatrixPoint{r, c}) = other[MatrixPoint{r, c}];
+        }
+    }
+
+    void fill(const value_type& val) const {
+        static_assert(!std::is_const<T>::value, "Cannot assign through a ConstMatrixView");
+        for(std::size_t r = 0; r < m_rows; ++r) {
+            for(std::size_t c = 0; c < m_columns; ++c) operator[](MatrixPoint{r, c}) = val;
+        }
+    }
+
+private:
+    T* m_data = nullptr;
+    std::size_t m_rows = 0;
+    std::size_t m_columns = 0;
+    std::ptrdiff_t m_rowStride = 0;
+    std::ptrdiff_t m_columnStride = 1;
+};
+
+template <class X> struct IsMatrixView: std::false_type {};
+template <typename T> struct IsMatrixView<BasicMatrixView<T>>: std::true_type {};
+
+/** Strided matrix or view, anything the kernels can take as an operand. */
+template <class X> struct IsMatrixLike:
+    std::integral_constant<bool, IsStridedMatrix<typename std::decay<X>::type>::value ||
+                                 IsMatrixView<typename std::decay<X>::type>::value> {};
+
+/** Element type of a matrix-like operand, empty for anything else so that it
+    can be used in SFINAE contexts.
+ */
+template <class X, class = void> struct MatrixValueType {};
+template <class X> struct MatrixValueType<X, typename std::enable_if<IsMatrixLike<X>::value>::type> {
+    typedef typename std::decay<X>::type::value_type type;
+};
+
+template <typename T, class Allocator, class Layout>
+inline ConstMatrixView<T> constView(const Matrix<T, Allocator, Layout>& m) { return ConstMatrixView<T>(m); }
+
+template <typename T>
+inline ConstMatrixView<typename std::remove_const<T>::type> constView(const BasicMatrixView<T>& v) { return v; }
+
+template <typename T, class Allocator, class Layout>
+inline MatrixView<T> mutableView(Matrix<T, Allocator, Layout>& m) { return MatrixView<T>(m); }
+
+template <typename T>
+inline MatrixView<T> mutableView(const MatrixView<T>& v) { return v; }
+
+/** Expression leaf over a view. */
+template <typename T>
+class ViewLeaf final: public MatrixExpression<ViewLeaf<T>> {
+public:
+    typedef T value_type;
+
+    template <typename U>
+    explicit ViewLeaf(const BasicMatrixView<U>& view): m_view(view) {}
+
+    inline std::size_t rows() const noexcept { return m_view.rows(); }
+    inline std::size_t columns() const noexcept { return m_view.columns(); }
+    inline const T& coeff(std::size_t index) const { return m_view[index]; }
+    inline const T& coeff(std::size_t row, std::size_t column) const { return m_view[MatrixPoint{row, column}]; }
+
+private:
+    ConstMatrixView<T> m_view;
+};
+
+template <typename T> struct IsExpressionOperand<BasicMatrixView<T>>: std::true_type {};
+template <typename T> struct ExpressionOperand<BasicMatrixView<T>> {
+    typedef ViewLeaf<typename std::remove_const<T>::type> type;
+};
+
+} //namespace matrix
+} //namespace cppmath
+
+#endif /* cppmath_matrix_view_hpp */
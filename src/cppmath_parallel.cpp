@@ -0,0 +1,205 @@
+//
+//  cppmath_parallel.cpp
+//  CppMath
+//
+//  Created by Dmytro Krasnianskyi on 17.10.26.
+//  Copyright © 2026 Dmytro Krasnianskyi. All rights reserved.
+//
+
+#include "cppmath_parallel.hpp"
+
+#include <cstdlib>
+
+namespace cppmath {
+namespace execution {
+
+namespace {
+
+thread_local ThreadPool* tPool = nullptr;
+thread_local std::size_t tWorker = 0;
+
+std::mutex gPoolMutex;
+std::atomic<ThreadPool*> gPool{nullptr};
+std::size_t gRequestedThreads = 0;
+bool gPoolShutDown = false;
+
+/** Owner of the shared pool. At exit it unpublishes the pool before joining
+    the workers, so later callers never see a destroyed pool.
+ */
+struct SharedPool {
+    std::unique_ptr<ThreadPool> pool;
+
+    ~SharedPool() {
+        std::unique_ptr<ThreadPool> last;
+        {
+            std::lock_guard<std::mutex> lock(gPoolMutex);
+            gPool.store(nullptr, std::memory_order_release);
+            gPoolShutDown = true;
+            last.swap(pool);
+        }
+    }
+};
+
+SharedPool& sharedPool() {
+    static SharedPool owner;
+    return owner;
+}
+
+std::size_t resolveThreadCount(std::size_t requested) {
+    if(requested != 0) return requested;
+    if(const char* env = std::getenv("CPPMATH_NUM_THREADS")) {
+        const unsigned long value = std::strtoul(env, nullptr, 10);
+        if(value != 0) return static_cast<std::size_t>(value);
+    }
+    return std::max<std::size_t>(1, std::thread::hardware_concurrency());
+}
+
+} // namespace
+
+ThreadPool::ThreadPool(std::size_t threads) {
+    const std::size_t workers = threads > 1 ? threads - 1 : 0;
+    // One deque per worker and the shared deque of outside threads last
+    for(std::size_t i = 0; i <= workers; ++i) m_queues.emplace_back(new Queue());
+    m_workers.reserve(workers);
+    for(std::size_t i = 0; i < workers; ++i) m_workers.emplace_back(&ThreadPool::workerLoop, this, i);
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(m_sleepMutex);
+        m_stop = true;
+    }
+    m_wake.notify_all();
+    for(std::thread& worker : m_workers) worker.join();
+}
+
+bool ThreadPool::isWorkerThread() const noexcept {
+    return tPool == this;
+}
+
+void ThreadPool::submit(void (*run)(void*, std::size_t), void* context, std::size_t first, std::size_t last) {
+    Queue& queue = isWorkerThread() ? *m_queues[tWorker] : *m_queues.back();
+    // Counted before queueing, so the count never falls below the queue sizes
+    m_queued.fetch_add(last - first, std::memory_order_release);
+    {
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        for(std::size_t part = first; part < last; ++part) queue.tasks.push_back(Task{run, context, part});
+    }
+    notify();
+}
+
+void ThreadPool::notify() {
+    {
+        // Pairs with the predicate checks of sleeping threads
+        std::lock_guard<std::mutex> lock(m_sleepMutex);
+    }
+    m_wake.notify_all();
+}
+
+bool ThreadPool::pop(Task& task) {
+    if(m_queued.load(std::memory_order_acquire) == 0) return false;
+
+    const std::size_t workers = m_workers.size();
+    const bool worker = isWorkerThread();
+    if(worker) {
+        Queue& own = *m_queues[tWorker];
+        std::lock_guard<std::mutex> lock(own.mutex);
+        if(!own.tasks.empty()) {
+            task = own.tasks.back();
+            own.tasks.pop_back();
+            return true;
+        }
+    }
+    {
+        Queue& shared = *m_queues.back();
+        std::lock_guard<std::mutex> lock(shared.mutex);
+        if(!shared.tasks.empty()) {
+            task = shared.tasks.front();
+            shared.tasks.pop_front();
+            return true;
+        }
+    }
+    const std::size_t start = worker ? tWorker + 1 : 0;
+    for(std::size_t i = 0; i < workers; ++i) {
+        Queue& victim = *m_queues[(start + i) % workers];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if(!victim.tasks.empty()) {
+            task = victim.tasks.front();
+            victim.tasks.pop_front();
+            return true;
+        }
+    }
+    return false;
+}
+
+bool ThreadPool::runOne() {
+    Task task;
+    if(!pop(task)) return false;
+    m_queued.fetch_sub(1, std::memory_order_relaxed);
+    task.run(task.context, task.part);
+    return true;
+}
+
+void ThreadPool::wait(const std::atomic<std::size_t>& remaining) {
+    while(remaining.load(std::memory_order_acquire) != 0) {
+        if(runOne()) continue;
+
+        // The rest of the tasks run on other threads, sleep until they are
+        // done or new tasks are queued
+        std::unique_lock<std::mutex> lock(m_sleepMutex);
+        m_wake.wait(lock, [&]{
+            return remaining.load(std::memory_order_acquire) == 0 || m_queued.load(std::memory_order_acquire) != 0;
+        });
+    }
+}
+
+void ThreadPool::workerLoop(std::size_t index) {
+    tPool = this;
+    tWorker = index;
+    for(;;) {
+        if(runOne()) continue;
+
+        for(int spin = 0; spin < 64 && m_queued.load(std::memory_order_relaxed) == 0; ++spin) {
+            std::this_thread::yield();
+        }
+        if(m_queued.load(std::memory_order_relaxed) != 0) continue;
+
+        std::unique_lock<std::mutex> lock(m_sleepMutex);
+        m_wake.wait(lock, [this]{ return m_stop || m_queued.load(std::memory_order_acquire) != 0; });
+        if(m_stop && m_queued.load(std::memory_order_acquire) == 0) return;
+    }
+}
+
+ThreadPool& defaultPool() {
+    ThreadPool* pool = gPool.load(std::memory_order_acquire);
+    if(pool) return *pool;
+
+    std::lock_guard<std::mutex> lock(gPoolMutex);
+    if(gPoolShutDown) {
+        // Kernels run from static destructors get a pool without workers,
+        // every task runs on the calling thread
+        static ThreadPool* const serial = new ThreadPool(1);
+        return *serial;
+    }
+    std::unique_ptr<ThreadPool>& owner = sharedPool().pool;
+    if(!owner) {
+        owner.reset(new ThreadPool(resolveThreadCount(gRequestedThreads)));
+        gPool.store(owner.get(), std::memory_order_release);
+    }
+    return *owner;
+}
+
+void setThreadCount(std::size_t threads) {
+    std::lock_guard<std::mutex> lock(gPoolMutex);
+    gRequestedThreads = threads;
+    if(gPoolShutDown) return;
+    gPool.store(nullptr, std::memory_order_release);
+    sharedPool().pool.reset();
+}
+
+std::size_t threadCount() {
+    return defaultPool().concurrency();
+}
+
+} //namespace execution
+} //namespace cppmath
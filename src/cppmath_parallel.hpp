@@ -0,0 +1,224 @@
+//
+//  cppmath_parallel.hpp
+//  CppMath
+//
+//  Created by Dmytro Krasnianskyi on 17.10.26.
+//  Copyright © 2026 Dmytro Krasnianskyi. All rights reserved.
+//
+
+#ifndef cppmath_parallel_hpp
+#define cppmath_parallel_hpp
+
+#include <cstddef>
+#include <atomic>
+#include <mutex>
+#include <deque>
+#include <memory>
+#include <thread>
+#include <vector>
+#include <algorithm>
+#include <exception>
+#include <condition_variable>
+
+/** Parallel execution of the matrix kernels.
+
+    Kernels take an ExecutionPolicy: seq runs on the calling thread, par and
+    par_unseq may split the work into tasks for the shared work-stealing
+    pool. The kernels vectorize inside a task either way, so par_unseq is
+    accepted for symmetry with std::execution and behaves like par.
+
+    Every pool worker owns a deque. It pushes and pops its own tasks at the
+    back and steals from the front of the other deques when idle. A thread
+    waiting for its tasks keeps running queued tasks and only sleeps once
+    nothing is left to take, so nested parallel calls from inside a task
+    neither deadlock nor create threads. The number of threads stays fixed
+    however many callers share the pool.
+ */
+
+namespace cppmath {
+namespace execution {
+
+enum class Execution: int {
+    Sequenced = 0,
+    Parallel,
+    ParallelUnsequenced
+};
+
+class ExecutionPolicy {
+public:
+    constexpr explicit ExecutionPolicy(Execution execution, std::size_t grain = 0):
+        m_execution(execution),
+        m_grain(grain)
+    {}
+
+    /** The same policy with at least grain work units per task. Zero lets
+        every kernel use its own default.
+     */
+    constexpr ExecutionPolicy withGrain(std::size_t grain) const { return ExecutionPolicy(m_execution, grain); }
+
+    constexpr Execution execution() const noexcept { return m_execution; }
+    constexpr std::size_t grain() const noexcept { return m_grain; }
+    constexpr bool isParallel() const noexcept { return m_execution != Execution::Sequenced; }
+
+    /** The grain set on the policy, or the kernel default. */
+    constexpr std::size_t grainOr(std::size_t fallback) const noexcept { return m_grain != 0 ? m_grain : fallback; }
+
+private:
+    Execution m_execution;
+    std::size_t m_grain;
+};
+
+constexpr ExecutionPolicy seq(Execution::Sequenced);
+constexpr ExecutionPolicy par(Execution::Parallel);
+constexpr ExecutionPolicy par_unseq(Execution::ParallelUnsequenced);
+
+class ThreadPool {
+public:
+    /** A pool running up to threads tasks at once: threads - 1 workers and
+        the thread waiting for the result.
+     */
+    explicit ThreadPool(std::size_t threads);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator = (const ThreadPool&) = delete;
+
+    /** Tasks that can run at the same time, including the calling thread. */
+    inline std::size_t concurrency() const noexcept { return m_workers.size() + 1; }
+
+    /** True on the worker threads of this pool. */
+    bool isWorkerThread() const noexcept;
+
+    /** Calls fn(first, last) over subranges of [begin, end) holding at least
+        grain indices, and returns once all of them are done. The first
+        exception thrown by fn is rethrown here.
+     */
+    template <class Fn>
+    void parallelFor(std::size_t begin, std::size_t end, std::size_t grain, Fn fn);
+
+private:
+    struct Task {
+        void (*run)(void* context, std::size_t part);
+        void* context;
+        std::size_t part;
+    };
+
+    struct Queue {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+    };
+
+    template <class Fn>
+    struct ForContext {
+        ThreadPool* pool;
+        Fn* fn;
+        std::size_t begin;
+        std::size_t size;
+        std::size_t parts;
+        std::atomic<std::size_t> remaining;
+        std::mutex errorMutex;
+        std::exception_ptr error;
+
+        static void run(void* context, std::size_t part);
+    };
+
+    /** Queues parts [first, last) of a context, on the own deque of a worker
+        or on the shared deque for outside threads.
+     */
+    void submit(void (*run)(void*, std::size_t), void* context, std::size_t first, std::size_t last);
+
+    /** Runs one queued task: own deque first, then the shared one, then
+        stealing. Returns false when nothing was queued.
+     */
+    bool runOne();
+
+    bool pop(Task& task);
+
+    /** Runs queued tasks until remaining drops to zero, sleeping while
+        there is nothing to run.
+     */
+    void wait(const std::atomic<std::size_t>& remaining);
+
+    /** Wakes threads sleeping in wait() or in the worker loop. */
+    void notify();
+    void workerLoop(std::size_t index);
+
+    std::vector<std::unique_ptr<Queue>> m_queues;
+    std::vector<std::thread> m_workers;
+    std::atomic<std::size_t> m_queued{0};
+    std::mutex m_sleepMutex;
+    std::condition_variable m_wake;
+    bool m_stop = false;
+};
+
+template <class Fn>
+void ThreadPool::ForContext<Fn>::run(void* context, std::size_t part) {
+    ForContext& c = *static_cast<ForContext*>(context);
+    const std::size_t first = c.begin + c.size * part / c.parts;
+    const std::size_t last = c.begin + c.size * (part + 1) / c.parts;
+    try {
+        if(first < last) (*c.fn)(first, last);
+    } catch(...) {
+        std::lock_guard<std::mutex> lock(c.errorMutex);
+        if(!c.error) c.error = std::current_exception();
+    }
+    // The waiter may free the context as soon as the count reaches zero
+    ThreadPool* pool = c.pool;
+    if(c.remaining.fetch_sub(1, std::memory_order_acq_rel) == 1) pool->notify();
+}
+
+template <class Fn>
+void ThreadPool::parallelFor(std::size_t begin, std::size_t end, std::size_t grain, Fn fn) {
+    if(begin >= end) return;
+    const std::size_t size = end - begin;
+    grain = std::max<std::size_t>(grain, 1);
+    const std::size_t parts = std::min((size - 1) / grain + 1, 4 * concurrency());
+    if(parts <= 1) {
+        fn(begin, end);
+        return;
+    }
+
+    ForContext<Fn> context;
+    context.pool = this;
+    context.fn = &fn;
+    context.begin = begin;
+    context.size = size;
+    context.parts = parts;
+    context.remaining.store(parts, std::memory_order_relaxed);
+
+    submit(&ForContext<Fn>::run, &context, 1, parts);
+    ForContext<Fn>::run(&context, 0);
+    wait(context.remaining);
+
+    if(context.error) std::rethrow_exception(context.error);
+}
+
+/** The pool shared by all kernels, created on the first use. */
+ThreadPool& defaultPool();
+
+/** Sets the concurrency of the shared pool, zero picks the CPPMATH_NUM_THREADS
+    environment variable or the hardware concurrency. The pool is rebuilt, so
+    this must not run while parallel kernels are in flight.
+ */
+void setThreadCount(std::size_t threads);
+
+/** Concurrency of the shared pool. */
+std::size_t threadCount();
+
+/** parallelFor on the shared pool, or a single call for sequenced policies.
+    A grain set on the policy overrides the kernel's grain.
+ */
+template <class Fn>
+void parallelFor(const ExecutionPolicy& policy, std::size_t begin, std::size_t end, std::size_t grain, Fn fn) {
+    if(begin >= end) return;
+    if(!policy.isParallel()) {
+        fn(begin, end);
+        return;
+    }
+    defaultPool().parallelFor(begin, end, policy.grainOr(grain), fn);
+}
+
+} //namespace execution
+} //namespace cppmath
+
+#endif /* cppmath_parallel_hpp */
@@ -0,0 +1,165 @@
+//
+//  cppmath_power.hpp
+//  CppMath
+//
+//  Created by Dmytro Krasnianskyi on 17.10.26.
+//  Copyright © 2026 Dmytro Krasnianskyi. All rights reserved.
+//
+
+#ifndef cppmath_power_hpp
+#define cppmath_power_hpp
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <utility>
+#include <algorithm>
+#include <type_traits>
+#include <stdexcept>
+
+#include "cppmath_gemm.hpp"
+#include "cppmath_instrumentation.hpp"
+
+/** Integer powers of square matrices by repeated squaring.
+
+    M^k takes bitLength(k) - 1 squarings and popcount(k) - 1 further
+    products on the gemm kernels. The squares and the products go through
+    two per thread n x n buffers that are swapped after every step, so no
+    step allocates. Element types only need T(0), T(1), + and *, which
+    covers the counting types of cppmath_combinatorics.hpp: ModularInt for
+    counts modulo a prime and SaturatingInt for counts that stop at their
+    maximum. powers() evaluates many exponents of one matrix with every
+    square formed once.
+ */
+
+namespace cppmath {
+namespace matrix{
+namespace detail {
+
+/** Squares and products of power(), kept per thread and only grown. */
+template <typename T>
+inline GemmBuffer<T>& powerBuffer() {
+    static thread_local GemmBuffer<T> buffer;
+    return buffer;
+}
+
+inline std::size_t bitLength(std::uint64_t value) {
+    std::size_t bits = 0;
+    for(; value != 0; value >>= 1) ++bits;
+    return bits;
+}
+
+inline std::size_t lowestBit(std::uint64_t value) {
+    std::size_t bit = 0;
+    for(; value != 0 && (value & 1) == 0; value >>= 1) ++bit;
+    return bit;
+}
+
+/** outs[i] = M^exponents[i] for the n x n matrix m. Bit b of every exponent
+    is applied while M^(2^b) is the current square: the lowest set bit copies
+    it, every further one multiplies it in. The outputs may overlap m.
+ */
+template <typename T>
+void powers(const execution::ExecutionPolicy& policy, const ConstMatrixView<T>& m,
+            const std::uint64_t* exponents, const MatrixView<T>* outs, std::size_t count) {
+    const std::size_t n = m.rows();
+    std::uint64_t highest = 0;
+    double products = 0;
+    for(std::size_t i = 0; i < count; ++i) {
+        highest = std::max(highest, exponents[i]);
+        for(std::uint64_t e = exponents[i]; e > 1; e &= e - 1) ++products;
+    }
+    const std::size_t bits = bitLength(highest);
+    const instrumentation::ScopedOperation counted(instrumentation::Operation::Gemm,
+                                                   2.0 * n * n * n * (products + (bits > 0 ? bits - 1 : 0)));
+
+    GemmBufferLease<T> lease(powerBuffer<T>());
+    T* square = lease.data(2 * n * n);
+    T* scratch = square + n * n;
+    const std::ptrdiff_t ld = static_cast<std::ptrdiff_t>(n);
+    ConstMatrixView<T> squareView(square, n, n, ld);
+    MatrixView<T>(square, n, n, ld).assign(m);
+
+    for(std::size_t i = 0; i < count; ++i) {
+        if(exponents[i] != 0) continue;
+        for(std::size_t r = 0; r < n; ++r)
+            for(std::size_t c = 0; c < n; ++c)
+                outs[i][MatrixPoint{r, c}] = r == c ? T(1) : T(0);
+    }
+
+    for(std::size_t bit = 0; bit < bits; ++bit) {
+        for(std::size_t i = 0; i < count; ++i) {
+            const std::uint64_t e = exponents[i];
+            if(((e >> bit) & 1) == 0) continue;
+            if(bit == lowestBit(e)) {
+                outs[i].assign(squareView);
+                continue;
+            }
+            const MatrixView<T>& out = outs[i];
+            gemm(n, n, n, T(1), out.data(), out.rowStride(), out.columnStride(), square, ld, 1,
+                 T(0), scratch, ld, 1, activeGemmKernel<T>(), policy);
+            out.assign(ConstMatrixView<T>(scratch, n, n, ld));
+        }
+        if(bit + 1 < bits) {
+            gemm(n, n, n, T(1), square, ld, 1, square, ld, 1, T(0), scratch, ld, 1, activeGemmKernel<T>(), policy);
+            std::swap(square, scratch);
+            squareView = ConstMatrixView<T>(square, n, n, ld);
+        }
+    }
+}
+
+template <class M, class Out>
+using EnableIfPower = typename std::enable_if<IsMatrixLike<M>::value && IsMatrixLike<Out>::value>::type;
+
+} // namespace detail
+
+/** out = m^exponent for a square m, m^0 is the identity. out must have the
+    shape of m and may be m itself. Without a policy large products run in
+    parallel. Throws std::invalid_argument unless m is a non-empty square
+    matrix and out has its shape.
+ */
+template <class M, class Out>
+detail::EnableIfPower<M, Out> power(const execution::ExecutionPolicy& policy, const M& m, std::uint64_t exponent, Out&& out) {
+    typedef typename MatrixValueType<Out>::type T;
+    const ConstMatrixView<T> vm = constView(m);
+    const MatrixView<T> vo = mutableView(out);
+    if(!vm.isSquareMatrix()) throw std::invalid_argument("power: matrix is not square");
+    if(vo.rows() != vm.rows() || vo.columns() != vm.columns()) throw std::invalid_argument("power: output shape differs from the matrix");
+    detail::powers(policy, vm, &exponent, &vo, 1);
+}
+
+template <class M, class Out>
+detail::EnableIfPower<M, Out> power(const M& m, std::uint64_t exponent, Out&& out) {
+    power(execution::par, m, exponent, std::forward<Out>(out));
+}
+
+template <typename T, class Allocator, class Layout>
+Matrix<T, Allocator, Layout> power(const Matrix<T, Allocator, Layout>& m, std::uint64_t exponent) {
+    Matrix<T, Allocator, Layout> result(m.rows(), m.columns(), m.get_allocator());
+    power(execution::par, m, exponent, result);
+    return result;
+}
+
+/** m^exponents[i] for every exponent, each square of m is formed once. */
+template <typename T, class Allocator, class Layout>
+std::vector<Matrix<T, Allocator, Layout>> powers(const execution::ExecutionPolicy& policy, const Matrix<T, Allocator, Layout>& m,
+                                                 const std::vector<std::uint64_t>& exponents) {
+    if(!m.isSquareMatrix()) throw std::invalid_argument("powers: matrix is not square");
+    std::vector<Matrix<T, Allocator, Layout>> results(exponents.size(),
+                                                      Matrix<T, Allocator, Layout>(m.rows(), m.columns(), m.get_allocator()));
+    std::vector<MatrixView<T>> views;
+    views.reserve(results.size());
+    for(Matrix<T, Allocator, Layout>& result : results) views.push_back(result.view());
+    detail::powers(policy, constView(m), exponents.data(), views.data(), exponents.size());
+    return results;
+}
+
+template <typename T, class Allocator, class Layout>
+std::vector<Matrix<T, Allocator, Layout>> powers(const Matrix<T, Allocator, Layout>& m, const std::vector<std::uint64_t>& exponents) {
+    return powers(execution::par, m, exponents);
+}
+
+} //namespace matrix
+} //namespace cppmath
+
+#endif /* cppmath_power_hpp */
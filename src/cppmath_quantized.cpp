@@ -0,0 +1,132 @@
+//
+//  cppmath_quantized.cpp
+//  CppMath
+//
+//  Created by Dmytro Krasnianskyi on 17.10.26.
+//  Copyright © 2026 Dmytro Krasnianskyi. All rights reserved.
+//
+
+#include "cppmath_quantized.hpp"
+#include "cppmath_simd.hpp"
+
+namespace cppmath{
+namespace matrix{
+namespace detail {
+
+namespace {
+
+#if CPPMATH_X86_DISPATCH
+
+using namespace simd;
+
+/** MR x (NV * width) int32 tile, the layout of the float gemm kernels with
+    one 32-bit group of A broadcast per row and DOT in place of fma.
+ */
+#define CPPMATH_QUANTIZED_MICRO_KERNEL_BODY(DOT)                            \
+    typedef typename V::Vec Vec;                                            \
+    const std::size_t NR = NV * V::width;                                   \
+    const unsigned char* pa = static_cast<const unsigned char*>(a);         \
+    const unsigned char* pb = static_cast<const unsigned char*>(b);         \
+    Vec acc[MR][NV];                                                        \
+    _Pragma("GCC unroll 16")                                                \
+    for(std::size_t i = 0; i < MR; ++i) {                                   \
+        _Pragma("GCC unroll 4")                                             \
+        for(std::size_t v = 0; v < NV; ++v) acc[i][v] = V::zero();          \
+    }                                                                       \
+    for(std::size_t g = 0; g < groups; ++g, pa += MR * kQuantizedGroupBytes, pb += NR * kQuantizedGroupBytes) { \
+        Vec bv[NV];                                                         \
+        _Pragma("GCC unroll 4")                                             \
+        for(std::size_t v = 0; v < NV; ++v) bv[v] = V::load(pb + v * V::width * kQuantizedGroupBytes); \
+        _Pragma("GCC unroll 16")                                            \
+        for(std::size_t i = 0; i < MR; ++i) {                               \
+            const Vec ai = V::broadcast(pa + i * kQuantizedGroupBytes);     \
+            _Pragma("GCC unroll 4")                                         \
+            for(std::size_t v = 0; v < NV; ++v) acc[i][v] = V::DOT(acc[i][v], ai, bv[v]); \
+        }                                                                   \
+    }                                                                       \
+    _Pragma("GCC unroll 16")                                                \
+    for(std::size_t i = 0; i < MR; ++i) {                                   \
+        _Pragma("GCC unroll 4")                                             \
+        for(std::size_t v = 0; v < NV; ++v) V::store(ab + i * NR + v * V::width, acc[i][v]); \
+    }
+
+template <class V, std::size_t MR, std::size_t NV>
+CPPMATH_SSE2
+void sse2WordKernel(std::size_t groups, const void* a, const void* b, std::int32_t* ab) {
+    CPPMATH_QUANTIZED_MICRO_KERNEL_BODY(dotWords)
+}
+
+template <class V, std::size_t MR, std::size_t NV>
+CPPMATH_AVX2
+void avx2WordKernel(std::size_t groups, const void* a, const void* b, std::int32_t* ab) {
+    CPPMATH_QUANTIZED_MICRO_KERNEL_BODY(dotWords)
+}
+
+template <class V, std::size_t MR, std::size_t NV>
+CPPMATH_AVX2_VNNI
+void avx2ByteKernel(std::size_t groups, const void* a, const void* b, std::int32_t* ab) {
+    CPPMATH_QUANTIZED_MICRO_KERNEL_BODY(dotBytes)
+}
+
+template <class V, std::size_t MR, std::size_t NV>
+CPPMATH_AVX512
+void avx512WordKernel(std::size_t groups, const void* a, const void* b, std::int32_t* ab) {
+    CPPMATH_QUANTIZED_MICRO_KERNEL_BODY(dotWords)
+}
+
+template <class V, std::size_t MR, std::size_t NV>
+CPPMATH_AVX512_VNNI
+void avx512ByteKernel(std::size_t groups, const void* a, const void* b, std::int32_t* ab) {
+    CPPMATH_QUANTIZED_MICRO_KERNEL_BODY(dotBytes)
+}
+
+#undef CPPMATH_QUANTIZED_MICRO_KERNEL_BODY
+
+#endif // CPPMATH_X86_DISPATCH
+
+QuantizedKernel makeKernel(std::size_t mr, std::size_t nr, QuantizedKernel::MicroKernel kernel) {
+    QuantizedKernel k;
+    k.mr = mr;
+    k.nr = nr;
+    k.kernel = kernel;
+    return k;
+}
+
+} // namespace
+
+QuantizedKernels quantizedKernels(cpu::InstructionSet isa, bool vnni) {
+    QuantizedKernels k;
+#if CPPMATH_X86_DISPATCH
+    switch(isa) {
+        case cpu::InstructionSet::AVX512:
+            k.words = makeKernel(12, 32, &avx512WordKernel<Avx512Int32, 12, 2>);
+            if(vnni) k.bytes = makeKernel(12, 32, &avx512ByteKernel<Avx512Int32, 12, 2>);
+            return k;
+        case cpu::InstructionSet::AVX2:
+            k.words = makeKernel(6, 16, &avx2WordKernel<Avx2Int32, 6, 2>);
+            if(vnni) k.bytes = makeKernel(6, 16, &avx2ByteKernel<Avx2Int32, 6, 2>);
+            return k;
+        case cpu::InstructionSet::SSE2:
+            k.words = makeKernel(4, 8, &sse2WordKernel<Sse2Int32, 4, 2>);
+            return k;
+        default: break;
+    }
+#endif
+    (void)isa;
+    (void)vnni;
+    k.words = makeKernel(4, 4, &quantizedGenericMicroKernel<std::int16_t, 4, 4>);
+    return k;
+}
+
+const QuantizedKernels& activeQuantizedKernels() {
+    static const QuantizedKernels kernels = [](){
+        const cpu::InstructionSet isa = cpu::instructionSet();
+        const cpu::Features& f = cpu::features();
+        return quantizedKernels(isa, isa == cpu::InstructionSet::AVX512 ? f.avx512vnni : f.avxvnni);
+    }();
+    return kernels;
+}
+
+} // namespace detail
+} //namespace matrix
+} //namespace cppmath
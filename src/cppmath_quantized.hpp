@@ -0,0 +1,376 @@
+//
+//  cppmath_quantized.hpp
+//  CppMath
+//
+//  Created by Dmytro Krasnianskyi on 17.10.26.
+//  Copyright © 2026 Dmytro Krasnianskyi. All rights reserved.
+//
+
+#ifndef cppmath_quantized_hpp
+#define cppmath_quantized_hpp
+
+#include <cstddef>
+#include <cstdint>
+#include <cassert>
+#include <vector>
+#include <utility>
+#include <algorithm>
+#include <type_traits>
+
+#include "cppmath_cpu.hpp"
+#include "cppmath_gemm.hpp"
+#include "cppmath_parallel.hpp"
+#include "cppmath_instrumentation.hpp"
+
+/** Quantized matrix multiply with int32 accumulation.
+
+    Operands hold affine quantized values, real = scale * (q - zeroPoint),
+    and the product (A - zA) * (B - zB) is accumulated exactly in int32.
+    Supported operand pairs are int8 x int8, uint8 x int8 and int16 x int16.
+
+    The driver packs an A block and a B panel like gemm, with the k values
+    of one multiply-add group next to each other:
+    - with VNNI, 8-bit operands are packed four k values per 32-bit lane and
+      multiplied with vpdpbusd (unsigned x signed bytes), a signed A is moved
+      to the unsigned range by adding 128 to the values and the zero points,
+    - otherwise operands are widened to int16 while packing, two k values per
+      lane, and multiplied with pmaddwd, which is exact for 8-bit inputs.
+    The whole k range is packed at once, so a micro-kernel call yields the
+    final sums of its tile and the zero point terms are applied right away.
+    The int32 sums wrap when |A - zA| * |B - zB| * k exceeds 2^31, for int16
+    operands that already happens at k = 2 with both values at -32768.
+ */
+
+namespace cppmath {
+namespace matrix{
+
+/** Quantization parameters of one operand: a single scale and zero point,
+    or one per channel, that is per row of the left operand and per column
+    of the right one.
+ */
+struct Quantization {
+    std::vector<float> scales;
+    std::vector<std::int32_t> zeroPoints;
+
+    Quantization(float scale = 1.0f, std::int32_t zeroPoint = 0): scales(1, scale), zeroPoints(1, zeroPoint) {}
+    Quantization(std::vector<float> channelScales, std::vector<std::int32_t> channelZeroPoints):
+        scales(std::move(channelScales)),
+        zeroPoints(std::move(channelZeroPoints))
+    {
+        assert(!scales.empty() && !zeroPoints.empty());
+    }
+
+    inline float scale(std::size_t channel) const { return scales[scales.size() == 1 ? 0 : channel]; }
+    inline std::int32_t zeroPoint(std::size_t channel) const { return zeroPoints[zeroPoints.size() == 1 ? 0 : channel]; }
+
+    /** Parameters of channels channels, each list has one entry or one per channel. */
+    inline bool fits(std::size_t channels) const {
+        return (scales.size() == 1 || scales.size() == channels) && (zeroPoints.size() == 1 || zeroPoints.size() == channels);
+    }
+};
+
+namespace detail {
+
+struct QuantizedKernel {
+    /** Computes the raw MR x NR int32 product of packed micro-panels over
+        groups of k values and stores it row-major (leading dimension NR)
+        into ab.
+     */
+    typedef void (*MicroKernel)(std::size_t groups, const void* a, const void* b, std::int32_t* ab);
+
+    std::size_t mr = 0;
+    std::size_t nr = 0;
+    MicroKernel kernel = nullptr;
+};
+
+struct QuantizedKernels {
+    /** uint8 x int8, four k values per group. Null without VNNI. */
+    QuantizedKernel bytes;
+    /** int16 x int16, two k values per group. */
+    QuantizedKernel words;
+};
+
+/** Every packed group takes 32 bits: four bytes or two words. */
+constexpr std::size_t kQuantizedGroupBytes = 4;
+
+template <typename P, std::size_t MR, std::size_t NR>
+void quantizedGenericMicroKernel(std::size_t groups, const void* a, const void* b, std::int32_t* ab) {
+    typedef typename std::conditional<std::is_same<P, std::uint8_t>::value, std::int8_t, P>::type Q;
+    const std::size_t G = kQuantizedGroupBytes / sizeof(P);
+    const P* pa = static_cast<const P*>(a);
+    const Q* pb = static_cast<const Q*>(b);
+    std::int32_t acc[MR][NR] = {};
+
+    for(std::size_t g = 0; g < groups; ++g, pa += MR * G, pb += NR * G) {
+        for(std::size_t i = 0; i < MR; ++i) {
+            for(std::size_t j = 0; j < NR; ++j) {
+                std::int32_t sum = 0;
+                for(std::size_t e = 0; e < G; ++e) sum += std::int32_t(pa[i * G + e]) * std::int32_t(pb[j * G + e]);
+                acc[i][j] += sum;
+            }
+        }
+    }
+
+    for(std::size_t i = 0; i < MR; ++i)
+        for(std::size_t j = 0; j < NR; ++j)
+            ab[i * NR + j] = acc[i][j];
+}
+
+/** Kernels for the given level, with vnni set the byte kernel uses the
+    VNNI dot product of that level.
+ */
+QuantizedKernels quantizedKernels(cpu::InstructionSet isa, bool vnni);
+
+/** Kernels for the running CPU, selected on the first use. */
+const QuantizedKernels& activeQuantizedKernels();
+
+struct QuantizedWorkspace {
+    GemmBuffer<std::uint8_t> packedA;
+    GemmBuffer<std::uint8_t> packedB;
+    GemmBuffer<std::int32_t> sumsA;
+    GemmBuffer<std::int32_t> sumsB;
+};
+
+/** Per thread packing buffers, see gemmWorkspace. */
+inline QuantizedWorkspace& quantizedWorkspace() {
+    static thread_local QuantizedWorkspace workspace;
+    return workspace;
+}
+
+/** Packs mb x k of A into micro-panels of mr rows: per group of G k values,
+    the G values of each row. Values are shifted by offset, padding is zero.
+ */
+template <typename P, typename S>
+void quantizedPackA(std::size_t mb, std::size_t k, const S* a, std::ptrdiff_t rsA, std::ptrdiff_t csA,
+                    std::size_t mr, std::int32_t offset, P* dst) {
+    const std::size_t G = kQuantizedGroupBytes / sizeof(P);
+    for(std::size_t ir = 0; ir < mb; ir += mr) {
+        const std::size_t rows = std::min(mr, mb - ir);
+        for(std::size_t p0 = 0; p0 < k; p0 += G) {
+            for(std::size_t i = 0; i < mr; ++i) {
+                const S* src = a + static_cast<std::ptrdiff_t>(ir + std::min(i, rows - 1)) * rsA;
+                for(std::size_t e = 0; e < G; ++e) {
+                    const std::size_t p = p0 + e;
+                    *dst++ = i < rows && p < k ?
+                             static_cast<P>(std::int32_t(src[static_cast<std::ptrdiff_t>(p) * csA]) + offset) : P();
+                }
+            }
+        }
+    }
+}
+
+/** Packs k x nb of B into micro-panels of nr columns: per group of G k
+    values, the G values of each column. Padding is zero.
+ */
+template <typename Q, typename S>
+void quantizedPackB(std::size_t k, std::size_t nb, const S* b, std::ptrdiff_t rsB, std::ptrdiff_t csB,
+                    std::size_t nr, Q* dst) {
+    const std::size_t G = kQuantizedGroupBytes / sizeof(Q);
+    for(std::size_t jr = 0; jr < nb; jr += nr) {
+        const std::size_t columns = std::min(nr, nb - jr);
+        for(std::size_t p0 = 0; p0 < k; p0 += G) {
+            for(std::size_t j = 0; j < nr; ++j) {
+                const S* src = b + static_cast<std::ptrdiff_t>(jr + std::min(j, columns - 1)) * csB;
+                for(std::size_t e = 0; e < G; ++e) {
+                    const std::size_t p = p0 + e;
+                    *dst++ = j < columns && p < k ? static_cast<Q>(src[static_cast<std::ptrdiff_t>(p) * rsB]) : Q();
+                }
+            }
+        }
+    }
+}
+
+/** sums[i] = sum over p of x[i * rs + p * cs] for i < count. */
+template <typename S>
+void quantizedSums(std::size_t count, std::size_t k, const S* x, std::ptrdiff_t rs, std::ptrdiff_t cs, std::int32_t* sums) {
+    for(std::size_t i = 0; i < count; ++i) {
+        const S* src = x + static_cast<std::ptrdiff_t>(i) * rs;
+        std::int32_t sum = 0;
+        for(std::size_t p = 0; p < k; ++p) sum += src[static_cast<std::ptrdiff_t>(p) * cs];
+        sums[i] = sum;
+    }
+}
+
+inline std::int32_t quantizedResult(std::int64_t value, float, std::int32_t*) {
+    return static_cast<std::int32_t>(value);
+}
+
+inline float quantizedResult(std::int64_t value, float scale, float*) {
+    return scale * static_cast<float>(value);
+}
+
+/** Below this many multiply-adds a product stays on the calling thread. */
+constexpr std::size_t kQuantizedParallelWork = std::size_t(1) << 22;
+
+/** Packed product of m x k A and k x n B with P/Q the packed element types
+    and offset the shift applied to the values of A while packing. Every
+    element of C is written once, as (A - zA) * (B - zB) converted by
+    quantizedResult.
+ */
+template <typename P, typename Q, typename SA, typename SB, typename Out>
+void quantizedGemm(std::size_t m, std::size_t n, std::size_t k,
+                   const SA* a, std::ptrdiff_t rsA, std::ptrdiff_t csA, const Quantization& qa, std::int32_t offset,
+                   const SB* b, std::ptrdiff_t rsB, std::ptrdiff_t csB, const Quantization& qb,
+                   Out* c, std::ptrdiff_t rsC, std::ptrdiff_t csC,
+                   const QuantizedKernel& kernel, const execution::ExecutionPolicy& policy) {
+    const std::size_t mr = kernel.mr;
+    const std::size_t nr = kernel.nr;
+    const std::size_t G = kQuantizedGroupBytes / sizeof(P);
+    const std::size_t groups = (k + G - 1) / G;
+    const std::size_t panelBytes = std::max<std::size_t>(groups, 1) * kQuantizedGroupBytes;
+
+    // A block of mc rows fills half of L2, a B panel of nc columns half of L3
+    const cpu::CacheSizes& caches = cpu::cacheSizes();
+    const std::size_t mc = std::min((m + mr - 1) / mr * mr, roundDown(caches.l2 / 2 / panelBytes, mr));
+    const std::size_t nc = roundDown(caches.l3 / 2 / panelBytes, nr);
+    const std::size_t packedASize = mc * panelBytes;
+    const std::size_t packedBSize = (std::min(nc, n) + nr - 1) / nr * nr * panelBytes;
+
+    QuantizedWorkspace& workspace = quantizedWorkspace();
+    GemmBufferLease<std::uint8_t> leaseB(workspace.packedB);
+    Q* packedB = reinterpret_cast<Q*>(leaseB.data(packedBSize));
+    GemmBufferLease<std::int32_t> leaseSumsA(workspace.sumsA);
+    std::int32_t* sumsA = leaseSumsA.data(m);
+    GemmBufferLease<std::int32_t> leaseSumsB(workspace.sumsB);
+    std::int32_t* sumsB = leaseSumsB.data(std::min(nc, n));
+    quantizedSums(m, k, a, rsA, csA, sumsA);
+
+    const std::size_t mBlocks = (m - 1) / mc + 1;
+    const std::size_t threads = policy.isParallel() && m * n * k >= kQuantizedParallelWork ?
+                                execution::defaultPool().concurrency() : 1;
+    const std::int64_t kk = static_cast<std::int64_t>(k);
+
+    for(std::size_t jc = 0; jc < n; jc += nc) {
+        const std::size_t nb = std::min(nc, n - jc);
+        const SB* bPanel = b + static_cast<std::ptrdiff_t>(jc) * csB;
+        quantizedPackB(k, nb, bPanel, rsB, csB, nr, packedB);
+        quantizedSums(nb, k, bPanel, csB, rsB, sumsB);
+
+        const std::size_t panels = (nb - 1) / nr + 1;
+        const std::size_t columnGroups = threads <= 1 ? 1 :
+                                         std::min(panels, std::max<std::size_t>(1, (2 * threads - 1) / mBlocks + 1));
+        execution::parallelFor(threads <= 1 ? execution::seq : policy, 0, mBlocks * columnGroups, 1,
+                               [&](std::size_t first, std::size_t last){
+            GemmBufferLease<std::uint8_t> leaseA(quantizedWorkspace().packedA);
+            P* packedA = reinterpret_cast<P*>(leaseA.data(packedASize));
+            std::int32_t tile[32 * 32];
+            assert(mr * nr <= 32 * 32);
+            std::size_t packed = mBlocks;
+
+            for(std::size_t task = first; task < last; ++task) {
+                const std::size_t block = task / columnGroups;
+                const std::size_t group = task % columnGroups;
+                const std::size_t ic = block * mc;
+                const std::size_t mb = std::min(mc, m - ic);
+                const std::size_t j0 = panels * group / columnGroups * nr;
+                const std::size_t j1 = std::min(nb, panels * (group + 1) / columnGroups * nr);
+                if(j0 >= j1) continue;
+                if(packed != block) {
+                    quantizedPackA(mb, k, a + static_cast<std::ptrdiff_t>(ic) * rsA, rsA, csA, mr, offset, packedA);
+                    packed = block;
+                }
+
+                for(std::size_t jr = j0; jr < j1; jr += nr) {
+                    const std::size_t columns = std::min(nr, j1 - jr);
+                    for(std::size_t ir = 0; ir < mb; ir += mr) {
+                        const std::size_t rows = std::min(mr, mb - ir);
+                        kernel.kernel(groups, packedA + ir * groups * G, packedB + jr * groups * G, tile);
+
+                        // sum (a + offset - zA - offset)(b - zB) from the raw sum over the shifted a
+                        for(std::size_t i = 0; i < rows; ++i) {
+                            const std::size_t row = ic + ir + i;
+                            const std::int64_t za = std::int64_t(qa.zeroPoint(row)) + offset;
+                            const std::int64_t rowSum = std::int64_t(sumsA[row]) + std::int64_t(offset) * kk;
+                            Out* cRow = c + static_cast<std::ptrdiff_t>(row) * rsC;
+                            for(std::size_t j = 0; j < columns; ++j) {
+                                const std::size_t column = jc + jr + j;
+                                const std::int64_t zb = qb.zeroPoint(column);
+                                const std::int64_t value = std::int64_t(tile[i * nr + j]) - za * sumsB[jr + j] - zb * rowSum + kk * za * zb;
+                                cRow[static_cast<std::ptrdiff_t>(column) * csC] =
+                                    quantizedResult(value, qa.scale(row) * qb.scale(column), static_cast<Out*>(nullptr));
+                            }
+                        }
+                    }
+                }
+            }
+        });
+    }
+}
+
+template <typename SA, typename SB, typename Out>
+void quantizedGemm(std::size_t m, std::size_t n, std::size_t k,
+                   const SA* a, std::ptrdiff_t rsA, std::ptrdiff_t csA, const Quantization& qa,
+                   const SB* b, std::ptrdiff_t rsB, std::ptrdiff_t csB, const Quantization& qb,
+                   Out* c, std::ptrdiff_t rsC, std::ptrdiff_t csC,
+                   const QuantizedKernels& kernels, const execution::ExecutionPolicy& policy) {
+    if(m == 0 || n == 0) return;
+    if(sizeof(SA) == 1 && kernels.bytes.kernel) {
+        const std::int32_t offset = std::is_signed<SA>::value ? 128 : 0;
+        quantizedGemm<std::uint8_t, std::int8_t>(m, n, k, a, rsA, csA, qa, offset, b, rsB, csB, qb,
+                                                 c, rsC, csC, kernels.bytes, policy);
+    } else {
+        quantizedGemm<std::int16_t, std::int16_t>(m, n, k, a, rsA, csA, qa, 0, b, rsB, csB, qb,
+                                                  c, rsC, csC, kernels.words, policy);
+    }
+}
+
+template <typename SA, typename SB>
+struct IsQuantizedPair: std::integral_constant<bool,
+    ((std::is_same<SA, std::int8_t>::value || std::is_same<SA, std::uint8_t>::value) && std::is_same<SB, std::int8_t>::value) ||
+    (std::is_same<SA, std::int16_t>::value && std::is_same<SB, std::int16_t>::value)> {};
+
+template <class A, class B, class C>
+using EnableIfQuantized = typename std::enable_if<
+    IsMatrixLike<A>::value && IsMatrixLike<B>::value && IsMatrixLike<C>::value &&
+    IsQuantizedPair<typename MatrixValueType<A>::type, typename MatrixValueType<B>::type>::value &&
+    (std::is_same<typename MatrixValueType<C>::type, std::int32_t>::value ||
+     std::is_same<typename MatrixValueType<C>::type, float>::value)>::type;
+
+} // namespace detail
+
+/** C = (A - zA) * (B - zB) with the zero points of qa per row of A and of
+    qb per column of B. An int32 C receives the exact integer sums, a float C
+    the dequantized product scaleA(i) * scaleB(j) * sum. C must already have
+    A.rows() x B.columns() shape and is overwritten. Without a policy large
+    products run in parallel.
+ */
+template <class A, class B, class C>
+detail::EnableIfQuantized<A, B, C> quantizedMultiply(const execution::ExecutionPolicy& policy,
+                                                     const A& a, const Quantization& qa,
+                                                     const B& b, const Quantization& qb, C&& c) {
+    typedef typename MatrixValueType<A>::type SA;
+    typedef typename MatrixValueType<B>::type SB;
+    typedef typename MatrixValueType<C>::type Out;
+    const ConstMatrixView<SA> va = constView(a);
+    const ConstMatrixView<SB> vb = constView(b);
+    const MatrixView<Out> vc = mutableView(c);
+
+    assert(va.columns() == vb.rows());
+    assert(vc.rows() == va.rows() && vc.columns() == vb.columns());
+    assert(qa.fits(va.rows()) && qb.fits(vb.columns()));
+
+    const instrumentation::ScopedOperation counted(instrumentation::Operation::Gemm,
+                                                   2.0 * va.rows() * vb.columns() * va.columns());
+    detail::quantizedGemm(va.rows(), vb.columns(), va.columns(),
+                          va.data(), va.rowStride(), va.columnStride(), qa,
+                          vb.data(), vb.rowStride(), vb.columnStride(), qb,
+                          vc.data(), vc.rowStride(), vc.columnStride(),
+                          detail::activeQuantizedKernels(), policy);
+}
+
+template <class A, class B, class C>
+detail::EnableIfQuantized<A, B, C> quantizedMultiply(const A& a, const Quantization& qa,
+                                                     const B& b, const Quantization& qb, C&& c) {
+    quantizedMultiply(execution::par, a, qa, b, qb, std::forward<C>(c));
+}
+
+/** Raw integer product without zero points, C = A * B. */
+template <class A, class B, class C>
+detail::EnableIfQuantized<A, B, C> quantizedMultiply(const A& a, const B& b, C&& c) {
+    quantizedMultiply(execution::par, a, Quantization(), b, Quantization(), std::forward<C>(c));
+}
+
+} //namespace matrix
+} //namespace cppmath
+
+#endif /* cppmath_quantized_hpp */
@@ -0,0 +1,221 @@
+//
+//  cppmath_reduction.cpp
+//  CppMath
+//
+//  Created by Dmytro Krasnianskyi on 17.10.26.
+//  Copyright © 2026 Dmytro Krasnianskyi. All rights reserved.
+//
+
+#include "cppmath_reduction.hpp"
+#include "cppmath_simd.hpp"
+
+namespace cppmath{
+namespace matrix{
+namespace detail {
+
+namespace {
+
+#if CPPMATH_X86_DISPATCH
+
+using namespace simd;
+
+/** The same kernel set is stamped out for every level, only the target
+    attribute differs. Spans run four independent vector accumulators (two
+    sum and compensation pairs for Kahan) so that the adds are not bound by
+    their latency; tails are finished with the scalar code.
+ */
+#define CPPMATH_REDUCTION_KERNELS(PREFIX, TARGET)                                       \
+template <class V, ReductionOp Op>                                                      \
+TARGET inline typename V::Vec PREFIX##Term(typename V::Vec x, typename V::Vec shift) {  \
+    if(Op == ReductionOp::Sum) return x;                                                \
+    if(Op == ReductionOp::SumSquares) {                                                 \
+        const typename V::Vec d = V::sub(x, shift);                                     \
+        return V::mul(d, d);                                                            \
+    }                                                                                   \
+    return V::abs(x);                                                                   \
+}                                                                                       \
+template <class V, ReductionOp Op>                                                      \
+TARGET inline typename V::Vec PREFIX##Combine(typename V::Vec a, typename V::Vec b) {   \
+    return Op == ReductionOp::MaxAbs ? V::max(a, b) : V::add(a, b);                     \
+}                                                                                       \
+template <class V, ReductionOp Op, typename T>                                          \
+TARGET T PREFIX##Horizontal(typename V::Vec v) {                                        \
+    if(Op != ReductionOp::MaxAbs) return V::reduce(v);                                  \
+    T lanes[V::width];                                                                  \
+    V::store(lanes, v);                                                                 \
+    T result = lanes[0];                                                                \
+    for(std::size_t i = 1; i < V::width; ++i) result = std::max(result, lanes[i]);      \
+    return result;                                                                      \
+}                                                                                       \
+template <class V, ReductionOp Op, typename T>                                          \
+TARGET T PREFIX##Span(const T* x, std::size_t n, T shift) {                             \
+    typedef typename V::Vec Vec;                                                        \
+    const std::size_t w = V::width;                                                     \
+    const Vec vs = V::set1(shift);                                                      \
+    Vec acc0 = V::zero(), acc1 = V::zero(), acc2 = V::zero(), acc3 = V::zero();         \
+    std::size_t i = 0;                                                                  \
+    for(; i + 4 * w <= n; i += 4 * w) {                                                 \
+        acc0 = PREFIX##Combine<V, Op>(acc0, PREFIX##Term<V, Op>(V::load(x + i), vs));   \
+        acc1 = PREFIX##Combine<V, Op>(acc1, PREFIX##Term<V, Op>(V::load(x + i + w), vs)); \
+        acc2 = PREFIX##Combine<V, Op>(acc2, PREFIX##Term<V, Op>(V::load(x + i + 2 * w), vs)); \
+        acc3 = PREFIX##Combine<V, Op>(acc3, PREFIX##Term<V, Op>(V::load(x + i + 3 * w), vs)); \
+    }                                                                                   \
+    for(; i + w <= n; i += w) acc0 = PREFIX##Combine<V, Op>(acc0, PREFIX##Term<V, Op>(V::load(x + i), vs)); \
+    const Vec acc = PREFIX##Combine<V, Op>(PREFIX##Combine<V, Op>(acc0, acc1), PREFIX##Combine<V, Op>(acc2, acc3)); \
+    T result = PREFIX##Horizontal<V, Op, T>(acc);                                       \
+    for(; i < n; ++i) result = reductionCombine<Op>(result, reductionTerm<Op>(x[i], shift)); \
+    return result;                                                                      \
+}                                                                                       \
+template <class V>                                                                      \
+TARGET inline void PREFIX##CompensatedAdd(typename V::Vec& sum, typename V::Vec& compensation, typename V::Vec x) { \
+    const typename V::Vec t = V::add(sum, x);                                           \
+    const typename V::Mask larger = V::greater(V::abs(x), V::abs(sum));                 \
+    const typename V::Vec big = V::select(larger, x, sum);                              \
+    const typename V::Vec small = V::select(larger, sum, x);                            \
+    compensation = V::add(compensation, V::add(V::sub(big, t), small));                 \
+    sum = t;                                                                            \
+}                                                                                       \
+template <class V, ReductionOp Op, typename T>                                          \
+TARGET T PREFIX##KahanSpan(const T* x, std::size_t n, T shift) {                        \
+    typedef typename V::Vec Vec;                                                        \
+    const std::size_t w = V::width;                                                     \
+    const Vec vs = V::set1(shift);                                                      \
+    Vec sum0 = V::zero(), sum1 = V::zero(), c0 = V::zero(), c1 = V::zero();             \
+    std::size_t i = 0;                                                                  \
+    for(; i + 2 * w <= n; i += 2 * w) {                                                 \
+        PREFIX##CompensatedAdd<V>(sum0, c0, PREFIX##Term<V, Op>(V::load(x + i), vs));   \
+        PREFIX##CompensatedAdd<V>(sum1, c1, PREFIX##Term<V, Op>(V::load(x + i + w), vs)); \
+    }                                                                                   \
+    T lanes[4 * V::width];                                                              \
+    V::store(lanes, sum0);                                                              \
+    V::store(lanes + w, sum1);                                                          \
+    V::store(lanes + 2 * w, c0);                                                        \
+    V::store(lanes + 3 * w, c1);                                                        \
+    T sum = T(0);                                                                       \
+    T compensation = T(0);                                                              \
+    for(std::size_t l = 0; l < 4 * w; ++l) compensatedAdd(sum, compensation, lanes[l]); \
+    for(; i < n; ++i) compensatedAdd(sum, compensation, reductionTerm<Op>(x[i], shift)); \
+    return sum + compensation;                                                          \
+}                                                                                       \
+template <class V, ReductionOp Op, typename T>                                          \
+TARGET void PREFIX##Accumulate(const T* row, const T* shift, T* acc, T*, std::size_t n) { \
+    const std::size_t w = V::width;                                                     \
+    std::size_t i = 0;                                                                  \
+    for(; i + w <= n; i += w) {                                                         \
+        const typename V::Vec s = shift ? V::load(shift + i) : V::zero();               \
+        V::store(acc + i, PREFIX##Combine<V, Op>(V::load(acc + i), PREFIX##Term<V, Op>(V::load(row + i), s))); \
+    }                                                                                   \
+    for(; i < n; ++i) acc[i] = reductionCombine<Op>(acc[i], reductionTerm<Op>(row[i], shift ? shift[i] : T(0))); \
+}                                                                                       \
+template <class V, ReductionOp Op, typename T>                                          \
+TARGET void PREFIX##KahanAccumulate(const T* row, const T* shift, T* acc, T* compensation, std::size_t n) { \
+    typedef typename V::Vec Vec;                                                        \
+    const std::size_t w = V::width;                                                     \
+    std::size_t i = 0;                                                                  \
+    for(; i + w <= n; i += w) {                                                         \
+        const Vec s = shift ? V::load(shift + i) : V::zero();                           \
+        Vec sum = V::load(acc + i);                                                     \
+        Vec c = V::load(compensation + i);                                              \
+        PREFIX##CompensatedAdd<V>(sum, c, PREFIX##Term<V, Op>(V::load(row + i), s));    \
+        V::store(acc + i, sum);                                                         \
+        V::store(compensation + i, c);                                                  \
+    }                                                                                   \
+    genericKahanAccumulate<Op>(row + i, shift ? shift + i : nullptr, acc + i, compensation + i, n - i); \
+}                                                                                       \
+template <class V, typename T>                                                          \
+TARGET void PREFIX##Extremes(const T* x, std::size_t n, T* minimum, T* maximum) {       \
+    typedef typename V::Vec Vec;                                                        \
+    const std::size_t w = V::width;                                                     \
+    if(n < 2 * w) {                                                                     \
+        genericExtremes(x, n, minimum, maximum);                                        \
+        return;                                                                         \
+    }                                                                                   \
+    Vec lo0 = V::load(x), lo1 = V::load(x + w);                                         \
+    Vec hi0 = lo0, hi1 = lo1;                                                           \
+    std::size_t i = 2 * w;                                                              \
+    for(; i + 2 * w <= n; i += 2 * w) {                                                 \
+        const Vec a = V::load(x + i);                                                   \
+        const Vec b = V::load(x + i + w);                                               \
+        lo0 = V::min(lo0, a);                                                           \
+        lo1 = V::min(lo1, b);                                                           \
+        hi0 = V::max(hi0, a);                                                           \
+        hi1 = V::max(hi1, b);                                                           \
+    }                                                                                   \
+    T lanes[2 * V::width];                                                              \
+    V::store(lanes, V::min(lo0, lo1));                                                  \
+    V::store(lanes + w, V::max(hi0, hi1));                                              \
+    T lo = lanes[0];                                                                    \
+    T hi = lanes[w];                                                                    \
+    for(std::size_t l = 1; l < w; ++l) {                                                \
+        lo = lanes[l] < lo ? lanes[l] : lo;                                             \
+        hi = lanes[w + l] > hi ? lanes[w + l] : hi;                                     \
+    }                                                                                   \
+    for(; i < n; ++i) {                                                                 \
+        lo = x[i] < lo ? x[i] : lo;                                                     \
+        hi = x[i] > hi ? x[i] : hi;                                                     \
+    }                                                                                   \
+    *minimum = lo;                                                                      \
+    *maximum = hi;                                                                      \
+}                                                                                       \
+template <class V, typename T = typename V::value_type>                                 \
+ReductionKernels<T> PREFIX##Kernels() {                                                 \
+    ReductionKernels<T> k;                                                              \
+    k.span[0] = &PREFIX##Span<V, ReductionOp::Sum, T>;                                  \
+    k.span[1] = &PREFIX##Span<V, ReductionOp::SumAbs, T>;                               \
+    k.span[2] = &PREFIX##Span<V, ReductionOp::SumSquares, T>;                           \
+    k.span[3] = &PREFIX##Span<V, ReductionOp::MaxAbs, T>;                               \
+    k.kahanSpan[0] = &PREFIX##KahanSpan<V, ReductionOp::Sum, T>;                        \
+    k.kahanSpan[1] = &PREFIX##KahanSpan<V, ReductionOp::SumAbs, T>;                     \
+    k.kahanSpan[2] = &PREFIX##KahanSpan<V, ReductionOp::SumSquares, T>;                 \
+    k.kahanSpan[3] = k.span[3];                                                         \
+    k.accumulate[0] = &PREFIX##Accumulate<V, ReductionOp::Sum, T>;                      \
+    k.accumulate[1] = &PREFIX##Accumulate<V, ReductionOp::SumAbs, T>;                   \
+    k.accumulate[2] = &PREFIX##Accumulate<V, ReductionOp::SumSquares, T>;               \
+    k.accumulate[3] = &PREFIX##Accumulate<V, ReductionOp::MaxAbs, T>;                   \
+    k.kahanAccumulate[0] = &PREFIX##KahanAccumulate<V, ReductionOp::Sum, T>;            \
+    k.kahanAccumulate[1] = &PREFIX##KahanAccumulate<V, ReductionOp::SumAbs, T>;         \
+    k.kahanAccumulate[2] = &PREFIX##KahanAccumulate<V, ReductionOp::SumSquares, T>;     \
+    k.kahanAccumulate[3] = k.accumulate[3];                                             \
+    k.extremes = &PREFIX##Extremes<V, T>;                                               \
+    return k;                                                                           \
+}
+
+CPPMATH_REDUCTION_KERNELS(sse2, CPPMATH_SSE2)
+CPPMATH_REDUCTION_KERNELS(avx2, CPPMATH_AVX2)
+CPPMATH_REDUCTION_KERNELS(avx512, CPPMATH_AVX512)
+
+#undef CPPMATH_REDUCTION_KERNELS
+
+#endif // CPPMATH_X86_DISPATCH
+
+} // namespace
+
+template <> ReductionKernels<float> reductionKernels<float>(cpu::InstructionSet isa) {
+#if CPPMATH_X86_DISPATCH
+    switch(isa) {
+        case cpu::InstructionSet::AVX512: return avx512Kernels<Avx512Float>();
+        case cpu::InstructionSet::AVX2: return avx2Kernels<Avx2Float>();
+        case cpu::InstructionSet::SSE2: return sse2Kernels<Sse2Float>();
+        default: break;
+    }
+#endif
+    (void)isa;
+    return genericReductionKernels<float>();
+}
+
+template <> ReductionKernels<double> reductionKernels<double>(cpu::InstructionSet isa) {
+#if CPPMATH_X86_DISPATCH
+    switch(isa) {
+        case cpu::InstructionSet::AVX512: return avx512Kernels<Avx512Double>();
+        case cpu::InstructionSet::AVX2: return avx2Kernels<Avx2Double>();
+        case cpu::InstructionSet::SSE2: return sse2Kernels<Sse2Double>();
+        default: break;
+    }
+#endif
+    (void)isa;
+    return genericReductionKernels<double>();
+}
+
+} // namespace detail
+} //namespace matrix
+} //namespace cppmath
@@ -0,0 +1,857 @@
+//
+//  cppmath_reduction.hpp
+//  CppMath
+//
+//  Created by Dmytro Krasnianskyi on 17.10.26.
+//  Copyright © 2026 Dmytro Krasnianskyi. All rights reserved.
+//
+
+#ifndef cppmath_reduction_hpp
+#define cppmath_reduction_hpp
+
+#include <cstddef>
+#include <cassert>
+#include <cmath>
+#include <vector>
+#include <utility>
+#include <algorithm>
+#include <type_traits>
+
+#include "cppmath_cpu.hpp"
+#include "cppmath_matrix.hpp"
+#include "cppmath_parallel.hpp"
+#include "cppmath_instrumentation.hpp"
+
+/** Sums, extrema, means, variances and norms of a whole matrix or of each of
+    its rows or columns.
+
+    The kernels read contiguous runs only: dense storage is cut into equal
+    spans, other views are read row by row, and views whose columns are the
+    contiguous direction are reduced through their transpose. Per column
+    results never walk a column; whole rows are accumulated into a vector of
+    column results instead. float and double run SSE2/AVX2/AVX-512 kernels
+    with several vector accumulators, other arithmetic types the portable
+    loops below. Spans are cut independently of the thread count, so results
+    do not depend on the policy.
+
+    Summation::Pairwise, the default, sums blocks of kPairwiseBlock elements
+    in the vector accumulators and adds the block sums pairwise, which keeps
+    the error growing with the logarithm of the count at the speed of a plain
+    loop. Kahan carries a compensation per lane and is about half as fast.
+    Fast runs one pass of the accumulators. NaN elements leave extrema and
+    sums unspecified.
+ */
+
+namespace cppmath {
+namespace matrix{
+
+enum class Summation: int {
+    Fast = 0,
+    Pairwise,
+    Kahan
+};
+
+/** The direction reduced away: Rows gives one result per row, Columns one
+    result per column.
+ */
+enum class Axis: int {
+    Rows = 0,
+    Columns
+};
+
+/** Entrywise norms: L1 sums magnitudes, L2 and Frobenius are the square root
+    of the sum of squares, Infinity is the largest magnitude.
+ */
+enum class Norm: int {
+    L1 = 0,
+    L2,
+    Frobenius,
+    Infinity
+};
+
+template <typename T>
+struct Extremum {
+    T value = T();
+    MatrixPoint point;
+};
+
+template <typename T>
+struct Extrema {
+    Extremum<T> minimum;
+    Extremum<T> maximum;
+};
+
+namespace detail {
+
+/** Sum adds x, SumAbs |x|, SumSquares (x - shift)^2 and MaxAbs keeps the
+    largest |x|. Only SumSquares reads the shift.
+ */
+enum class ReductionOp: int {
+    Sum = 0,
+    SumAbs,
+    SumSquares,
+    MaxAbs
+};
+
+constexpr std::size_t kReductionOps = 4;
+
+template <typename T>
+struct ReductionKernels {
+    /** op over x[0, n) */
+    typedef T (*Span)(const T* x, std::size_t n, T shift);
+    /** acc[i] = acc[i] op row[i], shift[i] for SumSquares or zero when null.
+        The Kahan versions keep the running compensation in compensation[i],
+        the total is acc[i] + compensation[i].
+     */
+    typedef void (*Accumulate)(const T* row, const T* shift, T* acc, T* compensation, std::size_t n);
+    /** smallest and largest of x[0, n), n > 0 */
+    typedef void (*Extremes)(const T* x, std::size_t n, T* minimum, T* maximum);
+
+    Span span[kReductionOps] = {};
+    Span kahanSpan[kReductionOps] = {};
+    Accumulate accumulate[kReductionOps] = {};
+    Accumulate kahanAccumulate[kReductionOps] = {};
+    Extremes extremes = nullptr;
+};
+
+template <typename T>
+inline T magnitude(T x, std::true_type) { return x < T(0) ? T(-x) : x; }
+
+template <typename T>
+inline T magnitude(T x, std::false_type) { return x; }
+
+template <typename T>
+inline T magnitude(T x) { return magnitude(x, std::integral_constant<bool, std::is_signed<T>::value>()); }
+
+template <ReductionOp Op, typename T>
+inline T reductionTerm(T x, T shift) {
+    if(Op == ReductionOp::Sum) return x;
+    if(Op == ReductionOp::SumSquares) {
+        const T d = T(x - shift);
+        return T(d * d);
+    }
+    return magnitude(x);
+}
+
+template <ReductionOp Op, typename T>
+inline T reductionCombine(T a, T b) {
+    return Op == ReductionOp::MaxAbs ? std::max(a, b) : T(a + b);
+}
+
+template <ReductionOp Op, typename T>
+T genericReductionSpan(const T* x, std::size_t n, T shift) {
+    T acc = T(0);
+    for(std::size_t i = 0; i < n; ++i) acc = reductionCombine<Op>(acc, reductionTerm<Op>(x[i], shift));
+    return acc;
+}
+
+/** sum + compensation tracks the exact total: every add keeps the rounding
+    error of the larger operand (Neumaier's form of Kahan summation, which
+    also survives terms larger than the running sum).
+ */
+template <typename T>
+inline void compensatedAdd(T& sum, T& compensation, T x) {
+    const T t = sum + x;
+    compensation += magnitude(sum) >= magnitude(x) ? (sum - t) + x : (x - t) + sum;
+    sum = t;
+}
+
+template <ReductionOp Op, typename T>
+T genericKahanSpan(const T* x, std::size_t n, T shift) {
+    T sum = T(0);
+    T compensation = T(0);
+    for(std::size_t i = 0; i < n; ++i) compensatedAdd(sum, compensation, reductionTerm<Op>(x[i], shift));
+    return sum + compensation;
+}
+
+template <ReductionOp Op, typename T>
+void genericReductionAccumulate(const T* row, const T* shift, T* acc, T*, std::size_t n) {
+    for(std::size_t i = 0; i < n; ++i) acc[i] = reductionCombine<Op>(acc[i], reductionTerm<Op>(row[i], shift ? shift[i] : T(0)));
+}
+
+template <ReductionOp Op, typename T>
+void genericKahanAccumulate(const T* row, const T* shift, T* acc, T* compensation, std::size_t n) {
+    for(std::size_t i = 0; i < n; ++i) compensatedAdd(acc[i], compensation[i], reductionTerm<Op>(row[i], shift ? shift[i] : T(0)));
+}
+
+template <typename T>
+void genericExtremes(const T* x, std::size_t n, T* minimum, T* maximum) {
+    T lo = x[0];
+    T hi = x[0];
+    for(std::size_t i = 1; i < n; ++i) {
+        lo = x[i] < lo ? x[i] : lo;
+        hi = x[i] > hi ? x[i] : hi;
+    }
+    *minimum = lo;
+    *maximum = hi;
+}
+
+template <typename T>
+ReductionKernels<T> genericReductionKernels() {
+    ReductionKernels<T> k;
+    k.span[0] = &genericReductionSpan<ReductionOp::Sum, T>;
+    k.span[1] = &genericReductionSpan<ReductionOp::SumAbs, T>;
+    k.span[2] = &genericReductionSpan<ReductionOp::SumSquares, T>;
+    k.span[3] = &genericReductionSpan<ReductionOp::MaxAbs, T>;
+    k.kahanSpan[0] = &genericKahanSpan<ReductionOp::Sum, T>;
+    k.kahanSpan[1] = &genericKahanSpan<ReductionOp::SumAbs, T>;
+    k.kahanSpan[2] = &genericKahanSpan<ReductionOp::SumSquares, T>;
+    k.kahanSpan[3] = k.span[3];
+    k.accumulate[0] = &genericReductionAccumulate<ReductionOp::Sum, T>;
+    k.accumulate[1] = &genericReductionAccumulate<ReductionOp::SumAbs, T>;
+    k.accumulate[2] = &genericReductionAccumulate<ReductionOp::SumSquares, T>;
+    k.accumulate[3] = &genericReductionAccumulate<ReductionOp::MaxAbs, T>;
+    k.kahanAccumulate[0] = &genericKahanAccumulate<ReductionOp::Sum, T>;
+    k.kahanAccumulate[1] = &genericKahanAccumulate<ReductionOp::SumAbs, T>;
+    k.kahanAccumulate[2] = &genericKahanAccumulate<ReductionOp::SumSquares, T>;
+    k.kahanAccumulate[3] = k.accumulate[3];
+    k.extremes = &genericExtremes<T>;
+    return k;
+}
+
+/** Kernels for the given instruction set level. The generic template
+    ignores the level, float and double have SIMD specializations.
+ */
+template <typename T>
+inline ReductionKernels<T> reductionKernels(cpu::InstructionSet) {
+    return genericReductionKernels<T>();
+}
+
+template <> ReductionKernels<float> reductionKernels<float>(cpu::InstructionSet isa);
+template <> ReductionKernels<double> reductionKernels<double>(cpu::InstructionSet isa);
+
+/** Kernels for the running CPU, selected on the first use. */
+template <typename T>
+inline const ReductionKernels<T>& activeReductionKernels() {
+    static const ReductionKernels<T> kernels = reductionKernels<T>(cpu::instructionSet());
+    return kernels;
+}
+
+/** Elements per span and per task. */
+constexpr std::size_t kReductionGrain = std::size_t(1) << 15;
+/** Elements summed in the vector accumulators before pairwise addition. */
+constexpr std::size_t kPairwiseBlock = 1024;
+/** Rows added into a column accumulator before pairwise addition. */
+constexpr std::size_t kPairwiseRows = 64;
+/** Columns per task of the per column reductions. */
+constexpr std::size_t kReductionColumns = 512;
+/** Elements per extremes call, small enough to search again from L1. */
+constexpr std::size_t kExtremaBlock = 2048;
+
+template <typename T>
+T pairwiseSpan(typename ReductionKernels<T>::Span leaf, const T* x, std::size_t n, T shift) {
+    if(n <= kPairwiseBlock) return leaf(x, n, shift);
+    const std::size_t half = std::max(kPairwiseBlock, n / 2 / kPairwiseBlock * kPairwiseBlock);
+    return pairwiseSpan(leaf, x, half, shift) + pairwiseSpan(leaf, x + half, n - half, shift);
+}
+
+template <typename T>
+T reduceSpan(const ReductionKernels<T>& kernels, ReductionOp op, Summation summation,
+             const T* x, std::size_t n, T shift) {
+    const std::size_t i = static_cast<std::size_t>(op);
+    if(op == ReductionOp::MaxAbs || summation == Summation::Fast) return kernels.span[i](x, n, shift);
+    if(summation == Summation::Kahan) return kernels.kahanSpan[i](x, n, shift);
+    return pairwiseSpan(kernels.span[i], x, n, shift);
+}
+
+/** values[0, n) added in the given mode, or their maximum for MaxAbs. */
+template <typename T>
+T combineValues(ReductionOp op, Summation summation, const T* values, std::size_t n) {
+    if(op == ReductionOp::MaxAbs) return genericReductionSpan<ReductionOp::MaxAbs>(values, n, T(0));
+    if(summation == Summation::Kahan) return genericKahanSpan<ReductionOp::Sum>(values, n, T(0));
+    if(summation == Summation::Pairwise && n > 2) {
+        const std::size_t half = n / 2;
+        return combineValues(op, summation, values, half) + combineValues(op, summation, values + half, n - half);
+    }
+    return genericReductionSpan<ReductionOp::Sum>(values, n, T(0));
+}
+
+/** The elements of a view with contiguous rows as spans of at most
+    kReductionGrain elements: the whole storage as one line when it is dense,
+    otherwise every row is a line. Lines are cut into equal pieces.
+ */
+template <typename T>
+struct ReductionSpans {
+    explicit ReductionSpans(const ConstMatrixView<T>& view):
+        data(view.data()),
+        lines(view.isContiguous() ? 1 : view.rows()),
+        length(view.isContiguous() ? view.size() : view.columns()),
+        pieces(length == 0 ? 0 : (length - 1) / kReductionGrain + 1),
+        stride(view.rowStride())
+    {}
+
+    std::size_t count() const { return lines * pieces; }
+    const T* begin(std::size_t s) const {
+        return data + static_cast<std::ptrdiff_t>(s / pieces) * stride + (s % pieces) * kReductionGrain;
+    }
+    std::size_t size(std::size_t s) const { return std::min(kReductionGrain, length - (s % pieces) * kReductionGrain); }
+    /** Row-major position of the first element of span s. */
+    std::size_t position(std::size_t s) const { return (s / pieces) * length + (s % pieces) * kReductionGrain; }
+    /** Spans per task, so that short rows are not handed out one by one. */
+    std::size_t group() const { return std::max<std::size_t>(1, kReductionGrain / std::max<std::size_t>(length, 1)); }
+
+    const T* data;
+    std::size_t lines;
+    std::size_t length;
+    std::size_t pieces;
+    std::ptrdiff_t stride;
+};
+
+template <typename T>
+T reduceSpanRange(const ReductionKernels<T>& kernels, const ReductionSpans<T>& spans, std::size_t first, std::size_t last,
+                  ReductionOp op, Summation summation, T shift) {
+    if(last - first == 1) return reduceSpan(kernels, op, summation, spans.begin(first), spans.size(first), shift);
+    if(summation == Summation::Pairwise && op != ReductionOp::MaxAbs) {
+        const std::size_t middle = first + (last - first) / 2;
+        return reduceSpanRange(kernels, spans, first, middle, op, summation, shift) +
+               reduceSpanRange(kernels, spans, middle, last, op, summation, shift);
+    }
+    const std::size_t chunk = 64;
+    T values[chunk];
+    T partials[chunk];
+    std::size_t count = 0;
+    for(std::size_t s = first; s < last; s += chunk) {
+        const std::size_t n = std::min(chunk, last - s);
+        for(std::size_t i = 0; i < n; ++i) values[i] = reduceSpan(kernels, op, summation, spans.begin(s + i), spans.size(s + i), shift);
+        partials[count++] = combineValues(op, summation, values, n);
+        if(count == chunk) {
+            partials[0] = combineValues(op, summation, partials, count);
+            count = 1;
+        }
+    }
+    return combineValues(op, summation, partials, count);
+}
+
+/** Per task results, on the stack unless there are many. */
+template <typename T>
+class ReductionPartials {
+public:
+    explicit ReductionPartials(std::size_t count) {
+        if(count > kLocal) {
+            m_heap.resize(count);
+            m_data = m_heap.data();
+        }
+    }
+    T* data() noexcept { return m_data; }
+    T& operator [] (std::size_t i) noexcept { return m_data[i]; }
+
+private:
+    static constexpr std::size_t kLocal = 64;
+    T m_local[kLocal];
+    std::vector<T> m_heap;
+    T* m_data = m_local;
+};
+
+/** The view reduced in place of a: a itself when its rows are contiguous,
+    its transpose when its columns are. transposed reports which one.
+ */
+template <typename T>
+inline bool readableView(ConstMatrixView<T>& a, bool& transposed) {
+    transposed = false;
+    if(a.hasContiguousRows()) return true;
+    if(!a.transposed().hasContiguousRows()) return false;
+    a = a.transposed();
+    transposed = true;
+    return true;
+}
+
+template <typename T>
+T reduceAll(const execution::ExecutionPolicy& policy, ConstMatrixView<T> a, ReductionOp op, Summation summation, T shift) {
+    bool transposed = false;
+    if(!readableView(a, transposed)) {
+        const Matrix<T> copy(a);
+        return reduceAll(policy, constView(copy), op, summation, shift);
+    }
+    const ReductionKernels<T>& kernels = activeReductionKernels<T>();
+    const ReductionSpans<T> spans(a);
+    const std::size_t group = spans.group();
+    const std::size_t tasks = (spans.count() + group - 1) / group;
+    ReductionPartials<T> partials(tasks);
+    execution::parallelFor(policy, 0, tasks, 1, [&](std::size_t first, std::size_t last){
+        for(std::size_t t = first; t < last; ++t)
+            partials[t] = reduceSpanRange(kernels, spans, t * group, std::min(spans.count(), (t + 1) * group), op, summation, shift);
+    });
+    return combineValues(op, summation, partials.data(), tasks);
+}
+
+/** Extrema of a span with row-major positions, ties kept at the first. */
+template <typename T>
+struct SpanExtrema {
+    T minimum = T();
+    T maximum = T();
+    std::size_t minimumAt = 0;
+    std::size_t maximumAt = 0;
+};
+
+template <typename T>
+SpanExtrema<T> spanExtrema(const ReductionKernels<T>& kernels, const T* x, std::size_t n, std::size_t position) {
+    SpanExtrema<T> result;
+    for(std::size_t offset = 0; offset < n; offset += kExtremaBlock) {
+        const std::size_t count = std::min(kExtremaBlock, n - offset);
+        const T* block = x + offset;
+        T lo, hi;
+        kernels.extremes(block, count, &lo, &hi);
+        if(offset == 0 || lo < result.minimum) {
+            result.minimum = lo;
+            result.minimumAt = position + offset + std::min<std::size_t>(std::find(block, block + count, lo) - block, count - 1);
+        }
+        if(offset == 0 || hi > result.maximum) {
+            result.maximum = hi;
+            result.maximumAt = position + offset + std::min<std::size_t>(std::find(block, block + count, hi) - block, count - 1);
+        }
+    }
+    return result;
+}
+
+template <typename T>
+void mergeExtrema(SpanExtrema<T>& to, const SpanExtrema<T>& from) {
+    if(from.minimum < to.minimum) {
+        to.minimum = from.minimum;
+        to.minimumAt = from.minimumAt;
+    }
+    if(from.maximum > to.maximum) {
+        to.maximum = from.maximum;
+        to.maximumAt = from.maximumAt;
+    }
+}
+
+inline MatrixPoint reductionPoint(std::size_t row, std::size_t column, bool transposed) {
+    return transposed ? MatrixPoint{column, row} : MatrixPoint{row, column};
+}
+
+template <typename T>
+Extrema<T> extremaAll(const execution::ExecutionPolicy& policy, ConstMatrixView<T> a) {
+    assert(a.size() > 0);
+    bool transposed = false;
+    if(!readableView(a, transposed)) {
+        const Matrix<T> copy(a);
+        return extremaAll(policy, constView(copy));
+    }
+    const ReductionKernels<T>& kernels = activeReductionKernels<T>();
+    const ReductionSpans<T> spans(a);
+    const std::size_t group = spans.group();
+    const std::size_t tasks = (spans.count() + group - 1) / group;
+    ReductionPartials<SpanExtrema<T>> partials(tasks);
+    execution::parallelFor(policy, 0, tasks, 1, [&](std::size_t first, std::size_t last){
+        for(std::size_t t = first; t < last; ++t) {
+            const std::size_t end = std::min(spans.count(), (t + 1) * group);
+            SpanExtrema<T> result = spanExtrema(kernels, spans.begin(t * group), spans.size(t * group), spans.position(t * group));
+            for(std::size_t s = t * group + 1; s < end; ++s)
+                mergeExtrema(result, spanExtrema(kernels, spans.begin(s), spans.size(s), spans.position(s)));
+            partials[t] = result;
+        }
+    });
+    SpanExtrema<T> result = partials[0];
+    for(std::size_t t = 1; t < tasks; ++t) mergeExtrema(result, partials[t]);
+
+    const std::size_t columns = a.columns();
+    Extrema<T> extrema;
+    extrema.minimum.value = result.minimum;
+    extrema.minimum.point = reductionPoint(result.minimumAt / columns, result.minimumAt % columns, transposed);
+    extrema.maximum.value = result.maximum;
+    extrema.maximum.point = reductionPoint(result.maximumAt / columns, result.maximumAt % columns, transposed);
+    return extrema;
+}
+
+/** acc[0, n) = the reduction of columns [c0, c0 + n) over rows [first, last)
+    added pairwise in blocks of kPairwiseRows rows. Every level of the
+    recursion keeps its right half in the next n elements of scratch.
+ */
+template <typename T>
+void pairwiseRows(const ReductionKernels<T>& kernels, ReductionOp op, const ConstMatrixView<T>& a,
+                  std::size_t c0, std::size_t n, const T* shift, std::size_t first, std::size_t last, T* acc, T* scratch) {
+    std::fill(acc, acc + n, T(0));
+    const typename ReductionKernels<T>::Accumulate accumulate = kernels.accumulate[static_cast<std::size_t>(op)];
+    if(last - first <= kPairwiseRows) {
+        for(std::size_t r = first; r < last; ++r) accumulate(a.rowData(r) + c0, shift, acc, nullptr, n);
+        return;
+    }
+    const std::size_t middle = first + (last - first) / 2;
+    pairwiseRows(kernels, op, a, c0, n, shift, first, middle, acc, scratch);
+    pairwiseRows(kernels, op, a, c0, n, shift, middle, last, scratch, scratch + n);
+    kernels.accumulate[static_cast<std::size_t>(ReductionOp::Sum)](scratch, nullptr, acc, nullptr, n);
+}
+
+inline std::size_t pairwiseDepth(std::size_t rows) {
+    std::size_t depth = 0;
+    for(std::size_t blocks = (rows + kPairwiseRows - 1) / kPairwiseRows; blocks > 1; blocks = (blocks + 1) / 2) ++depth;
+    return depth;
+}
+
+/** store(i, value) for every row (Axis::Rows) or column (Axis::Columns) of a.
+    shifts holds one SumSquares shift per result or is null.
+ */
+template <typename T, class Store>
+void reduceLines(const execution::ExecutionPolicy& policy, ConstMatrixView<T> a, Axis axis,
+                 ReductionOp op, Summation summation, const T* shifts, Store store) {
+    bool transposed = false;
+    if(!readableView(a, transposed)) {
+        const Matrix<T> copy(a);
+        reduceLines(policy, constView(copy), axis, op, summation, shifts, store);
+        return;
+    }
+    if(transposed) axis = axis == Axis::Rows ? Axis::Columns : Axis::Rows;
+
+    const ReductionKernels<T>& kernels = activeReductionKernels<T>();
+    const std::size_t rows = a.rows();
+    const std::size_t columns = a.columns();
+    if(axis == Axis::Rows) {
+        const std::size_t grain = std::max<std::size_t>(1, kReductionGrain / std::max<std::size_t>(columns, 1));
+        execution::parallelFor(policy, 0, rows, grain, [&](std::size_t first, std::size_t last){
+            for(std::size_t r = first; r < last; ++r)
+                store(r, reduceSpan(kernels, op, summation, a.rowData(r), columns, shifts ? shifts[r] : T(0)));
+        });
+        return;
+    }
+
+    const std::size_t blocks = (columns + kReductionColumns - 1) / kReductionColumns;
+    const std::size_t grain = std::max<std::size_t>(1, kReductionGrain / std::max<std::size_t>(rows * kReductionColumns, 1));
+    const bool pairwise = summation == Summation::Pairwise && op != ReductionOp::MaxAbs && rows > kPairwiseRows;
+    const bool kahan = summation == Summation::Kahan && op != ReductionOp::MaxAbs;
+    execution::parallelFor(policy, 0, blocks, grain, [&](std::size_t first, std::size_t last){
+        T acc[kReductionColumns];
+        T compensation[kReductionColumns];
+        std::vector<T> scratch(pairwise ? pairwiseDepth(rows) * kReductionColumns : 0);
+        for(std::size_t b = first; b < last; ++b) {
+            const std::size_t c0 = b * kReductionColumns;
+            const std::size_t n = std::min(kReductionColumns, columns - c0);
+            const T* shift = shifts ? shifts + c0 : nullptr;
+            if(pairwise) {
+                pairwiseRows(kernels, op, a, c0, n, shift, 0, rows, acc, scratch.data());
+            } else {
+                const typename ReductionKernels<T>::Accumulate accumulate =
+                    (kahan ? kernels.kahanAccumulate : kernels.accumulate)[static_cast<std::size_t>(op)];
+                std::fill(acc, acc + n, T(0));
+                std::fill(compensation, compensation + n, T(0));
+                for(std::size_t r = 0; r < rows; ++r) accumulate(a.rowData(r) + c0, shift, acc, compensation, n);
+            }
+            if(kahan) {
+                for(std::size_t j = 0; j < n; ++j) store(c0 + j, acc[j] + compensation[j]);
+            } else {
+                for(std::size_t j = 0; j < n; ++j) store(c0 + j, acc[j]);
+            }
+        }
+    });
+}
+
+/** out[i] = extrema of row i (Axis::Rows) or column i (Axis::Columns). */
+template <typename T>
+void extremaLines(const execution::ExecutionPolicy& policy, ConstMatrixView<T> a, Axis axis, Extrema<T>* out) {
+    bool transposed = false;
+    if(!readableView(a, transposed)) {
+        const Matrix<T> copy(a);
+        extremaLines(policy, constView(copy), axis, out);
+        return;
+    }
+    if(transposed) axis = axis == Axis::Rows ? Axis::Columns : Axis::Rows;
+
+    const ReductionKernels<T>& kernels = activeReductionKernels<T>();
+    const std::size_t rows = a.rows();
+    const std::size_t columns = a.columns();
+    const auto write = [&](std::size_t i, const T& lo, std::size_t loRow, std::size_t loColumn,
+                           const T& hi, std::size_t hiRow, std::size_t hiColumn){
+        out[i].minimum.value = lo;
+        out[i].minimum.point = reductionPoint(loRow, loColumn, transposed);
+        out[i].maximum.value = hi;
+        out[i].maximum.point = reductionPoint(hiRow, hiColumn, transposed);
+    };
+    if(axis == Axis::Rows) {
+        assert(columns > 0);
+        const std::size_t grain = std::max<std::size_t>(1, kReductionGrain / columns);
+        execution::parallelFor(policy, 0, rows, grain, [&](std::size_t first, std::size_t last){
+            for(std::size_t r = first; r < last; ++r) {
+                const SpanExtrema<T> e = spanExtrema(kernels, a.rowData(r), columns, 0);
+                write(r, e.minimum, r, e.minimumAt, e.maximum, r, e.maximumAt);
+            }
+        });
+        return;
+    }
+
+    assert(rows > 0);
+    const std::size_t blocks = (columns + kReductionColumns - 1) / kReductionColumns;
+    const std::size_t grain = std::max<std::size_t>(1, kReductionGrain / (rows * kReductionColumns));
+    execution::parallelFor(policy, 0, blocks, grain, [&](std::size_t first, std::size_t last){
+        T lo[kReductionColumns];
+        T hi[kReductionColumns];
+        std::size_t loRow[kReductionColumns];
+        std::size_t hiRow[kReductionColumns];
+        for(std::size_t b = first; b < last; ++b) {
+            const std::size_t c0 = b * kReductionColumns;
+            const std::size_t n = std::min(kReductionColumns, columns - c0);
+            std::copy(a.rowData(0) + c0, a.rowData(0) + c0 + n, lo);
+            std::copy(a.rowData(0) + c0, a.rowData(0) + c0 + n, hi);
+            std::fill(loRow, loRow + n, std::size_t(0));
+            std::fill(hiRow, hiRow + n, std::size_t(0));
+            for(std::size_t r = 1; r < rows; ++r) {
+                const T* row = a.rowData(r) + c0;
+                for(std::size_t j = 0; j < n; ++j) {
+                    const bool lower = row[j] < lo[j];
+                    const bool higher = row[j] > hi[j];
+                    lo[j] = lower ? row[j] : lo[j];
+                    loRow[j] = lower ? r : loRow[j];
+                    hi[j] = higher ? row[j] : hi[j];
+                    hiRow[j] = higher ? r : hiRow[j];
+                }
+            }
+            for(std::size_t j = 0; j < n; ++j) write(c0 + j, lo[j], loRow[j], c0 + j, hi[j], hiRow[j], c0 + j);
+        }
+    });
+}
+
+/** Writes value i of a row or column vector. */
+template <typename T>
+struct VectorStore {
+    void operator () (std::size_t i, const T& value) const {
+        if(view.rows() == 1) view[MatrixPoint{0, i}] = value;
+        else view[MatrixPoint{i, 0}] = value;
+    }
+    MatrixView<T> view;
+};
+
+inline std::size_t reductionCount(std::size_t rows, std::size_t columns, Axis axis) {
+    return axis == Axis::Rows ? rows : columns;
+}
+
+/** Length of every line reduced along the axis. */
+inline std::size_t reductionLength(std::size_t rows, std::size_t columns, Axis axis) {
+    return axis == Axis::Rows ? columns : rows;
+}
+
+template <typename T>
+inline void assertVectorOutput(const MatrixView<T>& out, std::size_t count) {
+    assert((out.rows() == 1 || out.columns() == 1) && out.size() == count);
+    (void)out;
+    (void)count;
+}
+
+template <typename T>
+inline ReductionOp normOp(Norm norm) {
+    return norm == Norm::L1 ? ReductionOp::SumAbs :
+           norm == Norm::Infinity ? ReductionOp::MaxAbs : ReductionOp::SumSquares;
+}
+
+template <typename T>
+inline T finishNorm(Norm norm, T value) {
+    return norm == Norm::L2 || norm == Norm::Frobenius ? T(std::sqrt(value)) : value;
+}
+
+template <class A>
+using EnableIfReduction = typename std::enable_if<IsMatrixLike<A>::value, typename MatrixValueType<A>::type>::type;
+
+template <class A>
+using EnableIfExtrema = typename std::enable_if<IsMatrixLike<A>::value, Extrema<typename MatrixValueType<A>::type>>::type;
+
+template <class A>
+using EnableIfExtremum = typename std::enable_if<IsMatrixLike<A>::value, Extremum<typename MatrixValueType<A>::type>>::type;
+
+template <class A, class Out>
+using EnableIfAxisReduction = typename std::enable_if<IsMatrixLike<A>::value && IsMatrixLike<Out>::value>::type;
+
+} // namespace detail
+
+/** Sum of all elements. */
+template <class A>
+detail::EnableIfReduction<A> sum(const execution::ExecutionPolicy& policy, const A& a, Summation summation = Summation::Pairwise) {
+    typedef typename MatrixValueType<A>::type T;
+    const ConstMatrixView<T> va = constView(a);
+    const instrumentation::ScopedOperation counted(instrumentation::Operation::Elementwise, double(va.size()));
+    return detail::reduceAll(policy, va, detail::ReductionOp::Sum, summation, T(0));
+}
+
+/** Smallest and largest element with their positions, ties resolve to the
+    first element in storage order. a must not be empty.
+ */
+template <class A>
+detail::EnableIfExtrema<A> extrema(const execution::ExecutionPolicy& policy, const A& a) {
+    typedef typename MatrixValueType<A>::type T;
+    const ConstMatrixView<T> va = constView(a);
+    const instrumentation::ScopedOperation counted(instrumentation::Operation::Elementwise, 2.0 * va.size());
+    return detail::extremaAll(policy, va);
+}
+
+template <class A>
+detail::EnableIfExtremum<A> minimum(const execution::ExecutionPolicy& policy, const A& a) {
+    return extrema(policy, a).minimum;
+}
+
+template <class A>
+detail::EnableIfExtremum<A> maximum(const execution::ExecutionPolicy& policy, const A& a) {
+    return extrema(policy, a).maximum;
+}
+
+/** Arithmetic mean of all elements, for floating point matrices. */
+template <class A>
+detail::EnableIfReduction<A> mean(const execution::ExecutionPolicy& policy, const A& a, Summation summation = Summation::Pairwise) {
+    typedef typename MatrixValueType<A>::type T;
+    static_assert(std::is_floating_point<T>::value, "mean needs a floating point matrix");
+    return sum(policy, a, summation) / T(constView(a).size());
+}
+
+/** Variance of all elements around their mean, divided by size - ddof:
+    ddof = 0 gives the population variance, 1 the sample variance. Two passes,
+    the second sums the squared deviations from the mean of the first.
+ */
+template <class A>
+detail::EnableIfReduction<A> variance(const execution::ExecutionPolicy& policy, const A& a, std::size_t ddof = 0) {
+    typedef typename MatrixValueType<A>::type T;
+    static_assert(std::is_floating_point<T>::value, "variance needs a floating point matrix");
+    const ConstMatrixView<T> va = constView(a);
+    assert(va.size() > ddof);
+    const instrumentation::ScopedOperation counted(instrumentation::Operation::Elementwise, 4.0 * va.size());
+    const T center = detail::reduceAll(policy, va, detail::ReductionOp::Sum, Summation::Pairwise, T(0)) / T(va.size());
+    return detail::reduceAll(policy, va, detail::ReductionOp::SumSquares, Summation::Pairwise, center) / T(va.size() - ddof);
+}
+
+/** Entrywise norm of all elements, for floating point matrices. */
+template <class A>
+detail::EnableIfReduction<A> norm(const execution::ExecutionPolicy& policy, const A& a, Norm kind = Norm::Frobenius) {
+    typedef typename MatrixValueType<A>::type T;
+    static_assert(std::is_floating_point<T>::value, "norm needs a floating point matrix");
+    const ConstMatrixView<T> va = constView(a);
+    const instrumentation::ScopedOperation counted(instrumentation::Operation::Elementwise, 2.0 * va.size());
+    return detail::finishNorm(kind, detail::reduceAll(policy, va, detail::normOp<T>(kind), Summation::Pairwise, T(0)));
+}
+
+/** out[i] = sum of row i (Axis::Rows) or of column i (Axis::Columns). out is
+    a row or column vector with one element per result.
+ */
+template <class A, class Out>
+detail::EnableIfAxisReduction<A, Out> sum(const execution::ExecutionPolicy& policy, const A& a, Axis axis, Out&& out,
+                                          Summation summation = Summation::Pairwise) {
+    typedef typename MatrixValueType<Out>::type T;
+    const ConstMatrixView<T> va = constView(a);
+    const detail::VectorStore<T> store{mutableView(out)};
+    detail::assertVectorOutput(store.view, detail::reductionCount(va.rows(), va.columns(), axis));
+    const instrumentation::ScopedOperation counted(instrumentation::Operation::Elementwise, double(va.size()));
+    detail::reduceLines(policy, va, axis, detail::ReductionOp::Sum, summation, static_cast<const T*>(nullptr), store);
+}
+
+/** out[i] = mean of row i or column i. */
+template <class A, class Out>
+detail::EnableIfAxisReduction<A, Out> mean(const execution::ExecutionPolicy& policy, const A& a, Axis axis, Out&& out,
+                                           Summation summation = Summation::Pairwise) {
+    typedef typename MatrixValueType<Out>::type T;
+    static_assert(std::is_floating_point<T>::value, "mean needs a floating point matrix");
+    const ConstMatrixView<T> va = constView(a);
+    const detail::VectorStore<T> store{mutableView(out)};
+    detail::assertVectorOutput(store.view, detail::reductionCount(va.rows(), va.columns(), axis));
+    const T length = T(detail::reductionLength(va.rows(), va.columns(), axis));
+    const instrumentation::ScopedOperation counted(instrumentation::Operation::Elementwise, double(va.size()));
+    detail::reduceLines(policy, va, axis, detail::ReductionOp::Sum, summation, static_cast<const T*>(nullptr),
+                        [&](std::size_t i, const T& value){ store(i, value / length); });
+}
+
+/** out[i] = variance of row i or column i, divided by its length - ddof. */
+template <class A, class Out>
+detail::EnableIfAxisReduction<A, Out> variance(const execution::ExecutionPolicy& policy, const A& a, Axis axis, Out&& out,
+                                               std::size_t ddof = 0) {
+    typedef typename MatrixValueType<Out>::type T;
+    static_assert(std::is_floating_point<T>::value, "variance needs a floating point matrix");
+    const ConstMatrixView<T> va = constView(a);
+    const detail::VectorStore<T> store{mutableView(out)};
+    const std::size_t count = detail::reductionCount(va.rows(), va.columns(), axis);
+    const std::size_t length = detail::reductionLength(va.rows(), va.columns(), axis);
+    detail::assertVectorOutput(store.view, count);
+    assert(length > ddof);
+    const instrumentation::ScopedOperation counted(instrumentation::Operation::Elementwise, 4.0 * va.size());
+
+    std::vector<T> centers(count);
+    detail::reduceLines(policy, va, axis, detail::ReductionOp::Sum, Summation::Pairwise, static_cast<const T*>(nullptr),
+                        [&](std::size_t i, const T& value){ centers[i] = value / T(length); });
+    detail::reduceLines(policy, va, axis, detail::ReductionOp::SumSquares, Summation::Pairwise, centers.data(),
+                        [&](std::size_t i, const T& value){ store(i, value / T(length - ddof)); });
+}
+
+/** out[i] = entrywise norm of row i or column i. */
+template <class A, class Out>
+detail::EnableIfAxisReduction<A, Out> norm(const execution::ExecutionPolicy& policy, const A& a, Axis axis, Out&& out,
+                                           Norm kind = Norm::Frobenius) {
+    typedef typename MatrixValueType<Out>::type T;
+    static_assert(std::is_floating_point<T>::value, "norm needs a floating point matrix");
+    const ConstMatrixView<T> va = constView(a);
+    const detail::VectorStore<T> store{mutableView(out)};
+    detail::assertVectorOutput(store.view, detail::reductionCount(va.rows(), va.columns(), axis));
+    const instrumentation::ScopedOperation counted(instrumentation::Operation::Elementwise, 2.0 * va.size());
+    detail::reduceLines(policy, va, axis, detail::normOp<T>(kind), Summation::Pairwise, static_cast<const T*>(nullptr),
+                        [&](std::size_t i, const T& value){ store(i, detail::finishNorm(kind, value)); });
+}
+
+/** out[i] = extrema of row i or column i, with positions in a. out is
+    resized to the number of results; no line may be empty.
+ */
+template <class A>
+typename std::enable_if<IsMatrixLike<A>::value>::type
+extrema(const execution::ExecutionPolicy& policy, const A& a, Axis axis, std::vector<Extrema<typename MatrixValueType<A>::type>>& out) {
+    typedef typename MatrixValueType<A>::type T;
+    const ConstMatrixView<T> va = constView(a);
+    out.resize(detail::reductionCount(va.rows(), va.columns(), axis));
+    const instrumentation::ScopedOperation counted(instrumentation::Operation::Elementwise, 2.0 * va.size());
+    if(!out.empty()) detail::extremaLines(policy, va, axis, out.data());
+}
+
+/** The overloads without a policy split large matrices between threads. */
+template <class A>
+detail::EnableIfReduction<A> sum(const A& a, Summation summation = Summation::Pairwise) {
+    return sum(execution::par, a, summation);
+}
+
+template <class A>
+detail::EnableIfExtrema<A> extrema(const A& a) {
+    return extrema(execution::par, a);
+}
+
+template <class A>
+detail::EnableIfExtremum<A> minimum(const A& a) {
+    return extrema(execution::par, a).minimum;
+}
+
+template <class A>
+detail::EnableIfExtremum<A> maximum(const A& a) {
+    return extrema(execution::par, a).maximum;
+}
+
+template <class A>
+detail::EnableIfReduction<A> mean(const A& a, Summation summation = Summation::Pairwise) {
+    return mean(execution::par, a, summation);
+}
+
+template <class A>
+detail::EnableIfReduction<A> variance(const A& a, std::size_t ddof = 0) {
+    return variance(execution::par, a, ddof);
+}
+
+template <class A>
+detail::EnableIfReduction<A> norm(const A& a, Norm kind = Norm::Frobenius) {
+    return norm(execution::par, a, kind);
+}
+
+template <class A, class Out>
+detail::EnableIfAxisReduction<A, Out> sum(const A& a, Axis axis, Out&& out, Summation summation = Summation::Pairwise) {
+    sum(execution::par, a, axis, std::forward<Out>(out), summation);
+}
+
+template <class A, class Out>
+detail::EnableIfAxisReduction<A, Out> mean(const A& a, Axis axis, Out&& out, Summation summation = Summation::Pairwise) {
+    mean(execution::par, a, axis, std::forward<Out>(out), summation);
+}
+
+template <class A, class Out>
+detail::EnableIfAxisReduction<A, Out> variance(const A& a, Axis axis, Out&& out, std::size_t ddof = 0) {
+    variance(execution::par, a, axis, std::forward<Out>(out), ddof);
+}
+
+template <class A, class Out>
+detail::EnableIfAxisReduction<A, Out> norm(const A& a, Axis axis, Out&& out, Norm kind = Norm::Frobenius) {
+    norm(execution::par, a, axis, std::forward<Out>(out), kind);
+}
+
+template <class A>
+typename std::enable_if<IsMatrixLike<A>::value>::type
+extrema(const A& a, Axis axis, std::vector<Extrema<typename MatrixValueType<A>::type>>& out) {
+    extrema(execution::par, a, axis, out);
+}
+
+} //namespace matrix
+} //namespace cppmath
+
+#endif /* cppmath_reduction_hpp */
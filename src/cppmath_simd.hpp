@@ -0,0 +1,311 @@
+//
+//  cppmath_simd.hpp
+//  CppMath
+//
+//  Created by Dmytro Krasnianskyi on 17.10.26.
+//  Copyright © 2026 Dmytro Krasnianskyi. All rights reserved.
+//
+
+#ifndef cppmath_simd_hpp
+#define cppmath_simd_hpp
+
+/** Internal header: thin per instruction set vector traits used by the
+    runtime dispatched kernels. Only include it from translation units, every
+    function carries the target attribute of its level so that it can be
+    inlined into kernels compiled for the same level.
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#include "cppmath_cpu.hpp"
+#include "cppmath_elementwise.hpp"
+
+#if CPPMATH_X86_DISPATCH
+#   include <immintrin.h>
+#endif
+
+namespace cppmath {
+namespace simd {
+
+using matrix::CompareOp;
+
+#if CPPMATH_X86_DISPATCH
+
+constexpr int avxCompareImmediate(CompareOp op) {
+    return op == CompareOp::Equal ? _CMP_EQ_OQ :
+           op == CompareOp::NotEqual ? _CMP_NEQ_UQ :
+           op == CompareOp::Less ? _CMP_LT_OQ :
+           op == CompareOp::LessEqual ? _CMP_LE_OQ :
+           op == CompareOp::Greater ? _CMP_GT_OQ : _CMP_GE_OQ;
+}
+
+#define CPPMATH_SSE2 CPPMATH_TARGET("sse2")
+#define CPPMATH_AVX2 CPPMATH_TARGET("avx2,fma")
+#define CPPMATH_AVX512 CPPMATH_TARGET("avx512f,avx512bw,avx512dq,avx512vl,fma")
+#define CPPMATH_AVX2_VNNI CPPMATH_TARGET("avx2,fma,avxvnni")
+#define CPPMATH_AVX512_VNNI CPPMATH_TARGET("avx512f,avx512bw,avx512dq,avx512vl,fma,avx512vnni")
+#define CPPMATH_POPCNT CPPMATH_TARGET("sse2,popcnt")
+#define CPPMATH_AVX512_POPCNT CPPMATH_TARGET("avx512f,avx512bw,avx512dq,avx512vl,fma,avx512vpopcntdq,popcnt")
+
+struct Sse2Float {
+    typedef float value_type;
+    typedef __m128 Vec;
+    typedef __m128 Mask;
+    static constexpr std::size_t width = 4;
+    CPPMATH_SSE2 static inline Vec zero() { return _mm_setzero_ps(); }
+    CPPMATH_SSE2 static inline Vec set1(float v) { return _mm_set1_ps(v); }
+    CPPMATH_SSE2 static inline Vec load(const float* p) { return _mm_loadu_ps(p); }
+    CPPMATH_SSE2 static inline Vec broadcast(const float* p) { return _mm_set1_ps(*p); }
+    CPPMATH_SSE2 static inline void store(float* p, Vec v) { _mm_storeu_ps(p, v); }
+    CPPMATH_SSE2 static inline Vec add(Vec a, Vec b) { return _mm_add_ps(a, b); }
+    CPPMATH_SSE2 static inline Vec sub(Vec a, Vec b) { return _mm_sub_ps(a, b); }
+    CPPMATH_SSE2 static inline Vec mul(Vec a, Vec b) { return _mm_mul_ps(a, b); }
+    CPPMATH_SSE2 static inline Vec fma(Vec a, Vec b, Vec c) { return _mm_add_ps(_mm_mul_ps(a, b), c); }
+    CPPMATH_SSE2 static inline Vec div(Vec a, Vec b) { return _mm_div_ps(a, b); }
+    CPPMATH_SSE2 static inline Vec abs(Vec a) { return _mm_andnot_ps(_mm_set1_ps(-0.0f), a); }
+    CPPMATH_SSE2 static inline Vec min(Vec a, Vec b) { return _mm_min_ps(a, b); }
+    CPPMATH_SSE2 static inline Vec max(Vec a, Vec b) { return _mm_max_ps(a, b); }
+    CPPMATH_SSE2 static inline Mask greater(Vec a, Vec b) { return _mm_cmpgt_ps(a, b); }
+    CPPMATH_SSE2 static inline Vec select(Mask m, Vec a, Vec b) { return _mm_or_ps(_mm_and_ps(m, a), _mm_andnot_ps(m, b)); }
+    CPPMATH_SSE2 static inline Vec gather(const float* base, const std::int32_t* idx) {
+        return _mm_set_ps(base[idx[3]], base[idx[2]], base[idx[1]], base[idx[0]]);
+    }
+    CPPMATH_SSE2 static inline float reduce(Vec v) {
+        const __m128 h = _mm_add_ps(v, _mm_movehl_ps(v, v));
+        return _mm_cvtss_f32(_mm_add_ss(h, _mm_shuffle_ps(h, h, 1)));
+    }
+    template <CompareOp Op>
+    CPPMATH_SSE2 static inline unsigned compare(Vec a, Vec b) {
+        return static_cast<unsigned>(_mm_movemask_ps(
+            Op == CompareOp::Equal ? _mm_cmpeq_ps(a, b) :
+            Op == CompareOp::NotEqual ? _mm_cmpneq_ps(a, b) :
+            Op == CompareOp::Less ? _mm_cmplt_ps(a, b) :
+            Op == CompareOp::LessEqual ? _mm_cmple_ps(a, b) :
+            Op == CompareOp::Greater ? _mm_cmpgt_ps(a, b) : _mm_cmpge_ps(a, b)));
+    }
+};
+
+struct Sse2Double {
+    typedef double value_type;
+    typedef __m128d Vec;
+    typedef __m128d Mask;
+    static constexpr std::size_t width = 2;
+    CPPMATH_SSE2 static inline Vec zero() { return _mm_setzero_pd(); }
+    CPPMATH_SSE2 static inline Vec set1(double v) { return _mm_set1_pd(v); }
+    CPPMATH_SSE2 static inline Vec load(const double* p) { return _mm_loadu_pd(p); }
+    CPPMATH_SSE2 static inline Vec broadcast(const double* p) { return _mm_set1_pd(*p); }
+    CPPMATH_SSE2 static inline void store(double* p, Vec v) { _mm_storeu_pd(p, v); }
+    CPPMATH_SSE2 static inline Vec add(Vec a, Vec b) { return _mm_add_pd(a, b); }
+    CPPMATH_SSE2 static inline Vec sub(Vec a, Vec b) { return _mm_sub_pd(a, b); }
+    CPPMATH_SSE2 static inline Vec mul(Vec a, Vec b) { return _mm_mul_pd(a, b); }
+    CPPMATH_SSE2 static inline Vec fma(Vec a, Vec b, Vec c) { return _mm_add_pd(_mm_mul_pd(a, b), c); }
+    CPPMATH_SSE2 static inline Vec div(Vec a, Vec b) { return _mm_div_pd(a, b); }
+    CPPMATH_SSE2 static inline Vec abs(Vec a) { return _mm_andnot_pd(_mm_set1_pd(-0.0), a); }
+    CPPMATH_SSE2 static inline Vec min(Vec a, Vec b) { return _mm_min_pd(a, b); }
+    CPPMATH_SSE2 static inline Vec max(Vec a, Vec b) { return _mm_max_pd(a, b); }
+    CPPMATH_SSE2 static inline Mask greater(Vec a, Vec b) { return _mm_cmpgt_pd(a, b); }
+    CPPMATH_SSE2 static inline Vec select(Mask m, Vec a, Vec b) { return _mm_or_pd(_mm_and_pd(m, a), _mm_andnot_pd(m, b)); }
+    CPPMATH_SSE2 static inline Vec gather(const double* base, const std::int32_t* idx) {
+        return _mm_set_pd(base[idx[1]], base[idx[0]]);
+    }
+    CPPMATH_SSE2 static inline double reduce(Vec v) {
+        return _mm_cvtsd_f64(_mm_add_sd(v, _mm_unpackhi_pd(v, v)));
+    }
+    template <CompareOp Op>
+    CPPMATH_SSE2 static inline unsigned compare(Vec a, Vec b) {
+        return static_cast<unsigned>(_mm_movemask_pd(
+            Op == CompareOp::Equal ? _mm_cmpeq_pd(a, b) :
+            Op == CompareOp::NotEqual ? _mm_cmpneq_pd(a, b) :
+            Op == CompareOp::Less ? _mm_cmplt_pd(a, b) :
+            Op == CompareOp::LessEqual ? _mm_cmple_pd(a, b) :
+            Op == CompareOp::Greater ? _mm_cmpgt_pd(a, b) : _mm_cmpge_pd(a, b)));
+    }
+};
+
+struct Avx2Float {
+    typedef float value_type;
+    typedef __m256 Vec;
+    typedef __m256 Mask;
+    static constexpr std::size_t width = 8;
+    CPPMATH_AVX2 static inline Vec zero() { return _mm256_setzero_ps(); }
+    CPPMATH_AVX2 static inline Vec set1(float v) { return _mm256_set1_ps(v); }
+    CPPMATH_AVX2 static inline Vec load(const float* p) { return _mm256_loadu_ps(p); }
+    CPPMATH_AVX2 static inline Vec broadcast(const float* p) { return _mm256_broadcast_ss(p); }
+    CPPMATH_AVX2 static inline void store(float* p, Vec v) { _mm256_storeu_ps(p, v); }
+    CPPMATH_AVX2 static inline Vec add(Vec a, Vec b) { return _mm256_add_ps(a, b); }
+    CPPMATH_AVX2 static inline Vec sub(Vec a, Vec b) { return _mm256_sub_ps(a, b); }
+    CPPMATH_AVX2 static inline Vec mul(Vec a, Vec b) { return _mm256_mul_ps(a, b); }
+    CPPMATH_AVX2 static inline Vec fma(Vec a, Vec b, Vec c) { return _mm256_fmadd_ps(a, b, c); }
+    CPPMATH_AVX2 static inline Vec div(Vec a, Vec b) { return _mm256_div_ps(a, b); }
+    CPPMATH_AVX2 static inline Vec abs(Vec a) { return _mm256_andnot_ps(_mm256_set1_ps(-0.0f), a); }
+    CPPMATH_AVX2 static inline Vec min(Vec a, Vec b) { return _mm256_min_ps(a, b); }
+    CPPMATH_AVX2 static inline Vec max(Vec a, Vec b) { return _mm256_max_ps(a, b); }
+    CPPMATH_AVX2 static inline Mask greater(Vec a, Vec b) { return _mm256_cmp_ps(a, b, _CMP_GT_OQ); }
+    CPPMATH_AVX2 static inline Vec select(Mask m, Vec a, Vec b) { return _mm256_blendv_ps(b, a, m); }
+    CPPMATH_AVX2 static inline Vec gather(const float* base, const std::int32_t* idx) {
+        return _mm256_i32gather_ps(base, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(idx)), 4);
+    }
+    CPPMATH_AVX2 static inline float reduce(Vec v) {
+        __m128 h = _mm_add_ps(_mm256_castps256_ps128(v), _mm256_extractf128_ps(v, 1));
+        h = _mm_add_ps(h, _mm_movehl_ps(h, h));
+        return _mm_cvtss_f32(_mm_add_ss(h, _mm_shuffle_ps(h, h, 1)));
+    }
+    template <CompareOp Op>
+    CPPMATH_AVX2 static inline unsigned compare(Vec a, Vec b) {
+        constexpr int predicate = avxCompareImmediate(Op);
+        return static_cast<unsigned>(_mm256_movemask_ps(_mm256_cmp_ps(a, b, predicate)));
+    }
+};
+
+struct Avx2Double {
+    typedef double value_type;
+    typedef __m256d Vec;
+    typedef __m256d Mask;
+    static constexpr std::size_t width = 4;
+    CPPMATH_AVX2 static inline Vec zero() { return _mm256_setzero_pd(); }
+    CPPMATH_AVX2 static inline Vec set1(double v) { return _mm256_set1_pd(v); }
+    CPPMATH_AVX2 static inline Vec load(const double* p) { return _mm256_loadu_pd(p); }
+    CPPMATH_AVX2 static inline Vec broadcast(const double* p) { return _mm256_broadcast_sd(p); }
+    CPPMATH_AVX2 static inline void store(double* p, Vec v) { _mm256_storeu_pd(p, v); }
+    CPPMATH_AVX2 static inline Vec add(Vec a, Vec b) { return _mm256_add_pd(a, b); }
+    CPPMATH_AVX2 static inline Vec sub(Vec a, Vec b) { return _mm256_sub_pd(a, b); }
+    CPPMATH_AVX2 static inline Vec mul(Vec a, Vec b) { return _mm256_mul_pd(a, b); }
+    CPPMATH_AVX2 static inline Vec fma(Vec a, Vec b, Vec c) { return _mm256_fmadd_pd(a, b, c); }
+    CPPMATH_AVX2 static inline Vec div(Vec a, Vec b) { return _mm256_div_pd(a, b); }
+    CPPMATH_AVX2 static inline Vec abs(Vec a) { return _mm256_andnot_pd(_mm256_set1_pd(-0.0), a); }
+    CPPMATH_AVX2 static inline Vec min(Vec a, Vec b) { return _mm256_min_pd(a, b); }
+    CPPMATH_AVX2 static inline Vec max(Vec a, Vec b) { return _mm256_max_pd(a, b); }
+    CPPMATH_AVX2 static inline Mask greater(Vec a, Vec b) { return _mm256_cmp_pd(a, b, _CMP_GT_OQ); }
+    CPPMATH_AVX2 static inline Vec select(Mask m, Vec a, Vec b) { return _mm256_blendv_pd(b, a, m); }
+    CPPMATH_AVX2 static inline Vec gather(const double* base, const std::int32_t* idx) {
+        return _mm256_i32gather_pd(base, _mm_loadu_si128(reinterpret_cast<const __m128i*>(idx)), 8);
+    }
+    CPPMATH_AVX2 static inline double reduce(Vec v) {
+        const __m128d h = _mm_add_pd(_mm256_castpd256_pd128(v), _mm256_extractf128_pd(v, 1));
+        return _mm_cvtsd_f64(_mm_add_sd(h, _mm_unpackhi_pd(h, h)));
+    }
+    template <CompareOp Op>
+    CPPMATH_AVX2 static inline unsigned compare(Vec a, Vec b) {
+        constexpr int predicate = avxCompareImmediate(Op);
+        return static_cast<unsigned>(_mm256_movemask_pd(_mm256_cmp_pd(a, b, predicate)));
+    }
+};
+
+struct Avx512Float {
+    typedef float value_type;
+    typedef __m512 Vec;
+    typedef __mmask16 Mask;
+    static constexpr std::size_t width = 16;
+    CPPMATH_AVX512 static inline Vec zero() { return _mm512_setzero_ps(); }
+    CPPMATH_AVX512 static inline Vec set1(float v) { return _mm512_set1_ps(v); }
+    CPPMATH_AVX512 static inline Vec load(const float* p) { return _mm512_loadu_ps(p); }
+    CPPMATH_AVX512 static inline Vec broadcast(const float* p) { return _mm512_set1_ps(*p); }
+    CPPMATH_AVX512 static inline void store(float* p, Vec v) { _mm512_storeu_ps(p, v); }
+    CPPMATH_AVX512 static inline Vec add(Vec a, Vec b) { return _mm512_add_ps(a, b); }
+    CPPMATH_AVX512 static inline Vec sub(Vec a, Vec b) { return _mm512_sub_ps(a, b); }
+    CPPMATH_AVX512 static inline Vec mul(Vec a, Vec b) { return _mm512_mul_ps(a, b); }
+    CPPMATH_AVX512 static inline Vec fma(Vec a, Vec b, Vec c) { return _mm512_fmadd_ps(a, b, c); }
+    CPPMATH_AVX512 static inline Vec div(Vec a, Vec b) { return _mm512_div_ps(a, b); }
+    CPPMATH_AVX512 static inline Vec abs(Vec a) { return _mm512_abs_ps(a); }
+    CPPMATH_AVX512 static inline Vec min(Vec a, Vec b) { return _mm512_min_ps(a, b); }
+    CPPMATH_AVX512 static inline Vec max(Vec a, Vec b) { return _mm512_max_ps(a, b); }
+    CPPMATH_AVX512 static inline Mask greater(Vec a, Vec b) { return _mm512_cmp_ps_mask(a, b, _CMP_GT_OQ); }
+    CPPMATH_AVX512 static inline Vec select(Mask m, Vec a, Vec b) { return _mm512_mask_blend_ps(m, b, a); }
+    CPPMATH_AVX512 static inline Vec gather(const float* base, const std::int32_t* idx) {
+        return _mm512_i32gather_ps(_mm512_loadu_si512(idx), base, 4);
+    }
+    CPPMATH_AVX512 static inline float reduce(Vec v) { return _mm512_reduce_add_ps(v); }
+    template <CompareOp Op>
+    CPPMATH_AVX512 static inline unsigned compare(Vec a, Vec b) {
+        constexpr int predicate = avxCompareImmediate(Op);
+        return static_cast<unsigned>(_mm512_cmp_ps_mask(a, b, predicate));
+    }
+};
+
+struct Avx512Double {
+    typedef double value_type;
+    typedef __m512d Vec;
+    typedef __mmask8 Mask;
+    static constexpr std::size_t width = 8;
+    CPPMATH_AVX512 static inline Vec zero() { return _mm512_setzero_pd(); }
+    CPPMATH_AVX512 static inline Vec set1(double v) { return _mm512_set1_pd(v); }
+    CPPMATH_AVX512 static inline Vec load(const double* p) { return _mm512_loadu_pd(p); }
+    CPPMATH_AVX512 static inline Vec broadcast(const double* p) { return _mm512_set1_pd(*p); }
+    CPPMATH_AVX512 static inline void store(double* p, Vec v) { _mm512_storeu_pd(p, v); }
+    CPPMATH_AVX512 static inline Vec add(Vec a, Vec b) { return _mm512_add_pd(a, b); }
+    CPPMATH_AVX512 static inline Vec sub(Vec a, Vec b) { return _mm512_sub_pd(a, b); }
+    CPPMATH_AVX512 static inline Vec mul(Vec a, Vec b) { return _mm512_mul_pd(a, b); }
+    CPPMATH_AVX512 static inline Vec fma(Vec a, Vec b, Vec c) { return _mm512_fmadd_pd(a, b, c); }
+    CPPMATH_AVX512 static inline Vec div(Vec a, Vec b) { return _mm512_div_pd(a, b); }
+    CPPMATH_AVX512 static inline Vec abs(Vec a) { return _mm512_abs_pd(a); }
+    CPPMATH_AVX512 static inline Vec min(Vec a, Vec b) { return _mm512_min_pd(a, b); }
+    CPPMATH_AVX512 static inline Vec max(Vec a, Vec b) { return _mm512_max_pd(a, b); }
+    CPPMATH_AVX512 static inline Mask greater(Vec a, Vec b) { return _mm512_cmp_pd_mask(a, b, _CMP_GT_OQ); }
+    CPPMATH_AVX512 static inline Vec select(Mask m, Vec a, Vec b) { return _mm512_mask_blend_pd(m, b, a); }
+    CPPMATH_AVX512 static inline Vec gather(const double* base, const std::int32_t* idx) {
+        return _mm512_i32gather_pd(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(idx)), base, 8);
+    }
+    CPPMATH_AVX512 static inline double reduce(Vec v) { return _mm512_reduce_add_pd(v); }
+    template <CompareOp Op>
+    CPPMATH_AVX512 static inline unsigned compare(Vec a, Vec b) {
+        constexpr int predicate = avxCompareImmediate(Op);
+        return static_cast<unsigned>(_mm512_cmp_pd_mask(a, b, predicate));
+    }
+};
+
+/** int32 lanes for the quantized kernels. dotWords adds the pairwise
+    int16 products (pmaddwd), dotBytes the sums of four unsigned x signed
+    byte products (vpdpbusd) and needs the VNNI target.
+ */
+struct Sse2Int32 {
+    typedef __m128i Vec;
+    static constexpr std::size_t width = 4;
+    CPPMATH_SSE2 static inline Vec zero() { return _mm_setzero_si128(); }
+    CPPMATH_SSE2 static inline Vec load(const void* p) { return _mm_loadu_si128(static_cast<const __m128i*>(p)); }
+    CPPMATH_SSE2 static inline Vec broadcast(const void* p) {
+        std::int32_t v;
+        std::memcpy(&v, p, sizeof(v));
+        return _mm_set1_epi32(v);
+    }
+    CPPMATH_SSE2 static inline void store(std::int32_t* p, Vec v) { _mm_storeu_si128(reinterpret_cast<__m128i*>(p), v); }
+    CPPMATH_SSE2 static inline Vec dotWords(Vec acc, Vec a, Vec b) { return _mm_add_epi32(acc, _mm_madd_epi16(a, b)); }
+};
+
+struct Avx2Int32 {
+    typedef __m256i Vec;
+    static constexpr std::size_t width = 8;
+    CPPMATH_AVX2 static inline Vec zero() { return _mm256_setzero_si256(); }
+    CPPMATH_AVX2 static inline Vec load(const void* p) { return _mm256_loadu_si256(static_cast<const __m256i*>(p)); }
+    CPPMATH_AVX2 static inline Vec broadcast(const void* p) {
+        std::int32_t v;
+        std::memcpy(&v, p, sizeof(v));
+        return _mm256_set1_epi32(v);
+    }
+    CPPMATH_AVX2 static inline void store(std::int32_t* p, Vec v) { _mm256_storeu_si256(reinterpret_cast<__m256i*>(p), v); }
+    CPPMATH_AVX2 static inline Vec dotWords(Vec acc, Vec a, Vec b) { return _mm256_add_epi32(acc, _mm256_madd_epi16(a, b)); }
+    CPPMATH_AVX2_VNNI static inline Vec dotBytes(Vec acc, Vec a, Vec b) { return _mm256_dpbusd_avx_epi32(acc, a, b); }
+};
+
+struct Avx512Int32 {
+    typedef __m512i Vec;
+    static constexpr std::size_t width = 16;
+    CPPMATH_AVX512 static inline Vec zero() { return _mm512_setzero_si512(); }
+    CPPMATH_AVX512 static inline Vec load(const void* p) { return _mm512_loadu_si512(p); }
+    CPPMATH_AVX512 static inline Vec broadcast(const void* p) {
+        std::int32_t v;
+        std::memcpy(&v, p, sizeof(v));
+        return _mm512_set1_epi32(v);
+    }
+    CPPMATH_AVX512 static inline void store(std::int32_t* p, Vec v) { _mm512_storeu_si512(p, v); }
+    CPPMATH_AVX512 static inline Vec dotWords(Vec acc, Vec a, Vec b) { return _mm512_add_epi32(acc, _mm512_madd_epi16(a, b)); }
+    CPPMATH_AVX512_VNNI static inline Vec dotBytes(Vec acc, Vec a, Vec b) { return _mm512_dpbusd_epi32(acc, a, b); }
+};
+
+#endif // CPPMATH_X86_DISPATCH
+
+} // namespace simd
+} // namespace cppmath
+
+#endif /* cppmath_simd_hpp */
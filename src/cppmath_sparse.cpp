@@ -0,0 +1,97 @@
+//
+//  cppmath_sparse.cpp
+//  CppMath
+//
+//  Created by Dmytro Krasnianskyi on 17.10.26.
+//  Copyright © 2026 Dmytro Krasnianskyi. All rights reserved.
+//
+
+#include "cppmath_sparse.hpp"
+#include "cppmath_simd.hpp"
+
+namespace cppmath{
+namespace matrix{
+namespace detail {
+
+namespace {
+
+#if CPPMATH_X86_DISPATCH
+
+using namespace simd;
+
+/** Row dot products gather x through the column indices. Two accumulators
+    hide the gather latency, short rows and tails use the scalar loop.
+ */
+#define CPPMATH_SPARSE_KERNELS(PREFIX, TARGET)                                          \
+template <class V, typename T>                                                          \
+TARGET void PREFIX##Spmv(const std::size_t* pointers, const SparseIndex* indices, const T* values, \
+                         const T* x, T* y, std::size_t begin, std::size_t end, T alpha, T beta) { \
+    const std::size_t w = V::width;                                                     \
+    for(std::size_t i = begin; i < end; ++i) {                                          \
+        std::size_t k = pointers[i];                                                    \
+        const std::size_t e = pointers[i + 1];                                          \
+        T dot = T();                                                                    \
+        if(k + w <= e) {                                                                \
+            typename V::Vec acc0 = V::zero();                                           \
+            typename V::Vec acc1 = V::zero();                                           \
+            for(; k + 2 * w <= e; k += 2 * w) {                                         \
+                acc0 = V::fma(V::load(values + k), V::gather(x, indices + k), acc0);    \
+                acc1 = V::fma(V::load(values + k + w), V::gather(x, indices + k + w), acc1); \
+            }                                                                           \
+            if(k + w <= e) {                                                            \
+                acc0 = V::fma(V::load(values + k), V::gather(x, indices + k), acc0);    \
+                k += w;                                                                 \
+            }                                                                           \
+            dot = V::reduce(V::add(acc0, acc1));                                        \
+        }                                                                               \
+        for(; k < e; ++k) dot += values[k] * x[indices[k]];                             \
+        y[i] = beta == T(0) ? alpha * dot : alpha * dot + beta * y[i];                  \
+    }                                                                                   \
+}                                                                                       \
+template <class V>                                                                      \
+SparseKernels<typename V::value_type> PREFIX##Kernels() {                               \
+    typedef typename V::value_type T;                                                   \
+    SparseKernels<T> k;                                                                 \
+    k.spmv = &PREFIX##Spmv<V, T>;                                                       \
+    return k;                                                                           \
+}
+
+CPPMATH_SPARSE_KERNELS(sse2, CPPMATH_SSE2)
+CPPMATH_SPARSE_KERNELS(avx2, CPPMATH_AVX2)
+CPPMATH_SPARSE_KERNELS(avx512, CPPMATH_AVX512)
+
+#undef CPPMATH_SPARSE_KERNELS
+
+#endif // CPPMATH_X86_DISPATCH
+
+} // namespace
+
+template <> SparseKernels<float> sparseKernels<float>(cpu::InstructionSet isa) {
+#if CPPMATH_X86_DISPATCH
+    switch(isa) {
+        case cpu::InstructionSet::AVX512: return avx512Kernels<Avx512Float>();
+        case cpu::InstructionSet::AVX2: return avx2Kernels<Avx2Float>();
+        case cpu::InstructionSet::SSE2: return sse2Kernels<Sse2Float>();
+        default: break;
+    }
+#endif
+    (void)isa;
+    return genericSparseKernels<float>();
+}
+
+template <> SparseKernels<double> sparseKernels<double>(cpu::InstructionSet isa) {
+#if CPPMATH_X86_DISPATCH
+    switch(isa) {
+        case cpu::InstructionSet::AVX512: return avx512Kernels<Avx512Double>();
+        case cpu::InstructionSet::AVX2: return avx2Kernels<Avx2Double>();
+        case cpu::InstructionSet::SSE2: return sse2Kernels<Sse2Double>();
+        default: break;
+    }
+#endif
+    (void)isa;
+    return genericSparseKernels<double>();
+}
+
+} // namespace detail
+} //namespace matrix
+} //namespace cppmath
@@ -0,0 +1,597 @@
+//
+//  cppmath_sparse.hpp
+//  CppMath
+//
+//  Created by Dmytro Krasnianskyi on 17.10.26.
+//  Copyright © 2026 Dmytro Krasnianskyi. All rights reserved.
+//
+
+#ifndef cppmath_sparse_hpp
+#define cppmath_sparse_hpp
+
+#include <cstddef>
+#include <cstdint>
+#include <cassert>
+#include <limits>
+#include <vector>
+#include <utility>
+#include <algorithm>
+#include <type_traits>
+
+#include "cppmath_cpu.hpp"
+#include "cppmath_matrix.hpp"
+#include "cppmath_elementwise.hpp"
+#include "cppmath_parallel.hpp"
+
+/** Sparse matrices.
+
+    CooMatrix collects (row, column, value) triplets in any order and is
+    meant for assembly only. CsrMatrix and CscMatrix are the compressed row
+    and column formats used for computation. Converting to them sorts the
+    entries and sums duplicates in O(nnz + rows + columns) with two counting
+    passes. Memory and time of every operation scale with the number of
+    stored entries.
+
+    Indices are signed 32-bit, as the SIMD gathers take them, so both
+    dimensions are limited to 2^31 - 1.
+ */
+
+namespace cppmath {
+namespace matrix{
+
+typedef std::int32_t SparseIndex;
+
+template <typename T> class CsrMatrix;
+template <typename T> class CscMatrix;
+
+namespace detail {
+
+inline bool fitsSparseIndex(std::size_t n) {
+    return n <= static_cast<std::size_t>(std::numeric_limits<SparseIndex>::max());
+}
+
+/** Compressed storage along the major dimension: rows for CSR, columns for
+    CSC. pointers has major + 1 entries, entry k of major line i is
+    (indices[k], values[k]) for pointers[i] <= k < pointers[i + 1], sorted by
+    the minor index without duplicates.
+ */
+template <typename T>
+struct CompressedStorage {
+    std::size_t major = 0;
+    std::size_t minor = 0;
+    std::vector<std::size_t> pointers = std::vector<std::size_t>(1, 0);
+    std::vector<SparseIndex> indices;
+    std::vector<T> values;
+
+    inline std::size_t nonZeros() const noexcept { return indices.size(); }
+
+    T at(std::size_t i, std::size_t j) const {
+        assert(i < major && j < minor);
+        const SparseIndex* first = indices.data() + pointers[i];
+        const SparseIndex* last = indices.data() + pointers[i + 1];
+        const SparseIndex* it = std::lower_bound(first, last, static_cast<SparseIndex>(j));
+        return it != last && *it == static_cast<SparseIndex>(j) ? values[it - indices.data()] : T();
+    }
+};
+
+/** Sorts the triplets by (major, minor) with two stable counting passes and
+    sums duplicates.
+ */
+template <typename T>
+CompressedStorage<T> compress(std::size_t major, std::size_t minor,
+                              const std::vector<SparseIndex>& majorIdx, const std::vector<SparseIndex>& minorIdx,
+                              const std::vector<T>& values) {
+    const std::size_t n = values.size();
+    assert(majorIdx.size() == n && minorIdx.size() == n);
+
+    // Pass 1: order by the minor index
+    std::vector<std::size_t> offsets(minor + 1, 0);
+    for(std::size_t k = 0; k < n; ++k) ++offsets[minorIdx[k] + 1];
+    for(std::size_t j = 0; j < minor; ++j) offsets[j + 1] += offsets[j];
+    std::vector<std::size_t> order(n);
+    for(std::size_t k = 0; k < n; ++k) order[offsets[minorIdx[k]]++] = k;
+
+    // Pass 2: stable order by the major index keeps the minor order per line
+    CompressedStorage<T> s;
+    s.major = major;
+    s.minor = minor;
+    s.pointers.assign(major + 1, 0);
+    for(std::size_t k = 0; k < n; ++k) ++s.pointers[majorIdx[k] + 1];
+    for(std::size_t i = 0; i < major; ++i) s.pointers[i + 1] += s.pointers[i];
+    std::vector<std::size_t> next(s.pointers.begin(), s.pointers.end() - 1);
+    s.indices.resize(n);
+    s.values.resize(n);
+    for(std::size_t k : order) {
+        const std::size_t pos = next[majorIdx[k]]++;
+        s.indices[pos] = minorIdx[k];
+        s.values[pos] = values[k];
+    }
+
+    // Sum duplicates in place
+    std::size_t out = 0;
+    std::size_t begin = 0;
+    for(std::size_t i = 0; i < major; ++i) {
+        const std::size_t end = s.pointers[i + 1];
+        for(std::size_t k = begin; k < end; ++k) {
+            if(out > s.pointers[i] && s.indices[out - 1] == s.indices[k]) {
+                s.values[out - 1] += s.values[k];
+            } else {
+                s.indices[out] = s.indices[k];
+                s.values[out] = s.values[k];
+                ++out;
+            }
+        }
+        begin = end;
+        s.pointers[i + 1] = out;
+    }
+    s.indices.resize(out);
+    s.values.resize(out);
+    s.indices.shrink_to_fit();
+    s.values.shrink_to_fit();
+    return s;
+}
+
+/** The same entries compressed along the other dimension. */
+template <typename T>
+CompressedStorage<T> transpose(const CompressedStorage<T>& s) {
+    CompressedStorage<T> t;
+    t.major = s.minor;
+    t.minor = s.major;
+    t.pointers.assign(t.major + 1, 0);
+    for(SparseIndex j : s.indices) ++t.pointers[j + 1];
+    for(std::size_t i = 0; i < t.major; ++i) t.pointers[i + 1] += t.pointers[i];
+    std::vector<std::size_t> next(t.pointers.begin(), t.pointers.end() - 1);
+    t.indices.resize(s.nonZeros());
+    t.values.resize(s.nonZeros());
+    for(std::size_t i = 0; i < s.major; ++i) {
+        for(std::size_t k = s.pointers[i]; k < s.pointers[i + 1]; ++k) {
+            const std::size_t pos = next[s.indices[k]]++;
+            t.indices[pos] = static_cast<SparseIndex>(i);
+            t.values[pos] = s.values[k];
+        }
+    }
+    return t;
+}
+
+/** Non-zero elements of a dense operand, by rows or by columns. */
+template <typename T>
+CompressedStorage<T> compressDense(const ConstMatrixView<T>& v, bool byRows) {
+    assert(fitsSparseIndex(v.rows()) && fitsSparseIndex(v.columns()));
+    const ConstMatrixView<T> m = byRows ? v : v.transposed();
+    CompressedStorage<T> s;
+    s.major = m.rows();
+    s.minor = m.columns();
+    s.pointers.assign(s.major + 1, 0);
+    for(std::size_t i = 0; i < s.major; ++i) {
+        for(std::size_t j = 0; j < s.minor; ++j) {
+            const T& value = m[MatrixPoint{i, j}];
+            if(value != T()) {
+                s.indices.push_back(static_cast<SparseIndex>(j));
+                s.values.push_back(value);
+            }
+        }
+        s.pointers[i + 1] = s.indices.size();
+    }
+    return s;
+}
+
+template <typename T>
+Matrix<T> expand(const CompressedStorage<T>& s, bool byRows) {
+    Matrix<T> result(byRows ? s.major : s.minor, byRows ? s.minor : s.major);
+    MatrixView<T> m = byRows ? result.view() : result.view().transposed();
+    for(std::size_t i = 0; i < s.major; ++i) {
+        for(std::size_t k = s.pointers[i]; k < s.pointers[i + 1]; ++k) {
+            m[MatrixPoint{i, static_cast<std::size_t>(s.indices[k])}] = s.values[k];
+        }
+    }
+    return result;
+}
+
+template <typename T>
+struct SparseKernels {
+    /** y[i] = alpha * (A x)[i] + beta * y[i] for rows [begin, end) of a CSR
+        matrix, y is overwritten when beta is zero.
+     */
+    typedef void (*Spmv)(const std::size_t* pointers, const SparseIndex* indices, const T* values,
+                         const T* x, T* y, std::size_t begin, std::size_t end, T alpha, T beta);
+
+    Spmv spmv = nullptr;
+};
+
+template <typename T>
+void genericSpmv(const std::size_t* pointers, const SparseIndex* indices, const T* values,
+                 const T* x, T* y, std::size_t begin, std::size_t end, T alpha, T beta) {
+    for(std::size_t i = begin; i < end; ++i) {
+        T dot = T();
+        for(std::size_t k = pointers[i]; k < pointers[i + 1]; ++k) dot += values[k] * x[indices[k]];
+        y[i] = beta == T(0) ? alpha * dot : alpha * dot + beta * y[i];
+    }
+}
+
+template <typename T>
+SparseKernels<T> genericSparseKernels() {
+    SparseKernels<T> k;
+    k.spmv = &genericSpmv<T>;
+    return k;
+}
+
+/** Kernels for the given instruction set level. The generic template
+    ignores the level, float and double have SIMD specializations.
+ */
+template <typename T>
+inline SparseKernels<T> sparseKernels(cpu::InstructionSet) {
+    return genericSparseKernels<T>();
+}
+
+template <> SparseKernels<float> sparseKernels<float>(cpu::InstructionSet isa);
+template <> SparseKernels<double> sparseKernels<double>(cpu::InstructionSet isa);
+
+/** Kernels for the running CPU, selected on the first use. */
+template <typename T>
+inline const SparseKernels<T>& activeSparseKernels() {
+    static const SparseKernels<T> kernels = sparseKernels<T>(cpu::instructionSet());
+    return kernels;
+}
+
+/** Multiply-adds per task of the parallel products. */
+constexpr std::size_t kSparseParallelWork = std::size_t(1) << 16;
+
+/** Splits the major lines into ranges with about the same number of entries
+    and runs fn(begin, end) for each of them. A line goes to the range
+    holding its first entry, trailing empty lines to the last range.
+ */
+template <class Fn>
+void parallelByNonZeros(const execution::ExecutionPolicy& policy, const std::vector<std::size_t>& pointers,
+                        std::size_t workPerEntry, Fn fn) {
+    const std::size_t lines = pointers.size() - 1;
+    const std::size_t nnz = pointers.back();
+    if(!policy.isParallel() || nnz == 0) {
+        fn(std::size_t(0), lines);
+        return;
+    }
+    const std::size_t grain = std::max<std::size_t>(1, kSparseParallelWork / std::max<std::size_t>(workPerEntry, 1));
+    execution::parallelFor(policy, 0, nnz, grain, [&](std::size_t first, std::size_t last){
+        const std::size_t begin = static_cast<std::size_t>(std::lower_bound(pointers.begin(), pointers.end() - 1, first) - pointers.begin());
+        const std::size_t end = last == nnz ? lines :
+            static_cast<std::size_t>(std::lower_bound(pointers.begin(), pointers.end() - 1, last) - pointers.begin());
+        if(begin < end) fn(begin, end);
+    });
+}
+
+/** c.row(i) = beta * c.row(i), zero when beta is zero. */
+template <typename T>
+inline void scaleRow(const MatrixView<T>& c, std::size_t i, const T& beta) {
+    T* row = c.rowData(i);
+    if(beta == T(0)) {
+        std::fill(row, row + c.columns(), T());
+    } else if(beta != T(1)) {
+        activeElementwiseKernels<T>().scale(row, beta, row, c.columns());
+    }
+}
+
+template <typename T>
+inline bool isDenseVector(const ConstMatrixView<T>& v) {
+    return v.isContiguous() && (v.rows() == 1 || v.columns() == 1);
+}
+
+template <class X, class Y>
+using EnableIfSparseVectors = typename std::enable_if<IsMatrixLike<X>::value && IsMatrixLike<Y>::value>::type;
+
+} // namespace detail
+
+/** Coordinate list for assembling a sparse matrix. */
+template <typename T>
+class CooMatrix {
+public:
+    typedef T           value_type;
+
+    CooMatrix() = default;
+
+    CooMatrix(std::size_t rows, std::size_t columns):
+        m_rows(rows),
+        m_columns(columns)
+    {
+        assert(detail::fitsSparseIndex(rows) && detail::fitsSparseIndex(columns));
+    }
+
+    inline void reserve(std::size_t nonZeros) {
+        m_rowIndices.reserve(nonZeros);
+        m_columnIndices.reserve(nonZeros);
+        m_values.reserve(nonZeros);
+    }
+
+    /** Adds an entry. Entries at the same position are summed on compression. */
+    inline void insert(std::size_t row, std::size_t column, const T& value) {
+        assert(row < m_rows && column < m_columns);
+        m_rowIndices.push_back(static_cast<SparseIndex>(row));
+        m_columnIndices.push_back(static_cast<SparseIndex>(column));
+        m_values.push_back(value);
+    }
+
+    inline void clear() {
+        m_rowIndices.clear();
+        m_columnIndices.clear();
+        m_values.clear();
+    }
+
+    Matrix<T> toMatrix() const {
+        Matrix<T> result(m_rows, m_columns);
+        for(std::size_t k = 0; k < m_values.size(); ++k) {
+            result[MatrixPoint{static_cast<std::size_t>(m_rowIndices[k]), static_cast<std::size_t>(m_columnIndices[k])}] += m_values[k];
+        }
+        return result;
+    }
+
+    inline const std::vector<SparseIndex>& rowIndices() const noexcept { return m_rowIndices; }
+    inline const std::vector<SparseIndex>& columnIndices() const noexcept { return m_columnIndices; }
+    inline const std::vector<T>& values() const noexcept { return m_values; }
+
+    std::size_t nonZeros() const noexcept {return m_values.size();}
+    std::size_t rows() const noexcept {return m_rows;}
+    std::size_t columns() const noexcept {return m_columns;}
+
+private:
+    std::vector<SparseIndex> m_rowIndices;
+    std::vector<SparseIndex> m_columnIndices;
+    std::vector<T> m_values;
+    std::size_t m_rows = 0;
+    std::size_t m_columns = 0;
+};
+
+/** Compressed sparse rows. */
+template <typename T>
+class CsrMatrix {
+public:
+    typedef T           value_type;
+
+    CsrMatrix() = default;
+
+    explicit CsrMatrix(const CooMatrix<T>& coo):
+        m_storage(detail::compress(coo.rows(), coo.columns(), coo.rowIndices(), coo.columnIndices(), coo.values()))
+    {}
+
+    explicit CsrMatrix(const CscMatrix<T>& csc):
+        m_storage(detail::transpose(csc.m_storage))
+    {}
+
+    /** Keeps the non-zero elements of a dense matrix or view. */
+    template <class MatrixT, class = typename std::enable_if<IsMatrixLike<MatrixT>::value>::type>
+    explicit CsrMatrix(const MatrixT& m):
+        m_storage(detail::compressDense(constView(m), true))
+    {}
+
+    /** Element value, zero when it is not stored. O(log(nnz in the row)). */
+    inline T operator [] (const MatrixPoint& point) const {
+        return m_storage.at(point.row, point.column);
+    }
+
+    CsrMatrix transposed() const {
+        return CsrMatrix(detail::transpose(m_storage));
+    }
+
+    Matrix<T> toMatrix() const {
+        return detail::expand(m_storage, true);
+    }
+
+    inline const std::vector<std::size_t>& rowPointers() const noexcept { return m_storage.pointers; }
+    inline const std::vector<SparseIndex>& columnIndices() const noexcept { return m_storage.indices; }
+    inline const std::vector<T>& values() const noexcept { return m_storage.values; }
+
+    std::size_t nonZeros() const noexcept {return m_storage.nonZeros();}
+    std::size_t rows() const noexcept {return m_storage.major;}
+    std::size_t columns() const noexcept {return m_storage.minor;}
+
+private:
+    friend class CscMatrix<T>;
+
+    explicit CsrMatrix(detail::CompressedStorage<T>&& storage): m_storage(std::move(storage)) {}
+
+    detail::CompressedStorage<T> m_storage;
+};
+
+/** Compressed sparse columns. */
+template <typename T>
+class CscMatrix {
+public:
+    typedef T           value_type;
+
+    CscMatrix() = default;
+
+    explicit CscMatrix(const CooMatrix<T>& coo):
+        m_storage(detail::compress(coo.columns(), coo.rows(), coo.columnIndices(), coo.rowIndices(), coo.values()))
+    {}
+
+    explicit CscMatrix(const CsrMatrix<T>& csr):
+        m_storage(detail::transpose(csr.m_storage))
+    {}
+
+    /** Keeps the non-zero elements of a dense matrix or view. */
+    template <class MatrixT, class = typename std::enable_if<IsMatrixLike<MatrixT>::value>::type>
+    explicit CscMatrix(const MatrixT& m):
+        m_storage(detail::compressDense(constView(m), false))
+    {}
+
+    /** Element value, zero when it is not stored. O(log(nnz in the column)). */
+    inline T operator [] (const MatrixPoint& point) const {
+        return m_storage.at(point.column, point.row);
+    }
+
+    CscMatrix transposed() const {
+        return CscMatrix(detail::transpose(m_storage));
+    }
+
+    Matrix<T> toMatrix() const {
+        return detail::expand(m_storage, false);
+    }
+
+    inline const std::vector<std::size_t>& columnPointers() const noexcept { return m_storage.pointers; }
+    inline const std::vector<SparseIndex>& rowIndices() const noexcept { return m_storage.indices; }
+    inline const std::vector<T>& values() const noexcept { return m_storage.values; }
+
+    std::size_t nonZeros() const noexcept {return m_storage.nonZeros();}
+    std::size_t rows() const noexcept {return m_storage.minor;}
+    std::size_t columns() const noexcept {return m_storage.major;}
+
+private:
+    friend class CsrMatrix<T>;
+
+    explicit CscMatrix(detail::CompressedStorage<T>&& storage): m_storage(std::move(storage)) {}
+
+    detail::CompressedStorage<T> m_storage;
+};
+
+/** y = alpha * A x + beta * y for row or column vectors x and y. y is
+    overwritten when beta is zero. Rows are split between threads by their
+    number of entries.
+ */
+template <typename T, class X, class Y>
+detail::EnableIfSparseVectors<X, Y> spmv(const execution::ExecutionPolicy& policy,
+                                         const T& alpha, const CsrMatrix<T>& a, const X& x, const T& beta, Y&& y) {
+    const ConstMatrixView<T> vx = constView(x);
+    MatrixView<T> vy = mutableView(y);
+    assert(vx.isVector() || a.columns() == 0);
+    assert(vx.size() == a.columns() && vy.size() == a.rows());
+
+    std::vector<T> bufferX;
+    const T* px = vx.data();
+    if(!detail::isDenseVector(vx)) {
+        bufferX.assign(vx.begin(), vx.end());
+        px = bufferX.data();
+    }
+    std::vector<T> bufferY;
+    T* py = vy.data();
+    const bool denseY = detail::isDenseVector(ConstMatrixView<T>(vy));
+    if(!denseY) {
+        bufferY.assign(vy.begin(), vy.end());
+        py = bufferY.data();
+    }
+
+    const instrumentation::ScopedOperation counted(instrumentation::Operation::Sparse, 2.0 * a.nonZeros());
+    const typename detail::SparseKernels<T>::Spmv kernel = detail::activeSparseKernels<T>().spmv;
+    const std::size_t* pointers = a.rowPointers().data();
+    const SparseIndex* indices = a.columnIndices().data();
+    const T* values = a.values().data();
+    detail::parallelByNonZeros(policy, a.rowPointers(), 1, [=](std::size_t begin, std::size_t end){
+        kernel(pointers, indices, values, px, py, begin, end, alpha, beta);
+    });
+
+    if(!denseY) std::copy(bufferY.begin(), bufferY.end(), vy.begin());
+}
+
+template <typename T, class X, class Y>
+detail::EnableIfSparseVectors<X, Y> spmv(const T& alpha, const CsrMatrix<T>& a, const X& x, const T& beta, Y&& y) {
+    spmv(execution::par, alpha, a, x, beta, std::forward<Y>(y));
+}
+
+/** C = alpha * A B + beta * C with a sparse A and dense B and C. C is
+    overwritten when beta is zero.
+ */
+template <typename T, class B, class C>
+detail::EnableIfSparseVectors<B, C> spmm(const execution::ExecutionPolicy& policy,
+                                         const T& alpha, const CsrMatrix<T>& a, const B& b, const T& beta, C&& c) {
+    const ConstMatrixView<T> vb = constView(b);
+    const MatrixView<T> vc = mutableView(c);
+    assert(vb.rows() == a.columns());
+    assert(vc.rows() == a.rows() && vc.columns() == vb.columns());
+
+    if(vc.columns() == 1) {
+        spmv(policy, alpha, a, vb, beta, vc);
+        return;
+    }
+    if(!vb.hasContiguousRows()) {
+        spmm(policy, alpha, a, Matrix<T>(vb), beta, vc);
+        return;
+    }
+    if(!vc.hasContiguousRows()) {
+        Matrix<T> dense(vc);
+        spmm(policy, alpha, a, vb, beta, dense);
+        vc.assign(dense.view());
+        return;
+    }
+
+    const instrumentation::ScopedOperation counted(instrumentation::Operation::Sparse, 2.0 * a.nonZeros() * vc.columns());
+    const typename detail::ElementwiseKernels<T>::Axpy axpy = detail::activeElementwiseKernels<T>().axpy;
+    const std::size_t* pointers = a.rowPointers().data();
+    const SparseIndex* indices = a.columnIndices().data();
+    const T* values = a.values().data();
+    detail::parallelByNonZeros(policy, a.rowPointers(), vc.columns(), [&](std::size_t begin, std::size_t end){
+        for(std::size_t i = begin; i < end; ++i) {
+            detail::scaleRow(vc, i, beta);
+            for(std::size_t k = pointers[i]; k < pointers[i + 1]; ++k) {
+                axpy(alpha * values[k], vb.rowData(static_cast<std::size_t>(indices[k])), vc.rowData(i), vc.columns());
+            }
+        }
+    });
+}
+
+/** C = alpha * A B + beta * C for a column compressed A. Every entry of A
+    scatters into a row of C, so the work is split along the columns of C.
+ */
+template <typename T, class B, class C>
+detail::EnableIfSparseVectors<B, C> spmm(const execution::ExecutionPolicy& policy,
+                                         const T& alpha, const CscMatrix<T>& a, const B& b, const T& beta, C&& c) {
+    const ConstMatrixView<T> vb = constView(b);
+    const MatrixView<T> vc = mutableView(c);
+    assert(vb.rows() == a.columns());
+    assert(vc.rows() == a.rows() && vc.columns() == vb.columns());
+
+    if(!vb.hasContiguousRows()) {
+        spmm(policy, alpha, a, Matrix<T>(vb), beta, vc);
+        return;
+    }
+    if(!vc.hasContiguousRows()) {
+        Matrix<T> dense(vc);
+        spmm(policy, alpha, a, vb, beta, dense);
+        vc.assign(dense.view());
+        return;
+    }
+
+    const instrumentation::ScopedOperation counted(instrumentation::Operation::Sparse, 2.0 * a.nonZeros() * vc.columns());
+    const typename detail::ElementwiseKernels<T>::Axpy axpy = detail::activeElementwiseKernels<T>().axpy;
+    const std::size_t width = vc.columns();
+    const std::size_t grain = std::max<std::size_t>(16, detail::kSparseParallelWork / std::max<std::size_t>(a.nonZeros(), 1));
+    execution::parallelFor(policy, 0, width, grain, [&](std::size_t c0, std::size_t c1){
+        const std::size_t n = c1 - c0;
+        for(std::size_t i = 0; i < vc.rows(); ++i) {
+            detail::scaleRow(vc.submatrix(MatrixPoint{0, c0}, vc.rows(), n), i, beta);
+        }
+        for(std::size_t j = 0; j < a.columns(); ++j) {
+            const T* row = vb.rowData(j) + c0;
+            for(std::size_t k = a.columnPointers()[j]; k < a.columnPointers()[j + 1]; ++k) {
+                axpy(alpha * a.values()[k], row, vc.rowData(static_cast<std::size_t>(a.rowIndices()[k])) + c0, n);
+            }
+        }
+    });
+}
+
+/** The spmm overloads without a policy split large products between threads. */
+template <typename T, class B, class C>
+detail::EnableIfSparseVectors<B, C> spmm(const T& alpha, const CsrMatrix<T>& a, const B& b, const T& beta, C&& c) {
+    spmm(execution::par, alpha, a, b, beta, std::forward<C>(c));
+}
+
+template <typename T, class B, class C>
+detail::EnableIfSparseVectors<B, C> spmm(const T& alpha, const CscMatrix<T>& a, const B& b, const T& beta, C&& c) {
+    spmm(execution::par, alpha, a, b, beta, std::forward<C>(c));
+}
+
+template <typename T, class B>
+typename std::enable_if<IsMatrixLike<B>::value, Matrix<T>>::type
+operator * (const CsrMatrix<T>& a, const B& b) {
+    Matrix<T> result(a.rows(), b.columns());
+    spmm(T(1), a, b, T(0), result);
+    return result;
+}
+
+template <typename T, class B>
+typename std::enable_if<IsMatrixLike<B>::value, Matrix<T>>::type
+operator * (const CscMatrix<T>& a, const B& b) {
+    Matrix<T> result(a.rows(), b.columns());
+    spmm(T(1), a, b, T(0), result);
+    return result;
+}
+
+} //namespace matrix
+} //namespace cppmath
+
+#endif /* cppmath_sparse_hpp */
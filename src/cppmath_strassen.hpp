@@ -0,0 +1,250 @@
+//
+//  cppmath_strassen.hpp
+//  CppMath
+//
+//  Created by Dmytro Krasnianskyi on 17.10.26.
+//  Copyright © 2026 Dmytro Krasnianskyi. All rights reserved.
+//
+
+#ifndef cppmath_strassen_hpp
+#define cppmath_strassen_hpp
+
+#include <cstddef>
+#include <cassert>
+#include <algorithm>
+#include <type_traits>
+
+#include "cppmath_gemm.hpp"
+#include "cppmath_instrumentation.hpp"
+
+/** Strassen-Winograd multiplication C = alpha * A * B + beta * C.
+
+    Every level splits the operands into quadrants and forms the product
+    from 7 half size products and 15 quadrant additions instead of 8
+    products, so the work drops to O(n^2.81). The products below the
+    crossover run on the blocked gemm kernel. Odd dimensions are peeled:
+    the even leading part recurses and the last row, column or rank one
+    term is added with gemm, so nothing is padded.
+
+    The whole recursion uses one workspace, two thirds of n x n for square
+    operands, taken from the per thread gemm buffers, so repeated calls do
+    not touch the heap. A nonzero beta needs another m x n block.
+
+    The error bound is normwise instead of componentwise and grows by about
+    a factor of 18 per recursion level, results differ from gemm in the low
+    bits and small entries of C can lose relative accuracy. Keep gemm where
+    that matters.
+ */
+
+namespace cppmath {
+namespace matrix{
+
+struct StrassenOptions {
+    /** Products with a dimension below this run on the classical kernel.
+        The default was tuned for double on the AVX2 kernels, where the
+        recursion saves about 10% at 2048 and 20% at 4096.
+     */
+    std::size_t crossover = 1024;
+};
+
+namespace detail {
+
+/** Levels of recursion for an m x k by k x n product. */
+inline std::size_t strassenDepth(std::size_t m, std::size_t n, std::size_t k, std::size_t crossover) {
+    crossover = std::max<std::size_t>(crossover, 2);
+    std::size_t depth = 0;
+    for(; std::min(m, std::min(n, k)) >= crossover; ++depth) {
+        m /= 2;
+        n /= 2;
+        k /= 2;
+    }
+    return depth;
+}
+
+/** Workspace elements for all levels: every level keeps an A sized and a B
+    sized quadrant temporary, the first also holds a C quadrant.
+ */
+inline std::size_t strassenWorkspaceSize(std::size_t m, std::size_t n, std::size_t k, std::size_t crossover) {
+    std::size_t size = 0;
+    for(std::size_t depth = strassenDepth(m, n, k, crossover); depth != 0; --depth) {
+        m /= 2;
+        n /= 2;
+        k /= 2;
+        size += m * std::max(k, n) + k * n;
+    }
+    return size;
+}
+
+/** z = op(x, y) element by element. z may be x or y. */
+template <typename T, class Op>
+void strassenCombine(const MatrixView<T>& z, const ConstMatrixView<T>& x, const ConstMatrixView<T>& y, Op op,
+                     const execution::ExecutionPolicy& policy) {
+    const std::size_t n = z.columns();
+    execution::parallelFor(policy, 0, z.rows(), std::max<std::size_t>(1, (std::size_t(1) << 16) / (n + 1)),
+                           [&](std::size_t first, std::size_t last){
+        for(std::size_t i = first; i < last; ++i) {
+            T* zr = z.rowData(i);
+            const T* xr = x.rowData(i);
+            const T* yr = y.rowData(i);
+            if(z.hasContiguousRows() && x.hasContiguousRows() && y.hasContiguousRows()) {
+                for(std::size_t j = 0; j < n; ++j) zr[j] = op(xr[j], yr[j]);
+            } else {
+                for(std::size_t j = 0; j < n; ++j) {
+                    const std::ptrdiff_t jj = static_cast<std::ptrdiff_t>(j);
+                    zr[jj * z.columnStride()] = op(xr[jj * x.columnStride()], yr[jj * y.columnStride()]);
+                }
+            }
+        }
+    });
+}
+
+template <typename T>
+void strassenAdd(const MatrixView<T>& z, const ConstMatrixView<T>& x, const ConstMatrixView<T>& y,
+                 const execution::ExecutionPolicy& policy) {
+    strassenCombine(z, x, y, [](const T& u, const T& v){ return u + v; }, policy);
+}
+
+template <typename T>
+void strassenSubtract(const MatrixView<T>& z, const ConstMatrixView<T>& x, const ConstMatrixView<T>& y,
+                      const execution::ExecutionPolicy& policy) {
+    strassenCombine(z, x, y, [](const T& u, const T& v){ return u - v; }, policy);
+}
+
+/** c = alpha * a * b on the classical kernel. */
+template <typename T>
+void strassenLeaf(const T& alpha, const ConstMatrixView<T>& a, const ConstMatrixView<T>& b, const T& beta,
+                  const MatrixView<T>& c, const execution::ExecutionPolicy& policy) {
+    gemm(a.rows(), b.columns(), a.columns(), alpha,
+         a.data(), a.rowStride(), a.columnStride(),
+         b.data(), b.rowStride(), b.columnStride(),
+         beta, c.data(), c.rowStride(), c.columnStride(), activeGemmKernel<T>(), policy);
+}
+
+/** c = alpha * a * b with depth levels of recursion left. The schedule keeps
+    all intermediate sums in two temporaries and the quadrants of C
+    (Boyer, Dumas, Pernet and Zhou, "Memory efficient scheduling of
+    Strassen-Winograd's matrix multiplication algorithm", 2009).
+ */
+template <typename T>
+void strassen(const T& alpha, const ConstMatrixView<T>& a, const ConstMatrixView<T>& b, const MatrixView<T>& c,
+              std::size_t depth, T* workspace, const execution::ExecutionPolicy& policy) {
+    if(depth == 0) {
+        strassenLeaf(alpha, a, b, T(0), c, policy);
+        return;
+    }
+
+    const std::size_t m = a.rows();
+    const std::size_t k = a.columns();
+    const std::size_t n = b.columns();
+    const std::size_t mh = m / 2;
+    const std::size_t kh = k / 2;
+    const std::size_t nh = n / 2;
+
+    const ConstMatrixView<T> a11 = a.submatrix({0, 0}, mh, kh);
+    const ConstMatrixView<T> a12 = a.submatrix({0, kh}, mh, kh);
+    const ConstMatrixView<T> a21 = a.submatrix({mh, 0}, mh, kh);
+    const ConstMatrixView<T> a22 = a.submatrix({mh, kh}, mh, kh);
+    const ConstMatrixView<T> b11 = b.submatrix({0, 0}, kh, nh);
+    const ConstMatrixView<T> b12 = b.submatrix({0, nh}, kh, nh);
+    const ConstMatrixView<T> b21 = b.submatrix({kh, 0}, kh, nh);
+    const ConstMatrixView<T> b22 = b.submatrix({kh, nh}, kh, nh);
+    const MatrixView<T> c11 = c.submatrix({0, 0}, mh, nh);
+    const MatrixView<T> c12 = c.submatrix({0, nh}, mh, nh);
+    const MatrixView<T> c21 = c.submatrix({mh, 0}, mh, nh);
+    const MatrixView<T> c22 = c.submatrix({mh, nh}, mh, nh);
+
+    const MatrixView<T> x(workspace, mh, kh, static_cast<std::ptrdiff_t>(kh));
+    const MatrixView<T> p1(workspace, mh, nh, static_cast<std::ptrdiff_t>(nh));
+    const MatrixView<T> y(workspace + mh * std::max(kh, nh), kh, nh, static_cast<std::ptrdiff_t>(nh));
+    T* const next = y.data() + kh * nh;
+    --depth;
+
+    strassenSubtract<T>(x, a11, a21, policy);             // S3 = A11 - A21
+    strassenSubtract<T>(y, b22, b12, policy);             // T3 = B22 - B12
+    strassen<T>(alpha, x, y, c21, depth, next, policy);   // P7 = S3 T3
+    strassenAdd<T>(x, a21, a22, policy);                  // S1 = A21 + A22
+    strassenSubtract<T>(y, b12, b11, policy);             // T1 = B12 - B11
+    strassen<T>(alpha, x, y, c22, depth, next, policy);   // P5 = S1 T1
+    strassenSubtract<T>(x, x, a11, policy);               // S2 = S1 - A11
+    strassenSubtract<T>(y, b22, y, policy);               // T2 = B22 - T1
+    strassen<T>(alpha, x, y, c12, depth, next, policy);   // P6 = S2 T2
+    strassenSubtract<T>(x, a12, x, policy);               // S4 = A12 - S2
+    strassen<T>(alpha, x, b22, c11, depth, next, policy); // P3 = S4 B22
+    strassen<T>(alpha, a11, b11, p1, depth, next, policy); // P1 = A11 B11
+    strassenAdd<T>(c12, p1, c12, policy);                 // U2 = P1 + P6
+    strassenAdd<T>(c21, c12, c21, policy);                // U3 = U2 + P7
+    strassenAdd<T>(c12, c12, c22, policy);                // U4 = U2 + P5
+    strassenAdd<T>(c22, c21, c22, policy);                // U7 = U3 + P5 = C22
+    strassenAdd<T>(c12, c12, c11, policy);                // U5 = U4 + P3 = C12
+    strassenSubtract<T>(y, y, b21, policy);               // T4 = T2 - B21
+    strassen<T>(alpha, a22, y, c11, depth, next, policy); // P4 = A22 T4
+    strassenSubtract<T>(c21, c21, c11, policy);           // U6 = U3 - P4 = C21
+    strassen<T>(alpha, a12, b21, c11, depth, next, policy); // P2 = A12 B21
+    strassenAdd<T>(c11, p1, c11, policy);                 // U1 = P1 + P2 = C11
+
+    // Peeling: the rank one term of an odd k, then the last column and row
+    const std::size_t me = 2 * mh;
+    const std::size_t ne = 2 * nh;
+    if(k != 2 * kh) {
+        strassenLeaf(alpha, a.submatrix({0, k - 1}, me, 1), b.submatrix({k - 1, 0}, 1, ne), T(1),
+                     c.submatrix({0, 0}, me, ne), policy);
+    }
+    if(n != ne) strassenLeaf(alpha, a.submatrix({0, 0}, me, k), b.submatrix({0, ne}, k, 1), T(0),
+                             c.submatrix({0, ne}, me, 1), policy);
+    if(m != me) strassenLeaf(alpha, a.submatrix({me, 0}, 1, k), b, T(0), c.submatrix({me, 0}, 1, n), policy);
+}
+
+} // namespace detail
+
+/** C = alpha * A * B + beta * C by Strassen-Winograd recursion down to
+    options.crossover. Shapes and aliasing rules are those of gemm. Without
+    a policy the products and the additions run in parallel.
+ */
+template <class A, class B, class C>
+EnableIfGemmOperands<A, B, C> strassen(const execution::ExecutionPolicy& policy,
+                                       const typename MatrixValueType<C>::type& alpha, const A& a, const B& b,
+                                       const typename MatrixValueType<C>::type& beta, C&& c,
+                                       const StrassenOptions& options = StrassenOptions()) {
+    typedef typename MatrixValueType<C>::type T;
+    const ConstMatrixView<T> va = constView(a);
+    const ConstMatrixView<T> vb = constView(b);
+    const MatrixView<T> vc = mutableView(c);
+
+    assert(va.columns() == vb.rows());
+    assert(vc.rows() == va.rows() && vc.columns() == vb.columns());
+
+    const std::size_t m = va.rows();
+    const std::size_t n = vb.columns();
+    const std::size_t k = va.columns();
+    const std::size_t depth = detail::strassenDepth(m, n, k, options.crossover);
+    if(depth == 0 || alpha == T(0)) {
+        gemm(policy, alpha, va, vb, beta, vc);
+        return;
+    }
+
+    const instrumentation::ScopedOperation counted(instrumentation::Operation::Gemm, 2.0 * m * n * k);
+    const std::size_t recursion = detail::strassenWorkspaceSize(m, n, k, options.crossover);
+    const std::size_t product = beta == T(0) ? 0 : m * n;
+    detail::GemmBufferLease<T> lease(detail::gemmWorkspace<T>().strassen);
+    T* workspace = lease.data(recursion + product);
+
+    if(product == 0) {
+        detail::strassen<T>(alpha, va, vb, vc, depth, workspace, policy);
+        return;
+    }
+    const MatrixView<T> ab(workspace + recursion, m, n, static_cast<std::ptrdiff_t>(n));
+    detail::strassen<T>(alpha, va, vb, ab, depth, workspace, policy);
+    detail::strassenCombine<T>(vc, ab, vc, [&beta](const T& u, const T& v){ return u + beta * v; }, policy);
+}
+
+template <class A, class B, class C>
+EnableIfGemmOperands<A, B, C> strassen(const typename MatrixValueType<C>::type& alpha, const A& a, const B& b,
+                                       const typename MatrixValueType<C>::type& beta, C&& c,
+                                       const StrassenOptions& options = StrassenOptions()) {
+    strassen(execution::par, alpha, a, b, beta, std::forward<C>(c), options);
+}
+
+} //namespace matrix
+} //namespace cppmath
+
+#endif /* cppmath_strassen_hpp */
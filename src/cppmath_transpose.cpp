@@ -0,0 +1,168 @@
+//
+//  cppmath_transpose.cpp
+//  CppMath
+//
+//  Created by Dmytro Krasnianskyi on 17.10.26.
+//  Copyright © 2026 Dmytro Krasnianskyi. All rights reserved.
+//
+
+#include "cppmath_transpose.hpp"
+#include "cppmath_simd.hpp"
+
+namespace cppmath{
+namespace matrix{
+namespace detail {
+
+namespace {
+
+#if CPPMATH_X86_DISPATCH
+
+/** In-register tile transposes. The AVX-512 level uses the 256-bit tiles as
+    well: wider tiles need more shuffles per element and leave the leaf
+    blocks with longer scalar edges.
+ */
+CPPMATH_SSE2 inline void sse2TileFloat(const float* src, std::ptrdiff_t srcStride, float* dst, std::ptrdiff_t dstStride) {
+    __m128 r0 = _mm_loadu_ps(src);
+    __m128 r1 = _mm_loadu_ps(src + srcStride);
+    __m128 r2 = _mm_loadu_ps(src + 2 * srcStride);
+    __m128 r3 = _mm_loadu_ps(src + 3 * srcStride);
+    _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+    _mm_storeu_ps(dst, r0);
+    _mm_storeu_ps(dst + dstStride, r1);
+    _mm_storeu_ps(dst + 2 * dstStride, r2);
+    _mm_storeu_ps(dst + 3 * dstStride, r3);
+}
+
+CPPMATH_SSE2 inline void sse2TileDouble(const double* src, std::ptrdiff_t srcStride, double* dst, std::ptrdiff_t dstStride) {
+    // Four 2x2 transposes make one 4x4 tile
+    for(std::ptrdiff_t i = 0; i < 4; i += 2) {
+        for(std::ptrdiff_t j = 0; j < 4; j += 2) {
+            const __m128d r0 = _mm_loadu_pd(src + i * srcStride + j);
+            const __m128d r1 = _mm_loadu_pd(src + (i + 1) * srcStride + j);
+            _mm_storeu_pd(dst + j * dstStride + i, _mm_unpacklo_pd(r0, r1));
+            _mm_storeu_pd(dst + (j + 1) * dstStride + i, _mm_unpackhi_pd(r0, r1));
+        }
+    }
+}
+
+CPPMATH_AVX2 inline void avx2TileFloat(const float* src, std::ptrdiff_t srcStride, float* dst, std::ptrdiff_t dstStride) {
+    const __m256 r0 = _mm256_loadu_ps(src);
+    const __m256 r1 = _mm256_loadu_ps(src + srcStride);
+    const __m256 r2 = _mm256_loadu_ps(src + 2 * srcStride);
+    const __m256 r3 = _mm256_loadu_ps(src + 3 * srcStride);
+    const __m256 r4 = _mm256_loadu_ps(src + 4 * srcStride);
+    const __m256 r5 = _mm256_loadu_ps(src + 5 * srcStride);
+    const __m256 r6 = _mm256_loadu_ps(src + 6 * srcStride);
+    const __m256 r7 = _mm256_loadu_ps(src + 7 * srcStride);
+
+    const __m256 t0 = _mm256_unpacklo_ps(r0, r1);
+    const __m256 t1 = _mm256_unpackhi_ps(r0, r1);
+    const __m256 t2 = _mm256_unpacklo_ps(r2, r3);
+    const __m256 t3 = _mm256_unpackhi_ps(r2, r3);
+    const __m256 t4 = _mm256_unpacklo_ps(r4, r5);
+    const __m256 t5 = _mm256_unpackhi_ps(r4, r5);
+    const __m256 t6 = _mm256_unpacklo_ps(r6, r7);
+    const __m256 t7 = _mm256_unpackhi_ps(r6, r7);
+
+    const __m256 u0 = _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(1, 0, 1, 0));
+    const __m256 u1 = _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(3, 2, 3, 2));
+    const __m256 u2 = _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(1, 0, 1, 0));
+    const __m256 u3 = _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(3, 2, 3, 2));
+    const __m256 u4 = _mm256_shuffle_ps(t4, t6, _MM_SHUFFLE(1, 0, 1, 0));
+    const __m256 u5 = _mm256_shuffle_ps(t4, t6, _MM_SHUFFLE(3, 2, 3, 2));
+    const __m256 u6 = _mm256_shuffle_ps(t5, t7, _MM_SHUFFLE(1, 0, 1, 0));
+    const __m256 u7 = _mm256_shuffle_ps(t5, t7, _MM_SHUFFLE(3, 2, 3, 2));
+
+    _mm256_storeu_ps(dst, _mm256_permute2f128_ps(u0, u4, 0x20));
+    _mm256_storeu_ps(dst + dstStride, _mm256_permute2f128_ps(u1, u5, 0x20));
+    _mm256_storeu_ps(dst + 2 * dstStride, _mm256_permute2f128_ps(u2, u6, 0x20));
+    _mm256_storeu_ps(dst + 3 * dstStride, _mm256_permute2f128_ps(u3, u7, 0x20));
+    _mm256_storeu_ps(dst + 4 * dstStride, _mm256_permute2f128_ps(u0, u4, 0x31));
+    _mm256_storeu_ps(dst + 5 * dstStride, _mm256_permute2f128_ps(u1, u5, 0x31));
+    _mm256_storeu_ps(dst + 6 * dstStride, _mm256_permute2f128_ps(u2, u6, 0x31));
+    _mm256_storeu_ps(dst + 7 * dstStride, _mm256_permute2f128_ps(u3, u7, 0x31));
+}
+
+CPPMATH_AVX2 inline void avx2TileDouble(const double* src, std::ptrdiff_t srcStride, double* dst, std::ptrdiff_t dstStride) {
+    const __m256d r0 = _mm256_loadu_pd(src);
+    const __m256d r1 = _mm256_loadu_pd(src + srcStride);
+    const __m256d r2 = _mm256_loadu_pd(src + 2 * srcStride);
+    const __m256d r3 = _mm256_loadu_pd(src + 3 * srcStride);
+
+    const __m256d t0 = _mm256_unpacklo_pd(r0, r1);
+    const __m256d t1 = _mm256_unpackhi_pd(r0, r1);
+    const __m256d t2 = _mm256_unpacklo_pd(r2, r3);
+    const __m256d t3 = _mm256_unpackhi_pd(r2, r3);
+
+    _mm256_storeu_pd(dst, _mm256_permute2f128_pd(t0, t2, 0x20));
+    _mm256_storeu_pd(dst + dstStride, _mm256_permute2f128_pd(t1, t3, 0x20));
+    _mm256_storeu_pd(dst + 2 * dstStride, _mm256_permute2f128_pd(t0, t2, 0x31));
+    _mm256_storeu_pd(dst + 3 * dstStride, _mm256_permute2f128_pd(t1, t3, 0x31));
+}
+
+/** Leaf block kernels: whole tiles in registers, the ragged right and
+    bottom edges with the scalar loop.
+ */
+#define CPPMATH_TRANSPOSE_BLOCK(NAME, TARGET, T, TILE, TILE_FN)                         \
+TARGET void NAME(const T* src, std::ptrdiff_t srcStride, T* dst, std::ptrdiff_t dstStride, \
+                 std::size_t rows, std::size_t columns) {                               \
+    const std::size_t fullRows = rows - rows % TILE;                                    \
+    const std::size_t fullColumns = columns - columns % TILE;                           \
+    for(std::size_t r = 0; r < fullRows; r += TILE) {                                   \
+        const T* s = src + static_cast<std::ptrdiff_t>(r) * srcStride;                  \
+        for(std::size_t c = 0; c < fullColumns; c += TILE) {                            \
+            TILE_FN(s + c, srcStride, dst + static_cast<std::ptrdiff_t>(c) * dstStride + r, dstStride); \
+        }                                                                               \
+    }                                                                                   \
+    if(fullColumns < columns) {                                                         \
+        genericTransposeBlock(src + fullColumns, srcStride, dst + static_cast<std::ptrdiff_t>(fullColumns) * dstStride, \
+                              dstStride, fullRows, columns - fullColumns);              \
+    }                                                                                   \
+    if(fullRows < rows) {                                                               \
+        genericTransposeBlock(src + static_cast<std::ptrdiff_t>(fullRows) * srcStride, srcStride, dst + fullRows, \
+                              dstStride, rows - fullRows, columns);                     \
+    }                                                                                   \
+}
+
+CPPMATH_TRANSPOSE_BLOCK(sse2BlockFloat, CPPMATH_SSE2, float, 4, sse2TileFloat)
+CPPMATH_TRANSPOSE_BLOCK(sse2BlockDouble, CPPMATH_SSE2, double, 4, sse2TileDouble)
+CPPMATH_TRANSPOSE_BLOCK(avx2BlockFloat, CPPMATH_AVX2, float, 8, avx2TileFloat)
+CPPMATH_TRANSPOSE_BLOCK(avx2BlockDouble, CPPMATH_AVX2, double, 4, avx2TileDouble)
+
+#undef CPPMATH_TRANSPOSE_BLOCK
+
+#endif // CPPMATH_X86_DISPATCH
+
+} // namespace
+
+template <> TransposeKernels<float> transposeKernels<float>(cpu::InstructionSet isa) {
+    TransposeKernels<float> k = genericTransposeKernels<float>();
+#if CPPMATH_X86_DISPATCH
+    switch(isa) {
+        case cpu::InstructionSet::AVX512:
+        case cpu::InstructionSet::AVX2: k.block = &avx2BlockFloat; break;
+        case cpu::InstructionSet::SSE2: k.block = &sse2BlockFloat; break;
+        default: break;
+    }
+#endif
+    (void)isa;
+    return k;
+}
+
+template <> TransposeKernels<double> transposeKernels<double>(cpu::InstructionSet isa) {
+    TransposeKernels<double> k = genericTransposeKernels<double>();
+#if CPPMATH_X86_DISPATCH
+    switch(isa) {
+        case cpu::InstructionSet::AVX512:
+        case cpu::InstructionSet::AVX2: k.block = &avx2BlockDouble; break;
+        case cpu::InstructionSet::SSE2: k.block = &sse2BlockDouble; break;
+        default: break;
+    }
+#endif
+    (void)isa;
+    return k;
+}
+
+} // namespace detail
+} //namespace matrix
+} //namespace cppmath
@@ -0,0 +1,393 @@
+//
+//  cppmath_transpose.hpp
+//  CppMath
+//
+//  Created by Dmytro Krasnianskyi on 17.10.26.
+//  Copyright © 2026 Dmytro Krasnianskyi. All rights reserved.
+//
+
+#ifndef cppmath_transpose_hpp
+#define cppmath_transpose_hpp
+
+#include <cstddef>
+#include <cassert>
+#include <vector>
+#include <utility>
+#include <algorithm>
+#include <type_traits>
+
+#include "cppmath_cpu.hpp"
+#include "cppmath_matrix.hpp"
+#include "cppmath_parallel.hpp"
+
+/** Out-of-place and in-place transposes.
+
+    The out-of-place transpose halves the longer side of the matrix until a
+    block fits in the cache, so both the reads and the scattered writes stay
+    within a few pages at any depth. Leaf blocks go to a runtime dispatched
+    kernel that transposes 4x4 or 8x8 tiles in registers. Square matrices
+    are transposed in place by swapping mirrored blocks, other shapes by
+    following the permutation cycles of the storage with one bit of
+    bookkeeping per element.
+
+    The same kernels convert matrices between storage layouts: the storage
+    of a column-major matrix is the row-major storage of its transpose, and
+    a tiled matrix is a grid of small row-major blocks, each copied to or
+    from its window of a strided matrix.
+ */
+
+namespace cppmath {
+namespace matrix{
+
+namespace detail {
+
+template <typename T>
+struct TransposeKernels {
+    /** dst = src^T for a rows x columns block with contiguous rows. Strides
+        are in elements.
+     */
+    typedef void (*Block)(const T* src, std::ptrdiff_t srcStride, T* dst, std::ptrdiff_t dstStride,
+                          std::size_t rows, std::size_t columns);
+
+    Block block = nullptr;
+};
+
+template <typename T>
+void genericTransposeBlock(const T* src, std::ptrdiff_t srcStride, T* dst, std::ptrdiff_t dstStride,
+                           std::size_t rows, std::size_t columns) {
+    for(std::size_t r = 0; r < rows; ++r) {
+        const T* row = src + static_cast<std::ptrdiff_t>(r) * srcStride;
+        for(std::size_t c = 0; c < columns; ++c) dst[static_cast<std::ptrdiff_t>(c) * dstStride + r] = row[c];
+    }
+}
+
+template <typename T>
+TransposeKernels<T> genericTransposeKernels() {
+    TransposeKernels<T> k;
+    k.block = &genericTransposeBlock<T>;
+    return k;
+}
+
+/** Kernels for the given instruction set level. The generic template
+    ignores the level, float and double have SIMD specializations.
+ */
+template <typename T>
+inline TransposeKernels<T> transposeKernels(cpu::InstructionSet) {
+    return genericTransposeKernels<T>();
+}
+
+template <> TransposeKernels<float> transposeKernels<float>(cpu::InstructionSet isa);
+template <> TransposeKernels<double> transposeKernels<double>(cpu::InstructionSet isa);
+
+/** Kernels for the running CPU, selected on the first use. */
+template <typename T>
+inline const TransposeKernels<T>& activeTransposeKernels() {
+    static const TransposeKernels<T> kernels = transposeKernels<T>(cpu::instructionSet());
+    return kernels;
+}
+
+/** Side of the leaf blocks: two 64 x 64 double blocks fit in L1. */
+constexpr std::size_t kTransposeLeaf = 64;
+
+/** Elements per task of the parallel transposes. */
+constexpr std::size_t kTransposeGrain = std::size_t(1) << 15;
+
+/** Split points are kept on multiples of 8 so that leaves stay tile aligned. */
+inline std::size_t transposeSplit(std::size_t n) {
+    const std::size_t half = n / 2;
+    return half >= 16 ? half & ~std::size_t(7) : half;
+}
+
+template <typename T>
+void transposeRecursive(const ConstMatrixView<T>& src, const MatrixView<T>& dst, const TransposeKernels<T>& kernels) {
+    const std::size_t rows = src.rows();
+    const std::size_t columns = src.columns();
+    if(rows <= kTransposeLeaf && columns <= kTransposeLeaf) {
+        if(src.columnStride() == 1 && dst.columnStride() == 1) {
+            kernels.block(src.data(), src.rowStride(), dst.data(), dst.rowStride(), rows, columns);
+        } else {
+            for(std::size_t r = 0; r < rows; ++r)
+                for(std::size_t c = 0; c < columns; ++c)
+                    dst[MatrixPoint{c, r}] = src[MatrixPoint{r, c}];
+        }
+        return;
+    }
+    if(rows >= columns) {
+        const std::size_t half = transposeSplit(rows);
+        transposeRecursive(src.submatrix(MatrixPoint{0, 0}, half, columns), dst.submatrix(MatrixPoint{0, 0}, columns, half), kernels);
+        transposeRecursive(src.submatrix(MatrixPoint{half, 0}, rows - half, columns),
+                           dst.submatrix(MatrixPoint{0, half}, columns, rows - half), kernels);
+    } else {
+        const std::size_t half = transposeSplit(columns);
+        transposeRecursive(src.submatrix(MatrixPoint{0, 0}, rows, half), dst.submatrix(MatrixPoint{0, 0}, half, rows), kernels);
+        transposeRecursive(src.submatrix(MatrixPoint{0, half}, rows, columns - half),
+                           dst.submatrix(MatrixPoint{half, 0}, columns - half, rows), kernels);
+    }
+}
+
+template <typename T>
+void transposeBands(const execution::ExecutionPolicy& policy, const ConstMatrixView<T>& src, const MatrixView<T>& dst) {
+    assert(src.rows() == dst.columns() && src.columns() == dst.rows());
+    if(src.size() == 0) return;
+    const TransposeKernels<T>& kernels = activeTransposeKernels<T>();
+    const std::size_t columns = src.columns();
+    // Tasks take bands of source rows, each band is transposed recursively
+    const std::size_t grain = std::max<std::size_t>(kTransposeLeaf, kTransposeGrain / columns);
+    execution::parallelFor(policy, 0, src.rows(), grain, [&](std::size_t first, std::size_t last){
+        transposeRecursive(src.submatrix(MatrixPoint{first, 0}, last - first, columns),
+                           dst.submatrix(MatrixPoint{0, first}, columns, last - first), kernels);
+    });
+}
+
+template <typename T>
+void transposeViews(const execution::ExecutionPolicy& policy, const ConstMatrixView<T>& src, const MatrixView<T>& dst) {
+    const instrumentation::ScopedOperation counted(instrumentation::Operation::Transpose, 0);
+    transposeBands(policy, src, dst);
+}
+
+/** Transposes a dense n x n matrix in place: diagonal blocks by swapping
+    across their diagonal, mirrored block pairs through one leaf buffer.
+ */
+template <typename T>
+void transposeSquareInPlace(const execution::ExecutionPolicy& policy, T* data, std::size_t n) {
+    const TransposeKernels<T>& kernels = activeTransposeKernels<T>();
+    const std::size_t leaf = kTransposeLeaf;
+    const std::size_t blocks = (n + leaf - 1) / leaf;
+    const std::ptrdiff_t stride = static_cast<std::ptrdiff_t>(n);
+    const std::size_t grain = std::max<std::size_t>(1, kTransposeGrain / (leaf * std::max<std::size_t>(n, 1)));
+
+    execution::parallelFor(policy, 0, blocks, grain, [&](std::size_t firstBlock, std::size_t lastBlock){
+        std::vector<T> buffer(leaf * leaf);
+        for(std::size_t bi = firstBlock; bi < lastBlock; ++bi) {
+            const std::size_t i0 = bi * leaf;
+            const std::size_t rows = std::min(leaf, n - i0);
+            for(std::size_t r = 0; r < rows; ++r)
+                for(std::size_t c = r + 1; c < rows; ++c)
+                    std::swap(data[(i0 + r) * n + i0 + c], data[(i0 + c) * n + i0 + r]);
+
+            for(std::size_t j0 = i0 + leaf; j0 < n; j0 += leaf) {
+                const std::size_t columns = std::min(leaf, n - j0);
+                T* upper = data + i0 * n + j0;
+                T* lower = data + j0 * n + i0;
+                // buffer = upper^T, upper = lower^T, lower = buffer
+                kernels.block(upper, stride, buffer.data(), static_cast<std::ptrdiff_t>(rows), rows, columns);
+                kernels.block(lower, stride, upper, stride, columns, rows);
+                for(std::size_t r = 0; r < columns; ++r)
+                    std::copy(buffer.data() + r * rows, buffer.data() + (r + 1) * rows, lower + r * n);
+            }
+        }
+    });
+}
+
+/** Permutes a dense rows x columns storage into its columns x rows
+    transpose. The element at index p moves to p * rows mod (size - 1), every
+    cycle of that permutation is rotated once.
+ */
+template <typename T>
+void transposeCyclesInPlace(T* data, std::size_t rows, std::size_t columns) {
+    const std::size_t size = rows * columns;
+    if(size < 3) return;
+    const std::size_t modulus = size - 1;
+    std::vector<bool> moved(size, false);
+    for(std::size_t start = 1; start < modulus; ++start) {
+        if(moved[start]) continue;
+        T value = std::move(data[start]);
+        std::size_t p = start;
+        do {
+            p = static_cast<std::size_t>((static_cast<unsigned long long>(p) * rows) % modulus);
+            std::swap(value, data[p]);
+            moved[p] = true;
+        } while(p != start);
+    }
+}
+
+template <class A, class Out>
+using EnableIfTranspose = typename std::enable_if<IsMatrixLike<A>::value && IsMatrixLike<Out>::value>::type;
+
+/** dst = src for views of the same shape. Rows are copied when both have
+    contiguous rows, a source or destination with contiguous columns goes
+    through the transpose kernels, anything else element by element.
+ */
+template <typename T>
+void copyView(const ConstMatrixView<T>& src, const MatrixView<T>& dst, const TransposeKernels<T>& kernels) {
+    assert(src.rows() == dst.rows() && src.columns() == dst.columns());
+    if(src.hasContiguousRows() && dst.hasContiguousRows()) {
+        for(std::size_t r = 0; r < src.rows(); ++r) std::copy(src.rowData(r), src.rowData(r) + src.columns(), dst.rowData(r));
+    } else if(src.transposed().hasContiguousRows() && dst.hasContiguousRows()) {
+        transposeRecursive(src.transposed(), dst, kernels);
+    } else if(src.hasContiguousRows() && dst.transposed().hasContiguousRows()) {
+        transposeRecursive(src, dst.transposed(), kernels);
+    } else {
+        dst.assign(src);
+    }
+}
+
+template <typename T, class Layout>
+inline BasicMatrixView<T> layoutView(T* data, std::size_t rows, std::size_t columns) {
+    return BasicMatrixView<T>(data, rows, columns, Layout::rowStride(rows, columns), Layout::columnStride(rows, columns));
+}
+
+/** Tiled::forEachTile with bands of block rows split between tasks. */
+template <class Tiled, class Fn>
+void forEachTileParallel(const execution::ExecutionPolicy& policy, std::size_t rows, std::size_t columns, Fn fn) {
+    const std::size_t bandElements = Tiled::kTile * std::max<std::size_t>(columns, 1);
+    const std::size_t grain = std::max<std::size_t>(1, kTransposeGrain / bandElements);
+    execution::parallelFor(policy, 0, Tiled::tiles(rows), grain, [&](std::size_t first, std::size_t last){
+        Tiled::forEachTile(rows, columns, first, last, fn);
+    });
+}
+
+template <typename T, class From, class To>
+void convertStorage(const execution::ExecutionPolicy& policy, const T* src, T* dst, std::size_t rows, std::size_t columns,
+                    std::true_type, std::true_type) {
+    const ConstMatrixView<T> vs = layoutView<const T, From>(src, rows, columns);
+    const MatrixView<T> vd = layoutView<T, To>(dst, rows, columns);
+    if(std::is_same<From, To>::value || rows <= 1 || columns <= 1) {
+        const std::size_t size = rows * columns;
+        execution::parallelFor(policy, 0, size, kTransposeGrain, [&](std::size_t first, std::size_t last){
+            std::copy(src + first, src + last, dst + first);
+        });
+    } else if(vs.columnStride() == 1) {
+        transposeBands(policy, vs, vd.transposed());
+    } else {
+        transposeBands(policy, vs.transposed(), vd);
+    }
+}
+
+template <typename T, class From, class To>
+void convertStorage(const execution::ExecutionPolicy& policy, const T* src, T* dst, std::size_t rows, std::size_t columns,
+                    std::false_type, std::true_type) {
+    const TransposeKernels<T>& kernels = activeTransposeKernels<T>();
+    const MatrixView<T> vd = layoutView<T, To>(dst, rows, columns);
+    const std::ptrdiff_t tile = static_cast<std::ptrdiff_t>(From::kTile);
+    forEachTileParallel<From>(policy, rows, columns,
+                              [&](const MatrixPoint& origin, std::size_t tileRows, std::size_t tileColumns, std::size_t offset){
+        copyView(ConstMatrixView<T>(src + offset, tileRows, tileColumns, tile, 1),
+                 vd.submatrix(origin, tileRows, tileColumns), kernels);
+    });
+}
+
+template <typename T, class From, class To>
+void convertStorage(const execution::ExecutionPolicy& policy, const T* src, T* dst, std::size_t rows, std::size_t columns,
+                    std::true_type, std::false_type) {
+    const TransposeKernels<T>& kernels = activeTransposeKernels<T>();
+    const ConstMatrixView<T> vs = layoutView<const T, From>(src, rows, columns);
+    const std::ptrdiff_t tile = static_cast<std::ptrdiff_t>(To::kTile);
+    forEachTileParallel<To>(policy, rows, columns,
+                            [&](const MatrixPoint& origin, std::size_t tileRows, std::size_t tileColumns, std::size_t offset){
+        copyView(vs.submatrix(origin, tileRows, tileColumns),
+                 MatrixView<T>(dst + offset, tileRows, tileColumns, tile, 1), kernels);
+    });
+}
+
+/** Between tiled layouts blocks of the same size are copied whole, other
+    sizes element by element.
+ */
+template <typename T, class From, class To>
+void convertStorage(const execution::ExecutionPolicy& policy, const T* src, T* dst, std::size_t rows, std::size_t columns,
+                    std::false_type, std::false_type) {
+    const std::size_t tile = To::kTile;
+    forEachTileParallel<To>(policy, rows, columns,
+                            [&](const MatrixPoint& origin, std::size_t tileRows, std::size_t tileColumns, std::size_t offset){
+        if(From::kTile == tile) {
+            const T* block = src + From::tileOffset(origin.row / tile, origin.column / tile, rows, columns);
+            std::copy(block, block + tile * tile, dst + offset);
+            return;
+        }
+        for(std::size_t i = 0; i < tileRows; ++i)
+            for(std::size_t j = 0; j < tileColumns; ++j)
+                dst[offset + i * tile + j] = src[From::offset(origin.row + i, origin.column + j, rows, columns)];
+    });
+}
+
+} // namespace detail
+
+/** out = a^T. out must be a.columns() x a.rows() and must not overlap a. */
+template <class A, class Out>
+detail::EnableIfTranspose<A, Out> transpose(const execution::ExecutionPolicy& policy, const A& a, Out&& out) {
+    typedef typename MatrixValueType<Out>::type T;
+    detail::transposeViews<T>(policy, constView(a), mutableView(out));
+}
+
+template <class A, class Out>
+detail::EnableIfTranspose<A, Out> transpose(const A& a, Out&& out) {
+    transpose(execution::par, a, std::forward<Out>(out));
+}
+
+/** A new matrix holding a^T. */
+template <class A>
+typename std::enable_if<IsMatrixLike<A>::value, Matrix<typename MatrixValueType<A>::type>>::type
+transposed(const execution::ExecutionPolicy& policy, const A& a) {
+    typedef typename MatrixValueType<A>::type T;
+    const ConstMatrixView<T> va = constView(a);
+    Matrix<T> result(va.columns(), va.rows());
+    detail::transposeViews<T>(policy, va, result.view());
+    return result;
+}
+
+template <class A>
+typename std::enable_if<IsMatrixLike<A>::value, Matrix<typename MatrixValueType<A>::type>>::type
+transposed(const A& a) {
+    return transposed(execution::par, a);
+}
+
+/** Replaces m with its transpose without a second copy of the elements.
+    Rectangular matrices swap rows() and columns(). Only square matrices are
+    split between threads, the cycles of the rectangular case are walked in
+    order.
+ */
+template <typename T, class Allocator, class Layout>
+void transposeInPlace(const execution::ExecutionPolicy& policy, Matrix<T, Allocator, Layout>& m) {
+    static_assert(Layout::kStrided, "Only strided layouts are transposed in place");
+    const instrumentation::ScopedOperation counted(instrumentation::Operation::Transpose, 0);
+    if(m.rows() == m.columns()) {
+        detail::transposeSquareInPlace(policy, m.data(), m.rows());
+        return;
+    }
+    // A column-major storage is the row-major storage of the transpose
+    const std::size_t lines = Layout::kRowMajor ? m.rows() : m.columns();
+    if(m.rows() > 1 && m.columns() > 1) detail::transposeCyclesInPlace(m.data(), lines, m.size() / lines);
+    m.reshape(m.columns(), m.rows());
+}
+
+template <typename T, class Allocator, class Layout>
+void transposeInPlace(Matrix<T, Allocator, Layout>& m) {
+    transposeInPlace(execution::par, m);
+}
+
+/** dst = src with the elements rearranged for the layout of dst, which is
+    resized to the shape of src. Row-major to column-major and back runs the
+    cache-oblivious transpose over the storage, conversions from or to tiled
+    layouts copy block by block.
+ */
+template <typename T, class FromAllocator, class From, class ToAllocator, class To>
+void convertLayout(const execution::ExecutionPolicy& policy, const Matrix<T, FromAllocator, From>& src,
+                   Matrix<T, ToAllocator, To>& dst) {
+    assert(static_cast<const void*>(&src) != static_cast<const void*>(&dst));
+    const instrumentation::ScopedOperation counted(instrumentation::Operation::Transpose, 0);
+    if(dst.rows() != src.rows() || dst.columns() != src.columns()) {
+        dst = Matrix<T, ToAllocator, To>(src.rows(), src.columns(), dst.get_allocator());
+    }
+    if(src.size() == 0) return;
+    detail::convertStorage<T, From, To>(policy, src.data(), dst.data(), src.rows(), src.columns(),
+                                        std::integral_constant<bool, From::kStrided>(),
+                                        std::integral_constant<bool, To::kStrided>());
+}
+
+template <typename T, class FromAllocator, class From, class ToAllocator, class To>
+void convertLayout(const Matrix<T, FromAllocator, From>& src, Matrix<T, ToAllocator, To>& dst) {
+    convertLayout(execution::par, src, dst);
+}
+
+/** Copy of m in layout To, with the allocator of m. */
+template <class To, typename T, class Allocator, class From>
+Matrix<T, Allocator, To> withLayout(const Matrix<T, Allocator, From>& m) {
+    Matrix<T, Allocator, To> result(m.get_allocator());
+    convertLayout(execution::par, m, result);
+    return result;
+}
+
+} //namespace matrix
+} //namespace cppmath
+
+#endif /* cppmath_transpose_hpp */
@@ -0,0 +1,131 @@
+#include <iostream>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+
+#include "src/cppmath_matrix.hpp"
+#include "src/cppmath_gemm.hpp"
+#include "src/cppmath_elementwise.hpp"
+#include "cppmath_test.hpp"
+
+using namespace cppmath::matrix;
+using namespace cppmath::memory;
+
+static std::size_t gGlobalAllocations = 0;
+
+void* operator new(std::size_t bytes) {
+    ++gGlobalAllocations;
+    if(void* p = std::malloc(bytes ? bytes : 1)) return p;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+
+bool isAligned(const void* p, std::size_t alignment){
+    return reinterpret_cast<std::uintptr_t>(p) % alignment == 0;
+}
+
+void testAlignedAllocator(){
+    for(std::size_t n = 1; n < 40; n += 3) {
+        AlignedMatrix<float> m(n, n, 1.0f);
+        ASSERT_THROW(isAligned(m.data(), kSimdAlignment));
+        ASSERT_EQUAL(m[n * n - 1], 1.0f);
+    }
+
+    AlignedAllocator<double, 128> wide;
+    double* p = wide.allocate(7);
+    ASSERT_THROW(isAligned(p, 128));
+    wide.deallocate(p, 7);
+
+    AlignedMatrix<double> a({{1, 2}, {3, 4}});
+    AlignedMatrix<double> b = a;
+    ASSERT_THROW(isAligned(b.data(), kSimdAlignment));
+    ASSERT_EQUAL((b[{1, 0}]), 3.0);
+}
+
+void testArena(){
+    Arena arena(256);
+    ASSERT_EQUAL(arena.capacity(), 256);
+    ASSERT_EQUAL(arena.upstreamAllocations(), 1);
+
+    void* a = arena.allocate(10, 1);
+    void* b = arena.allocate(8, 64);
+    ASSERT_THROW(isAligned(b, 64));
+    ASSERT_THROW(static_cast<char*>(b) >= static_cast<char*>(a) + 10);
+    ASSERT_EQUAL(arena.used(), 72);
+
+    // Overflow goes to a bigger chunk, reset merges the chunks into one
+    arena.allocate(1000, 8);
+    ASSERT_EQUAL(arena.upstreamAllocations(), 2);
+    arena.reset();
+    ASSERT_EQUAL(arena.used(), 0);
+    ASSERT_EQUAL(arena.upstreamAllocations(), 3);
+    const std::size_t capacity = arena.capacity();
+    ASSERT_THROW(capacity >= 1256);
+
+    arena.allocate(10, 1);
+    arena.allocate(1000, 8);
+    arena.reset();
+    ASSERT_EQUAL(arena.upstreamAllocations(), 3);
+    ASSERT_EQUAL(arena.capacity(), capacity);
+
+    void* big = arena.allocate(16, 256);
+    ASSERT_THROW(isAligned(big, 256));
+}
+
+void testArenaMatrix(){
+    Arena arena;
+    ArenaMatrix<double> a(3, 3, 2.0, arena);
+    ArenaMatrix<double> b(3, 3, arena);
+    ASSERT_THROW(&a.get_allocator().arena() == &arena);
+    ASSERT_THROW(isAligned(a.data(), kSimdAlignment));
+    ASSERT_EQUAL(b[8], 0.0);
+
+    ArenaMatrix<double> copy = a;
+    ASSERT_THROW(&copy.get_allocator().arena() == &arena);
+
+    // Products keep the allocator of the left operand
+    auto c = a * a;
+    ASSERT_THROW(&c.get_allocator().arena() == &arena);
+    ASSERT_EQUAL((c[{1, 1}]), 12.0);
+
+    ArenaMatrix<double> e(a + a * 3.0, arena);
+    ASSERT_EQUAL(e[4], 8.0);
+    Matrix<double> plain(e.view());
+    ASSERT_EQUAL(plain[4], 8.0);
+}
+
+void requestRound(Arena& arena, std::size_t n){
+    arena.reset();
+    ArenaMatrix<double> a(n, n, 1.5, arena);
+    ArenaMatrix<double> b(n, n, 0.5, arena);
+    ArenaMatrix<double> sum(a + b * 2.0, arena);
+    auto product = a * b;
+    add(product, sum, product);
+    ASSERT_NEAR(product[n * n - 1], 0.75 * n + 2.5, 1e-12);
+}
+
+void testSteadyStateAllocations(){
+    Arena arena(1024);
+    requestRound(arena, 48);
+    requestRound(arena, 48);
+
+    const std::size_t before = gGlobalAllocations;
+    for(int i = 0; i < 10; ++i) requestRound(arena, 48);
+    ASSERT_EQUAL(gGlobalAllocations - before, 0);
+}
+
+void testAllocator()
+{
+    testAlignedAllocator();
+    testArena();
+    testArenaMatrix();
+    testSteadyStateAllocations();
+}
+
+int main(int a, char**)
+{
+    testAllocator();
+    return 0;
+}
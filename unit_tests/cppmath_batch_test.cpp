@@ -0,0 +1,184 @@
+#include <iostream>
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include "src/cppmath_batch.hpp"
+#include "src/cppmath_gemm.hpp"
+#include "src/cppmath_factorization.hpp"
+#include "cppmath_test.hpp"
+
+using namespace cppmath::matrix;
+using cppmath::cpu::InstructionSet;
+
+template <typename T>
+MatrixBatch<T> randomBatch(std::size_t count, std::size_t rows, std::size_t columns, std::mt19937& rng){
+    std::uniform_int_distribution<int> dist(-8, 8);
+    MatrixBatch<T> batch(count, rows, columns);
+    for(std::size_t i = 0; i < count; ++i) {
+        const MatrixView<T> m = batch[i];
+        for(std::size_t r = 0; r < rows; ++r)
+            for(std::size_t c = 0; c < columns; ++c)
+                m[MatrixPoint{r, c}] = static_cast<T>(dist(rng)) / T(4);
+    }
+    return batch;
+}
+
+/** Diagonally dominant, so far from singular. */
+template <typename T>
+MatrixBatch<T> regularBatch(std::size_t count, std::size_t n, std::mt19937& rng){
+    MatrixBatch<T> batch = randomBatch<T>(count, n, n, rng);
+    for(std::size_t i = 0; i < n; ++i) {
+        T* diagonal = batch.plane(i, i);
+        for(std::size_t l = 0; l < count; ++l) diagonal[l] += static_cast<T>(2 * n) * (diagonal[l] < T(0) ? T(-1) : T(1));
+    }
+    return batch;
+}
+
+void testLayout(){
+    MatrixBatch<double> batch(20, 2, 3);
+    ASSERT_EQUAL(batch.count(), 20u);
+    ASSERT_EQUAL(batch.stride(), 32u);
+    batch[5][MatrixPoint{1, 2}] = 7.0;
+    ASSERT_EQUAL(batch.plane(1, 2)[5], 7.0);
+    ASSERT_EQUAL(batch[5].rows(), 2u);
+    ASSERT_EQUAL(batch[5].columns(), 3u);
+
+    // Views assign from and into ordinary matrices
+    const Matrix<double> m(2, 3, {1, 2, 3, 4, 5, 6});
+    batch[19].assign(constView(m));
+    const Matrix<double> back(batch[19]);
+    for(std::size_t i = 0; i < m.size(); ++i) ASSERT_EQUAL(back[i], m[i]);
+    ASSERT_EQUAL(batch.plane(0, 1)[19], 2.0);
+    ASSERT_EQUAL(batch.plane(0, 1)[18], 0.0);
+}
+
+template <typename T>
+void testMultiply(){
+    std::mt19937 rng(3);
+    const std::size_t shapes[][3] = {{2, 2, 2}, {3, 3, 3}, {4, 4, 4}, {8, 8, 8}, {2, 5, 3}, {6, 1, 7}};
+    for(const auto& shape : shapes) {
+        const auto a = randomBatch<T>(45, shape[0], shape[1], rng);
+        const auto b = randomBatch<T>(45, shape[1], shape[2], rng);
+        MatrixBatch<T> c(45, shape[0], shape[2]);
+        batchMultiply(a, b, c);
+        for(std::size_t i = 0; i < a.count(); ++i) {
+            Matrix<T> expected(shape[0], shape[2]);
+            gemm(T(1), a[i], b[i], T(0), expected);
+            const Matrix<T> actual(c[i]);
+            // Quarter integers keep these products exact
+            for(std::size_t e = 0; e < expected.size(); ++e) ASSERT_EQUAL(actual[e], expected[e]);
+        }
+    }
+}
+
+template <typename T>
+void testSolve(double tolerance){
+    std::mt19937 rng(5);
+    for(std::size_t n = 1; n <= 8; ++n) {
+        const std::size_t count = 50;
+        const auto a = regularBatch<T>(count, n, rng);
+        const auto b = randomBatch<T>(count, n, 3, rng);
+
+        MatrixBatch<T> x(count, n, 3);
+        MatrixBatch<T> inverse(count, n, n);
+        const std::vector<T> det = batchDeterminant(a);
+        ASSERT_EQUAL(batchSolve(a, b, x), 0u);
+        ASSERT_EQUAL(batchInverse(a, inverse), 0u);
+        ASSERT_EQUAL(det.size(), count);
+
+        for(std::size_t i = 0; i < count; ++i) {
+            const LU<T> lu(a[i]);
+            const double scale = std::fabs(static_cast<double>(lu.determinant()));
+            ASSERT_NEAR(static_cast<double>(det[i]), static_cast<double>(lu.determinant()), tolerance * scale);
+
+            // Residuals of A X - B and A A^-1 - I
+            Matrix<T> residual(b[i]);
+            gemm(T(1), a[i], x[i], T(-1), residual);
+            Matrix<T> identity(n, n);
+            gemm(T(1), a[i], inverse[i], T(0), identity);
+            for(std::size_t e = 0; e < residual.size(); ++e) ASSERT_NEAR(static_cast<double>(residual[e]), 0.0, tolerance);
+            for(std::size_t r = 0; r < n; ++r)
+                for(std::size_t c = 0; c < n; ++c)
+                    ASSERT_NEAR(static_cast<double>(identity[MatrixPoint{r, c}]), r == c ? 1.0 : 0.0, tolerance);
+        }
+    }
+}
+
+void testSingular(){
+    MatrixBatch<double> a(3, 2, 2);
+    a[0].assign(constView(Matrix<double>(2, 2, {1, 2, 2, 4})));
+    a[1].assign(constView(Matrix<double>(2, 2, {0, 1, 1, 0})));
+    a[2].assign(constView(Matrix<double>(2, 2, {4, 7, 2, 6})));
+    MatrixBatch<double> inverse(3, 2, 2);
+    ASSERT_EQUAL(batchInverse(a, inverse), 1u);
+    ASSERT_THROW(!std::isfinite((inverse[0][MatrixPoint{1, 1}])));
+    ASSERT_NEAR((inverse[1][MatrixPoint{0, 1}]), 1.0, 1e-15);
+    ASSERT_NEAR((inverse[2][MatrixPoint{0, 0}]), 0.6, 1e-15);
+    ASSERT_NEAR((inverse[2][MatrixPoint{0, 1}]), -0.7, 1e-15);
+
+    const std::vector<double> det = batchDeterminant(a);
+    ASSERT_EQUAL(det[0], 0.0);
+    ASSERT_EQUAL(det[1], -1.0);
+    ASSERT_NEAR(det[2], 10.0, 1e-14);
+}
+
+/** Every kernel level against the generic loops on the same planes. */
+template <typename T>
+void testKernelLevels(double tolerance){
+    const InstructionSet levels[] = {InstructionSet::Generic, InstructionSet::SSE2, InstructionSet::AVX2, InstructionSet::AVX512};
+    std::mt19937 rng(9);
+    const std::size_t count = 64;
+    const std::size_t n = 5;
+    const auto a = regularBatch<T>(count, n, rng);
+    const auto b = randomBatch<T>(count, n, 2, rng);
+    const detail::BatchKernels<T> reference = detail::genericBatchKernels<T>();
+    std::vector<T> scratch(n * n * kBatchLanes);
+
+    MatrixBatch<T> expectedProduct(count, n, 2);
+    reference.multiply(a.data(), b.data(), expectedProduct.data(), n, n, 2, a.stride(), a.stride());
+    std::vector<T> expectedDet(count);
+    reference.determinant(a.data(), expectedDet.data(), n, a.stride(), a.stride(), scratch.data());
+    MatrixBatch<T> expectedX(b);
+    std::vector<unsigned char> expectedSingular(count);
+    reference.solve(a.data(), expectedX.data(), n, 2, a.stride(), a.stride(), expectedSingular.data(), scratch.data());
+
+    for(const InstructionSet isa : levels) {
+        if(!cppmath::cpu::supports(isa)) continue;
+        const detail::BatchKernels<T> kernels = detail::batchKernels<T>(isa);
+        MatrixBatch<T> product(count, n, 2);
+        kernels.multiply(a.data(), b.data(), product.data(), n, n, 2, a.stride(), a.stride());
+        std::vector<T> det(count);
+        kernels.determinant(a.data(), det.data(), n, a.stride(), a.stride(), scratch.data());
+        MatrixBatch<T> x(b);
+        std::vector<unsigned char> singular(count);
+        kernels.solve(a.data(), x.data(), n, 2, a.stride(), a.stride(), singular.data(), scratch.data());
+
+        for(std::size_t i = 0; i < count; ++i) {
+            ASSERT_EQUAL(singular[i], expectedSingular[i]);
+            ASSERT_NEAR(static_cast<double>(det[i]), static_cast<double>(expectedDet[i]),
+                        tolerance * std::fabs(static_cast<double>(expectedDet[i])));
+            for(std::size_t e = 0; e < n * 2; ++e) {
+                ASSERT_EQUAL(product[i][e], expectedProduct[i][e]);
+                ASSERT_NEAR(static_cast<double>(x[i][e]), static_cast<double>(expectedX[i][e]), tolerance);
+            }
+        }
+    }
+}
+
+void testBatch(){
+    testLayout();
+    testMultiply<double>();
+    testMultiply<float>();
+    testSolve<double>(1e-12);
+    testSolve<float>(1e-4);
+    testSingular();
+    testKernelLevels<double>(1e-12);
+    testKernelLevels<float>(1e-4);
+}
+
+int main(int a, char**)
+{
+    testBatch();
+    return 0;
+}
@@ -0,0 +1,243 @@
+#include <iostream>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "src/cppmath_bit_matrix.hpp"
+#include "cppmath_test.hpp"
+
+using namespace cppmath::matrix;
+using cppmath::cpu::InstructionSet;
+
+BitMatrix randomBits(std::size_t rows, std::size_t columns, double density, std::mt19937& rng){
+    std::bernoulli_distribution bit(density);
+    BitMatrix m(rows, columns);
+    for(std::size_t r = 0; r < rows; ++r)
+        for(std::size_t c = 0; c < columns; ++c)
+            if(bit(rng)) m.set(r, c);
+    return m;
+}
+
+BitMatrix naiveProduct(const BitMatrix& a, const BitMatrix& b){
+    BitMatrix c(a.rows(), b.columns());
+    for(std::size_t i = 0; i < a.rows(); ++i)
+        for(std::size_t k = 0; k < a.columns(); ++k)
+            if(a.test(i, k))
+                for(std::size_t j = 0; j < b.columns(); ++j)
+                    if(b.test(k, j)) c.set(i, j);
+    return c;
+}
+
+BitMatrix naiveClosure(BitMatrix m){
+    const std::size_t n = m.rows();
+    for(std::size_t k = 0; k < n; ++k)
+        for(std::size_t i = 0; i < n; ++i)
+            if(m.test(i, k))
+                for(std::size_t j = 0; j < n; ++j)
+                    if(m.test(k, j)) m.set(i, j);
+    return m;
+}
+
+void testLayout(){
+    const BitMatrix empty;
+    ASSERT_THROW(empty.empty());
+
+    // Rows padded to powers of two words, then to cache lines
+    ASSERT_EQUAL(BitMatrix(3, 64).wordsPerRow(), 1u);
+    ASSERT_EQUAL(BitMatrix(3, 130).wordsPerRow(), 4u);
+    ASSERT_EQUAL(BitMatrix(3, 600).wordsPerRow(), 16u);
+    ASSERT_EQUAL(BitMatrix(3, 600).rowWords(), 10u);
+    const BitMatrix aligned(5, 1000);
+    ASSERT_EQUAL(reinterpret_cast<std::uintptr_t>(aligned.rowData(3)) % 64, 0u);
+
+    // Padding bits stay clear
+    BitMatrix ones(7, 70, true);
+    ASSERT_EQUAL(ones.count(), 7u * 70u);
+    ASSERT_EQUAL(ones.rowCount(6), 70u);
+    ones.flip();
+    ASSERT_EQUAL(ones.count(), 0u);
+    ones.fill(true);
+    ASSERT_EQUAL((~ones).count(), 0u);
+
+    BitMatrix m(4, 100);
+    m.set(0, 0);
+    m.set(3, 99);
+    m.set(2, 64);
+    m.flip(2, 64);
+    m.flip(1, 63);
+    ASSERT_THROW(m.test(0, 0) && m.test(3, 99) && m.test(1, 63) && !m.test(2, 64));
+    ASSERT_THROW((m[MatrixPoint{3, 99}]));
+    m.reset(0, 0);
+    ASSERT_EQUAL(m.count(), 2u);
+
+    const Matrix<int> source(2, 3, {0, 5, 0, -1, 0, 2});
+    const BitMatrix fromSource(source);
+    ASSERT_THROW(!fromSource.test(0, 0) && fromSource.test(0, 1) && fromSource.test(1, 0) && fromSource.test(1, 2));
+    ASSERT_EQUAL(fromSource.count(), 3u);
+}
+
+void testKernelLevels(){
+    const InstructionSet levels[] = {InstructionSet::Generic, InstructionSet::SSE2, InstructionSet::AVX2, InstructionSet::AVX512};
+    const cppmath::cpu::Features& features = cppmath::cpu::features();
+    std::mt19937 rng(3);
+    std::uniform_int_distribution<std::uint64_t> word;
+    std::vector<std::uint64_t> a(83), b(83), out(83), tables(8 * 256 * 5);
+    for(std::size_t i = 0; i < a.size(); ++i) {
+        a[i] = word(rng);
+        b[i] = word(rng);
+    }
+    for(std::size_t i = 0; i < tables.size(); ++i) tables[i] = word(rng);
+    std::size_t expectedCount = 0;
+    for(const std::uint64_t w : a)
+        for(std::size_t bit = 0; bit < 64; ++bit) expectedCount += (w >> bit) & 1u;
+
+    for(const InstructionSet isa : levels) {
+        if(!cppmath::cpu::supports(isa)) continue;
+        for(int popcnt = 0; popcnt < 2; ++popcnt) {
+            if(popcnt && !features.popcnt) continue;
+            const detail::BitKernels k = detail::bitKernels(isa, popcnt != 0, popcnt != 0 && features.avx512vpopcntdq);
+            k.bitAnd(a.data(), b.data(), out.data(), a.size());
+            for(std::size_t i = 0; i < a.size(); ++i) ASSERT_THROW(out[i] == (a[i] & b[i]));
+            k.bitOr(a.data(), b.data(), out.data(), a.size());
+            for(std::size_t i = 0; i < a.size(); ++i) ASSERT_THROW(out[i] == (a[i] | b[i]));
+            k.bitXor(a.data(), b.data(), out.data(), a.size());
+            for(std::size_t i = 0; i < a.size(); ++i) ASSERT_THROW(out[i] == (a[i] ^ b[i]));
+            k.complement(a.data(), out.data(), a.size());
+            for(std::size_t i = 0; i < a.size(); ++i) ASSERT_THROW(out[i] == ~a[i]);
+            ASSERT_EQUAL(k.count(a.data(), a.size()), expectedCount);
+
+            const std::uint64_t selector = 0x0100ff0000a50003ull;
+            std::vector<std::uint64_t> row(b.begin(), b.begin() + 5);
+            k.orTable(row.data(), tables.data(), selector, 5);
+            for(std::size_t w = 0; w < 5; ++w) {
+                std::uint64_t expected = b[w];
+                for(std::size_t g = 0; g < 8; ++g) {
+                    const std::size_t byte = (selector >> (8 * g)) & 0xFF;
+                    if(byte != 0) expected |= tables[(g * 256 + byte) * 5 + w];
+                }
+                ASSERT_THROW(row[w] == expected);
+            }
+        }
+    }
+}
+
+void testAlgebraAndCounts(){
+    std::mt19937 rng(5);
+    const BitMatrix a = randomBits(37, 131, 0.4, rng);
+    const BitMatrix b = randomBits(37, 131, 0.6, rng);
+    const BitMatrix both = a & b, either = a | b, differ = a ^ b, negated = ~a;
+    std::size_t total = 0;
+    for(std::size_t r = 0; r < a.rows(); ++r) {
+        for(std::size_t c = 0; c < a.columns(); ++c) {
+            ASSERT_EQUAL(both.test(r, c), a.test(r, c) && b.test(r, c));
+            ASSERT_EQUAL(either.test(r, c), a.test(r, c) || b.test(r, c));
+            ASSERT_EQUAL(differ.test(r, c), a.test(r, c) != b.test(r, c));
+            ASSERT_EQUAL(negated.test(r, c), !a.test(r, c));
+            total += a.test(r, c);
+        }
+    }
+    ASSERT_EQUAL(a.count(), total);
+    ASSERT_EQUAL(negated.count(), a.size() - total);
+    ASSERT_THROW((a ^ a).count() == 0 && (a | negated).count() == a.size());
+    ASSERT_THROW(~negated == a);
+    ASSERT_THROW(a != b);
+
+    // Per column counts past the 255 row flush of the bit-sliced counters
+    const BitMatrix tall = randomBits(700, 150, 0.7, rng);
+    std::vector<std::size_t> rows, columns;
+    tall.rowCounts(rows);
+    tall.columnCounts(columns);
+    ASSERT_EQUAL(rows.size(), tall.rows());
+    ASSERT_EQUAL(columns.size(), tall.columns());
+    for(std::size_t r = 0; r < tall.rows(); ++r) {
+        std::size_t expected = 0;
+        for(std::size_t c = 0; c < tall.columns(); ++c) expected += tall.test(r, c);
+        ASSERT_EQUAL(rows[r], expected);
+    }
+    for(std::size_t c = 0; c < tall.columns(); ++c) {
+        std::size_t expected = 0;
+        for(std::size_t r = 0; r < tall.rows(); ++r) expected += tall.test(r, c);
+        ASSERT_EQUAL(columns[c], expected);
+    }
+    const BitMatrix full(300, 5, true);
+    full.columnCounts(columns);
+    for(const std::size_t count : columns) ASSERT_EQUAL(count, 300u);
+}
+
+void testTranspose(){
+    std::mt19937 rng(7);
+    const std::size_t shapes[][2] = {{1, 1}, {64, 64}, {65, 3}, {130, 200}, {5, 129}};
+    for(const auto& shape : shapes) {
+        const BitMatrix m = randomBits(shape[0], shape[1], 0.5, rng);
+        const BitMatrix t = m.transposed();
+        ASSERT_EQUAL(t.rows(), m.columns());
+        ASSERT_EQUAL(t.columns(), m.rows());
+        for(std::size_t r = 0; r < m.rows(); ++r)
+            for(std::size_t c = 0; c < m.columns(); ++c) ASSERT_EQUAL(t.test(c, r), m.test(r, c));
+        ASSERT_THROW(t.transposed() == m);
+    }
+}
+
+void testMultiply(){
+    std::mt19937 rng(11);
+    // Inner sizes not multiple of 8 or 64, results wider than one table chunk
+    const std::size_t shapes[][3] = {{1, 1, 1}, {7, 13, 5}, {70, 67, 130}, {40, 300, 1100}, {3, 0, 4}};
+    for(const auto& shape : shapes) {
+        for(const double density : {0.02, 0.3}) {
+            const BitMatrix a = randomBits(shape[0], shape[1], density, rng);
+            const BitMatrix b = randomBits(shape[1], shape[2], density, rng);
+            BitMatrix c(2, 2, true);
+            booleanMultiply(cppmath::execution::seq, a, b, c);
+            ASSERT_THROW(c == naiveProduct(a, b));
+            ASSERT_THROW(booleanMultiply(a, b) == c);
+        }
+    }
+
+    // More rows than one task
+    const BitMatrix a = randomBits(2100, 90, 0.05, rng);
+    const BitMatrix b = randomBits(90, 70, 0.05, rng);
+    BitMatrix c;
+    booleanMultiply(cppmath::execution::par.withGrain(1), a, b, c);
+    ASSERT_THROW(c == naiveProduct(a, b));
+}
+
+void testClosure(){
+    // A directed cycle 0 -> 1 -> ... -> n-1 -> 0 reaches everything
+    const std::size_t n = 150;
+    BitMatrix cycle(n, n);
+    for(std::size_t i = 0; i < n; ++i) cycle.set(i, (i + 1) % n);
+    transitiveClosure(cycle);
+    ASSERT_EQUAL(cycle.count(), n * n);
+
+    // A path backwards through the blocks: only later vertices are reachable
+    BitMatrix path(n, n);
+    for(std::size_t i = 1; i < n; ++i) path.set(i, i - 1);
+    transitiveClosure(cppmath::execution::seq, path);
+    for(std::size_t i = 0; i < n; ++i)
+        for(std::size_t j = 0; j < n; ++j) ASSERT_EQUAL(path.test(i, j), j < i);
+
+    std::mt19937 rng(13);
+    for(const std::size_t size : {1, 9, 64, 65, 200}) {
+        for(const double density : {0.005, 0.02, 0.1}) {
+            BitMatrix m = randomBits(size, size, density, rng);
+            const BitMatrix expected = naiveClosure(m);
+            transitiveClosure(cppmath::execution::par.withGrain(1), m);
+            ASSERT_THROW(m == expected);
+        }
+    }
+}
+
+void testBitMatrix(){
+    testLayout();
+    testKernelLevels();
+    testAlgebraAndCounts();
+    testTranspose();
+    testMultiply();
+    testClosure();
+}
+
+int main(int a, char**)
+{
+    testBitMatrix();
+    return 0;
+}
@@ -0,0 +1,125 @@
+#include <iostream>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <stdexcept>
+
+#include "src/cppmath_functions.hpp"
+#include "src/cppmath_combinatorics.hpp"
+#include "cppmath_test.hpp"
+
+using namespace cppmath::combinatorics;
+using cppmath::functions::matrixCountPaths;
+
+static_assert(binomial(10, 3) == 120, "table binomial");
+static_assert(binomial(100, 3) == 161700, "multiplicative binomial");
+static_assert(factorial(20) == 2432902008176640000ull, "largest factorial");
+static_assert(matrixCountPaths(2, 2) == 6, "paths through a 2x2 lattice");
+
+constexpr std::uint32_t kPrime = 1000000007u;
+constexpr FactorialTable<13, 13> kSmallTable;
+
+void testBinomial(){
+    // The whole 64-bit Pascal triangle and one row past it
+    std::vector<std::vector<BigUnsigned>> pascal(1, std::vector<BigUnsigned>(1, BigUnsigned(1)));
+    for(std::size_t n = 1; n <= 140; ++n) {
+        pascal.push_back(std::vector<BigUnsigned>(n + 1, BigUnsigned(1)));
+        for(std::size_t k = 1; k < n; ++k) pascal[n][k] = pascal[n - 1][k - 1] + pascal[n - 1][k];
+    }
+    for(std::size_t n = 0; n <= 140; ++n) {
+        for(std::size_t k = 0; k <= n; ++k) {
+            std::uint64_t expected = 0;
+            const bool fits = pascal[n][k].toUint64(expected);
+            std::uint64_t value = 0;
+            ASSERT_EQUAL(tryBinomial(n, k, value), fits);
+            if(fits) ASSERT_EQUAL(value, expected);
+            ASSERT_THROW(binomialBig(n, k) == pascal[n][k]);
+            ASSERT_EQUAL(binomialMod(n, k, kPrime), pascal[n][k].mod(kPrime));
+            ASSERT_EQUAL(binomialMod(n, k, 13), pascal[n][k].mod(13));
+            ASSERT_EQUAL(kSmallTable.binomial(n, k).value(), pascal[n][k].mod(13));
+        }
+    }
+    ASSERT_EQUAL(binomial(67, 33), 14226520737620288370ull);
+    ASSERT_EQUAL(binomial(5, 7), 0u);
+    ASSERT_EQUAL(binomial(1000000, 2), 499999500000ull);
+    ASSERT_EQUAL(binomial(1ull << 40, 1), 1ull << 40);
+
+    bool threw = false;
+    try { binomial(68, 34); } catch(const std::overflow_error&) { threw = true; }
+    ASSERT_THROW(threw);
+    threw = false;
+    try { factorial(21); } catch(const std::overflow_error&) { threw = true; }
+    ASSERT_THROW(threw);
+}
+
+void testBigUnsigned(){
+    ASSERT_THROW(binomialBig(100, 50).toString() == "100891344545564193334812497256");
+    ASSERT_THROW(BigUnsigned().toString() == "0");
+    ASSERT_THROW(BigUnsigned(1000000000ull).toString() == "1000000000");
+
+    BigUnsigned x(0xffffffffffffffffull);
+    x *= BigUnsigned(0xffffffffffffffffull);
+    ASSERT_THROW(x.toString() == "340282366920938463426481119284349108225");
+    ASSERT_EQUAL(x.bits(), 128u);
+    std::uint64_t value = 0;
+    ASSERT_THROW(!x.toUint64(value));
+    ASSERT_THROW(BigUnsigned(5) < x);
+    ASSERT_THROW(!(x < BigUnsigned(5)));
+
+    BigUnsigned y(12345);
+    y *= 1ull << 40;
+    ASSERT_EQUAL(y.divide(1024), 0u);
+    ASSERT_THROW(y == BigUnsigned(12345ull << 30));
+}
+
+void testModular(){
+    typedef ModularInt<kPrime> Mod;
+    const Mod a(kPrime - 1);
+    ASSERT_EQUAL((a + Mod(2)).value(), 1u);
+    ASSERT_EQUAL((Mod(1) - Mod(2)).value(), kPrime - 1);
+    ASSERT_EQUAL((Mod(123456789) * Mod(123456789).inverse()).value(), 1u);
+    ASSERT_EQUAL((Mod(10) / Mod(5)).value(), 2u);
+    ASSERT_EQUAL(Mod(3).pow(kPrime - 1).value(), 1u);
+
+    // Lucas' theorem for n far beyond the prime
+    const std::uint64_t n = 1000000000000000000ull;
+    ASSERT_EQUAL(binomialMod(n, 12345, 13), kSmallTable.binomial(n, 12345).value());
+    ASSERT_EQUAL(binomialMod(n, n - 1, kPrime), static_cast<std::uint32_t>(n % kPrime));
+    ASSERT_EQUAL(binomialMod(26, 13, 13), 2u);
+
+    const FactorialTable<kPrime, 1000> table;
+    ASSERT_EQUAL(table.binomial(3000, 1500).value(), binomialMod(3000, 1500, kPrime));
+    ASSERT_EQUAL((table.factorial(999) * table.inverseFactorial(999)).value(), 1u);
+}
+
+void testSaturating(){
+    typedef SaturatingInt<std::uint8_t> Count;
+    ASSERT_EQUAL((Count(200) + Count(55)).value(), 255);
+    ASSERT_THROW((Count(200) + Count(56)).saturated());
+    ASSERT_EQUAL((Count(15) * Count(17)).value(), 255);
+    ASSERT_THROW((Count(16) * Count(16)).saturated());
+    ASSERT_EQUAL((Count(0) * Count(255)).value(), 0);
+    ASSERT_THROW((Count(255) * Count(1)).saturated());
+}
+
+void testCountPaths(){
+    ASSERT_EQUAL(matrixCountPaths(3, 3), 20u);
+    ASSERT_EQUAL(matrixCountPaths(16, 16), 601080390u);
+    ASSERT_EQUAL(matrixCountPaths(17, 17), 2333606220u);
+    ASSERT_EQUAL(matrixCountPaths(30, 30), 118264581564861424u);
+    ASSERT_EQUAL(matrixCountPaths(0, 7), 1u);
+}
+
+void testCombinatorics(){
+    testBinomial();
+    testBigUnsigned();
+    testModular();
+    testSaturating();
+    testCountPaths();
+}
+
+int main(int a, char**)
+{
+    testCombinatorics();
+    return 0;
+}
@@ -0,0 +1,241 @@
+#include <iostream>
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include "src/cppmath_convolution.hpp"
+#include "src/cppmath_transpose.hpp"
+#include "cppmath_test.hpp"
+
+using namespace cppmath::matrix;
+namespace execution = cppmath::execution;
+using cppmath::cpu::InstructionSet;
+
+const Border kBorders[] = {Border::Zero, Border::Clamp, Border::Wrap, Border::Reflect};
+
+/** Folds i into [0, n) by stepping over the edges one at a time, -1 for zero padding. */
+long referenceIndex(long i, long n, Border border){
+    while(i < 0 || i >= n) {
+        switch(border) {
+            case Border::Zero: return -1;
+            case Border::Clamp: i = i < 0 ? 0 : n - 1; break;
+            case Border::Wrap: i = i < 0 ? i + n : i - n; break;
+            case Border::Reflect: i = i < 0 ? -1 - i : 2 * n - 1 - i; break;
+        }
+    }
+    return i;
+}
+
+const std::uniform_real_distribution<double> kValues(-1.0, 1.0);
+
+template <typename T>
+Matrix<T> naiveCorrelate(const Matrix<T>& a, const Matrix<T>& kernel, Border border){
+    const long rows = static_cast<long>(a.rows()), columns = static_cast<long>(a.columns());
+    const long kh = static_cast<long>(kernel.rows()), kw = static_cast<long>(kernel.columns());
+    Matrix<T> out(a.rows(), a.columns());
+    for(long r = 0; r < rows; ++r) {
+        for(long c = 0; c < columns; ++c) {
+            double acc = 0;
+            for(long i = 0; i < kh; ++i) {
+                for(long j = 0; j < kw; ++j) {
+                    const long sr = referenceIndex(r + i - kh / 2, rows, border);
+                    const long sc = referenceIndex(c + j - kw / 2, columns, border);
+                    if(sr < 0 || sc < 0) continue;
+                    acc += double(kernel[MatrixPoint{std::size_t(i), std::size_t(j)}]) * double(a[MatrixPoint{std::size_t(sr), std::size_t(sc)}]);
+                }
+            }
+            out[MatrixPoint{std::size_t(r), std::size_t(c)}] = static_cast<T>(acc);
+        }
+    }
+    return out;
+}
+
+template <class A, class B>
+double maxDifference(const A& a, const B& b){
+    double largest = 0;
+    for(std::size_t r = 0; r < a.rows(); ++r)
+        for(std::size_t c = 0; c < a.columns(); ++c)
+            largest = std::max(largest, std::fabs(double(a[MatrixPoint{r, c}]) - double(b[MatrixPoint{r, c}])));
+    return largest;
+}
+
+void testBorderIndex(){
+    // d c b a | a b c d | d c b a
+    const long n = 4;
+    for(const Border border : kBorders)
+        for(long i = -11; i < 15; ++i) ASSERT_EQUAL(detail::borderIndex(i, n, border), referenceIndex(i, n, border));
+    ASSERT_EQUAL(detail::borderIndex(-1, 4, Border::Reflect), 0);
+    ASSERT_EQUAL(detail::borderIndex(5, 4, Border::Reflect), 2);
+    ASSERT_EQUAL(detail::borderIndex(-1, 4, Border::Wrap), 3);
+    ASSERT_EQUAL(detail::borderIndex(7, 1, Border::Reflect), 0);
+}
+
+template <typename T>
+void testKernelLevels(){
+    const InstructionSet levels[] = {InstructionSet::Generic, InstructionSet::SSE2, InstructionSet::AVX2, InstructionSet::AVX512};
+    std::mt19937 rng(1);
+    const Matrix<T> src = randomMatrix<T>(5, 120, rng, kValues);
+    const Matrix<T> taps = randomMatrix<T>(1, 9, rng, kValues);
+    for(const InstructionSet isa : levels) {
+        if(!cppmath::cpu::supports(isa)) continue;
+        const detail::ConvolutionKernels<T> k = detail::convolutionKernels<T>(isa);
+        for(const std::size_t n : {0u, 1u, 7u, 33u, 111u}) {
+            std::vector<T> out(n, T(2));
+            k.rowFilter(src.data(), taps.data(), 9, out.data(), n, true);
+            for(std::size_t c = 0; c < n; ++c) {
+                double expected = 2;
+                for(std::size_t j = 0; j < 9; ++j) expected += double(taps[j]) * double(src[c + j]);
+                ASSERT_NEAR(double(out[c]), expected, 1e-5);
+            }
+            k.columnFilter(src.data() + 1, 120, taps.data(), 5, out.data(), n);
+            for(std::size_t c = 0; c < n; ++c) {
+                double expected = 0;
+                for(std::size_t i = 0; i < 5; ++i) expected += double(taps[i]) * double(src[i * 120 + 1 + c]);
+                ASSERT_NEAR(double(out[c]), expected, 1e-5);
+            }
+        }
+    }
+}
+
+template <typename T>
+void testCorrelate(double tolerance){
+    std::mt19937 rng(2);
+    const ConvolutionMethod methods[] = {ConvolutionMethod::Auto, ConvolutionMethod::Direct, ConvolutionMethod::Gemm};
+    const std::size_t shapes[][2] = {{1, 1}, {3, 2}, {17, 40}, {70, 530}};
+    const std::size_t kernels[][2] = {{1, 1}, {3, 3}, {2, 4}, {5, 1}, {1, 6}, {7, 9}};
+    for(const auto& shape : shapes) {
+        const Matrix<T> a = randomMatrix<T>(shape[0], shape[1], rng, kValues);
+        for(const auto& size : kernels) {
+            const Matrix<T> kernel = randomMatrix<T>(size[0], size[1], rng, kValues);
+            for(const Border border : kBorders) {
+                const Matrix<T> expected = naiveCorrelate(a, kernel, border);
+                for(const ConvolutionMethod method : methods) {
+                    Matrix<T> out(shape[0], shape[1], T(5));
+                    correlate(execution::par.withGrain(1), a, kernel, out, border, method);
+                    ASSERT_THROW(maxDifference(out, expected) < tolerance);
+                }
+            }
+        }
+    }
+
+    // Strided operands: a column-major source and kernel, a transposed output
+    const Matrix<T> a = randomMatrix<T>(45, 33, rng, kValues);
+    const Matrix<T> kernel = randomMatrix<T>(3, 5, rng, kValues);
+    const ColumnMajorMatrix<T> ca = withLayout<ColumnMajor>(a);
+    const ColumnMajorMatrix<T> ck = withLayout<ColumnMajor>(kernel);
+    ColumnMajorMatrix<T> out(45, 33);
+    correlate(ca, ck, out, Border::Reflect);
+    ASSERT_THROW(maxDifference(out, naiveCorrelate(a, kernel, Border::Reflect)) < tolerance);
+    Matrix<T> transposedOut(33, 45);
+    correlate(execution::seq, a, kernel, transposedOut.view().transposed(), Border::Clamp, ConvolutionMethod::Gemm);
+    ASSERT_THROW(maxDifference(transposedOut.view().transposed(), naiveCorrelate(a, kernel, Border::Clamp)) < tolerance);
+}
+
+template <typename T>
+void testSeparable(double tolerance){
+    std::mt19937 rng(3);
+    // Gaussian, box and Sobel kernels are outer products
+    const Matrix<T> column(5, 1, {1, 4, 6, 4, 1});
+    const Matrix<T> row(1, 5, {1, 4, 6, 4, 1});
+    const Matrix<T> gaussian = column * row * T(1.0 / 256);
+    const Matrix<T> sobel(3, 3, {-1, 0, 1, -2, 0, 2, -1, 0, 1});
+    const Matrix<T> box(4, 6, T(1.0 / 24));
+    const Matrix<T> laplacian(3, 3, {0, 1, 0, 1, -4, 1, 0, 1, 0});
+
+    Matrix<T> u(5, 1), v(1, 5);
+    ASSERT_THROW(separateKernel(gaussian, u, v));
+    ASSERT_THROW(maxDifference(Matrix<T>(u * v), gaussian) < tolerance);
+    Matrix<T> u3(1, 3), v3(3, 1);
+    ASSERT_THROW(separateKernel(sobel, u3, v3));
+    ASSERT_NEAR(double(u3[0] * v3[2]), 1.0, tolerance);
+    ASSERT_NEAR(double(u3[1] * v3[0]), -2.0, tolerance);
+    ASSERT_THROW(!separateKernel(laplacian, u3, v3));
+    ASSERT_THROW(!separateKernel(randomMatrix<T>(3, 3, rng, kValues), u3, v3));
+
+    const Matrix<T> a = randomMatrix<T>(67, 300, rng, kValues);
+    for(const Matrix<T>* kernel : {&gaussian, &sobel, &box, &laplacian}) {
+        for(const Border border : kBorders) {
+            Matrix<T> out(67, 300);
+            correlate(execution::par.withGrain(1), a, *kernel, out, border, ConvolutionMethod::Separable);
+            ASSERT_THROW(maxDifference(out, naiveCorrelate(a, *kernel, border)) < tolerance);
+        }
+    }
+}
+
+template <typename T>
+void testConvolve(double tolerance){
+    std::mt19937 rng(4);
+    const Matrix<T> a = randomMatrix<T>(23, 31, rng, kValues);
+    for(const std::size_t size : {3u, 4u}) {
+        const Matrix<T> kernel = randomMatrix<T>(size, size + 1, rng, kValues);
+        Matrix<T> rotated(size, size + 1);
+        for(std::size_t i = 0; i < size; ++i)
+            for(std::size_t j = 0; j <= size; ++j) rotated[MatrixPoint{i, j}] = kernel[MatrixPoint{size - 1 - i, size - j}];
+        for(const Border border : kBorders) {
+            Matrix<T> out(23, 31);
+            convolve(a, kernel, out, border);
+            ASSERT_THROW(maxDifference(out, naiveCorrelate(a, rotated, border)) < tolerance);
+        }
+    }
+
+    // A single one in the kernel shifts the image
+    Matrix<T> shift(3, 3, T(0));
+    shift[MatrixPoint{0, 2}] = 1;
+    Matrix<T> out(23, 31);
+    convolve(a, shift, out, Border::Wrap);
+    ASSERT_EQUAL((out[MatrixPoint{5, 7}]), (a[MatrixPoint{6, 6}]));
+    ASSERT_EQUAL((out[MatrixPoint{22, 0}]), (a[MatrixPoint{0, 30}]));
+}
+
+template <typename T>
+void testStencil(double tolerance){
+    std::mt19937 rng(5);
+    const Matrix<T> fivePoint(3, 3, {0, T(0.2), 0, T(0.2), T(0.2), T(0.2), 0, T(0.2), 0});
+    const Matrix<T> ninePoint = randomMatrix<T>(3, 3, rng, kValues) * T(0.3);
+    const Matrix<T> wide = randomMatrix<T>(5, 4, rng, kValues) * T(0.15);
+    // Fewer rows than a band, several bands with a short last one, fewer rows than the halo
+    const std::size_t shapes[][2] = {{9, 13}, {150, 70}, {3, 40}, {1, 5}};
+    for(const auto& shape : shapes) {
+        const Matrix<T> a = randomMatrix<T>(shape[0], shape[1], rng, kValues);
+        for(const Matrix<T>* kernel : {&fivePoint, &ninePoint, &wide}) {
+            for(const Border border : kBorders) {
+                Matrix<T> expected = a;
+                for(const std::size_t iterations : {0u, 1u, 3u, 8u, 9u, 20u}) {
+                    Matrix<T> out(shape[0], shape[1], T(7));
+                    stencil(execution::par.withGrain(1), a, *kernel, iterations, out, border);
+                    Matrix<T> reference = a;
+                    for(std::size_t k = 0; k < iterations; ++k) reference = naiveCorrelate(reference, *kernel, border);
+                    ASSERT_THROW(maxDifference(out, reference) < tolerance);
+                }
+            }
+        }
+    }
+
+    // A strided source and output
+    const Matrix<T> a = randomMatrix<T>(80, 41, rng, kValues);
+    Matrix<T> reference = a;
+    for(std::size_t k = 0; k < 11; ++k) reference = naiveCorrelate(reference, fivePoint, Border::Reflect);
+    ColumnMajorMatrix<T> out(80, 41);
+    stencil(withLayout<ColumnMajor>(a), fivePoint, 11, out, Border::Reflect);
+    ASSERT_THROW(maxDifference(out, reference) < tolerance);
+}
+
+void testConvolution(){
+    testBorderIndex();
+    testKernelLevels<float>();
+    testKernelLevels<double>();
+    testCorrelate<float>(1e-4);
+    testCorrelate<double>(1e-12);
+    testSeparable<float>(1e-4);
+    testSeparable<double>(1e-12);
+    testConvolve<float>(1e-4);
+    testConvolve<double>(1e-12);
+    testStencil<float>(1e-4);
+    testStencil<double>(1e-12);
+}
+
+int main(int a, char**)
+{
+    testConvolution();
+    return 0;
+}
@@ -0,0 +1,189 @@
+#include <iostream>
+#include <cstdio>
+#include <cstdlib>
+#include <cstdint>
+#include <string>
+#include <cmath>
+#include <limits>
+#include <random>
+#include <unistd.h>
+
+#include "src/cppmath_csv.hpp"
+#include "cppmath_test.hpp"
+
+using namespace cppmath::matrix;
+using namespace cppmath::io;
+namespace execution = cppmath::execution;
+
+std::string tempPath(const char* name){
+    return "/tmp/cppmath_csv_" + std::to_string(::getpid()) + "_" + name;
+}
+
+void writeFile(const std::string& path, const std::string& text){
+    std::FILE* f = std::fopen(path.c_str(), "wb");
+    std::fwrite(text.data(), 1, text.size(), f);
+    std::fclose(f);
+}
+
+template <class Fn>
+std::size_t parseErrorLine(Fn fn){
+    try {
+        fn();
+    } catch(const ParseError& e) {
+        return e.line();
+    }
+    return 0;
+}
+
+void testNumbers(){
+    const char* samples[] = {
+        "0", "-0", "1", "-17", "3.25", ".5", "5.", "1e10", "-2.5E-3", "123456789012345678",
+        "0.1", "0.3", "1.7976931348623157e308", "4.9e-324", "2.2250738585072014e-308",
+        "9007199254740993", "123456789012345678901234567890", "0.000000000000000000000000000001234",
+        "1e22", "1e23", "3.141592653589793238462643383279", "+7"
+    };
+    for(const char* s : samples) {
+        double value = 0;
+        const char* end = s + std::strlen(s);
+        ASSERT_THROW(detail::parseValue(s, end, value) == end);
+        ASSERT_EQUAL(value, std::strtod(s, nullptr));
+
+        float f = 0;
+        const float expected = std::strtof(s, nullptr);
+        if(std::isinf(expected)) {
+            ASSERT_THROW(detail::parseValue(s, end, f) == nullptr);
+            continue;
+        }
+        ASSERT_THROW(detail::parseValue(s, end, f) == end);
+        ASSERT_EQUAL(f, expected);
+    }
+
+    // Random decimals agree with strtod to the bit
+    std::mt19937_64 rng(3);
+    for(int i = 0; i < 20000; ++i) {
+        char text[64];
+        const int length = std::snprintf(text, sizeof(text), "%.*e", static_cast<int>(rng() % 17 + 1),
+                                         std::ldexp(static_cast<double>(rng() % 1000000) + 0.5, static_cast<int>(rng() % 80) - 40));
+        double value = 0;
+        ASSERT_THROW(detail::parseValue(text, text + length, value) == text + length);
+        ASSERT_EQUAL(value, std::strtod(text, nullptr));
+    }
+
+    const char* invalid[] = {"", "-", ".", "e5", "1e", "1e+", "abc"};
+    for(const char* s : invalid) {
+        double value = 0;
+        const char* end = s + std::strlen(s);
+        ASSERT_THROW(detail::parseValue(s, end, value) != end || *s == '\0');
+    }
+
+    int n = 0;
+    const char digits[] = "-2147483648";
+    ASSERT_THROW(detail::parseValue(digits, digits + 11, n) == digits + 11);
+    ASSERT_EQUAL(n, -2147483647 - 1);
+    const char overflow[] = "2147483648";
+    ASSERT_THROW(detail::parseValue(overflow, overflow + 10, n) == nullptr);
+    unsigned u = 0;
+    const char negative[] = "-1";
+    ASSERT_THROW(detail::parseValue(negative, negative + 2, u) == nullptr);
+
+    // Out of range floating literals are errors, inf itself is not
+    float f = 0;
+    const char large[] = "1e39";
+    ASSERT_THROW(detail::parseValue(large, large + 4, f) == nullptr);
+    const char small[] = "-3.5e40";
+    ASSERT_THROW(detail::parseValue(small, small + 7, f) == nullptr);
+    double d = 0;
+    ASSERT_THROW(detail::parseValue(large, large + 4, d) == large + 4);
+    ASSERT_EQUAL(d, 1e39);
+    const char huge[] = "1e400";
+    ASSERT_THROW(detail::parseValue(huge, huge + 5, d) == nullptr);
+    const char inf[] = "-inf";
+    ASSERT_THROW(detail::parseValue(inf, inf + 4, f) == inf + 4);
+    ASSERT_THROW(f == -std::numeric_limits<float>::infinity());
+    ASSERT_EQUAL(parseErrorLine([]{ parseCsv<float>("1,2\n3,1e39\n"); }), 2);
+}
+
+void testParser(){
+    const auto m = parseCsv<double>("1,2,3\n4, 5.5 ,6\r\n\n  \n7,8,9");
+    ASSERT_EQUAL(m.rows(), 3);
+    ASSERT_EQUAL(m.columns(), 3);
+    ASSERT_EQUAL((m[{1, 1}]), 5.5);
+    ASSERT_EQUAL((m[{2, 2}]), 9.0);
+
+    CsvOptions options;
+    options.delimiter = ';';
+    options.skipLines = 1;
+    options.hasHeader = true;
+    Matrix<int> ints(5, 5, 9);
+    CsvParser<int> parser(ints, options);
+    const std::string text = "# generated\n a ; b\n1;2\n3;4\n";
+    // Byte by byte feeding exercises the carried line
+    for(char c : text) parser.feed(&c, 1);
+    parser.finish();
+    ASSERT_EQUAL(ints.rows(), 2);
+    ASSERT_EQUAL(ints.columns(), 2);
+    ASSERT_EQUAL((ints[{1, 0}]), 3);
+    ASSERT_EQUAL(parser.header().size(), 2);
+    ASSERT_EQUAL(parser.header()[0] == "a" && parser.header()[1] == "b", true);
+    ASSERT_EQUAL(parser.lines(), 4);
+
+    ASSERT_EQUAL(parseErrorLine([]{ parseCsv<double>("1,2\n3\n"); }), 2);
+    ASSERT_EQUAL(parseErrorLine([]{ parseCsv<double>("1,2\n3,x\n"); }), 2);
+    ASSERT_EQUAL(parseErrorLine([]{ parseCsv<double>("1,,2\n"); }), 1);
+    ASSERT_EQUAL(parseErrorLine([]{ parseCsv<double>("1 2\n"); }), 1);
+    ASSERT_EQUAL(parseCsv<float>("").size(), 0);
+}
+
+void testFiles(){
+    const std::string path = tempPath("data");
+    std::mt19937 rng(11);
+    std::uniform_real_distribution<double> dist(-1000, 1000);
+    Matrix<double> expected(3000, 7);
+    std::string text = "x0,x1,x2,x3,x4,x5,x6\n";
+    for(std::size_t r = 0; r < expected.rows(); ++r) {
+        for(std::size_t c = 0; c < expected.columns(); ++c) {
+            char field[32];
+            std::snprintf(field, sizeof(field), "%.6f", dist(rng));
+            expected[{r, c}] = std::strtod(field, nullptr);
+            text += field;
+            text += c + 1 < expected.columns() ? "," : "\n";
+        }
+    }
+    writeFile(path, text);
+
+    CsvOptions options;
+    options.hasHeader = true;
+    options.chunkSize = 1000;
+    const auto sequential = readCsv<double>(path, options);
+    ASSERT_EQUAL(sequential.rows(), 3000);
+    for(std::size_t i = 0; i < expected.size(); ++i) ASSERT_EQUAL(sequential[i], expected[i]);
+
+    execution::setThreadCount(4);
+    const auto parallel = readCsv<double>(execution::par, path, options);
+    ASSERT_EQUAL(parallel.rows(), 3000);
+    ASSERT_EQUAL(parallel.columns(), 7);
+    for(std::size_t i = 0; i < expected.size(); ++i) ASSERT_EQUAL(parallel[i], expected[i]);
+    execution::setThreadCount(0);
+
+    bool thrown = false;
+    try {
+        readCsv<double>(path + "_missing");
+    } catch(const FileError&) {
+        thrown = true;
+    }
+    ASSERT_EQUAL(thrown, true);
+    std::remove(path.c_str());
+}
+
+void testCsv()
+{
+    testNumbers();
+    testParser();
+    testFiles();
+}
+
+int main(int a, char**)
+{
+    testCsv();
+    return 0;
+}
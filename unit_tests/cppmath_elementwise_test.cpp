@@ -0,0 +1,123 @@
+#include <iostream>
+#include <algorithm>
+#include <limits>
+
+#include "src/cppmath_elementwise.hpp"
+#include "cppmath_test.hpp"
+
+using namespace cppmath::matrix;
+
+template <typename T>
+Matrix<T> rampMatrix(std::size_t rows, std::size_t columns, T step, T offset){
+    Matrix<T> m(rows, columns);
+    for(std::size_t i = 0; i < m.size(); ++i) {
+        m[i] = offset + step * static_cast<T>(i % 23);
+    }
+    return m;
+}
+
+template <typename T>
+void testKernels(const detail::ElementwiseKernels<T>& k){
+    // Odd sizes exercise both the vector loops and the scalar tails.
+    const std::size_t sizes[] = {0, 1, 3, 7, 16, 31, 64, 129, 1000};
+    for(const auto n : sizes) {
+        const auto a = rampMatrix<T>(1, n, T(0.5), T(-3));
+        const auto b = rampMatrix<T>(1, n, T(-0.25), T(2));
+        Matrix<T> out(1, n);
+
+        k.add(a.data(), b.data(), out.data(), n);
+        for(std::size_t i = 0; i < n; ++i) ASSERT_EQUAL(out[i], a[i] + b[i]);
+
+        k.subtract(a.data(), b.data(), out.data(), n);
+        for(std::size_t i = 0; i < n; ++i) ASSERT_EQUAL(out[i], a[i] - b[i]);
+
+        k.multiply(a.data(), b.data(), out.data(), n);
+        for(std::size_t i = 0; i < n; ++i) ASSERT_EQUAL(out[i], a[i] * b[i]);
+
+        k.scale(a.data(), T(-2), out.data(), n);
+        for(std::size_t i = 0; i < n; ++i) ASSERT_EQUAL(out[i], T(-2) * a[i]);
+
+        Matrix<T> y(b);
+        k.axpy(T(4), a.data(), y.data(), n);
+        for(std::size_t i = 0; i < n; ++i) ASSERT_EQUAL(y[i], b[i] + T(4) * a[i]);
+
+        Matrix<unsigned char> mask(1, n);
+        k.compare(a.data(), b.data(), mask.data(), n, CompareOp::Less);
+        for(std::size_t i = 0; i < n; ++i) ASSERT_EQUAL(mask[i], a[i] < b[i]);
+        k.compare(a.data(), b.data(), mask.data(), n, CompareOp::GreaterEqual);
+        for(std::size_t i = 0; i < n; ++i) ASSERT_EQUAL(mask[i], a[i] >= b[i]);
+        k.compare(a.data(), a.data(), mask.data(), n, CompareOp::Equal);
+        for(std::size_t i = 0; i < n; ++i) ASSERT_EQUAL(mask[i], 1);
+        k.compare(a.data(), a.data(), mask.data(), n, CompareOp::NotEqual);
+        for(std::size_t i = 0; i < n; ++i) ASSERT_EQUAL(mask[i], 0);
+    }
+}
+
+template <typename T>
+void testAllKernels(){
+    const cppmath::cpu::InstructionSet levels[] = {
+        cppmath::cpu::InstructionSet::Generic,
+        cppmath::cpu::InstructionSet::SSE2,
+        cppmath::cpu::InstructionSet::AVX2,
+        cppmath::cpu::InstructionSet::AVX512
+    };
+    for(const auto isa : levels) {
+        if(cppmath::cpu::supports(isa)) {
+            testKernels<T>(detail::elementwiseKernels<T>(isa));
+        }
+    }
+}
+
+void testNanCompare(){
+    const double nan = std::numeric_limits<double>::quiet_NaN();
+    Matrix<double> a(3, 7, nan);
+    Matrix<double> b(3, 7, 1.0);
+    Matrix<unsigned char> mask(3, 7);
+
+    compare(a, b, CompareOp::NotEqual, mask);
+    for(std::size_t i = 0; i < mask.size(); ++i) ASSERT_EQUAL(mask[i], 1);
+    compare(a, b, CompareOp::LessEqual, mask);
+    for(std::size_t i = 0; i < mask.size(); ++i) ASSERT_EQUAL(mask[i], 0);
+}
+
+void testMatrixApi(){
+    Matrix<float> a(5, 9, 1.5f);
+    Matrix<float> b(5, 9, 0.5f);
+    Matrix<float> out(5, 9);
+
+    add(a, b, out);
+    ASSERT_EQUAL((out[{4, 8}]), 2.f);
+    subtract(a, b, out);
+    ASSERT_EQUAL((out[{2, 3}]), 1.f);
+    hadamard(a, b, out);
+    ASSERT_EQUAL((out[{0, 0}]), 0.75f);
+    scale(a, 2.f, out);
+    ASSERT_EQUAL((out[{1, 7}]), 3.f);
+    axpy(2.f, b, out);
+    ASSERT_EQUAL((out[{3, 3}]), 4.f);
+
+    // In place through aliasing output
+    add(a, a, a);
+    ASSERT_EQUAL((a[{4, 4}]), 3.f);
+
+    Matrix<int> x(2, 2, {1, 2, 3, 4});
+    Matrix<int> y(2, 2, {4, 3, 2, 1});
+    Matrix<int> z(2, 2);
+    add(x, y, z);
+    for(std::size_t i = 0; i < z.size(); ++i) ASSERT_EQUAL(z[i], 5);
+}
+
+void testElementwise()
+{
+    testAllKernels<float>();
+    testAllKernels<double>();
+    testAllKernels<int>();
+    testNanCompare();
+    testMatrixApi();
+}
+
+int main(int a, char**)
+{
+    testElementwise();
+    return 0;
+}
@@ -0,0 +1,108 @@
+#include <iostream>
+#include <algorithm>
+#include <numeric>
+
+#include "src/cppmath_matrix.hpp"
+#include "src/cppmath_gemm.hpp"
+#include "cppmath_test.hpp"
+
+using namespace cppmath::matrix;
+
+Matrix<double> ramp(std::size_t rows, std::size_t columns, double step){
+    Matrix<double> m(rows, columns);
+    for(std::size_t i = 0; i < m.size(); ++i) m[i] = step * static_cast<double>(i);
+    return m;
+}
+
+void testExpressionEvaluation(){
+    const auto a = ramp(3, 5, 1.0);
+    const auto b = ramp(3, 5, 0.5);
+    const auto c = ramp(3, 5, -2.0);
+
+    Matrix<double> d = a + b * 2 - c;
+    ASSERT_EQUAL(d.rows(), 3);
+    ASSERT_EQUAL(d.columns(), 5);
+    for(std::size_t i = 0; i < d.size(); ++i) {
+        ASSERT_EQUAL(d[i], a[i] + b[i] * 2 - c[i]);
+    }
+
+    d = -(a - c) / 2.0 + 0.5 * hadamard(a, b) - 1;
+    for(std::size_t i = 0; i < d.size(); ++i) {
+        ASSERT_EQUAL(d[i], -(a[i] - c[i]) / 2.0 + 0.5 * (a[i] * b[i]) - 1);
+    }
+}
+
+void testExpressionAssignment(){
+    const auto a = ramp(4, 4, 1.0);
+    Matrix<double> d(4, 4, 1.0);
+    const double* storage = d.data();
+
+    // Same shape reuses the buffer, the expression may read the destination.
+    d = d + a * 3.0;
+    ASSERT_EQUAL_EXP(d.data(), storage);
+    for(std::size_t i = 0; i < d.size(); ++i) {
+        ASSERT_EQUAL(d[i], 1.0 + 3.0 * a[i]);
+    }
+
+    // Different shape takes the shape of the expression.
+    Matrix<double> e;
+    e = a - a;
+    ASSERT_EQUAL(e.rows(), 4);
+    ASSERT_EQUAL(e.columns(), 4);
+    for(std::size_t i = 0; i < e.size(); ++i) ASSERT_EQUAL(e[i], 0.0);
+
+    // Existing copy and move assignment still apply to plain matrices.
+    Matrix<double> f;
+    f = a;
+    ASSERT_EQUAL(f.size(), a.size());
+    Matrix<double> g;
+    g = std::move(f);
+    ASSERT_EQUAL(g[5], a[5]);
+}
+
+void testExpressionIterators(){
+    const auto a = ramp(2, 3, 1.0);
+    const auto b = ramp(2, 3, 1.0);
+
+    const auto sum = a + b;
+    ASSERT_EQUAL(std::distance(sum.begin(), sum.end()), 6);
+    ASSERT_EQUAL(std::accumulate(sum.begin(), sum.end(), 0.0), 30.0);
+
+    auto it = sum.begin() + 4;
+    ASSERT_EQUAL(it.row(), 1);
+    ASSERT_EQUAL(it.column(), 1);
+    ASSERT_EQUAL(*it, 8.0);
+    ASSERT_EQUAL(it[1], 10.0);
+
+    Matrix<double> out(2, 3);
+    std::copy(sum.begin(), sum.end(), out.begin());
+    for(std::size_t i = 0; i < out.size(); ++i) ASSERT_EQUAL(out[i], 2.0 * static_cast<double>(i));
+
+    std::transform(a.begin(), a.end(), out.begin(), out.begin(), [](double x, double y){ return x + y; });
+    ASSERT_EQUAL(out[5], 15.0);
+
+    ASSERT_EQUAL(*std::max_element(sum.begin(), sum.end()), 10.0);
+}
+
+void testMatrixProductStaysEager(){
+    Matrix<int> a(2, 2, {1, 2, 3, 4});
+    Matrix<int> b(2, 2, {1, 0, 0, 1});
+
+    Matrix<int> c = a * b + a * 2;
+    int expect[4] = {3, 6, 9, 12};
+    for(std::size_t i = 0; i < c.size(); ++i) ASSERT_EQUAL(c[i], expect[i]);
+}
+
+void testExpression()
+{
+    testExpressionEvaluation();
+    testExpressionAssignment();
+    testExpressionIterators();
+    testMatrixProductStaysEager();
+}
+
+int main(int a, char**)
+{
+    testExpression();
+    return 0;
+}
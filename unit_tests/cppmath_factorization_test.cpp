@@ -0,0 +1,181 @@
+#include <iostream>
+#include <random>
+#include <cmath>
+#include <stdexcept>
+
+#include "src/cppmath_factorization.hpp"
+#include "src/cppmath_fixed_matrix.hpp"
+#include "cppmath_test.hpp"
+
+using namespace cppmath::matrix;
+
+const std::uniform_real_distribution<double> kValues(-1.0, 1.0);
+
+Matrix<double> product(const Matrix<double>& a, const Matrix<double>& b){
+    Matrix<double> c(a.rows(), b.columns());
+    gemm(1.0, a, b, 0.0, c);
+    return c;
+}
+
+double maxDifference(const Matrix<double>& a, const Matrix<double>& b){
+    ASSERT_EQUAL(a.rows(), b.rows());
+    ASSERT_EQUAL(a.columns(), b.columns());
+    double diff = 0;
+    for(std::size_t i = 0; i < a.size(); ++i) diff = std::max(diff, std::abs(a[i] - b[i]));
+    return diff;
+}
+
+Matrix<double> identity(std::size_t n){
+    Matrix<double> m(n, n);
+    for(std::size_t i = 0; i < n; ++i) m[{i, i}] = 1.0;
+    return m;
+}
+
+void testLU(){
+    std::mt19937 rng(5);
+    const std::size_t sizes[] = {1, 2, 7, 64, 65, 150};
+    const std::size_t blocks[] = {1, 8, 64};
+    for(const std::size_t n : sizes) {
+        for(const std::size_t block : blocks) {
+            const auto a = randomMatrix<double>(n, n, rng, kValues);
+            const LU<double> lu(a, block);
+            ASSERT_EQUAL(lu.isSingular(), false);
+
+            // P A = L U with the recorded row swaps
+            Matrix<double> pa(a);
+            for(std::size_t j = 0; j < n; ++j) {
+                for(std::size_t c = 0; c < n; ++c) std::swap(pa[{j, c}], pa[{lu.pivots()[j], c}]);
+            }
+            ASSERT_THROW(maxDifference(pa, product(lu.lower(), lu.upper())) < 1e-10);
+
+            const auto b = randomMatrix<double>(n, 3, rng, kValues);
+            ASSERT_THROW(maxDifference(product(a, lu.solve(b)), b) < 1e-9);
+            ASSERT_THROW(maxDifference(product(a, lu.inverse()), identity(n)) < 1e-9);
+        }
+    }
+
+    const FixedMatrix3<double> f{2, -1, 0, -1, 2, -1, 0, -1, 2};
+    ASSERT_NEAR(LU<double>(f.toMatrix()).determinant(), f.determinant(), 1e-12);
+    ASSERT_NEAR(determinant(Matrix<double>(2, 2, {0, 1, 1, 0})), -1.0, 1e-15);
+    ASSERT_NEAR(determinant(Matrix<double>(2, 2, {1, 2, 3, 4}).view().transposed()), -2.0, 1e-15);
+
+    const LU<double> singular(Matrix<double>(2, 2, {1, 2, 2, 4}));
+    ASSERT_EQUAL(singular.isSingular(), true);
+    ASSERT_EQUAL(singular.determinant(), 0.0);
+}
+
+void testCholesky(){
+    std::mt19937 rng(9);
+    const std::size_t sizes[] = {1, 5, 64, 129};
+    for(const std::size_t n : sizes) {
+        const auto m = randomMatrix<double>(n, n, rng, kValues);
+        Matrix<double> spd(n, n);
+        gemm(1.0, m, m.view().transposed(), 0.0, spd);
+        for(std::size_t i = 0; i < n; ++i) spd[{i, i}] += n;
+
+        const Cholesky<double> cholesky(spd, 16);
+        ASSERT_EQUAL(cholesky.isPositiveDefinite(), true);
+        Matrix<double> llt(n, n);
+        gemm(1.0, cholesky.lower(), cholesky.lower().view().transposed(), 0.0, llt);
+        ASSERT_THROW(maxDifference(llt, spd) < 1e-9);
+        for(std::size_t i = 0; i + 1 < n; ++i) ASSERT_EQUAL((cholesky.lower()[{i, i + 1}]), 0.0);
+
+        const auto b = randomMatrix<double>(n, 4, rng, kValues);
+        ASSERT_THROW(maxDifference(product(spd, cholesky.solve(b)), b) < 1e-9);
+        ASSERT_THROW(std::abs(cholesky.determinant() / LU<double>(spd).determinant() - 1.0) < 1e-9);
+    }
+
+    ASSERT_EQUAL(Cholesky<double>(Matrix<double>(2, 2, {1, 2, 2, 1})).isPositiveDefinite(), false);
+    ASSERT_EQUAL(Cholesky<double>(Matrix<double>(1, 1, {-1})).isPositiveDefinite(), false);
+}
+
+void testQR(){
+    std::mt19937 rng(13);
+    const std::size_t shapes[][2] = {{1, 1}, {5, 3}, {70, 70}, {200, 90}, {130, 1}};
+    for(const auto& shape : shapes) {
+        const std::size_t m = shape[0];
+        const std::size_t n = shape[1];
+        const auto a = randomMatrix<double>(m, n, rng, kValues);
+        const QR<double> qr(a, 16);
+        ASSERT_EQUAL(qr.isFullRank(), true);
+
+        const auto q = qr.thinQ();
+        ASSERT_THROW(maxDifference(product(q, qr.R()), a) < 1e-10);
+        Matrix<double> qtq(n, n);
+        gemm(1.0, q.view().transposed(), q, 0.0, qtq);
+        ASSERT_THROW(maxDifference(qtq, identity(n)) < 1e-10);
+
+        // Least squares residuals are orthogonal to the columns of A
+        const auto b = randomMatrix<double>(m, 2, rng, kValues);
+        const auto x = qr.solve(b);
+        Matrix<double> residual = product(a, x);
+        for(std::size_t i = 0; i < residual.size(); ++i) residual[i] -= b[i];
+        Matrix<double> normal(n, 2);
+        gemm(1.0, a.view().transposed(), residual, 0.0, normal);
+        ASSERT_THROW(maxDifference(normal, Matrix<double>(n, 2)) < 1e-9);
+        ASSERT_THROW(maxDifference(solve(a, b), x) < 1e-9);
+    }
+
+    const Matrix<double> square(2, 2, {4, 3, 6, 3});
+    ASSERT_NEAR(QR<double>(square).determinant(), -6.0, 1e-12);
+    ASSERT_EQUAL(QR<double>(Matrix<double>(3, 2, {1, 0, 2, 0, 3, 0})).isFullRank(), false);
+}
+
+void testSolve(){
+    const Matrix<double> a(2, 2, {3, 1, 1, 2});
+    const Matrix<double> b(2, 1, {9, 8});
+    const auto x = solve(a, b);
+    ASSERT_NEAR(x[0], 2.0, 1e-14);
+    ASSERT_NEAR(x[1], 3.0, 1e-14);
+
+    const auto inv = inverse(a);
+    ASSERT_NEAR((inv[{0, 0}]), 0.4, 1e-14);
+    ASSERT_NEAR((inv[{0, 1}]), -0.2, 1e-14);
+
+    // Line fit y = 1 + 2t through exact points
+    const Matrix<double> design(4, 2, {1, 0, 1, 1, 1, 2, 1, 3});
+    const Matrix<double> y(4, 1, {1, 3, 5, 7});
+    const auto fit = solve(design, y);
+    ASSERT_NEAR(fit[0], 1.0, 1e-12);
+    ASSERT_NEAR(fit[1], 2.0, 1e-12);
+
+    const Matrix<float> af(2, 2, {2, 0, 0, 4});
+    ASSERT_NEAR(determinant(af), 8.0f, 1e-6f);
+}
+
+template <class Fn>
+bool throwsInvalidArgument(Fn fn){
+    try {
+        fn();
+    } catch(const std::invalid_argument&) {
+        return true;
+    }
+    return false;
+}
+
+void testShapeErrors(){
+    const Matrix<double> wide(2, 3, {1, 2, 3, 4, 5, 6});
+    const Matrix<double> tall(3, 2, {1, 2, 3, 4, 5, 6});
+    ASSERT_THROW(throwsInvalidArgument([&]{ LU<double> lu(tall); }));
+    ASSERT_THROW(throwsInvalidArgument([&]{ Cholesky<double> cholesky(wide); }));
+    ASSERT_THROW(throwsInvalidArgument([&]{ QR<double> qr(wide); }));
+    ASSERT_THROW(throwsInvalidArgument([&]{ QR<double>(tall).determinant(); }));
+    ASSERT_THROW(throwsInvalidArgument([&]{ determinant(wide); }));
+    ASSERT_THROW(throwsInvalidArgument([&]{ inverse(tall.view().transposed()); }));
+    ASSERT_THROW(throwsInvalidArgument([&]{ LU<double> lu((Matrix<double>())); }));
+}
+
+void testFactorization()
+{
+    testLU();
+    testCholesky();
+    testQR();
+    testSolve();
+    testShapeErrors();
+}
+
+int main(int a, char**)
+{
+    testFactorization();
+    return 0;
+}
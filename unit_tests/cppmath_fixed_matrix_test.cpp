@@ -0,0 +1,133 @@
+#include <iostream>
+#include <vector>
+
+#include "src/cppmath_fixed_matrix.hpp"
+#include "src/cppmath_gemm.hpp"
+#include "cppmath_test.hpp"
+
+using namespace cppmath::matrix;
+
+constexpr FixedMatrix<int, 2, 3> kA({{1, 2, 3}, {4, 5, 6}});
+constexpr FixedMatrix<int, 3, 2> kB({{7, 8}, {9, 10}, {11, 12}});
+
+static_assert(kA.rows() == 2 && kA.columns() == 3 && kA.size() == 6, "");
+static_assert((kA + kA)[5] == 12, "");
+static_assert((kA - kA)[2] == 0, "");
+static_assert((-kA)[0] == -1, "");
+static_assert((2 * kA)[4] == 10, "");
+static_assert((kA * 3)[MatrixPoint{1, 2}] == 18, "");
+static_assert(kA.transposed()[MatrixPoint{2, 1}] == 6, "");
+static_assert((kA * kB)[MatrixPoint{0, 0}] == 58, "");
+static_assert((kA * kB)[MatrixPoint{1, 1}] == 154, "");
+static_assert(FixedMatrix3<int>::identity().trace() == 3, "");
+static_assert(FixedMatrix2<int>({{3, 8}, {4, 6}}).determinant() == -14, "");
+static_assert(FixedMatrix3<int>({{6, 1, 1}, {4, -2, 5}, {2, 8, 7}}).determinant() == -306, "");
+static_assert(FixedMatrix2<double>({{4.0, 7.0}, {2.0, 6.0}}).inverse()[1] == -0.7, "");
+static_assert(kA == FixedMatrix<int, 2, 3>{1, 2, 3, 4, 5, 6}, "");
+static_assert(kA != FixedMatrix<int, 2, 3>(1), "");
+static_assert(FixedMatrix2<int>{1, 2, 3, 4, 5, 6} == FixedMatrix2<int>{1, 2, 3, 4}, "");
+
+template <std::size_t N>
+FixedMatrix<double, N, N> testSquare(){
+    FixedMatrix<double, N, N> m;
+    for(std::size_t r = 0; r < N; ++r)
+        for(std::size_t c = 0; c < N; ++c)
+            m[{r, c}] = 1.0 / (1.0 + r + c) + (r == c ? 2.0 : 0.0) + 0.25 * c;
+    return m;
+}
+
+template <std::size_t N>
+void checkInverse(){
+    const auto m = testSquare<N>();
+    const auto product = m * m.inverse();
+    const auto identity = FixedMatrix<double, N, N>::identity();
+    for(std::size_t i = 0; i < product.size(); ++i) ASSERT_NEAR(product[i], identity[i], 1e-12);
+
+    // Determinant agrees with Gaussian elimination on the generic path
+    ASSERT_NEAR(m.determinant(), (detail::FixedSquare<double, N>::determinant(m)), 1e-12);
+    const auto general = detail::FixedSquare<double, N>::inverse(m);
+    for(std::size_t i = 0; i < product.size(); ++i) ASSERT_NEAR(general[i], m.inverse()[i], 1e-12);
+}
+
+void testInverse(){
+    checkInverse<1>();
+    checkInverse<2>();
+    checkInverse<3>();
+    checkInverse<4>();
+    checkInverse<6>();
+
+    const FixedMatrix3<double> singular({{1, 2, 3}, {2, 4, 6}, {1, 1, 1}});
+    ASSERT_NEAR(singular.determinant(), 0.0, 1e-12);
+    ASSERT_NEAR((FixedMatrix<double, 5, 5>::identity() * 2.0).determinant(), 32.0, 1e-12);
+}
+
+void testIterators(){
+    FixedMatrix<int, 2, 3> m = kA;
+    auto it = m.begin();
+    ASSERT_EQUAL(*it, 1);
+    it += 4;
+    ASSERT_EQUAL(*it, 5);
+    *it = 50;
+    ASSERT_EQUAL((m[{1, 1}]), 50);
+
+    int sum = 0;
+    for(const auto& v : kA) sum += v;
+    ASSERT_EQUAL(sum, 21);
+    ASSERT_EQUAL(*kA.beginAt({1, 0}), 4);
+    ASSERT_EQUAL(kA.end() - kA.begin(), 6);
+}
+
+void testAlignment(){
+    static_assert(alignof(FixedMatrix4<float>) == 16, "");
+    static_assert(alignof(FixedMatrix4<double>) == 16, "");
+    static_assert(alignof(FixedMatrix3<float>) == alignof(float), "");
+    static_assert(sizeof(FixedMatrix4<float>) == 16 * sizeof(float), "");
+
+    std::vector<FixedMatrix4<float>> v(3);
+    for(const auto& m : v) ASSERT_EQUAL(reinterpret_cast<std::uintptr_t>(m.data()) % 16, 0);
+}
+
+void testMatrixInterop(){
+    const Matrix<double> dynamic({{1, 2}, {3, 4}, {5, 6}});
+    const FixedMatrix<double, 3, 2> fixed(dynamic);
+    ASSERT_EQUAL((fixed[{2, 1}]), 6.0);
+
+    const FixedMatrix<double, 2, 3> fromView(dynamic.view().transposed());
+    ASSERT_EQUAL((fromView[{1, 2}]), 6.0);
+
+    const Matrix<double> back = fixed.toMatrix();
+    ASSERT_EQUAL(back.rows(), 3);
+    ASSERT_EQUAL(back.columns(), 2);
+    ASSERT_EQUAL((back[{1, 0}]), 3.0);
+
+    // Views let the dynamic kernels run on fixed storage
+    FixedMatrix<double, 2, 2> c;
+    gemm(1.0, fromView.view(), fixed.view(), 0.0, c.view());
+    const auto expected = fromView * fixed;
+    for(std::size_t i = 0; i < c.size(); ++i) ASSERT_EQUAL(c[i], expected[i]);
+}
+
+void testInitializerList(){
+    // Missing values are zero, values past R x C are ignored
+    const FixedMatrix2<double> shorter{1.0, 2.0};
+    ASSERT_EQUAL(shorter[1], 2.0);
+    ASSERT_EQUAL(shorter[3], 0.0);
+    const FixedMatrix2<double> longer{1.0, 2.0, 3.0, 4.0, 5.0, 6.0, 7.0};
+    ASSERT_EQUAL(longer[3], 4.0);
+    ASSERT_EQUAL(Matrix<double>(2, 2, {1.0, 2.0, 3.0, 4.0, 5.0, 6.0, 7.0})[3], longer[3]);
+}
+
+void testFixedMatrix()
+{
+    testInverse();
+    testIterators();
+    testAlignment();
+    testMatrixInterop();
+    testInitializerList();
+}
+
+int main(int a, char**)
+{
+    testFixedMatrix();
+    return 0;
+}
@@ -0,0 +1,124 @@
+#include <iostream>
+#include <algorithm>
+#include <random>
+
+#include "src/cppmath_gemm.hpp"
+#include "cppmath_test.hpp"
+
+using namespace cppmath::matrix;
+
+template <typename T>
+void testGemmShapes(const detail::GemmKernel<T>& kernel){
+    std::mt19937 rng(42);
+    const std::size_t sizes[][3] = {
+        {1, 1, 1}, {1, 7, 3}, {5, 1, 9}, {3, 4, 0}, {13, 17, 19},
+        {64, 64, 64}, {97, 33, 129}, {31, 259, 70}, {130, 65, 600}
+    };
+
+    for(const auto& size : sizes) {
+        const auto a = randomMatrix<T>(size[0], size[2], rng);
+        const auto b = randomMatrix<T>(size[2], size[1], rng);
+        const auto c = randomMatrix<T>(size[0], size[1], rng);
+
+        const T alphas[] = {T(1), T(2), T(-0.5)};
+        const T betas[] = {T(0), T(1), T(0.25)};
+        for(const T alpha : alphas) {
+            for(const T beta : betas) {
+                Matrix<T> result(c);
+                detail::gemm(a.rows(), b.columns(), a.columns(), alpha,
+                             a.data(), a.columns(), 1,
+                             b.data(), b.columns(), 1,
+                             beta, result.data(), result.columns(), 1, kernel);
+                checkEqual(result, naiveMultiply(alpha, a, b, beta, c));
+            }
+        }
+    }
+}
+
+template <typename T>
+void testGemmAllKernels(){
+    const cppmath::cpu::InstructionSet levels[] = {
+        cppmath::cpu::InstructionSet::Generic,
+        cppmath::cpu::InstructionSet::SSE2,
+        cppmath::cpu::InstructionSet::AVX2,
+        cppmath::cpu::InstructionSet::AVX512
+    };
+    for(const auto isa : levels) {
+        if(cppmath::cpu::supports(isa)) {
+            testGemmShapes<T>(detail::gemmKernel<T>(isa));
+        }
+    }
+}
+
+void testGemmBetaZeroIgnoresNan(){
+    Matrix<double> a(3, 2, 1.0);
+    Matrix<double> b(2, 5, 2.0);
+    Matrix<double> c(3, 5, std::nan(""));
+
+    gemm(1.0, a, b, 0.0, c);
+    for(std::size_t i = 0; i < c.size(); ++i) {
+        ASSERT_EQUAL(c[i], 4.0);
+    }
+}
+
+void testGemmStrided(){
+    // C^T = B^T * A^T through strides only.
+    std::mt19937 rng(7);
+    const auto a = randomMatrix<double>(23, 41, rng);
+    const auto b = randomMatrix<double>(41, 37, rng);
+    Matrix<double> ct(37, 23);
+
+    detail::gemm(b.columns(), a.rows(), a.columns(), 1.0,
+                 b.data(), 1, b.columns(),
+                 a.data(), 1, a.columns(),
+                 0.0, ct.data(), ct.columns(), 1);
+
+    const auto expected = naiveMultiply(1.0, a, b, 0.0, Matrix<double>(23, 37));
+    for(std::size_t i = 0; i < 23; ++i) {
+        for(std::size_t j = 0; j < 37; ++j) {
+            ASSERT_EQUAL((ct[{j, i}]), (expected[{i, j}]));
+        }
+    }
+}
+
+void testMultiplyOperator(){
+    Matrix<int> a({
+        {1, 2, 3},
+        {4, 5, 6}
+    });
+    Matrix<int> b({
+        {7, 8},
+        {9, 10},
+        {11, 12}
+    });
+
+    const auto c = a * b;
+    ASSERT_EQUAL(c.rows(), 2);
+    ASSERT_EQUAL(c.columns(), 2);
+
+    int expect[4] = {58, 64, 139, 154};
+    for(std::size_t i = 0; i < c.size(); ++i) {
+        ASSERT_EQUAL(c[i], expect[i]);
+    }
+
+    std::mt19937 rng(3);
+    const auto x = randomMatrix<float>(75, 300, rng);
+    const auto y = randomMatrix<float>(300, 45, rng);
+    checkEqual(x * y, naiveMultiply(1.f, x, y, 0.f, Matrix<float>(75, 45)));
+}
+
+void testGemm()
+{
+    testGemmAllKernels<float>();
+    testGemmAllKernels<double>();
+    testGemmAllKernels<long>();
+    testGemmBetaZeroIgnoresNan();
+    testGemmStrided();
+    testMultiplyOperator();
+}
+
+int main(int a, char**)
+{
+    testGemm();
+    return 0;
+}
@@ -0,0 +1,238 @@
+#include <iostream>
+#include <cstdint>
+#include <cmath>
+#include <limits>
+#include <random>
+#include <vector>
+#include <stdexcept>
+
+#include "src/cppmath_grid_paths.hpp"
+#include "cppmath_test.hpp"
+
+using namespace cppmath::matrix;
+using namespace cppmath::paths;
+using cppmath::combinatorics::BigUnsigned;
+using cppmath::combinatorics::ModularInt;
+using cppmath::cpu::InstructionSet;
+
+typedef ModularInt<1000000007u> Mod;
+
+Matrix<unsigned char> randomMask(std::size_t rows, std::size_t columns, double density, std::mt19937& rng) {
+    std::bernoulli_distribution blocked(density);
+    Matrix<unsigned char> mask(rows, columns);
+    for(std::size_t i = 0; i < mask.size(); ++i) mask[i] = blocked(rng) ? 1 : 0;
+    mask[0] = 0;
+    mask[mask.size() - 1] = 0;
+    return mask;
+}
+
+/** The full DP table, one cell at a time. */
+BigUnsigned referenceCount(const Matrix<unsigned char>& mask) {
+    std::vector<BigUnsigned> table(mask.size());
+    for(std::size_t r = 0; r < mask.rows(); ++r) {
+        for(std::size_t c = 0; c < mask.columns(); ++c) {
+            if(mask[MatrixPoint{r, c}]) continue;
+            BigUnsigned& cell = table[r * mask.columns() + c];
+            if(r == 0 && c == 0) cell = BigUnsigned(1);
+            if(r > 0) cell += table[(r - 1) * mask.columns() + c];
+            if(c > 0) cell += table[r * mask.columns() + c - 1];
+        }
+    }
+    return table.back();
+}
+
+template <typename T>
+T referenceCost(const Matrix<T>& costs, const Matrix<unsigned char>& mask) {
+    const T unreachable = MinCostPath<T>::unreachable();
+    std::vector<T> table(costs.size(), unreachable);
+    for(std::size_t r = 0; r < costs.rows(); ++r) {
+        for(std::size_t c = 0; c < costs.columns(); ++c) {
+            if(mask[MatrixPoint{r, c}]) continue;
+            T best = r == 0 && c == 0 ? T(0) : unreachable;
+            if(r > 0) best = std::min(best, table[(r - 1) * costs.columns() + c]);
+            if(c > 0) best = std::min(best, table[r * costs.columns() + c - 1]);
+            if(best != unreachable) table[r * costs.columns() + c] = best + costs[MatrixPoint{r, c}];
+        }
+    }
+    return table.back();
+}
+
+void testCounts(){
+    std::mt19937 rng(11);
+    const std::size_t shapes[][2] = {{1, 1}, {1, 9}, {9, 1}, {3, 4}, {7, 13}, {12, 33}, {20, 21}};
+    for(const auto& shape : shapes) {
+        for(double density : {0.0, 0.15, 0.4}) {
+            const Matrix<unsigned char> mask = randomMask(shape[0], shape[1], density, rng);
+            const BigUnsigned expected = referenceCount(mask);
+            std::uint64_t small = 0;
+            if(expected.toUint64(small)) ASSERT_EQUAL(countPaths(mask), small);
+            ASSERT_THROW(countPaths<BigUnsigned>(mask) == expected);
+            ASSERT_EQUAL(countPaths<Mod>(mask).value(), expected.mod(Mod::modulus));
+        }
+    }
+
+    // Open grids against the closed form
+    ASSERT_EQUAL(countPaths(3, 3), 6u);
+    ASSERT_EQUAL(countPaths(0, 5), 0u);
+    ASSERT_THROW(countPaths<BigUnsigned>(40, 50) == cppmath::combinatorics::binomialBig(88, 39));
+    ASSERT_EQUAL(countPaths<std::uint32_t>(10, 10), 48620u);
+
+    // A wall with one gap: paths enter the gap from above and leave it down
+    Matrix<int> wall(5, 6);
+    for(std::size_t c = 0; c < 6; ++c) wall[MatrixPoint{2, c}] = c == 4 ? 0 : 1;
+    ASSERT_EQUAL(countPaths(wall), countPaths(2, 5) * countPaths(2, 2));
+
+    // A strided view counts the transposed grid
+    const Matrix<unsigned char> mask = randomMask(9, 14, 0.2, rng);
+    ASSERT_EQUAL(countPaths(mask.view().transposed()), countPaths(mask));
+
+    // Overflow is reported, not wrapped
+    PathCounter<> counter(40);
+    bool threw = false;
+    try {
+        for(int r = 0; r < 40; ++r) counter.pushOpenRow();
+    } catch(const std::overflow_error&) {
+        threw = true;
+    }
+    ASSERT_THROW(threw);
+    threw = false;
+    try { countPaths<std::uint32_t>(20, 20); } catch(const std::overflow_error&) { threw = true; }
+    ASSERT_THROW(threw);
+
+    // Right at the limit: C(66, 33) fits 64 bits, C(68, 34) does not
+    const Matrix<unsigned char> open34(34, 34), open35(35, 35);
+    ASSERT_EQUAL(countPaths(open34), 7219428434016265740ull);
+    threw = false;
+    try { countPaths(open35); } catch(const std::overflow_error&) { threw = true; }
+    ASSERT_THROW(threw);
+    // C(32, 16) fits int32_t, C(34, 17) does not
+    ASSERT_EQUAL(countPaths<std::int32_t>(Matrix<unsigned char>(17, 17)), 601080390);
+    threw = false;
+    try { countPaths<std::int32_t>(Matrix<unsigned char>(18, 18)); } catch(const std::overflow_error&) { threw = true; }
+    ASSERT_THROW(threw);
+}
+
+void testStreaming(){
+    std::mt19937 rng(5);
+    const Matrix<unsigned char> mask = randomMask(50, 37, 0.1, rng);
+    PathCounter<Mod> counter(mask.columns());
+    for(std::size_t r = 0; r < mask.rows(); ++r) {
+        counter.pushRow(mask.view().rowData(r));
+        ASSERT_EQUAL(counter.rows(), r + 1);
+        ASSERT_EQUAL(counter.row().size(), mask.columns());
+    }
+    ASSERT_EQUAL(counter.count().value(), referenceCount(mask).mod(Mod::modulus));
+    counter.reset();
+    ASSERT_EQUAL(counter.count().value(), 0u);
+    counter.pushOpenRow();
+    ASSERT_EQUAL(counter.count().value(), 1u);
+}
+
+template <typename T>
+void testCosts(double tolerance){
+    std::mt19937 rng(17);
+    std::uniform_int_distribution<int> cost(0, 9);
+    const std::size_t shapes[][2] = {{1, 1}, {1, 10}, {10, 1}, {5, 7}, {16, 31}, {40, 67}};
+    for(const auto& shape : shapes) {
+        for(double density : {0.0, 0.2, 0.45}) {
+            Matrix<T> costs(shape[0], shape[1]);
+            for(std::size_t i = 0; i < costs.size(); ++i) costs[i] = static_cast<T>(cost(rng)) + T(1) / T(4);
+            const Matrix<unsigned char> mask = randomMask(shape[0], shape[1], density, rng);
+            const T expected = referenceCost(costs, mask);
+            const T actual = minPathCost(costs, mask);
+            if(expected == MinCostPath<T>::unreachable()) {
+                ASSERT_THROW(actual == expected);
+            } else {
+                ASSERT_NEAR(static_cast<double>(actual), static_cast<double>(expected), tolerance);
+            }
+        }
+    }
+
+    Matrix<T> costs(3, 3, {1, 2, 3, 4, 5, 6, 7, 8, 9});
+    ASSERT_EQUAL(minPathCost(costs), T(21));
+    ASSERT_EQUAL(minPathCost(costs.view().transposed()), T(21));
+
+    // No way through a full wall
+    Matrix<unsigned char> wall(3, 3, {0, 0, 0, 1, 1, 1, 0, 0, 0});
+    MinCostPath<T> path(3);
+    path.pushRow(costs.view().rowData(0), wall.view().rowData(0));
+    ASSERT_THROW(path.isReachable());
+    path.pushRow(costs.view().rowData(1), wall.view().rowData(1));
+    path.pushRow(costs.view().rowData(2), wall.view().rowData(2));
+    ASSERT_THROW(!path.isReachable());
+}
+
+/** Integer costs up to the unreachable marker, and one past it. */
+void testCostOverflow(){
+    const std::int32_t limit = std::numeric_limits<std::int32_t>::max();
+    Matrix<std::int32_t> costs(1, 3, {0, limit / 2, limit / 2});
+    ASSERT_EQUAL(minPathCost(costs), limit - 1);
+    costs[2] = limit / 2 + 1;
+    bool threw = false;
+    try { minPathCost(costs); } catch(const std::overflow_error&) { threw = true; }
+    ASSERT_THROW(threw);
+
+    Matrix<std::int8_t> negative(1, 3, {-100, -28, 0});
+    ASSERT_EQUAL(minPathCost(negative), -128);
+    negative[2] = -1;
+    threw = false;
+    try { minPathCost(negative); } catch(const std::overflow_error&) { threw = true; }
+    ASSERT_THROW(threw);
+
+    Matrix<std::uint16_t> counts(3, 1, {60000, 5000, 534});
+    ASSERT_EQUAL(minPathCost(counts), 65534);
+    counts[2] = 535;
+    threw = false;
+    try { minPathCost(counts); } catch(const std::overflow_error&) { threw = true; }
+    ASSERT_THROW(threw);
+}
+
+/** Every cost kernel level against the generic scan, row after row. */
+void testKernelLevels(){
+    const InstructionSet levels[] = {InstructionSet::Generic, InstructionSet::SSE2, InstructionSet::AVX2, InstructionSet::AVX512};
+    std::mt19937 rng(23);
+    std::uniform_real_distribution<double> cost(0.0, 5.0);
+    for(const InstructionSet isa : levels) {
+        if(!cppmath::cpu::supports(isa)) continue;
+        const auto costs = detail::minCostKernels<double>(isa);
+        const auto floatCosts = detail::minCostKernels<float>(isa);
+        for(std::size_t n : {1, 3, 4, 7, 8, 9, 31, 64, 67}) {
+            const Matrix<unsigned char> mask = randomMask(12, n, 0.1, rng);
+            std::vector<unsigned char> open(n);
+            std::vector<double> value(n, MinCostPath<double>::unreachable()), expectedValue(value);
+            std::vector<float> floatValue(n, MinCostPath<float>::unreachable()), expectedFloat(floatValue);
+            value[0] = expectedValue[0] = 0;
+            floatValue[0] = expectedFloat[0] = 0;
+            for(std::size_t r = 0; r < mask.rows(); ++r) {
+                detail::openCells(mask.view().rowData(r), open.data(), n);
+                std::vector<double> rowCosts(n);
+                std::vector<float> rowFloats(n);
+                for(std::size_t c = 0; c < n; ++c) rowFloats[c] = static_cast<float>(rowCosts[c] = std::floor(cost(rng)));
+                costs.row(rowCosts.data(), open.data(), value.data(), n);
+                detail::genericMinCostRow(rowCosts.data(), open.data(), expectedValue.data(), n);
+                floatCosts.row(rowFloats.data(), open.data(), floatValue.data(), n);
+                detail::genericMinCostRow(rowFloats.data(), open.data(), expectedFloat.data(), n);
+                for(std::size_t c = 0; c < n; ++c) {
+                    ASSERT_EQUAL(value[c], expectedValue[c]);
+                    ASSERT_EQUAL(floatValue[c], expectedFloat[c]);
+                }
+            }
+        }
+    }
+}
+
+void testGridPaths(){
+    testKernelLevels();
+    testCounts();
+    testStreaming();
+    testCosts<double>(1e-9);
+    testCosts<float>(1e-3);
+    testCosts<int>(0);
+    testCostOverflow();
+}
+
+int main(int a, char**)
+{
+    testGridPaths();
+    return 0;
+}
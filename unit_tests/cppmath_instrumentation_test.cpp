@@ -0,0 +1,160 @@
+#include <iostream>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <thread>
+
+#include "src/cppmath_gemm.hpp"
+#include "src/cppmath_elementwise.hpp"
+#include "src/cppmath_factorization.hpp"
+#include "src/cppmath_transpose.hpp"
+#include "src/cppmath_instrumentation.hpp"
+#include "cppmath_test.hpp"
+
+using namespace cppmath::matrix;
+namespace instrumentation = cppmath::instrumentation;
+namespace execution = cppmath::execution;
+
+using instrumentation::Operation;
+
+void testDisabled(){
+    instrumentation::reset();
+    {
+        const instrumentation::ScopedRegion region("disabled");
+        Matrix<double> a(4, 4, 1.0);
+        Matrix<double> b(a);
+        Matrix<double> c(4, 4);
+        gemm(1.0, a, b, 0.0, c);
+    }
+    const instrumentation::Snapshot s = instrumentation::snapshot();
+    ASSERT_EQUAL(s.allocations, 0u);
+    ASSERT_EQUAL(s.deepCopies, 0u);
+    ASSERT_EQUAL(s[Operation::Gemm].calls, 0u);
+    ASSERT_THROW(instrumentation::regions().empty());
+}
+
+void testMemory(){
+    instrumentation::reset();
+    {
+        Matrix<double> a(4, 4, 1.0);
+        instrumentation::Snapshot s = instrumentation::snapshot();
+        ASSERT_EQUAL(s.allocations, 1u);
+        ASSERT_EQUAL(s.allocatedBytes, 16 * sizeof(double));
+
+        Matrix<double> b(a);
+        b = a;
+        s = instrumentation::snapshot();
+        ASSERT_EQUAL(s.deepCopies, 2u);
+        ASSERT_EQUAL(s.copiedBytes, 32 * sizeof(double));
+
+        Matrix<double> c(std::move(b));
+        ASSERT_EQUAL(b.rows(), 0u);
+        ASSERT_EQUAL(c.rows(), 4u);
+        ASSERT_EQUAL(instrumentation::snapshot().moves, 1u);
+    }
+    const instrumentation::Snapshot s = instrumentation::snapshot();
+    ASSERT_EQUAL(s.allocations, s.deallocations);
+    ASSERT_EQUAL(s.allocatedBytes, s.deallocatedBytes);
+
+    // Aligned and arena storage count as well
+    instrumentation::reset();
+    {
+        AlignedMatrix<float> a(3, 5);
+        ASSERT_EQUAL(instrumentation::snapshot().allocatedBytes, 15 * sizeof(float));
+        cppmath::memory::Arena arena(4096);
+        ArenaMatrix<float> b(8, 8, cppmath::memory::ArenaAllocator<float>(arena));
+        ASSERT_EQUAL(instrumentation::snapshot().allocations, 2u);
+    }
+    ASSERT_EQUAL(instrumentation::snapshot().deallocations, 2u);
+}
+
+void testOperations(){
+    Matrix<double> a(8, 6, 1.0);
+    Matrix<double> b(6, 5, 2.0);
+    Matrix<double> c(8, 5);
+    Matrix<double> spd(4, 4, {4, 1, 0, 0, 1, 4, 1, 0, 0, 1, 4, 1, 0, 0, 1, 4});
+
+    instrumentation::reset();
+    gemm(1.0, a, b, 0.0, c);
+    add(c, c, c);
+    axpy(2.0, c, c);
+    const Matrix<double> t = transposed(c);
+    const LU<double> lu(spd);
+
+    const instrumentation::Snapshot s = instrumentation::snapshot();
+    ASSERT_EQUAL(s[Operation::Gemm].calls, 1u);
+    ASSERT_EQUAL(s[Operation::Gemm].flops, 2u * 8 * 5 * 6);
+    ASSERT_EQUAL(s[Operation::Elementwise].calls, 2u);
+    ASSERT_EQUAL(s[Operation::Elementwise].flops, 40u + 80u);
+    ASSERT_EQUAL(s[Operation::Transpose].calls, 1u);
+    ASSERT_EQUAL(s[Operation::Transpose].flops, 0u);
+    ASSERT_EQUAL(s[Operation::Factorization].calls, 1u);
+    ASSERT_EQUAL(s[Operation::Factorization].flops, 42u);
+    ASSERT_EQUAL(s[Operation::Sparse].calls, 0u);
+    ASSERT_THROW(std::string(instrumentation::operationName(Operation::Factorization)) == "factorization");
+}
+
+void testThreads(){
+    instrumentation::reset();
+    std::vector<std::thread> threads;
+    for(int i = 0; i < 4; ++i) {
+        threads.emplace_back([]{
+            for(int j = 0; j < 10; ++j) {
+                const Matrix<float> m(2, 2);
+                const Matrix<float> copy(m);
+            }
+        });
+    }
+    for(std::thread& thread : threads) thread.join();
+
+    // Exited threads keep their counts
+    const instrumentation::Snapshot s = instrumentation::snapshot();
+    ASSERT_EQUAL(s.deepCopies, 40u);
+    ASSERT_EQUAL(s.copiedBytes, 40u * 4 * sizeof(float));
+    ASSERT_EQUAL(s.allocations, 80u);
+
+    instrumentation::reset();
+    ASSERT_EQUAL(instrumentation::snapshot().deepCopies, 0u);
+}
+
+void testRegions(){
+    instrumentation::reset();
+    Matrix<double> a(3, 3, 1.0);
+    for(int i = 0; i < 3; ++i) {
+        const instrumentation::ScopedRegion region("copies");
+        const Matrix<double> b(a);
+        const instrumentation::ScopedRegion inner("inner");
+        add(a, b, a);
+    }
+
+    const std::vector<instrumentation::RegionStats> regions = instrumentation::regions();
+    ASSERT_EQUAL(regions.size(), 2u);
+    ASSERT_THROW(regions[0].name == "copies");
+    ASSERT_EQUAL(regions[0].calls, 3u);
+    ASSERT_EQUAL(regions[0].counters.deepCopies, 3u);
+    ASSERT_EQUAL(regions[0].counters[Operation::Elementwise].calls, 3u);
+    ASSERT_THROW(regions[1].name == "inner");
+    ASSERT_EQUAL(regions[1].counters.deepCopies, 0u);
+    ASSERT_EQUAL(regions[1].counters[Operation::Elementwise].flops, 27u);
+    ASSERT_THROW(regions[0].nanoseconds >= regions[1].nanoseconds);
+
+    instrumentation::reset();
+    ASSERT_THROW(instrumentation::regions().empty());
+}
+
+void testInstrumentation(){
+    if(!instrumentation::kEnabled) {
+        testDisabled();
+        return;
+    }
+    testMemory();
+    testOperations();
+    testThreads();
+    testRegions();
+}
+
+int main(int a, char**)
+{
+    testInstrumentation();
+    return 0;
+}
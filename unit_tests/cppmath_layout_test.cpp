@@ -0,0 +1,213 @@
+#include <iostream>
+#include <vector>
+#include <algorithm>
+
+#include "src/cppmath_transpose.hpp"
+#include "src/cppmath_gemm.hpp"
+#include "src/cppmath_elementwise.hpp"
+#include "src/cppmath_reduction.hpp"
+#include "cppmath_test.hpp"
+
+using namespace cppmath::matrix;
+namespace execution = cppmath::execution;
+
+typedef Matrix<double, cppmath::memory::DefaultAllocator<double>, layout::Tiled<8>> Tiled8;
+typedef Matrix<double, cppmath::memory::DefaultAllocator<double>, layout::Morton<8>> Morton8;
+typedef Matrix<double, cppmath::memory::AlignedAllocator<double>, layout::Morton<4>> Morton4;
+
+template <class M>
+M countingMatrix(std::size_t rows, std::size_t columns){
+    M m(rows, columns);
+    for(std::size_t i = 0; i < m.size(); ++i) m[i] = static_cast<typename M::value_type>(i + 1);
+    return m;
+}
+
+template <class A, class B>
+bool sameElements(const A& a, const B& b){
+    if(a.rows() != b.rows() || a.columns() != b.columns()) return false;
+    for(std::size_t r = 0; r < a.rows(); ++r)
+        for(std::size_t c = 0; c < a.columns(); ++c)
+            if(a[MatrixPoint{r, c}] != b[MatrixPoint{r, c}]) return false;
+    return true;
+}
+
+template <class Layout>
+bool isPermutation(std::size_t rows, std::size_t columns){
+    std::vector<bool> used(Layout::storageSize(rows, columns), false);
+    for(std::size_t r = 0; r < rows; ++r) {
+        for(std::size_t c = 0; c < columns; ++c) {
+            const std::size_t offset = Layout::offset(r, c, rows, columns);
+            if(offset >= used.size() || used[offset]) return false;
+            used[offset] = true;
+        }
+    }
+    return true;
+}
+
+void testLayoutOffsets(){
+    ASSERT_EQUAL(RowMajor::offset(2, 3, 5, 7), 17u);
+    ASSERT_EQUAL(ColumnMajor::offset(2, 3, 5, 7), 17u);
+    ASSERT_EQUAL(layout::Tiled<4>::storageSize(5, 9), 2u * 3u * 16u);
+    ASSERT_EQUAL(layout::Tiled<4>::offset(5, 9, 6, 10), (1u * 3u + 2u) * 16u + 1u * 4u + 1u);
+
+    // On a power of two grid the block index interleaves the coordinate bits
+    const std::size_t zOrder[4][4] = {{0, 1, 4, 5}, {2, 3, 6, 7}, {8, 9, 12, 13}, {10, 11, 14, 15}};
+    for(std::size_t r = 0; r < 4; ++r)
+        for(std::size_t c = 0; c < 4; ++c) ASSERT_EQUAL(layout::detail::ZOrderTiles::index(r, c, 4, 4), zOrder[r][c]);
+
+    // Other grids keep the curve order without gaps
+    const std::size_t grids[][2] = {{3, 5}, {1, 7}, {6, 2}, {5, 5}};
+    for(const auto& grid : grids) {
+        std::vector<std::size_t> order;
+        for(std::size_t r = 0; r < grid[0]; ++r)
+            for(std::size_t c = 0; c < grid[1]; ++c) order.push_back(layout::detail::ZOrderTiles::index(r, c, grid[0], grid[1]));
+        std::vector<std::size_t> sorted(order);
+        std::sort(sorted.begin(), sorted.end());
+        for(std::size_t i = 0; i < sorted.size(); ++i) ASSERT_EQUAL(sorted[i], i);
+        for(std::size_t r = 0; r + 1 < grid[0]; ++r)
+            for(std::size_t c = 0; c + 1 < grid[1]; ++c)
+                ASSERT_THROW(order[r * grid[1] + c] < order[r * grid[1] + c + 1] && order[r * grid[1] + c] < order[(r + 1) * grid[1] + c]);
+    }
+
+    const std::size_t shapes[][2] = {{1, 1}, {7, 3}, {16, 16}, {17, 33}, {40, 9}};
+    for(const auto& shape : shapes) {
+        ASSERT_THROW(isPermutation<RowMajor>(shape[0], shape[1]));
+        ASSERT_THROW(isPermutation<ColumnMajor>(shape[0], shape[1]));
+        ASSERT_THROW(isPermutation<layout::Tiled<8>>(shape[0], shape[1]));
+        ASSERT_THROW(isPermutation<layout::Morton<4>>(shape[0], shape[1]));
+    }
+}
+
+template <class M>
+void testMatrixLayout(){
+    const Matrix<double> reference = countingMatrix<Matrix<double>>(13, 10);
+    const M m(13, 10, {1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12}, -1.0);
+    ASSERT_EQUAL((m[MatrixPoint{1, 1}]), 12.0);
+    ASSERT_EQUAL((m[MatrixPoint{1, 2}]), -1.0);
+    ASSERT_EQUAL(m.size(), 130u);
+
+    // Linear indices and iterators stay row-major
+    M counted = countingMatrix<M>(13, 10);
+    ASSERT_THROW(sameElements(counted, reference));
+    ASSERT_THROW(std::equal(counted.begin(), counted.end(), reference.begin()));
+    ASSERT_EQUAL(*counted.beginAt(MatrixPoint{4, 7}), 48.0);
+    ASSERT_EQUAL(counted.end() - counted.beginAt(MatrixPoint{12, 0}), 10);
+    *counted.beginAt(MatrixPoint{12, 9}) = 0;
+    ASSERT_EQUAL((counted[MatrixPoint{12, 9}]), 0.0);
+    counted[MatrixPoint{12, 9}] = 130;
+
+    const M copy(reference.view());
+    ASSERT_THROW(sameElements(copy, reference));
+
+    // Expressions mix layouts and evaluate in the layout of the target
+    const M sum = counted + reference * 2.0;
+    const Matrix<double> expected = reference * 3.0;
+    ASSERT_THROW(sameElements(sum, expected));
+    M accumulated = counted;
+    accumulated += reference;
+    accumulated -= counted;
+    accumulated += accumulated;
+    ASSERT_THROW(sameElements(accumulated, Matrix<double>(reference * 2.0)));
+    accumulated = accumulated - reference;
+    ASSERT_THROW(sameElements(accumulated, reference));
+    accumulated = Matrix<double>(3, 2, 4.0) * 0.5;
+    ASSERT_THROW(accumulated.rows() == 3 && accumulated.columns() == 2 && (accumulated[MatrixPoint{2, 1}]) == 2.0);
+
+    // Resizing keeps every element at its place
+    const std::size_t sizes[][2] = {{20, 10}, {20, 17}, {9, 17}, {9, 4}, {15, 4}, {0, 3}, {5, 6}};
+    M resized = counted;
+    Matrix<double> resizedReference = reference;
+    for(const auto& size : sizes) {
+        resized.resize(size[0], size[1], -2.0);
+        resizedReference.resize(size[0], size[1], -2.0);
+        ASSERT_THROW(sameElements(resized, resizedReference));
+    }
+}
+
+void testColumnMajorKernels(){
+    const Matrix<double> a = countingMatrix<Matrix<double>>(37, 23);
+    const Matrix<double> b = countingMatrix<Matrix<double>>(23, 19);
+    const ColumnMajorMatrix<double> ca = withLayout<ColumnMajor>(a);
+    const ColumnMajorMatrix<double> cb = withLayout<ColumnMajor>(b);
+
+    const ConstMatrixView<double> view = ca.view();
+    ASSERT_THROW(view.rowStride() == 1 && view.columnStride() == 37);
+    ASSERT_EQUAL(ca.data()[1], (a[MatrixPoint{1, 0}]));
+
+    // Products keep the layout of the left operand
+    const ColumnMajorMatrix<double> product = ca * cb;
+    ASSERT_THROW(sameElements(product, a * b));
+
+    ColumnMajorMatrix<double> added(37, 23);
+    add(execution::par.withGrain(1), ca, ca, added);
+    ASSERT_THROW(sameElements(added, Matrix<double>(a * 2.0)));
+    add(ca, a, added);
+    ASSERT_THROW(sameElements(added, Matrix<double>(a * 2.0)));
+
+    ASSERT_NEAR(sum(ca), sum(a), 1e-9);
+    Matrix<double> expectedRows(37, 1), expectedColumns(1, 23);
+    ColumnMajorMatrix<double> rows(37, 1), columns(1, 23);
+    sum(ca, Axis::Rows, rows);
+    sum(ca, Axis::Columns, columns);
+    sum(a, Axis::Rows, expectedRows);
+    sum(a, Axis::Columns, expectedColumns);
+    ASSERT_THROW(sameElements(rows, expectedRows));
+    ASSERT_THROW(sameElements(columns, expectedColumns));
+
+    ColumnMajorMatrix<double> transposed = ca;
+    transposeInPlace(transposed);
+    ASSERT_THROW(transposed.rows() == 23 && transposed.columns() == 37);
+    for(std::size_t r = 0; r < a.rows(); ++r)
+        for(std::size_t c = 0; c < a.columns(); ++c) ASSERT_EQUAL((transposed[MatrixPoint{c, r}]), (a[MatrixPoint{r, c}]));
+}
+
+template <class From, class To>
+void checkConversion(const Matrix<double>& reference){
+    From source(reference.rows(), reference.columns());
+    convertLayout(reference, source);
+    To converted(2, 2, 5.0);
+    convertLayout(execution::par.withGrain(1), source, converted);
+    ASSERT_THROW(sameElements(converted, reference));
+}
+
+template <class From>
+void checkConversions(const Matrix<double>& reference){
+    checkConversion<From, Matrix<double>>(reference);
+    checkConversion<From, ColumnMajorMatrix<double>>(reference);
+    checkConversion<From, Tiled8>(reference);
+    checkConversion<From, Morton8>(reference);
+    checkConversion<From, Morton4>(reference);
+}
+
+void testConversions(){
+    const std::size_t shapes[][2] = {{1, 1}, {1, 9}, {9, 1}, {8, 8}, {31, 45}, {70, 33}, {130, 129}};
+    for(const auto& shape : shapes) {
+        const Matrix<double> reference = countingMatrix<Matrix<double>>(shape[0], shape[1]);
+        checkConversions<Matrix<double>>(reference);
+        checkConversions<ColumnMajorMatrix<double>>(reference);
+        checkConversions<Tiled8>(reference);
+        checkConversions<Morton8>(reference);
+        checkConversions<Morton4>(reference);
+    }
+
+    const Matrix<double> m = countingMatrix<Matrix<double>>(50, 70);
+    const Matrix<double, cppmath::memory::DefaultAllocator<double>, layout::Morton<32>> morton = withLayout<layout::Morton<32>>(m);
+    ASSERT_THROW(sameElements(morton, m));
+    ASSERT_THROW(sameElements(withLayout<RowMajor>(morton), m));
+}
+
+void testLayouts(){
+    testLayoutOffsets();
+    testMatrixLayout<Matrix<double>>();
+    testMatrixLayout<ColumnMajorMatrix<double>>();
+    testMatrixLayout<Tiled8>();
+    testMatrixLayout<Morton4>();
+    testColumnMajorKernels();
+    testConversions();
+}
+
+int main(int a, char**)
+{
+    testLayouts();
+    return 0;
+}
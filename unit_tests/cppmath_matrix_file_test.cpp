@@ -0,0 +1,156 @@
+#include <iostream>
+#include <cstdio>
+#include <cstdint>
+#include <string>
+#include <unistd.h>
+
+#include "src/cppmath_matrix_file.hpp"
+#include "cppmath_test.hpp"
+
+using namespace cppmath::matrix;
+using namespace cppmath::io;
+
+std::string tempPath(const char* name){
+    return "/tmp/cppmath_matrix_file_" + std::to_string(::getpid()) + "_" + name;
+}
+
+template <class Fn>
+bool throwsFileError(Fn fn){
+    try {
+        fn();
+    } catch(const FileError&) {
+        return true;
+    }
+    return false;
+}
+
+void testRoundTrip(){
+    const std::string path = tempPath("round_trip");
+    Matrix<double> m(37, 53);
+    for(std::size_t i = 0; i < m.size(); ++i) m[i] = i * 0.5 - 3.0;
+    save(path, m);
+
+    const MappedMatrix<double> mapped(path);
+    ASSERT_EQUAL(mapped.rows(), 37);
+    ASSERT_EQUAL(mapped.columns(), 53);
+    ASSERT_EQUAL(mapped.header().version, kMatrixFileVersion);
+    ASSERT_EQUAL(mapped.header().dataOffset % mapped.header().alignment, 0);
+    ASSERT_EQUAL(reinterpret_cast<std::uintptr_t>(mapped.data()) % cppmath::memory::kSimdAlignment, 0);
+    ASSERT_EQUAL(mapped.verifyChecksum(), true);
+    for(std::size_t i = 0; i < m.size(); ++i) ASSERT_EQUAL(mapped.data()[i], m[i]);
+    ASSERT_EQUAL((mapped.view()[{36, 52}]), (m[{36, 52}]));
+
+    const Matrix<double> loaded = load<double>(path);
+    ASSERT_EQUAL(loaded.rows(), 37);
+    for(std::size_t i = 0; i < m.size(); ++i) ASSERT_EQUAL(loaded[i], m[i]);
+
+    // Strided views are written row by row
+    save(path, m.view().transposed());
+    const Matrix<double> transposed = load<double>(path);
+    ASSERT_EQUAL(transposed.rows(), 53);
+    ASSERT_EQUAL((transposed[{7, 3}]), (m[{3, 7}]));
+
+    const Matrix<float> empty;
+    save(path, empty);
+    ASSERT_EQUAL(load<float>(path).size(), 0);
+    std::remove(path.c_str());
+}
+
+void testCopyOnWrite(){
+    const std::string path = tempPath("cow");
+    Matrix<int> m(4, 4, 7);
+    save(path, m);
+    {
+        MappedMatrix<int> mapped(path, MapMode::CopyOnWrite);
+        mapped.mutableView()[{1, 2}] = 42;
+        ASSERT_EQUAL((mapped.view()[{1, 2}]), 42);
+        ASSERT_EQUAL(mapped.verifyChecksum(), false);
+    }
+    // The file is untouched
+    const MappedMatrix<int> reopened(path);
+    ASSERT_EQUAL((reopened.view()[{1, 2}]), 7);
+    ASSERT_EQUAL(reopened.verifyChecksum(), true);
+    std::remove(path.c_str());
+}
+
+void testStreamingWriter(){
+    const std::string path = tempPath("stream");
+    {
+        MatrixFileWriter<float> writer(path, 1000, 3, 256);
+        for(std::size_t r = 0; r < 1000; ++r) {
+            const float row[3] = {float(r), float(r) + 0.25f, float(r) + 0.5f};
+            writer.write(row, 3);
+        }
+        ASSERT_EQUAL(writer.written(), 3000);
+        writer.close();
+    }
+    const MappedMatrix<float> mapped(path);
+    ASSERT_EQUAL(mapped.header().dataOffset, 256);
+    ASSERT_EQUAL(mapped.verifyChecksum(), true);
+    ASSERT_EQUAL((mapped.view()[{999, 2}]), 999.5f);
+
+    // Unfinished files never open
+    {
+        MatrixFileWriter<float> writer(path, 10, 10);
+        const float values[5] = {};
+        writer.write(values, 5);
+        ASSERT_EQUAL(throwsFileError([&]{ writer.close(); }), true);
+    }
+    ASSERT_EQUAL(throwsFileError([&]{ MappedMatrix<float> m(path); }), true);
+    {
+        MatrixFileWriter<float> writer(path, 1, 2);
+        const float values[3] = {};
+        ASSERT_EQUAL(throwsFileError([&]{ writer.write(values, 3); }), true);
+    }
+    std::remove(path.c_str());
+}
+
+void testInvalidFiles(){
+    const std::string path = tempPath("invalid");
+    ASSERT_EQUAL(throwsFileError([&]{ MappedMatrix<double> m(path + "_missing"); }), true);
+
+    save(path, Matrix<double>(3, 3, 1.0));
+    ASSERT_EQUAL(throwsFileError([&]{ MappedMatrix<float> m(path); }), true);
+    ASSERT_EQUAL(throwsFileError([&]{ MappedMatrix<std::int64_t> m(path); }), true);
+
+    // Truncated data
+    ASSERT_EQUAL(::truncate(path.c_str(), 64 + 8 * 8), 0);
+    ASSERT_EQUAL(throwsFileError([&]{ MappedMatrix<double> m(path); }), true);
+
+    // Corrupted data fails the checksum
+    save(path, Matrix<double>(3, 3, 1.0));
+    {
+        std::FILE* f = std::fopen(path.c_str(), "r+b");
+        std::fseek(f, 64, SEEK_SET);
+        const double value = 2.0;
+        std::fwrite(&value, sizeof(value), 1, f);
+        std::fclose(f);
+    }
+    ASSERT_EQUAL(MappedMatrix<double>(path).verifyChecksum(), false);
+    ASSERT_EQUAL(throwsFileError([&]{ load<double>(path); }), true);
+
+    // Foreign byte order
+    {
+        std::FILE* f = std::fopen(path.c_str(), "r+b");
+        std::fseek(f, 12, SEEK_SET);
+        const std::uint32_t swapped = 0x04030201;
+        std::fwrite(&swapped, sizeof(swapped), 1, f);
+        std::fclose(f);
+    }
+    ASSERT_EQUAL(throwsFileError([&]{ MappedMatrix<double> m(path); }), true);
+    std::remove(path.c_str());
+}
+
+void testMatrixFile()
+{
+    testRoundTrip();
+    testCopyOnWrite();
+    testStreamingWriter();
+    testInvalidFiles();
+}
+
+int main(int a, char**)
+{
+    testMatrixFile();
+    return 0;
+}
@@ -1,58 +1,10 @@
 #include <iostream>
 #include <algorithm>
+#include <memory>
 
 #include "src/cppmath_matrix.hpp"
+#include "cppmath_test.hpp"
 
-#define ASSERT_THROW( condition )                                   \
-{                                                                   \
-  if( !( condition ) )                                              \
-  {                                                                 \
-    throw std::runtime_error(   std::string( __FILE__ )             \
-                              + std::string( ":" )                  \
-                              + std::to_string( __LINE__ )          \
-                              + std::string( " in " )               \
-                              + std::string( __PRETTY_FUNCTION__ )  \
-    );                                                              \
-  }                                                                 \
-}
-
-#define ASSERT_EQUAL( x, y )                                        \
-{                                                                   \
-  if( ( x ) != ( y ) )                                              \
-  {                                                                 \
-    throw std::runtime_error(   std::string( __FILE__ )             \
-                              + std::string( ":" )                  \
-                              + std::to_string( __LINE__ )          \
-                              + std::string( " in " )               \
-                              + std::string( __PRETTY_FUNCTION__ )  \
-                              + std::string( ": " )                 \
-                              + std::to_string( ( x ) )             \
-                              + std::string( " != " )               \
-                              + std::to_string( ( y ) )             \
-                              + std::string( " in expr.: " )        \
-                              + std::string( #x )                   \
-                              + std::string( " != " )               \
-                              + std::string( #y )                   \
-    );                                                              \
-  }                                                                 \
-}
-
-#define ASSERT_EQUAL_EXP( x, y )                                    \
-{                                                                   \
-if( ( x ) != ( y ) )                                                \
-{                                                                   \
-throw std::runtime_error(   std::string( __FILE__ )                 \
-                            + std::string( ":" )                    \
-                            + std::to_string( __LINE__ )            \
-                            + std::string( " in " )                 \
-                            + std::string( __PRETTY_FUNCTION__ )    \
-                            + std::string( ": " )                   \
-                            + std::string( #x )                     \
-                            + std::string( " != " )                 \
-                            + std::string( #y )                     \
-);                                                                  \
-}                                                                   \
-}
 using namespace cppmath::matrix;
 
 void testRaowIterator(){
@@ -98,7 +50,6 @@ void testMatrixResize(){
         ASSERT_EQUAL(m[i], 0);
     }
     
-    const auto oldSize = m.size();
     auto defaultValue = 6;
     
     m.resize(4, 1, defaultValue);
@@ -112,14 +63,12 @@ void testMatrixResize(){
     ASSERT_EQUAL(m.isVector(), true);
     ASSERT_EQUAL(m.isEmpty(), false);
 
-    for(i = 0; i < oldSize; ++i) {
-        ASSERT_EQUAL(m[i], 0);
-    }
-    for(; i < m.size(); ++i) {
+    // Only (0, 0) existed before
+    ASSERT_EQUAL(m[0], 0);
+    for(i = 1; i < m.size(); ++i) {
         ASSERT_EQUAL(m[i], defaultValue);
     }
     
-    const auto oldSize2 = m.size();
     auto defaultValue2 = 7;
     m.resize(4, 4, defaultValue2);
     
@@ -130,15 +79,108 @@ void testMatrixResize(){
     ASSERT_EQUAL(m.isColumnVector(), false);
     ASSERT_EQUAL(m.isRowVector(), false);
     ASSERT_EQUAL(m.isVector(), false);
-    for(i = 0; i < oldSize; ++i) {
-        ASSERT_EQUAL(m[i], 0);
+    ASSERT_EQUAL((m[{0, 0}]), 0);
+    for(i = 1; i < 4; ++i) {
+        ASSERT_EQUAL((m[{std::size_t(i), 0}]), defaultValue);
     }
-    for(; i < oldSize2; ++i) {
-        ASSERT_EQUAL(m[i], defaultValue);
+    for(i = 0; i < m.size(); ++i) {
+        if(i % 4 != 0) ASSERT_EQUAL(m[i], defaultValue2);
+    }
+}
+
+void testResizeKeepsLayout(){
+    const std::size_t shapes[][2] = {{3, 5}, {5, 3}, {2, 2}, {6, 7}, {6, 2}, {1, 9}, {4, 4}, {0, 3}, {3, 3}};
+    Matrix<int> m(4, 4);
+    for(std::size_t i = 0; i < m.size(); ++i) m[i] = int(i);
+    Matrix<int> expected(m);
+
+    for(const auto& shape : shapes) {
+        Matrix<int> next(shape[0], shape[1], -1);
+        for(std::size_t r = 0; r < std::min(shape[0], expected.rows()); ++r)
+            for(std::size_t c = 0; c < std::min(shape[1], expected.columns()); ++c)
+                next[{r, c}] = expected[{r, c}];
+
+        m.resize(shape[0], shape[1], -1);
+        ASSERT_EQUAL(m.rows(), shape[0]);
+        ASSERT_EQUAL(m.columns(), shape[1]);
+        for(std::size_t i = 0; i < m.size(); ++i) ASSERT_EQUAL(m[i], next[i]);
+        expected = next;
     }
-    for(; i < m.size(); ++i) {
-        ASSERT_EQUAL(m[i], defaultValue2);
+}
+
+void testReshapeAndCapacity(){
+    Matrix<int> m(2, 6, {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11});
+    const int* storage = m.data();
+    m.reshape(3, 4);
+    ASSERT_THROW(m.data() == storage);
+    ASSERT_EQUAL((m[{2, 1}]), 9);
+
+    m.reserve(100);
+    ASSERT_THROW(m.capacity() >= 100);
+    storage = m.data();
+    m.resize(9, 10);
+    m.resize(7, 3);
+    m.resize(10, 10);
+    ASSERT_THROW(m.data() == storage);
+    ASSERT_EQUAL((m[{2, 1}]), 9);
+
+    m.resize(2, 2);
+    m.shrink_to_fit();
+    ASSERT_EQUAL(m.capacity(), 4);
+    ASSERT_EQUAL((m[{1, 1}]), 5);
+}
+
+namespace {
+
+/** Counts the allocations made through it. */
+template <typename T>
+struct AllocationCounter {
+    typedef T value_type;
+    static std::size_t allocations;
+
+    AllocationCounter() = default;
+    template <typename U> AllocationCounter(const AllocationCounter<U>&) noexcept {}
+
+    T* allocate(std::size_t n) {
+        ++allocations;
+        return std::allocator<T>().allocate(n);
+    }
+    void deallocate(T* p, std::size_t n) noexcept { std::allocator<T>().deallocate(p, n); }
+
+    template <typename U> bool operator == (const AllocationCounter<U>&) const noexcept { return true; }
+    template <typename U> bool operator != (const AllocationCounter<U>&) const noexcept { return false; }
+};
+
+template <typename T> std::size_t AllocationCounter<T>::allocations = 0;
+
+} // namespace
+
+void testCompoundAssignment(){
+    typedef Matrix<double, AllocationCounter<double>> CountedMatrix;
+    CountedMatrix state(3, 4, 1.0);
+    CountedMatrix velocity(3, 4);
+    for(std::size_t i = 0; i < velocity.size(); ++i) velocity[i] = double(i);
+    const Matrix<double> damping(3, 4, 0.5);
+
+    const std::size_t warm = AllocationCounter<double>::allocations;
+    for(int frame = 0; frame < 3; ++frame) {
+        state += velocity;
+        state -= damping * 2.0;
+        state += hadamard(state, damping);
+        state *= 2.0;
+        state /= 4.0;
+        state -= state;
+        state += velocity + damping;
     }
+    ASSERT_EQUAL(AllocationCounter<double>::allocations, warm);
+    for(std::size_t i = 0; i < state.size(); ++i) ASSERT_EQUAL(state[i], double(i) + 0.5);
+
+    // The right-hand side may read the destination
+    state *= 2.0;
+    state += state * 0.5;
+    ASSERT_EQUAL(state[3], 10.5);
+    state -= state;
+    ASSERT_EQUAL(state[3], 0.0);
 }
 
 void testZeroMatrix(){
@@ -244,6 +286,9 @@ void testMatrix()
     testMatrixInit();
     testMatrixSetFunc();
     testMatrixResize();
+    testResizeKeepsLayout();
+    testReshapeAndCapacity();
+    testCompoundAssignment();
     testZeroMatrix();
     testMatrixIndexes();
     testRaowIterator();
@@ -0,0 +1,208 @@
+#include <iostream>
+#include <algorithm>
+#include <numeric>
+
+#include "src/cppmath_matrix.hpp"
+#include "src/cppmath_gemm.hpp"
+#include "src/cppmath_elementwise.hpp"
+#include "cppmath_test.hpp"
+
+using namespace cppmath::matrix;
+
+Matrix<int> indexMatrix(std::size_t rows, std::size_t columns){
+    Matrix<int> m(rows, columns);
+    for(std::size_t i = 0; i < m.size(); ++i) m[i] = static_cast<int>(i);
+    return m;
+}
+
+void testSubmatrixView(){
+    auto m = indexMatrix(4, 5);
+    auto block = m.submatrix({1, 2}, 2, 3);
+
+    ASSERT_EQUAL(block.rows(), 2);
+    ASSERT_EQUAL(block.columns(), 3);
+    ASSERT_EQUAL(block.rowStride(), 5);
+    ASSERT_EQUAL(block.columnStride(), 1);
+    ASSERT_EQUAL(block.isContiguous(), false);
+    ASSERT_EQUAL((block[{0, 0}]), 7);
+    ASSERT_EQUAL((block[{1, 2}]), 14);
+    ASSERT_EQUAL(block[4], 13);
+
+    // Writes go to the viewed matrix.
+    block[{1, 1}] = -1;
+    ASSERT_EQUAL((m[{2, 3}]), -1);
+
+    auto inner = block.submatrix({1, 1}, 1, 2);
+    ASSERT_EQUAL(inner[0], -1);
+    ASSERT_EQUAL(inner[1], 14);
+
+    const Matrix<int>& cm = m;
+    ConstMatrixView<int> cblock = cm.submatrix({0, 0}, 2, 2);
+    ASSERT_EQUAL(cblock[3], 6);
+
+    ConstMatrixView<int> converted = block;
+    ASSERT_EQUAL(converted[0], 7);
+}
+
+void testRowColumnDiagonalViews(){
+    auto m = indexMatrix(3, 4);
+    auto v = m.view();
+
+    auto row = v.row(1);
+    ASSERT_EQUAL(row.isRowVector(), true);
+    ASSERT_EQUAL(row.isContiguous(), true);
+    for(std::size_t c = 0; c < 4; ++c) ASSERT_EQUAL(row[c], static_cast<int>(4 + c));
+
+    auto column = v.column(2);
+    ASSERT_EQUAL(column.isColumnVector(), true);
+    ASSERT_EQUAL(column.isContiguous(), false);
+    for(std::size_t r = 0; r < 3; ++r) ASSERT_EQUAL(column[r], static_cast<int>(4 * r + 2));
+
+    auto diagonal = v.diagonal();
+    ASSERT_EQUAL(diagonal.size(), 3);
+    ASSERT_EQUAL(diagonal[0], 0);
+    ASSERT_EQUAL(diagonal[1], 5);
+    ASSERT_EQUAL(diagonal[2], 10);
+
+    auto t = v.transposed();
+    ASSERT_EQUAL(t.rows(), 4);
+    ASSERT_EQUAL(t.columns(), 3);
+    for(std::size_t r = 0; r < 4; ++r) {
+        for(std::size_t c = 0; c < 3; ++c) {
+            ASSERT_EQUAL((t[{r, c}]), (m[{c, r}]));
+        }
+    }
+    ASSERT_EQUAL((t.transposed()[{2, 3}]), 11);
+}
+
+void testViewIterators(){
+    auto m = indexMatrix(4, 4);
+    auto block = m.submatrix({1, 1}, 2, 3);
+
+    ASSERT_EQUAL(std::distance(block.begin(), block.end()), 6);
+    ASSERT_EQUAL(std::accumulate(block.begin(), block.end(), 0), 5 + 6 + 7 + 9 + 10 + 11);
+
+    auto it = block.begin();
+    int expect[6] = {5, 6, 7, 9, 10, 11};
+    for(int i = 0; i < 6; ++i, ++it) {
+        ASSERT_EQUAL(*it, expect[i]);
+        ASSERT_EQUAL(it.row(), static_cast<std::size_t>(i / 3));
+        ASSERT_EQUAL(it.column(), static_cast<std::size_t>(i % 3));
+    }
+    ASSERT_EQUAL_EXP(it, block.end());
+
+    auto jt = block.end();
+    --jt;
+    ASSERT_EQUAL(*jt, 11);
+    jt -= 3;
+    ASSERT_EQUAL(*jt, 7);
+    ASSERT_EQUAL(*(block.begin() + 4), 10);
+    ASSERT_EQUAL_EXP(block.beginAt({1, 0}), block.begin() + 3);
+
+    std::fill(block.column(0).begin(), block.column(0).end(), 0);
+    ASSERT_EQUAL((m[{1, 1}]), 0);
+    ASSERT_EQUAL((m[{2, 1}]), 0);
+
+    auto diagonal = m.view().diagonal();
+    std::sort(diagonal.begin(), diagonal.end(), std::greater<int>());
+    ASSERT_EQUAL((m[{0, 0}]), 15);
+    ASSERT_EQUAL((m[{3, 3}]), 0);
+
+    auto t = m.view().transposed();
+    std::reverse(t.begin(), t.end());
+    ASSERT_EQUAL((m[{0, 0}]), 0);
+
+    const Matrix<int> copy(m.submatrix({2, 2}, 2, 2));
+    ASSERT_EQUAL(copy.rows(), 2);
+    ASSERT_EQUAL(copy[0], (m[{2, 2}]));
+    ASSERT_EQUAL(copy[3], (m[{3, 3}]));
+}
+
+void testGemmOnViews(){
+    Matrix<double> a(6, 6);
+    for(std::size_t i = 0; i < a.size(); ++i) a[i] = static_cast<double>(i % 7) - 3.0;
+
+    // Upper left block times transposed lower right block into a block of c.
+    Matrix<double> c(6, 6, 1.0);
+    auto a11 = a.submatrix({0, 0}, 3, 4);
+    auto a22t = a.submatrix({2, 2}, 2, 4).transposed();
+    gemm(1.0, a11, a22t, 0.0, c.submatrix({3, 3}, 3, 2));
+
+    for(std::size_t i = 0; i < 3; ++i) {
+        for(std::size_t j = 0; j < 2; ++j) {
+            double acc = 0;
+            for(std::size_t p = 0; p < 4; ++p) acc += (a[{i, p}]) * (a[{2 + j, 2 + p}]);
+            ASSERT_EQUAL((c[{3 + i, 3 + j}]), acc);
+        }
+    }
+    ASSERT_EQUAL((c[{0, 0}]), 1.0);
+    ASSERT_EQUAL((c[{5, 5}]), 1.0);
+
+    const Matrix<double> p = a.view().transposed() * a;
+    for(std::size_t i = 0; i < 6; ++i) {
+        for(std::size_t j = 0; j < 6; ++j) {
+            double acc = 0;
+            for(std::size_t k = 0; k < 6; ++k) acc += (a[{k, i}]) * (a[{k, j}]);
+            ASSERT_EQUAL((p[{i, j}]), acc);
+        }
+    }
+}
+
+void testElementwiseOnViews(){
+    Matrix<float> m(5, 300, 1.f);
+    Matrix<float> n(300, 5, 2.f);
+
+    // Strided columns go through the gathered path.
+    add(m.view().column(3), n.view().row(2).transposed(), m.view().column(3));
+    for(std::size_t r = 0; r < 5; ++r) ASSERT_EQUAL((m[{r, 3}]), 3.f);
+    ASSERT_EQUAL((m[{0, 2}]), 1.f);
+
+    axpy(2.f, n.view().transposed(), m.view());
+    ASSERT_EQUAL((m[{4, 3}]), 7.f);
+    ASSERT_EQUAL((m[{4, 299}]), 5.f);
+
+    scale(m.submatrix({1, 1}, 2, 2), 0.5f, m.submatrix({1, 1}, 2, 2));
+    ASSERT_EQUAL((m[{1, 1}]), 2.5f);
+    ASSERT_EQUAL((m[{0, 1}]), 5.f);
+
+    Matrix<unsigned char> mask(5, 300);
+    compare(m, n.view().transposed(), CompareOp::Greater, mask);
+    ASSERT_EQUAL((mask[{0, 0}]), 1);
+}
+
+void testExpressionsOnViews(){
+    auto m = indexMatrix(3, 3);
+    const Matrix<int> sum = m.view().transposed() + m;
+    for(std::size_t r = 0; r < 3; ++r) {
+        for(std::size_t c = 0; c < 3; ++c) {
+            ASSERT_EQUAL((sum[{r, c}]), (m[{r, c}]) + (m[{c, r}]));
+        }
+    }
+
+    Matrix<int> out(4, 4, 0);
+    out.submatrix({1, 1}, 3, 3).assign(m * 2 - m.view().transposed());
+    ASSERT_EQUAL((out[{0, 0}]), 0);
+    ASSERT_EQUAL((out[{1, 2}]), 2 * 1 - 3);
+    ASSERT_EQUAL((out[{3, 3}]), 8);
+
+    out.view().row(0).fill(9);
+    ASSERT_EQUAL((out[{0, 3}]), 9);
+    out.view().column(0).assign(out.view().row(0).transposed());
+    ASSERT_EQUAL((out[{3, 0}]), 9);
+}
+
+void testMatrixView()
+{
+    testSubmatrixView();
+    testRowColumnDiagonalViews();
+    testViewIterators();
+    testGemmOnViews();
+    testElementwiseOnViews();
+    testExpressionsOnViews();
+}
+
+int main(int a, char**)
+{
+    testMatrixView();
+    return 0;
+}
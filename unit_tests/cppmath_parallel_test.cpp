@@ -0,0 +1,195 @@
+#include <iostream>
+#include <atomic>
+#include <random>
+#include <thread>
+#include <vector>
+#include <stdexcept>
+#include <cstdlib>
+
+#include "src/cppmath_parallel.hpp"
+#include "src/cppmath_gemm.hpp"
+#include "src/cppmath_elementwise.hpp"
+#include "src/cppmath_sparse.hpp"
+#include "cppmath_test.hpp"
+
+using namespace cppmath::matrix;
+using namespace cppmath::execution;
+
+static_assert(!seq.isParallel() && par.isParallel() && par_unseq.isParallel(), "");
+static_assert(par.withGrain(64).grain() == 64 && par.withGrain(64).isParallel(), "");
+static_assert(par.grainOr(8) == 8 && par.withGrain(3).grainOr(8) == 3, "");
+
+Matrix<double> quarterMatrix(std::size_t rows, std::size_t columns, std::mt19937& rng){
+    std::uniform_int_distribution<int> dist(-8, 8);
+    Matrix<double> m(rows, columns);
+    for(std::size_t i = 0; i < m.size(); ++i) m[i] = dist(rng) / 4.0;
+    return m;
+}
+
+void testCoverage(){
+    ThreadPool pool(4);
+    ASSERT_EQUAL(pool.concurrency(), 4);
+    ASSERT_EQUAL(pool.isWorkerThread(), false);
+
+    const std::size_t grains[] = {1, 7, 100, 5000};
+    for(const std::size_t grain : grains) {
+        std::vector<std::atomic<int>> hits(1000);
+        std::atomic<std::size_t> smallest(1000);
+        pool.parallelFor(0, 1000, grain, [&](std::size_t first, std::size_t last){
+            std::size_t current = smallest.load();
+            while(last - first < current && !smallest.compare_exchange_weak(current, last - first)) {}
+            for(std::size_t i = first; i < last; ++i) ++hits[i];
+        });
+        for(const auto& h : hits) ASSERT_EQUAL(h.load(), 1);
+        ASSERT_THROW(smallest.load() >= std::min<std::size_t>(grain, 1000));
+    }
+
+    // A single pool thread runs everything inline
+    ThreadPool single(1);
+    const std::thread::id caller = std::this_thread::get_id();
+    single.parallelFor(0, 100, 1, [&](std::size_t, std::size_t){
+        ASSERT_THROW(std::this_thread::get_id() == caller);
+    });
+}
+
+void testNested(){
+    ThreadPool pool(3);
+    std::atomic<std::size_t> total(0);
+    pool.parallelFor(0, 16, 1, [&](std::size_t first, std::size_t last){
+        for(std::size_t i = first; i < last; ++i) {
+            pool.parallelFor(0, 64, 1, [&](std::size_t a, std::size_t b){
+                pool.parallelFor(a, b, 1, [&](std::size_t c, std::size_t d){ total += d - c; });
+            });
+        }
+    });
+    ASSERT_EQUAL(total.load(), 16 * 64);
+}
+
+void testExceptions(){
+    ThreadPool pool(4);
+    bool thrown = false;
+    try {
+        pool.parallelFor(0, 100, 1, [](std::size_t first, std::size_t){
+            if(first > 50) throw std::logic_error("task");
+        });
+    } catch(const std::logic_error&) {
+        thrown = true;
+    }
+    ASSERT_EQUAL(thrown, true);
+
+    // The pool stays usable
+    std::atomic<std::size_t> count(0);
+    pool.parallelFor(0, 100, 1, [&](std::size_t first, std::size_t last){ count += last - first; });
+    ASSERT_EQUAL(count.load(), 100);
+}
+
+void testConcurrentCallers(){
+    ThreadPool pool(4);
+    std::vector<std::thread> callers;
+    std::atomic<std::size_t> total(0);
+    for(int t = 0; t < 6; ++t) {
+        callers.emplace_back([&]{
+            for(int round = 0; round < 20; ++round) {
+                pool.parallelFor(0, 256, 4, [&](std::size_t first, std::size_t last){ total += last - first; });
+            }
+        });
+    }
+    for(std::thread& t : callers) t.join();
+    ASSERT_EQUAL(total.load(), 6 * 20 * 256);
+}
+
+void testSequencedPolicy(){
+    const std::thread::id caller = std::this_thread::get_id();
+    std::size_t calls = 0;
+    parallelFor(seq, 0, 1 << 20, 1, [&](std::size_t first, std::size_t last){
+        ASSERT_THROW(std::this_thread::get_id() == caller);
+        ASSERT_EQUAL(first, 0);
+        ASSERT_EQUAL(last, 1 << 20);
+        ++calls;
+    });
+    ASSERT_EQUAL(calls, 1);
+}
+
+void testKernels(){
+    setThreadCount(4);
+    ASSERT_EQUAL(threadCount(), 4);
+
+    std::mt19937 rng(17);
+    const auto a = quarterMatrix(301, 257, rng);
+    const auto b = quarterMatrix(257, 190, rng);
+
+    // Products of quarters are exact, so every split gives the same result
+    Matrix<double> expected(301, 190);
+    gemm(seq, 1.0, a, b, 0.0, expected);
+    Matrix<double> actual(301, 190);
+    gemm(par, 1.0, a, b, 0.0, actual);
+    for(std::size_t i = 0; i < actual.size(); ++i) ASSERT_EQUAL(actual[i], expected[i]);
+    gemm(par_unseq.withGrain(3), 1.0, a, b.view(), 0.0, actual.view());
+    for(std::size_t i = 0; i < actual.size(); ++i) ASSERT_EQUAL(actual[i], expected[i]);
+
+    const auto x = quarterMatrix(700, 300, rng);
+    const auto y = quarterMatrix(700, 300, rng);
+    Matrix<double> sum(700, 300);
+    add(par.withGrain(1000), x, y, sum);
+    for(std::size_t i = 0; i < sum.size(); ++i) ASSERT_EQUAL(sum[i], x[i] + y[i]);
+    Matrix<double> strided(300, 700);
+    subtract(par.withGrain(1000), x.view().transposed(), y.view().transposed(), strided.view());
+    for(std::size_t r = 0; r < 700; ++r)
+        for(std::size_t c = 0; c < 300; ++c)
+            ASSERT_EQUAL((strided[{c, r}]), (x[{r, c}] - y[{r, c}]));
+
+    const CsrMatrix<double> sparse(quarterMatrix(500, 257, rng));
+    Matrix<double> sparseExpected(500, 190);
+    spmm(seq, 1.0, sparse, b, 0.0, sparseExpected);
+    Matrix<double> sparseActual(500, 190);
+    spmm(par.withGrain(1), 1.0, sparse, b, 0.0, sparseActual);
+    for(std::size_t i = 0; i < sparseActual.size(); ++i) ASSERT_EQUAL(sparseActual[i], sparseExpected[i]);
+    spmm(par.withGrain(1), 1.0, CscMatrix<double>(sparse), b, 0.0, sparseActual);
+    for(std::size_t i = 0; i < sparseActual.size(); ++i) ASSERT_EQUAL(sparseActual[i], sparseExpected[i]);
+    Matrix<double> vector(500, 1);
+    spmv(par.withGrain(1), 1.0, sparse, b.view().column(3), 0.0, vector);
+    for(std::size_t i = 0; i < 500; ++i) ASSERT_EQUAL(vector[i], (sparseExpected[{i, 3}]));
+
+    // Products nested in pool tasks
+    std::vector<Matrix<double>> results(8, Matrix<double>(301, 190));
+    parallelFor(par, 0, results.size(), 1, [&](std::size_t first, std::size_t last){
+        for(std::size_t i = first; i < last; ++i) gemm(par, 1.0, a, b, 0.0, results[i]);
+    });
+    for(const auto& r : results)
+        for(std::size_t i = 0; i < r.size(); ++i) ASSERT_EQUAL(r[i], expected[i]);
+
+    setThreadCount(0);
+}
+
+/** Built before the shared pool and so destroyed after it: a kernel run
+    from its destructor must not reach the joined pool.
+ */
+struct LateCaller {
+    ~LateCaller() {
+        std::vector<int> hits(1000, 0);
+        parallelFor(par, 0, hits.size(), 10, [&](std::size_t first, std::size_t last){
+            for(std::size_t i = first; i < last; ++i) ++hits[i];
+        });
+        for(const int hit : hits) if(hit != 1) std::_Exit(1);
+    }
+};
+
+LateCaller lateCaller;
+
+void testParallel()
+{
+    testCoverage();
+    testNested();
+    testExceptions();
+    testConcurrentCallers();
+    testSequencedPolicy();
+    testKernels();
+    // Leaves a live shared pool for LateCaller to outlive
+    ASSERT_THROW(threadCount() >= 1);
+}
+
+int main(int a, char**)
+{
+    testParallel();
+    return 0;
+}
@@ -0,0 +1,140 @@
+#include <iostream>
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <vector>
+#include <stdexcept>
+
+#include "src/cppmath_power.hpp"
+#include "src/cppmath_combinatorics.hpp"
+#include "cppmath_test.hpp"
+
+using namespace cppmath::matrix;
+using cppmath::combinatorics::ModularInt;
+using cppmath::combinatorics::SaturatingInt;
+
+typedef ModularInt<1000000007u> Mod;
+typedef SaturatingInt<std::uint64_t> Count;
+
+template <typename T>
+Matrix<T> naivePower(const Matrix<T>& m, std::uint64_t exponent){
+    Matrix<T> result(m.rows(), m.columns());
+    for(std::size_t i = 0; i < m.rows(); ++i) result[{i, i}] = T(1);
+    for(std::uint64_t e = 0; e < exponent; ++e) {
+        Matrix<T> next(m.rows(), m.columns());
+        gemm(cppmath::execution::seq, T(1), result, m, T(0), next);
+        result = next;
+    }
+    return result;
+}
+
+void testFibonacci(){
+    const Matrix<std::uint64_t> q(2, 2, {1, 1, 1, 0});
+    const Matrix<std::uint64_t> f90 = power(q, 90);
+    ASSERT_THROW(f90[1] == 2880067194370816120ull);
+    ASSERT_THROW(f90[0] == f90[1] + f90[3]);
+
+    // F(10^18) modulo 1e9 + 7
+    const Matrix<Mod> qm(2, 2, {Mod(1), Mod(1), Mod(1), Mod(0)});
+    const Matrix<Mod> big = power(qm, 1000000000000000000ull);
+    ASSERT_EQUAL(big[1].value(), 209783453u);
+}
+
+void testSaturatingWalks(){
+    // Walks in the complete graph K4: (3^k + 3 (-1)^k) / 4 closed ones and
+    // (3^k - (-1)^k) / 4 between two vertices
+    Matrix<Count> k4(4, 4, Count(1));
+    for(std::size_t i = 0; i < 4; ++i) k4[{i, i}] = Count(0);
+
+    const Matrix<Count> walks41 = power(k4, 41);
+    ASSERT_THROW((walks41[{2, 2}]).value() == 9118249094292696600ull);
+    ASSERT_THROW((walks41[{0, 3}]).value() == 9118249094292696601ull);
+    ASSERT_THROW(!(walks41[{0, 3}]).saturated());
+
+    const Matrix<Count> walks45 = power(k4, 45);
+    for(std::size_t i = 0; i < walks45.size(); ++i) ASSERT_THROW(walks45[i].saturated());
+}
+
+void testAgainstRepeatedProducts(){
+    std::mt19937 rng(3);
+    std::uniform_int_distribution<int> dist(-2, 2);
+    Matrix<double> m(7, 7);
+    for(std::size_t i = 0; i < m.size(); ++i) m[i] = dist(rng) * 0.25;
+
+    for(std::uint64_t e = 0; e <= 20; ++e) {
+        const Matrix<double> expected = naivePower(m, e);
+        const Matrix<double> actual = power(m, e);
+        for(std::size_t i = 0; i < m.size(); ++i)
+            ASSERT_NEAR(actual[i], expected[i], 1e-9 * (1.0 + std::fabs(expected[i])));
+    }
+
+    // In place and into a submatrix
+    Matrix<double> inPlace(m);
+    power(cppmath::execution::seq, inPlace, 9, inPlace);
+    Matrix<double> target(10, 10, -1.0);
+    power(m.view().transposed(), 9, target.submatrix({2, 1}, 7, 7));
+    const Matrix<double> expected = naivePower(m, 9);
+    for(std::size_t r = 0; r < 7; ++r) {
+        for(std::size_t c = 0; c < 7; ++c) {
+            ASSERT_NEAR((inPlace[{r, c}]), (expected[{r, c}]), 1e-9);
+            ASSERT_NEAR((target[{r + 2, c + 1}]), (expected[{c, r}]), 1e-9);
+        }
+    }
+    ASSERT_EQUAL((target[{0, 0}]), -1.0);
+    ASSERT_EQUAL((target[{9, 9}]), -1.0);
+}
+
+void testBatchedPowers(){
+    std::mt19937 rng(5);
+    std::uniform_int_distribution<int> dist(0, 1000);
+    Matrix<Mod> m(5, 5);
+    for(std::size_t i = 0; i < m.size(); ++i) m[i] = Mod(dist(rng));
+
+    const std::vector<std::uint64_t> exponents = {0, 1, 2, 5, 13, 64, 1000, 123456789, 1};
+    const std::vector<Matrix<Mod>> results = powers(m, exponents);
+    ASSERT_EQUAL(results.size(), exponents.size());
+    for(std::size_t k = 0; k < exponents.size(); ++k) {
+        const Matrix<Mod> expected = exponents[k] <= 64 ? naivePower(m, exponents[k]) : power(m, exponents[k]);
+        for(std::size_t i = 0; i < m.size(); ++i) ASSERT_EQUAL(results[k][i].value(), expected[i].value());
+    }
+
+    // m^1000 = (m^500)^2
+    const Matrix<Mod> half = power(m, 500);
+    const Matrix<Mod> squared = power(half, 2);
+    for(std::size_t i = 0; i < m.size(); ++i) ASSERT_EQUAL(squared[i].value(), results[6][i].value());
+}
+
+void testNonSquare(){
+    const Matrix<double> m(2, 3, {1, 2, 3, 4, 5, 6});
+    bool threw = false;
+    try { power(m, 2); } catch(const std::invalid_argument&) { threw = true; }
+    ASSERT_THROW(threw);
+    threw = false;
+    try { powers(m, std::vector<std::uint64_t>{0, 3}); } catch(const std::invalid_argument&) { threw = true; }
+    ASSERT_THROW(threw);
+
+    const Matrix<double> square(2, 2, {1, 1, 0, 1});
+    Matrix<double> out(3, 3);
+    threw = false;
+    try { power(square, 2, out); } catch(const std::invalid_argument&) { threw = true; }
+    ASSERT_THROW(threw);
+
+    // isSquareMatrix() does not count an empty matrix as square
+    threw = false;
+    try { power(Matrix<double>(), 3); } catch(const std::invalid_argument&) { threw = true; }
+    ASSERT_THROW(threw);
+}
+
+void testPower(){
+    testFibonacci();
+    testSaturatingWalks();
+    testAgainstRepeatedProducts();
+    testBatchedPowers();
+    testNonSquare();
+}
+
+int main(int a, char**)
+{
+    testPower();
+    return 0;
+}
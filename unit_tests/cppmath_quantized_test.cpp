@@ -0,0 +1,150 @@
+#include <iostream>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <vector>
+
+#include "src/cppmath_quantized.hpp"
+#include "cppmath_test.hpp"
+
+using namespace cppmath::matrix;
+using cppmath::cpu::InstructionSet;
+
+/** Full range bytes, int16 kept small enough for the int32 sums. */
+template <typename T>
+std::uniform_int_distribution<int> quantizedValues(){
+    return std::uniform_int_distribution<int>(sizeof(T) == 1 ? std::numeric_limits<T>::min() : -2000,
+                                              sizeof(T) == 1 ? std::numeric_limits<T>::max() : 2000);
+}
+
+Quantization randomQuantization(std::size_t channels, int lowZero, int highZero, std::mt19937& rng){
+    std::uniform_int_distribution<int> zero(lowZero, highZero);
+    std::uniform_real_distribution<float> scale(0.001f, 0.1f);
+    std::vector<float> scales(channels);
+    std::vector<std::int32_t> zeroPoints(channels);
+    for(std::size_t i = 0; i < channels; ++i) {
+        scales[i] = scale(rng);
+        zeroPoints[i] = zero(rng);
+    }
+    return Quantization(scales, zeroPoints);
+}
+
+template <class A, class B>
+Matrix<std::int64_t> naiveProduct(const A& a, const Quantization& qa, const B& b, const Quantization& qb){
+    Matrix<std::int64_t> c(a.rows(), b.columns());
+    for(std::size_t i = 0; i < a.rows(); ++i) {
+        for(std::size_t j = 0; j < b.columns(); ++j) {
+            std::int64_t sum = 0;
+            for(std::size_t p = 0; p < a.columns(); ++p)
+                sum += (std::int64_t(a[MatrixPoint{i, p}]) - qa.zeroPoint(i)) * (std::int64_t(b[MatrixPoint{p, j}]) - qb.zeroPoint(j));
+            c[MatrixPoint{i, j}] = sum;
+        }
+    }
+    return c;
+}
+
+template <typename SA, typename SB>
+void testExact(const detail::QuantizedKernels& kernels){
+    std::mt19937 rng(17);
+    // k not a multiple of the group, edges past every tile size
+    const std::size_t shapes[][3] = {{1, 1, 1}, {5, 7, 3}, {13, 33, 17}, {40, 70, 129}, {3, 100, 64}, {25, 2, 0}};
+    for(const auto& shape : shapes) {
+        const std::size_t m = shape[0], n = shape[1], k = shape[2];
+        const Matrix<SA> a = randomMatrix<SA>(m, k, rng, quantizedValues<SA>());
+        const Matrix<SB> b = randomMatrix<SB>(k, n, rng, quantizedValues<SB>());
+        const Quantization qa = randomQuantization(m, -20, 20, rng);
+        const Quantization qb = randomQuantization(n, -20, 20, rng);
+        const Matrix<std::int64_t> expected = naiveProduct(a, qa, b, qb);
+
+        Matrix<std::int32_t> c(m, n, -1);
+        detail::quantizedGemm(m, n, k, a.data(), std::ptrdiff_t(k), 1, qa, b.data(), std::ptrdiff_t(n), 1, qb,
+                              c.data(), std::ptrdiff_t(n), 1, kernels, cppmath::execution::seq);
+        for(std::size_t i = 0; i < c.size(); ++i) ASSERT_EQUAL(std::int64_t(c[i]), expected[i]);
+    }
+}
+
+template <typename SA, typename SB>
+void testKernelLevels(){
+    const InstructionSet levels[] = {InstructionSet::Generic, InstructionSet::SSE2, InstructionSet::AVX2, InstructionSet::AVX512};
+    const cppmath::cpu::Features& features = cppmath::cpu::features();
+    for(const InstructionSet isa : levels) {
+        if(!cppmath::cpu::supports(isa)) continue;
+        testExact<SA, SB>(detail::quantizedKernels(isa, false));
+        const bool vnni = isa == InstructionSet::AVX512 ? features.avx512vnni :
+                          isa == InstructionSet::AVX2 ? features.avxvnni : false;
+        if(vnni) {
+            const detail::QuantizedKernels kernels = detail::quantizedKernels(isa, true);
+            ASSERT_THROW(kernels.bytes.kernel != nullptr);
+            testExact<SA, SB>(kernels);
+        }
+    }
+}
+
+void testSaturation(){
+    // pmaddubsw would saturate 255 * 127 + 255 * 127 in int16
+    const std::size_t k = 1000;
+    const Matrix<std::uint8_t> a(3, k, 255);
+    const Matrix<std::int8_t> b(k, 4, 127);
+    Matrix<std::int32_t> c(3, 4);
+    quantizedMultiply(a, b, c);
+    for(std::size_t i = 0; i < c.size(); ++i) ASSERT_EQUAL(c[i], 255 * 127 * 1000);
+
+    const Matrix<std::int8_t> low(2, k, -128);
+    const Matrix<std::int8_t> high(k, 2, -128);
+    Matrix<std::int32_t> d(2, 2);
+    quantizedMultiply(low, high, d);
+    for(std::size_t i = 0; i < d.size(); ++i) ASSERT_EQUAL(d[i], 128 * 128 * 1000);
+}
+
+void testViewsAndFloat(){
+    std::mt19937 rng(23);
+    const Matrix<std::int8_t> a = randomMatrix<std::int8_t>(30, 45, rng, quantizedValues<std::int8_t>());
+    const Matrix<std::int8_t> bt = randomMatrix<std::int8_t>(20, 45, rng, quantizedValues<std::int8_t>());
+    const Quantization qa(0.05f, 3);
+    const Quantization qb = randomQuantization(20, 0, 0, rng);
+
+    // B given transposed, the result written into a submatrix of a float matrix
+    Matrix<float> out(32, 24, 7.0f);
+    quantizedMultiply(a, qa, bt.view().transposed(), qb, out.submatrix({1, 2}, 30, 20));
+    const Matrix<std::int64_t> expected = naiveProduct(a, qa, Matrix<std::int8_t>(bt.view().transposed()), qb);
+
+    for(std::size_t i = 0; i < out.rows(); ++i) {
+        for(std::size_t j = 0; j < out.columns(); ++j) {
+            const bool inside = i >= 1 && i < 31 && j >= 2 && j < 22;
+            if(!inside) {
+                ASSERT_EQUAL((out[{i, j}]), 7.0f);
+                continue;
+            }
+            const double real = double(qa.scale(0)) * qb.scale(j - 2) * double(expected[{i - 1, j - 2}]);
+            ASSERT_NEAR(double(out[{i, j}]), real, 1e-5 * std::fabs(real) + 1e-6);
+        }
+    }
+}
+
+void testParallel(){
+    std::mt19937 rng(29);
+    const Matrix<std::uint8_t> a = randomMatrix<std::uint8_t>(150, 300, rng, quantizedValues<std::uint8_t>());
+    const Matrix<std::int8_t> b = randomMatrix<std::int8_t>(300, 170, rng, quantizedValues<std::int8_t>());
+    const Quantization qa = randomQuantization(150, 100, 140, rng);
+    const Quantization qb(1.0f, -5);
+    Matrix<std::int32_t> c(150, 170);
+    quantizedMultiply(cppmath::execution::par.withGrain(1), a, qa, b, qb, c);
+    const Matrix<std::int64_t> expected = naiveProduct(a, qa, b, qb);
+    for(std::size_t i = 0; i < c.size(); ++i) ASSERT_EQUAL(std::int64_t(c[i]), expected[i]);
+}
+
+void testQuantized(){
+    testKernelLevels<std::int8_t, std::int8_t>();
+    testKernelLevels<std::uint8_t, std::int8_t>();
+    testKernelLevels<std::int16_t, std::int16_t>();
+    testSaturation();
+    testViewsAndFloat();
+    testParallel();
+}
+
+int main(int a, char**)
+{
+    testQuantized();
+    return 0;
+}
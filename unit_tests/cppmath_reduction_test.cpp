@@ -0,0 +1,289 @@
+#include <iostream>
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "src/cppmath_reduction.hpp"
+#include "cppmath_test.hpp"
+
+using namespace cppmath::matrix;
+using cppmath::cpu::InstructionSet;
+
+const std::uniform_real_distribution<double> kValues(-4.0, 4.0);
+
+template <typename T>
+void testKernels(const detail::ReductionKernels<T>& k){
+    std::mt19937 rng(7);
+    const std::size_t sizes[] = {1, 3, 7, 16, 31, 64, 129, 1000, 4099};
+    const double tolerance = sizeof(T) == 4 ? 1e-4 : 1e-10;
+    for(const auto n : sizes) {
+        const Matrix<T> x = randomMatrix<T>(1, n, rng, kValues);
+        const T shift = T(0.75);
+        double sum = 0, sumAbs = 0, sumSquares = 0, maxAbs = 0;
+        T lo = x[0], hi = x[0];
+        for(std::size_t i = 0; i < n; ++i) {
+            sum += x[i];
+            sumAbs += std::fabs(double(x[i]));
+            sumSquares += (double(x[i]) - shift) * (double(x[i]) - shift);
+            maxAbs = std::max(maxAbs, std::fabs(double(x[i])));
+            lo = std::min(lo, x[i]);
+            hi = std::max(hi, x[i]);
+        }
+        const double expected[] = {sum, sumAbs, sumSquares, maxAbs};
+        for(std::size_t op = 0; op < detail::kReductionOps; ++op) {
+            const double scale = tolerance * (1.0 + sumAbs + sumSquares);
+            ASSERT_NEAR(double(k.span[op](x.data(), n, shift)), expected[op], scale);
+            ASSERT_NEAR(double(k.kahanSpan[op](x.data(), n, shift)), expected[op], scale);
+        }
+        T minimum, maximum;
+        k.extremes(x.data(), n, &minimum, &maximum);
+        ASSERT_EQUAL(minimum, lo);
+        ASSERT_EQUAL(maximum, hi);
+
+        // Column accumulators: acc += f(row - shift) element by element
+        const Matrix<T> shifts = randomMatrix<T>(1, n, rng, kValues);
+        for(std::size_t op = 0; op < detail::kReductionOps; ++op) {
+            Matrix<T> acc(1, n, T(1));
+            Matrix<T> kahan(1, n, T(1));
+            Matrix<T> compensation(1, n, T(0));
+            k.accumulate[op](x.data(), shifts.data(), acc.data(), nullptr, n);
+            k.kahanAccumulate[op](x.data(), shifts.data(), kahan.data(), compensation.data(), n);
+            for(std::size_t i = 0; i < n; ++i) {
+                const double v = x[i];
+                const double d = v - shifts[i];
+                const double e = op == 0 ? 1 + v : op == 1 ? 1 + std::fabs(v) : op == 2 ? 1 + d * d : std::max(1.0, std::fabs(v));
+                ASSERT_NEAR(double(acc[i]), e, tolerance * (1 + std::fabs(e)));
+                ASSERT_NEAR(double(kahan[i]), e, tolerance * (1 + std::fabs(e)));
+            }
+        }
+    }
+}
+
+void testKernelLevels(){
+    const InstructionSet levels[] = {InstructionSet::Generic, InstructionSet::SSE2, InstructionSet::AVX2, InstructionSet::AVX512};
+    for(const InstructionSet isa : levels) {
+        if(!cppmath::cpu::supports(isa)) continue;
+        testKernels(detail::reductionKernels<float>(isa));
+        testKernels(detail::reductionKernels<double>(isa));
+    }
+    testKernels(detail::reductionKernels<long double>(InstructionSet::Generic));
+}
+
+void testSummationAccuracy(){
+    // 0.1f cannot be represented exactly: a single float accumulator drifts
+    // by about 1e-3 relative over four million terms, pairwise and Kahan do not.
+    const std::size_t n = std::size_t(1) << 22;
+    const Matrix<float> m(2048, n / 2048, 0.1f);
+    const double exact = double(0.1f) * n;
+    ASSERT_NEAR(double(sum(m, Summation::Pairwise)), exact, 1e-6 * exact);
+    ASSERT_NEAR(double(sum(m, Summation::Kahan)), exact, 1e-6 * exact);
+    ASSERT_NEAR(double(sum(m, Summation::Fast)), exact, 1e-4 * exact);
+
+    // Large cancelling terms around small ones
+    Matrix<double> c(1, 3001);
+    for(std::size_t i = 0; i < c.size(); ++i) c[i] = i % 3 == 0 ? 1e16 : i % 3 == 1 ? 1.0 : -1e16;
+    ASSERT_EQUAL(sum(cppmath::execution::seq, c, Summation::Kahan), 1e16 + 1000.0);
+}
+
+void testWholeMatrix(){
+    std::mt19937 rng(11);
+    const Matrix<double> m = randomMatrix<double>(37, 53, rng, kValues);
+    double total = 0, l1 = 0, l2 = 0, inf = 0;
+    for(std::size_t i = 0; i < m.size(); ++i) {
+        total += m[i];
+        l1 += std::fabs(m[i]);
+        l2 += m[i] * m[i];
+        inf = std::max(inf, std::fabs(m[i]));
+    }
+    const double meanValue = total / m.size();
+    double deviations = 0;
+    for(std::size_t i = 0; i < m.size(); ++i) deviations += (m[i] - meanValue) * (m[i] - meanValue);
+
+    for(const Summation s : {Summation::Fast, Summation::Pairwise, Summation::Kahan}) {
+        ASSERT_NEAR(sum(m, s), total, 1e-10);
+        ASSERT_NEAR(mean(m, s), meanValue, 1e-12);
+    }
+    ASSERT_NEAR(variance(m), deviations / m.size(), 1e-10);
+    ASSERT_NEAR(variance(m, 1), deviations / (m.size() - 1), 1e-10);
+    ASSERT_NEAR(norm(m, Norm::L1), l1, 1e-9);
+    ASSERT_NEAR(norm(m, Norm::L2), std::sqrt(l2), 1e-10);
+    ASSERT_NEAR(norm(m), std::sqrt(l2), 1e-10);
+    ASSERT_EQUAL(norm(m, Norm::Infinity), inf);
+
+    // The same values through a transposed view, a submatrix and a view
+    // with strided columns
+    ASSERT_NEAR(sum(m.view().transposed()), total, 1e-10);
+    const Matrix<double> wide(m.rows(), 2 * m.columns(), 0.0);
+    Matrix<double> spread(wide);
+    for(std::size_t r = 0; r < m.rows(); ++r)
+        for(std::size_t c = 0; c < m.columns(); ++c) spread[{r, 2 * c + 1}] = m[{r, c}];
+    const ConstMatrixView<double> strided(spread.data() + 1, m.rows(), m.columns(), std::ptrdiff_t(spread.columns()), 2);
+    ASSERT_NEAR(sum(strided), total, 1e-10);
+    ASSERT_NEAR(norm(strided, Norm::L1), l1, 1e-9);
+    ASSERT_NEAR(sum(spread.submatrix({0, 1}, m.rows(), 1)), sum(m.submatrix({0, 0}, m.rows(), 1)), 1e-12);
+}
+
+void testExtrema(){
+    Matrix<int> m(5, 7, 3);
+    m[{2, 4}] = -8;
+    m[{4, 1}] = -8;
+    m[{1, 6}] = 12;
+    m[{3, 0}] = 12;
+    const Extrema<int> e = extrema(m);
+    ASSERT_EQUAL(e.minimum.value, -8);
+    ASSERT_EQUAL(e.minimum.point.row, 2u);
+    ASSERT_EQUAL(e.minimum.point.column, 4u);
+    ASSERT_EQUAL(e.maximum.value, 12);
+    ASSERT_EQUAL(e.maximum.point.row, 1u);
+    ASSERT_EQUAL(e.maximum.point.column, 6u);
+
+    // Positions are reported in the view that was passed, ties go to the
+    // first element in storage order
+    const Extremum<int> low = minimum(m.view().transposed());
+    ASSERT_EQUAL(low.value, -8);
+    ASSERT_EQUAL(low.point.row, 4u);
+    ASSERT_EQUAL(low.point.column, 2u);
+    const Extremum<int> high = maximum(m.submatrix({2, 0}, 3, 3));
+    ASSERT_EQUAL(high.value, 12);
+    ASSERT_EQUAL(high.point.row, 1u);
+    ASSERT_EQUAL(high.point.column, 0u);
+
+    // Spread over many extremes blocks and spans of a large matrix
+    std::mt19937 rng(13);
+    Matrix<float> big = randomMatrix<float>(300, 700, rng, kValues);
+    big[{211, 555}] = -100.0f;
+    big[{17, 3}] = 100.0f;
+    const Extrema<float> b = extrema(cppmath::execution::par.withGrain(1), big);
+    ASSERT_EQUAL(b.minimum.value, -100.0f);
+    ASSERT_EQUAL(b.minimum.point.row, 211u);
+    ASSERT_EQUAL(b.minimum.point.column, 555u);
+    ASSERT_EQUAL(b.maximum.point.row, 17u);
+    ASSERT_EQUAL(b.maximum.point.column, 3u);
+}
+
+template <typename T>
+void checkLines(const Matrix<T>& m, Axis axis, Summation summation, double tolerance){
+    const std::size_t count = axis == Axis::Rows ? m.rows() : m.columns();
+    const std::size_t length = axis == Axis::Rows ? m.columns() : m.rows();
+    std::vector<double> sums(count, 0.0), l1(count, 0.0), squares(count, 0.0), inf(count, 0.0);
+    for(std::size_t r = 0; r < m.rows(); ++r) {
+        for(std::size_t c = 0; c < m.columns(); ++c) {
+            const std::size_t i = axis == Axis::Rows ? r : c;
+            const double v = m[{r, c}];
+            sums[i] += v;
+            l1[i] += std::fabs(v);
+            squares[i] += v * v;
+            inf[i] = std::max(inf[i], std::fabs(v));
+        }
+    }
+    // Results into a column of a larger matrix and into a row vector
+    Matrix<T> column(count, 3, T(-1));
+    Matrix<T> row(1, count);
+    Matrix<T> norms(1, count);
+    Matrix<T> infinity(count, 1);
+    Matrix<T> variances(1, count);
+    sum(cppmath::execution::par.withGrain(1), m, axis, column.submatrix({0, 1}, count, 1), summation);
+    mean(m, axis, row, summation);
+    norm(m, axis, norms, Norm::L2);
+    norm(m, axis, infinity, Norm::Infinity);
+    variance(m, axis, variances, 1);
+    for(std::size_t i = 0; i < count; ++i) {
+        const double centered = squares[i] - sums[i] * sums[i] / length;
+        ASSERT_NEAR(double(column[{i, 1}]), sums[i], tolerance * (1 + l1[i]));
+        ASSERT_EQUAL((column[{i, 0}]), T(-1));
+        ASSERT_NEAR(double(row[i]), sums[i] / length, tolerance * (1 + l1[i]));
+        ASSERT_NEAR(double(norms[i]), std::sqrt(squares[i]), tolerance * (1 + l1[i]));
+        ASSERT_NEAR(double(infinity[i]), inf[i], 0.0);
+        ASSERT_NEAR(double(variances[i]), centered / (length - 1), tolerance * (1 + squares[i]));
+    }
+    Matrix<T> l1Norms(count, 1);
+    norm(cppmath::execution::seq, m, axis, l1Norms, Norm::L1);
+    for(std::size_t i = 0; i < count; ++i) ASSERT_NEAR(double(l1Norms[i]), l1[i], tolerance * (1 + l1[i]));
+}
+
+void testLines(){
+    std::mt19937 rng(17);
+    // More than kPairwiseRows rows and kReductionColumns columns, odd tails
+    const Matrix<double> tall = randomMatrix<double>(301, 5, rng, kValues);
+    const Matrix<double> wide = randomMatrix<double>(7, 1100, rng, kValues);
+    const Matrix<float> square = randomMatrix<float>(150, 150, rng, kValues);
+    for(const Summation s : {Summation::Fast, Summation::Pairwise, Summation::Kahan}) {
+        for(const Axis axis : {Axis::Rows, Axis::Columns}) {
+            checkLines(tall, axis, s, 1e-10);
+            checkLines(wide, axis, s, 1e-10);
+            checkLines(square, axis, s, 1e-5);
+        }
+    }
+
+    // A transposed view swaps the axes
+    Matrix<double> viaTranspose(1, tall.columns());
+    Matrix<double> direct(1, tall.columns());
+    sum(tall.view().transposed(), Axis::Rows, viaTranspose);
+    sum(tall, Axis::Columns, direct);
+    for(std::size_t i = 0; i < direct.size(); ++i) ASSERT_NEAR(viaTranspose[i], direct[i], 1e-12);
+
+    // Extrema of every row and column
+    std::vector<Extrema<double>> perRow, perColumn;
+    extrema(wide, Axis::Rows, perRow);
+    extrema(wide, Axis::Columns, perColumn);
+    ASSERT_EQUAL(perRow.size(), wide.rows());
+    ASSERT_EQUAL(perColumn.size(), wide.columns());
+    for(std::size_t r = 0; r < wide.rows(); ++r) {
+        const Extrema<double> e = extrema(wide.submatrix({r, 0}, 1, wide.columns()));
+        ASSERT_EQUAL(perRow[r].minimum.value, e.minimum.value);
+        ASSERT_EQUAL(perRow[r].minimum.point.row, r);
+        ASSERT_EQUAL(perRow[r].minimum.point.column, e.minimum.point.column);
+        ASSERT_EQUAL(perRow[r].maximum.point.column, e.maximum.point.column);
+    }
+    for(std::size_t c = 0; c < wide.columns(); ++c) {
+        const Extrema<double> e = extrema(wide.submatrix({0, c}, wide.rows(), 1));
+        ASSERT_EQUAL(perColumn[c].maximum.value, e.maximum.value);
+        ASSERT_EQUAL(perColumn[c].maximum.point.row, e.maximum.point.row);
+        ASSERT_EQUAL(perColumn[c].maximum.point.column, c);
+        ASSERT_EQUAL(perColumn[c].minimum.point.row, e.minimum.point.row);
+    }
+}
+
+void testIntegers(){
+    Matrix<std::int64_t> m(40, 30);
+    std::int64_t total = 0;
+    for(std::size_t i = 0; i < m.size(); ++i) {
+        m[i] = std::int64_t(i % 17) - 8;
+        total += m[i];
+    }
+    ASSERT_EQUAL(sum(m), total);
+    Matrix<std::int64_t> columns(1, 30);
+    sum(m, Axis::Columns, columns);
+    std::int64_t columnTotal = 0;
+    for(std::size_t i = 0; i < columns.size(); ++i) columnTotal += columns[i];
+    ASSERT_EQUAL(columnTotal, total);
+    ASSERT_EQUAL(minimum(m).value, std::int64_t(-8));
+    ASSERT_EQUAL(maximum(m).value, std::int64_t(8));
+}
+
+void testDeterminism(){
+    std::mt19937 rng(19);
+    const Matrix<float> m = randomMatrix<float>(700, 900, rng, kValues);
+    for(const Summation s : {Summation::Fast, Summation::Pairwise, Summation::Kahan}) {
+        const float serial = sum(cppmath::execution::seq, m, s);
+        ASSERT_EQUAL(sum(cppmath::execution::par.withGrain(1), m, s), serial);
+        ASSERT_EQUAL(sum(cppmath::execution::par, m, s), serial);
+    }
+}
+
+void testReduction(){
+    testKernelLevels();
+    testSummationAccuracy();
+    testWholeMatrix();
+    testExtrema();
+    testLines();
+    testIntegers();
+    testDeterminism();
+}
+
+int main(int a, char**)
+{
+    testReduction();
+    return 0;
+}
@@ -0,0 +1,206 @@
+#include <iostream>
+#include <cmath>
+#include <limits>
+#include <random>
+
+#include "src/cppmath_sparse.hpp"
+#include "src/cppmath_gemm.hpp"
+#include "cppmath_test.hpp"
+
+using namespace cppmath::matrix;
+using cppmath::cpu::InstructionSet;
+
+/** Multiples of 1/4 at density, so every sum is exact. */
+template <typename T>
+Matrix<T> randomSparse(std::size_t rows, std::size_t columns, double density, std::mt19937& rng){
+    std::uniform_int_distribution<int> dist(-8, 8);
+    std::uniform_real_distribution<double> keep(0.0, 1.0);
+    return randomMatrix<T>(rows, columns, rng, [&](std::mt19937& r){
+        return keep(r) < density ? static_cast<T>(dist(r)) / T(4) : T(0);
+    });
+}
+
+void testCooAssembly(){
+    CooMatrix<double> coo(3, 4);
+    coo.insert(2, 1, 5.0);
+    coo.insert(0, 3, 1.0);
+    coo.insert(0, 0, 2.0);
+    coo.insert(2, 1, -1.0);
+    coo.insert(1, 2, 3.0);
+    ASSERT_EQUAL(coo.nonZeros(), 5);
+
+    const CsrMatrix<double> csr(coo);
+    ASSERT_EQUAL(csr.nonZeros(), 4);
+    const std::size_t pointers[] = {0, 2, 3, 4};
+    const SparseIndex columns[] = {0, 3, 2, 1};
+    const double values[] = {2.0, 1.0, 3.0, 4.0};
+    for(std::size_t i = 0; i < 4; ++i) ASSERT_EQUAL(csr.rowPointers()[i], pointers[i]);
+    for(std::size_t k = 0; k < 4; ++k) {
+        ASSERT_EQUAL(csr.columnIndices()[k], columns[k]);
+        ASSERT_EQUAL(csr.values()[k], values[k]);
+    }
+    ASSERT_EQUAL((csr[{2, 1}]), 4.0);
+    ASSERT_EQUAL((csr[{2, 2}]), 0.0);
+
+    const CscMatrix<double> csc(coo);
+    ASSERT_EQUAL(csc.nonZeros(), 4);
+    ASSERT_EQUAL(csc.columnPointers()[4], 4);
+    ASSERT_EQUAL(csc.rowIndices()[3], 0);
+    ASSERT_EQUAL((csc[{1, 2}]), 3.0);
+
+    checkEqual(csr.toMatrix(), coo.toMatrix());
+    checkEqual(csc.toMatrix(), coo.toMatrix());
+}
+
+void testConversions(){
+    std::mt19937 rng(7);
+    const auto dense = randomSparse<double>(37, 23, 0.1, rng);
+
+    const CsrMatrix<double> csr(dense);
+    const CscMatrix<double> csc(dense);
+    checkEqual(csr.toMatrix(), dense);
+    checkEqual(csc.toMatrix(), dense);
+    checkEqual(CsrMatrix<double>(csc).toMatrix(), dense);
+    checkEqual(CscMatrix<double>(csr).toMatrix(), dense);
+
+    const Matrix<double> transposed(dense.view().transposed());
+    checkEqual(csr.transposed().toMatrix(), transposed);
+    checkEqual(csc.transposed().toMatrix(), transposed);
+    checkEqual(CsrMatrix<double>(dense.view().transposed()).toMatrix(), transposed);
+
+    std::size_t nonZeros = 0;
+    for(const double v : dense) nonZeros += v != 0.0;
+    ASSERT_EQUAL(csr.nonZeros(), nonZeros);
+
+    const CsrMatrix<double> empty(Matrix<double>(4, 5));
+    ASSERT_EQUAL(empty.nonZeros(), 0);
+    ASSERT_EQUAL(empty.rows(), 4);
+    checkEqual(empty.toMatrix(), Matrix<double>(4, 5));
+}
+
+template <typename T>
+void testSpmvKernels(){
+    std::mt19937 rng(11);
+    const InstructionSet levels[] = {InstructionSet::Generic, InstructionSet::SSE2, InstructionSet::AVX2, InstructionSet::AVX512};
+
+    for(const double density : {0.02, 0.3, 1.0}) {
+        const auto dense = randomSparse<T>(61, 97, density, rng);
+        const auto x = randomSparse<T>(97, 1, 1.0, rng);
+        const auto y = randomSparse<T>(61, 1, 1.0, rng);
+        const CsrMatrix<T> csr(dense);
+
+        Matrix<T> expected(61, 1);
+        gemm(T(2), dense, x, T(0), expected);
+        add(expected, y, expected);
+
+        for(const InstructionSet isa : levels) {
+            if(!cppmath::cpu::supports(isa)) continue;
+            const auto kernel = detail::sparseKernels<T>(isa).spmv;
+            Matrix<T> actual(y);
+            kernel(csr.rowPointers().data(), csr.columnIndices().data(), csr.values().data(),
+                   x.data(), actual.data(), 0, csr.rows(), T(2), T(1));
+            checkEqual(actual, expected);
+        }
+    }
+}
+
+void testSpmv(){
+    std::mt19937 rng(3);
+    const auto dense = randomSparse<double>(40, 30, 0.2, rng);
+    const auto x = randomSparse<double>(1, 30, 1.0, rng);
+    const CsrMatrix<double> csr(dense);
+
+    Matrix<double> expected(40, 1);
+    gemm(1.0, dense, x.view().transposed(), 0.0, expected);
+
+    // Row vector in, strided column out, NaN overwritten with beta == 0
+    Matrix<double> y(40, 3, std::numeric_limits<double>::quiet_NaN());
+    spmv(1.0, csr, x, 0.0, y.view().column(1));
+    for(std::size_t i = 0; i < 40; ++i) {
+        ASSERT_EQUAL((y[{i, 1}]), expected[i]);
+        ASSERT_THROW(std::isnan(y[{i, 0}]));
+    }
+
+    Matrix<double> z(40, 1, 1.0);
+    spmv(-1.0, csr, x.view().transposed(), 0.5, z);
+    for(std::size_t i = 0; i < 40; ++i) ASSERT_EQUAL(z[i], 0.5 - expected[i]);
+}
+
+template <typename T>
+void testSpmm(){
+    std::mt19937 rng(5);
+    const std::size_t shapes[][3] = {{1, 1, 1}, {17, 9, 5}, {64, 80, 33}, {50, 20, 1}};
+
+    for(const auto& shape : shapes) {
+        const auto dense = randomSparse<T>(shape[0], shape[1], 0.15, rng);
+        const auto b = randomSparse<T>(shape[1], shape[2], 1.0, rng);
+        const auto c = randomSparse<T>(shape[0], shape[2], 1.0, rng);
+
+        Matrix<T> expected(c);
+        gemm(T(0.5), dense, b, T(2), expected);
+
+        Matrix<T> fromCsr(c);
+        spmm(T(0.5), CsrMatrix<T>(dense), b, T(2), fromCsr);
+        checkEqual(fromCsr, expected);
+
+        Matrix<T> fromCsc(c);
+        spmm(T(0.5), CscMatrix<T>(dense), b, T(2), fromCsc);
+        checkEqual(fromCsc, expected);
+
+        checkEqual(CsrMatrix<T>(dense) * b, dense * b);
+        checkEqual(CscMatrix<T>(dense) * b, dense * b);
+    }
+}
+
+void testSpmmOnViews(){
+    std::mt19937 rng(9);
+    const auto dense = randomSparse<double>(12, 10, 0.3, rng);
+    const auto b = randomSparse<double>(8, 10, 1.0, rng);
+    const CsrMatrix<double> csr(dense);
+    const CscMatrix<double> csc(dense);
+
+    const Matrix<double> expected = dense * b.view().transposed();
+    checkEqual(csr * b.view().transposed(), expected);
+    checkEqual(csc * b.view().transposed(), expected);
+
+    Matrix<double> out(8, 12, std::numeric_limits<double>::quiet_NaN());
+    spmm(1.0, csr, b.view().transposed(), 0.0, out.view().transposed());
+    checkEqual(Matrix<double>(out.view().transposed()), expected);
+}
+
+void testLarge(){
+    std::mt19937 rng(13);
+    const std::size_t n = 3000;
+    CooMatrix<float> coo(n, n);
+    std::uniform_int_distribution<std::size_t> index(0, n - 1);
+    for(std::size_t k = 0; k < 40 * n; ++k) coo.insert(index(rng), index(rng), 0.5f);
+    for(std::size_t i = 0; i < n; ++i) coo.insert(i, i, 1.0f);
+
+    const CsrMatrix<float> csr(coo);
+    const Matrix<float> x(n, 1, 2.0f);
+    const Matrix<float> y = csr * x;
+    for(std::size_t i = 0; i < n; ++i) {
+        float expected = 0;
+        for(std::size_t k = csr.rowPointers()[i]; k < csr.rowPointers()[i + 1]; ++k) expected += 2.0f * csr.values()[k];
+        ASSERT_NEAR(y[i], expected, 1e-3);
+    }
+}
+
+void testSparse()
+{
+    testCooAssembly();
+    testConversions();
+    testSpmvKernels<float>();
+    testSpmvKernels<double>();
+    testSpmv();
+    testSpmm<float>();
+    testSpmm<double>();
+    testSpmmOnViews();
+    testLarge();
+}
+
+int main(int a, char**)
+{
+    testSparse();
+    return 0;
+}
@@ -0,0 +1,103 @@
+#include <iostream>
+#include <cmath>
+#include <random>
+
+#include "src/cppmath_strassen.hpp"
+#include "cppmath_test.hpp"
+
+using namespace cppmath::matrix;
+
+void testWorkspaceSize(){
+    ASSERT_EQUAL(detail::strassenDepth(100, 100, 100, 128), 0u);
+    ASSERT_EQUAL(detail::strassenDepth(256, 300, 1000, 64), 3u);
+    ASSERT_EQUAL(detail::strassenWorkspaceSize(100, 100, 100, 128), 0u);
+    // One level of a square product: two quadrant temporaries
+    ASSERT_EQUAL(detail::strassenWorkspaceSize(200, 200, 200, 128), 2u * 100 * 100);
+    ASSERT_EQUAL(detail::strassenWorkspaceSize(200, 200, 200, 100), 2u * 100 * 100 + 2u * 50 * 50);
+}
+
+template <typename T>
+void testShapes(){
+    std::mt19937 rng(42);
+    // Even, odd and mixed dimensions, peeled at every level
+    const std::size_t sizes[][3] = {
+        {16, 16, 16}, {17, 17, 17}, {32, 31, 33}, {45, 64, 38}, {65, 63, 127}, {100, 100, 100}
+    };
+    const std::size_t crossovers[] = {4, 8, 16};
+
+    for(const auto& size : sizes) {
+        const auto a = randomMatrix<T>(size[0], size[2], rng);
+        const auto b = randomMatrix<T>(size[2], size[1], rng);
+        const auto c = randomMatrix<T>(size[0], size[1], rng);
+        for(const std::size_t crossover : crossovers) {
+            StrassenOptions options;
+            options.crossover = crossover;
+            const T alphas[] = {T(1), T(-0.5)};
+            const T betas[] = {T(0), T(0.25)};
+            for(const T alpha : alphas) {
+                for(const T beta : betas) {
+                    Matrix<T> result(c);
+                    strassen(cppmath::execution::seq, alpha, a, b, beta, result, options);
+                    checkEqual(result, naiveMultiply(alpha, a, b, beta, c));
+                }
+            }
+        }
+    }
+}
+
+void testViews(){
+    // C^T = B^T * A^T through transposed views, written into a submatrix
+    std::mt19937 rng(7);
+    const auto a = randomMatrix<double>(37, 41, rng);
+    const auto b = randomMatrix<double>(41, 29, rng);
+    Matrix<double> out(40, 40, 1.0);
+    StrassenOptions options;
+    options.crossover = 8;
+
+    strassen(1.0, b.view().transposed(), a.view().transposed(), 0.0, out.view().submatrix({2, 3}, 29, 37), options);
+
+    const auto expected = naiveMultiply(1.0, a, b, 0.0, Matrix<double>(37, 29));
+    for(std::size_t i = 0; i < 40; ++i) {
+        for(std::size_t j = 0; j < 40; ++j) {
+            const bool inside = i >= 2 && i < 31 && j >= 3 && j < 40;
+            ASSERT_EQUAL((out[{i, j}]), inside ? (expected[{j - 3, i - 2}]) : 1.0);
+        }
+    }
+}
+
+void testRoundoff(){
+    // Uniform inputs lose a little to the extra additions, well within the
+    // normwise bound
+    std::mt19937 rng(11);
+    std::uniform_real_distribution<double> dist(-1.0, 1.0);
+    const std::size_t n = 301;
+    Matrix<double> a(n, n), b(n, n);
+    for(std::size_t i = 0; i < a.size(); ++i) {
+        a[i] = dist(rng);
+        b[i] = dist(rng);
+    }
+    Matrix<double> fast(n, n), classical(n, n);
+    StrassenOptions options;
+    options.crossover = 32;
+    strassen(1.0, a, b, 0.0, fast, options);
+    gemm(1.0, a, b, 0.0, classical);
+
+    double error = 0;
+    for(std::size_t i = 0; i < fast.size(); ++i) error = std::max(error, std::fabs(fast[i] - classical[i]));
+    ASSERT_THROW(error < 1e-10);
+}
+
+void testStrassen()
+{
+    testWorkspaceSize();
+    testShapes<double>();
+    testShapes<float>();
+    testViews();
+    testRoundoff();
+}
+
+int main(int a, char**)
+{
+    testStrassen();
+    return 0;
+}
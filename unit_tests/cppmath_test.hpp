@@ -0,0 +1,137 @@
+//
+//  cppmath_test.hpp
+//  CppMath unit tests
+//
+//  Created by Dmytro Krasnianskyi on 17.10.26.
+//  Copyright © 2026 Dmytro Krasnianskyi. All rights reserved.
+//
+
+#ifndef cppmath_test_hpp
+#define cppmath_test_hpp
+
+#include <string>
+#include <stdexcept>
+#include <cmath>
+#include <random>
+
+#include "src/cppmath_matrix.hpp"
+
+#define ASSERT_THROW( condition )                                   \
+{                                                                   \
+  if( !( condition ) )                                              \
+  {                                                                 \
+    throw std::runtime_error(   std::string( __FILE__ )             \
+                              + std::string( ":" )                  \
+                              + std::to_string( __LINE__ )          \
+                              + std::string( " in " )               \
+                              + std::string( __PRETTY_FUNCTION__ )  \
+    );                                                              \
+  }                                                                 \
+}
+
+#define ASSERT_EQUAL( x, y )                                        \
+{                                                                   \
+  if( ( x ) != ( y ) )                                              \
+  {                                                                 \
+    throw std::runtime_error(   std::string( __FILE__ )             \
+                              + std::string( ":" )                  \
+                              + std::to_string( __LINE__ )          \
+                              + std::string( " in " )               \
+                              + std::string( __PRETTY_FUNCTION__ )  \
+                              + std::string( ": " )                 \
+                              + std::to_string( ( x ) )             \
+                              + std::string( " != " )               \
+                              + std::to_string( ( y ) )             \
+                              + std::string( " in expr.: " )        \
+                              + std::string( #x )                   \
+                              + std::string( " != " )               \
+                              + std::string( #y )                   \
+    );                                                              \
+  }                                                                 \
+}
+
+#define ASSERT_EQUAL_EXP( x, y )                                    \
+{                                                                   \
+if( ( x ) != ( y ) )                                                \
+{                                                                   \
+throw std::runtime_error(   std::string( __FILE__ )                 \
+                            + std::string( ":" )                    \
+                            + std::to_string( __LINE__ )            \
+                            + std::string( " in " )                 \
+                            + std::string( __PRETTY_FUNCTION__ )    \
+                            + std::string( ": " )                   \
+                            + std::string( #x )                     \
+                            + std::string( " != " )                 \
+                            + std::string( #y )                     \
+);                                                                  \
+}                                                                   \
+}
+
+#define ASSERT_NEAR( x, y, tolerance )                              \
+{                                                                   \
+  if( !( std::fabs( ( x ) - ( y ) ) <= ( tolerance ) ) )            \
+  {                                                                 \
+    throw std::runtime_error(   std::string( __FILE__ )             \
+                              + std::string( ":" )                  \
+                              + std::to_string( __LINE__ )          \
+                              + std::string( " in " )               \
+                              + std::string( __PRETTY_FUNCTION__ )  \
+                              + std::string( ": " )                 \
+                              + std::to_string( ( x ) )             \
+                              + std::string( " !~ " )               \
+                              + std::to_string( ( y ) )             \
+                              + std::string( " in expr.: " )        \
+                              + std::string( #x )                   \
+                              + std::string( " !~ " )               \
+                              + std::string( #y )                   \
+    );                                                              \
+  }                                                                 \
+}
+
+/** rows x columns matrix of static_cast<T>(values(rng)). values is a
+    standard distribution or any callable taking the generator.
+ */
+template <typename T, class Values>
+cppmath::matrix::Matrix<T> randomMatrix(std::size_t rows, std::size_t columns, std::mt19937& rng, Values values){
+    cppmath::matrix::Matrix<T> m(rows, columns);
+    for(std::size_t i = 0; i < m.size(); ++i) m[i] = static_cast<T>(values(rng));
+    return m;
+}
+
+/** Multiples of 1/4 in [-2, 2]. Sums and products of them stay exact for
+    the sizes the tests use, so results can be compared bit for bit.
+ */
+template <typename T>
+cppmath::matrix::Matrix<T> randomMatrix(std::size_t rows, std::size_t columns, std::mt19937& rng){
+    std::uniform_int_distribution<int> dist(-8, 8);
+    return randomMatrix<T>(rows, columns, rng, [&](std::mt19937& r){ return static_cast<T>(dist(r)) / T(4); });
+}
+
+/** alpha * a * b + beta * c, one dot product per element. */
+template <typename T>
+cppmath::matrix::Matrix<T> naiveMultiply(const T& alpha, const cppmath::matrix::Matrix<T>& a, const cppmath::matrix::Matrix<T>& b,
+                                         const T& beta, const cppmath::matrix::Matrix<T>& c){
+    cppmath::matrix::Matrix<T> result(c);
+    for(std::size_t i = 0; i < a.rows(); ++i) {
+        for(std::size_t j = 0; j < b.columns(); ++j) {
+            T acc = T();
+            for(std::size_t p = 0; p < a.columns(); ++p) {
+                acc += a[{i, p}] * b[{p, j}];
+            }
+            result[{i, j}] = alpha * acc + beta * c[{i, j}];
+        }
+    }
+    return result;
+}
+
+/** Same shape and bitwise equal elements. */
+template <typename T>
+void checkEqual(const cppmath::matrix::Matrix<T>& actual, const cppmath::matrix::Matrix<T>& expected){
+    ASSERT_EQUAL(actual.rows(), expected.rows());
+    ASSERT_EQUAL(actual.columns(), expected.columns());
+    for(std::size_t i = 0; i < actual.size(); ++i) {
+        ASSERT_EQUAL(actual[i], expected[i]);
+    }
+}
+
+#endif /* cppmath_test_hpp */
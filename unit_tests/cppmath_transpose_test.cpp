@@ -0,0 +1,123 @@
+#include <iostream>
+#include <random>
+#include <vector>
+#include <algorithm>
+
+#include "src/cppmath_transpose.hpp"
+#include "cppmath_test.hpp"
+
+using namespace cppmath::matrix;
+using cppmath::cpu::InstructionSet;
+namespace execution = cppmath::execution;
+
+template <typename T>
+Matrix<T> countingMatrix(std::size_t rows, std::size_t columns){
+    Matrix<T> m(rows, columns);
+    for(std::size_t i = 0; i < m.size(); ++i) m[i] = static_cast<T>(i);
+    return m;
+}
+
+template <typename T, typename U>
+bool isTransposeOf(const Matrix<T>& t, const U& m){
+    if(t.rows() != m.columns() || t.columns() != m.rows()) return false;
+    for(std::size_t r = 0; r < m.rows(); ++r)
+        for(std::size_t c = 0; c < m.columns(); ++c)
+            if(t[MatrixPoint{c, r}] != m[MatrixPoint{r, c}]) return false;
+    return true;
+}
+
+template <typename T>
+bool isEqual(const Matrix<T>& a, const Matrix<T>& b){
+    return a.rows() == b.rows() && a.columns() == b.columns() && std::equal(a.data(), a.data() + a.size(), b.data());
+}
+
+template <typename T>
+void testKernelLevels(){
+    const InstructionSet levels[] = {InstructionSet::Generic, InstructionSet::SSE2, InstructionSet::AVX2, InstructionSet::AVX512};
+    const std::size_t shapes[][2] = {{1, 1}, {4, 4}, {8, 8}, {3, 17}, {16, 9}, {64, 64}, {61, 47}};
+    for(const InstructionSet isa : levels) {
+        if(!cppmath::cpu::supports(isa)) continue;
+        const auto kernels = detail::transposeKernels<T>(isa);
+        for(const auto& shape : shapes) {
+            const auto m = countingMatrix<T>(shape[0], shape[1]);
+            // Padded destination rows catch writes past the block
+            const std::size_t stride = shape[0] + 5;
+            std::vector<T> out(shape[1] * stride, T(-1));
+            kernels.block(m.data(), static_cast<std::ptrdiff_t>(shape[1]), out.data(), static_cast<std::ptrdiff_t>(stride), shape[0], shape[1]);
+            for(std::size_t r = 0; r < shape[0]; ++r)
+                for(std::size_t c = 0; c < shape[1]; ++c)
+                    ASSERT_EQUAL(out[c * stride + r], (m[{r, c}]));
+            for(std::size_t c = 0; c < shape[1]; ++c)
+                for(std::size_t p = shape[0]; p < stride; ++p)
+                    ASSERT_EQUAL(out[c * stride + p], T(-1));
+        }
+    }
+}
+
+void testOutOfPlace(){
+    testKernelLevels<float>();
+    testKernelLevels<double>();
+    testKernelLevels<int>();
+
+    const std::size_t shapes[][2] = {{1, 300}, {300, 1}, {129, 257}, {513, 70}, {200, 200}};
+    for(const auto& shape : shapes) {
+        const auto m = countingMatrix<double>(shape[0], shape[1]);
+        ASSERT_EQUAL(isTransposeOf(transposed(m), m), true);
+        ASSERT_EQUAL(isTransposeOf(transposed(execution::seq, m), m), true);
+        Matrix<double> out(shape[1], shape[0]);
+        transpose(execution::par.withGrain(1), m, out);
+        ASSERT_EQUAL(isTransposeOf(out, m), true);
+    }
+
+    // Views: strided source and destination
+    const auto big = countingMatrix<float>(300, 400);
+    const auto sub = big.submatrix({7, 13}, 150, 211);
+    const auto t = transposed(sub);
+    ASSERT_EQUAL(isTransposeOf(t, sub), true);
+    ASSERT_EQUAL(isTransposeOf(transposed(big.view().transposed()), big.view().transposed()), true);
+
+    Matrix<float> target(260, 200);
+    transpose(sub, target.submatrix({3, 40}, 211, 150));
+    for(std::size_t r = 0; r < 150; ++r)
+        for(std::size_t c = 0; c < 211; ++c)
+            ASSERT_EQUAL((target[{3 + c, 40 + r}]), (sub[{r, c}]));
+    ASSERT_EQUAL((target[{0, 0}]), 0.0f);
+}
+
+void testInPlace(){
+    const std::size_t squares[] = {0, 1, 2, 63, 64, 65, 200};
+    for(const std::size_t n : squares) {
+        const auto original = countingMatrix<double>(n, n);
+        Matrix<double> m(original);
+        transposeInPlace(m);
+        ASSERT_EQUAL(isTransposeOf(m, original), true);
+        transposeInPlace(execution::seq, m);
+        ASSERT_EQUAL(isEqual(m, original), true);
+    }
+
+    const std::size_t shapes[][2] = {{1, 7}, {7, 1}, {2, 3}, {3, 5}, {64, 65}, {100, 37}, {12, 300}};
+    for(const auto& shape : shapes) {
+        const auto original = countingMatrix<int>(shape[0], shape[1]);
+        Matrix<int> m(original);
+        const int* storage = m.data();
+        transposeInPlace(m);
+        ASSERT_EQUAL(m.rows(), shape[1]);
+        ASSERT_EQUAL(m.columns(), shape[0]);
+        ASSERT_THROW(m.data() == storage);
+        ASSERT_EQUAL(isTransposeOf(m, original), true);
+        transposeInPlace(m);
+        ASSERT_EQUAL(isEqual(m, original), true);
+    }
+}
+
+void testTranspose()
+{
+    testOutOfPlace();
+    testInPlace();
+}
+
+int main(int a, char**)
+{
+    testTranspose();
+    return 0;
+}